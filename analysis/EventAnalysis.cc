@@ -36,10 +36,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "TDirectory.h"
 #include "TFile.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 ClassImp(EventAnalysis)
@@ -53,7 +55,8 @@ EventAnalysis::EventAnalysis():
   emittanceOnTheFly(false),
   eventStart(0),
   eventEnd(-1),
-  nEventsToProcess(0)
+  nEventsToProcess(0),
+  nEventsNotAccumulated(0)
 {;}
 
 EventAnalysis::EventAnalysis(Event*   eventIn,
@@ -75,7 +78,8 @@ EventAnalysis::EventAnalysis(Event*   eventIn,
   emittanceOnTheFly(emittanceOnTheFlyIn),
   eventStart(eventStartIn),
   eventEnd(eventEndIn),
-  nEventsToProcess(eventEndIn - eventStartIn)
+  nEventsToProcess(eventEndIn - eventStartIn),
+  nEventsNotAccumulated(0)
 {
   // check we get this right for print out normalisation
   if (eventEndIn == -1)
@@ -233,6 +237,7 @@ void EventAnalysis::Terminate()
     {
       //vector of emittance values and errors: emitt_x, emitt_y, err_emitt_x, err_emitt_y
       std::vector<double> emittance = {0,0,0,0};
+      AccumulateSamplers();
       for (auto& samplerAnalysis : samplerAnalyses)
         {
           emittance = samplerAnalysis->Terminate(emittance, !emittanceOnTheFly);
@@ -288,78 +293,8 @@ void EventAnalysis::Write(TFile* outputFile)
 
   outputFile->cd("/");
 
-  std::vector<double> xOpticsPoint;
-  std::vector<double> yOpticsPoint;
-  std::vector<double> lOpticsPoint;
-  xOpticsPoint.resize(25);
-  yOpticsPoint.resize(25);
-  lOpticsPoint.resize(25);
-
-  // write optical functions
-  TTree* opticsTree = new TTree("Optics","Optics");
-  opticsTree->Branch("Emitt_x", &(xOpticsPoint[0]), "Emitt_x/D");
-  opticsTree->Branch("Emitt_y", &(yOpticsPoint[0]), "Emitt_y/D");
-  opticsTree->Branch("Alpha_x", &(xOpticsPoint[1]), "Alpha_x/D");
-  opticsTree->Branch("Alpha_y", &(yOpticsPoint[1]), "Alpha_y/D");
-  opticsTree->Branch("Beta_x",  &(xOpticsPoint[2]), "Beta_x/D");
-  opticsTree->Branch("Beta_y",  &(yOpticsPoint[2]), "Beta_y/D");
-  opticsTree->Branch("Gamma_x", &(xOpticsPoint[3]), "Gamma_x/D");
-  opticsTree->Branch("Gamma_y", &(yOpticsPoint[3]), "Gamma_y/D");
-  opticsTree->Branch("Disp_x",  &(xOpticsPoint[4]), "Disp_x/D");
-  opticsTree->Branch("Disp_y",  &(yOpticsPoint[4]), "Disp_y/D");
-  opticsTree->Branch("Disp_xp", &(xOpticsPoint[5]), "Disp_xp/D");
-  opticsTree->Branch("Disp_yp", &(yOpticsPoint[5]), "Disp_yp/D");
-  opticsTree->Branch("Mean_x",  &(xOpticsPoint[6]), "Mean_x/D");
-  opticsTree->Branch("Mean_y",  &(yOpticsPoint[6]), "Mean_y/D");
-  opticsTree->Branch("Mean_xp", &(xOpticsPoint[7]), "Mean_xp/D");
-  opticsTree->Branch("Mean_yp", &(yOpticsPoint[7]), "Mean_yp/D");
-  opticsTree->Branch("Sigma_x", &(xOpticsPoint[8]), "Sigma_x/D");
-  opticsTree->Branch("Sigma_y", &(yOpticsPoint[8]), "Sigma_y/D");
-  opticsTree->Branch("Sigma_xp",&(xOpticsPoint[9]), "Sigma_xp/D");
-  opticsTree->Branch("Sigma_yp",&(yOpticsPoint[9]), "Sigma_yp/D");
-  opticsTree->Branch("S"       ,&(xOpticsPoint[10]),"S/D");
-  opticsTree->Branch("Npart"   ,&(xOpticsPoint[11]),"Npart/D");
-
-  opticsTree->Branch("Sigma_Emitt_x", &(xOpticsPoint[12]), "Sigma_Emitt_x/D");
-  opticsTree->Branch("Sigma_Emitt_y", &(yOpticsPoint[12]), "Sigma_Emitt_y/D");
-  opticsTree->Branch("Sigma_Alpha_x", &(xOpticsPoint[13]), "Sigma_Alpha_x/D");
-  opticsTree->Branch("Sigma_Alpha_y", &(yOpticsPoint[13]), "Sigma_Alpha_y/D");
-  opticsTree->Branch("Sigma_Beta_x",  &(xOpticsPoint[14]), "Sigma_Beta_x/D");
-  opticsTree->Branch("Sigma_Beta_y",  &(yOpticsPoint[14]), "Sigma_Beta_y/D");
-  opticsTree->Branch("Sigma_Gamma_x", &(xOpticsPoint[15]), "Sigma_Gamma_x/D");
-  opticsTree->Branch("Sigma_Gamma_y", &(yOpticsPoint[15]), "Sigma_Gamma_y/D");
-  opticsTree->Branch("Sigma_Disp_x",  &(xOpticsPoint[16]), "Sigma_Disp_x/D");
-  opticsTree->Branch("Sigma_Disp_y",  &(yOpticsPoint[16]), "Sigma_Disp_y/D");
-  opticsTree->Branch("Sigma_Disp_xp", &(xOpticsPoint[17]), "Sigma_Disp_xp/D");
-  opticsTree->Branch("Sigma_Disp_yp", &(yOpticsPoint[17]), "Sigma_Disp_yp/D");
-  opticsTree->Branch("Sigma_Mean_x",  &(xOpticsPoint[18]), "Sigma_Mean_x/D");
-  opticsTree->Branch("Sigma_Mean_y",  &(yOpticsPoint[18]), "Sigma_Mean_y/D");
-  opticsTree->Branch("Sigma_Mean_xp", &(xOpticsPoint[19]), "Sigma_Mean_xp/D");
-  opticsTree->Branch("Sigma_Mean_yp", &(yOpticsPoint[19]), "Sigma_Mean_yp/D");
-  opticsTree->Branch("Sigma_Sigma_x", &(xOpticsPoint[20]), "Sigma_Sigma_x/D");
-  opticsTree->Branch("Sigma_Sigma_y", &(yOpticsPoint[20]), "Sigma_Sigma_y/D");
-  opticsTree->Branch("Sigma_Sigma_xp",&(xOpticsPoint[21]), "Sigma_Sigma_xp/D");
-  opticsTree->Branch("Sigma_Sigma_yp",&(yOpticsPoint[21]), "Sigma_Sigma_yp/D");
-
-  opticsTree->Branch("Mean_E",        &(lOpticsPoint[6]),  "Mean_E/D");
-  opticsTree->Branch("Mean_t",        &(lOpticsPoint[7]),  "Mean_t/D");
-  opticsTree->Branch("Sigma_E",       &(lOpticsPoint[8]),  "Sigma_E/D");
-  opticsTree->Branch("Sigma_t",       &(lOpticsPoint[9]),  "Sigma_t/D");
-  opticsTree->Branch("Sigma_Mean_E",  &(lOpticsPoint[18]), "Sigma_Mean_E/D");
-  opticsTree->Branch("Sigma_Mean_t",  &(lOpticsPoint[19]), "Sigma_Mean_t/D");
-  opticsTree->Branch("Sigma_Sigma_E", &(lOpticsPoint[20]), "Sigma_Sigma_E/D");
-  opticsTree->Branch("Sigma_Sigma_t", &(lOpticsPoint[21]), "Sigma_Sigma_t/D");
-
-  opticsTree->Branch("xyCorrelationCoefficent", &(xOpticsPoint[24]), "xyCorrelationCoefficent/D");
-
-  for(const auto& entry : opticalFunctions)
-    {
-      xOpticsPoint = entry[0];
-      yOpticsPoint = entry[1];
-      lOpticsPoint = entry[2];
-      opticsTree->Fill();
-    }
-  opticsTree->Write();
+  SamplerAnalysis::WriteOpticalFunctions(opticalFunctions);
+  SamplerAnalysis::WriteMoments(samplerAnalyses, emittanceOnTheFly);
 }
 
 void EventAnalysis::ProcessSamplers(bool firstTime)
@@ -368,7 +303,35 @@ void EventAnalysis::ProcessSamplers(bool firstTime)
     {
       for (auto s : samplerAnalyses)
         {s->Process(firstTime);}
+      nEventsNotAccumulated++;
+      if (nEventsNotAccumulated >= nEventsPerAccumulation)
+        {AccumulateSamplers();}
+    }
+}
+
+void EventAnalysis::AccumulateSamplers()
+{
+  nEventsNotAccumulated = 0;
+  // each sampler analysis is independent so share them out between threads
+  unsigned int nThreads = std::max(1u, std::thread::hardware_concurrency());
+  nThreads = std::min(nThreads, (unsigned int)samplerAnalyses.size());
+  if (nThreads <= 1)
+    {
+      for (auto s : samplerAnalyses)
+        {s->Accumulate();}
+      return;
+    }
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < nThreads; ++t)
+    {
+      threads.emplace_back([this, t, nThreads]()
+                           {
+                             for (std::size_t i = t; i < samplerAnalyses.size(); i += nThreads)
+                               {samplerAnalyses[i]->Accumulate();}
+                           });
     }
+  for (auto& thread : threads)
+    {thread.join();}
 }
 
 void EventAnalysis::Initialise()
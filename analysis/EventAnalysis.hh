@@ -97,9 +97,14 @@ private:
   /// Initialise each sampler analysis object in samplerAnalysis.
   void Initialise();
 
-  /// Process each sampler analysis object.
+  /// Process each sampler analysis object. The coordinates are accumulated into the
+  /// optics power sums every nEventsPerAccumulation events.
   void ProcessSamplers(bool firstTime = false);
 
+  /// Accumulate the coordinates stored by all sampler analysis objects, sharing the
+  /// samplers out between threads.
+  void AccumulateSamplers();
+
   /// The data is different for different sampler types and therefore we must
   /// specialise the PerEntryHistogramSet. This delegator function constructs
   /// the right one.
@@ -114,6 +119,10 @@ private:
   long int eventStart;    ///< Event index to start analysis from.
   long int eventEnd;      ///< Event index to end analysis at.
   long int nEventsToProcess; ///< Difference between start and stop.
+  long int nEventsNotAccumulated; ///< Events processed by the samplers since the last accumulation.
+
+  /// Number of events the sampler analyses store before they are accumulated.
+  static const long int nEventsPerAccumulation = 1000;
 
   /// Cache of all per entry histogram sets.
   std::vector<PerEntryHistogramSet*> perEntryHistogramSets;
@@ -121,7 +130,7 @@ private:
   /// Map of simple histograms created per histogram set for writing out.
   std::map<HistogramDefSet*, std::vector<TH1*> > simpleSetHistogramOutputs;
   
-  ClassDef(EventAnalysis,2);
+  ClassDef(EventAnalysis,3);
 };
 
 #endif
@@ -17,12 +17,18 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "SamplerAnalysis.hh"
+#include "SamplerMoments.hh"
 #include "rebdsim.hh"
 
+#include "TTree.h"
+
+#include <algorithm>
 #include <cmath>
+#include <string>
 #include <vector>
 
 double SamplerAnalysis::particleMass = 0;
+const std::string SamplerAnalysis::momentsTreeName = "OpticsMoments";
 
 SamplerAnalysis::SamplerAnalysis():
   s(nullptr),
@@ -48,6 +54,17 @@ SamplerAnalysis::SamplerAnalysis(BDSOutputROOTEventSampler<double> *samplerIn,
   CommonCtor();
 }
 
+SamplerAnalysis::SamplerAnalysis(const SamplerMoments& momentsIn,
+				 double                SIn):
+  s(nullptr),
+  npart(0),
+  S(SIn),
+  debug(false)
+{
+  CommonCtor();
+  moments = momentsIn;
+}
+
 void SamplerAnalysis::UpdateMass(SamplerAnalysis* s)
 {
   int id = s->s->partID[0];
@@ -97,6 +114,8 @@ void SamplerAnalysis::CommonCtor()
 
   // initialise a vector to store the first values in a sampler for assumed mean subtraction
   offsets.resize(6, 0);
+
+  moments.Clear();
   
   optical.resize(3); // resize to 3 entries initialised to 0
   varOptical.resize(3);
@@ -163,9 +182,11 @@ SamplerAnalysis::~SamplerAnalysis()
 void SamplerAnalysis::Initialise()
 {
   npart = 0;
+  block.clear();
+  moments.Clear();
 }
 
-void SamplerAnalysis::Process(bool firstTime)
+void SamplerAnalysis::Process(bool /*firstTime*/)
 {
   if(debug)
     {std::cout << __METHOD_NAME__ << "\"" << s->samplerName << "\" with " << s->n << " entries" << std::endl;}
@@ -191,27 +212,18 @@ void SamplerAnalysis::Process(bool firstTime)
     coordinates[4] = std::sqrt(std::pow(s->energy[i],2) - m2); // p = sqrt(E^2 - M^2)
     coordinates[5] = s->T[i];
 
-    if (firstTime)
-      {offsets = coordinates;}
-
-    // power sums
-    for(int a=0;a<6;++a)
-      {
-	for(int b=0;b<6;++b)
-	  {
-	    for (int j = 0; j <= 4; ++j)
-	      {
-		for (int k = 0; k <= 4; ++k)
-		  {
-		    powSums[a][b][j][k] += std::pow(coordinates[a]-offsets[a],j)*std::pow(coordinates[b]-offsets[b],k);
-		  }
-	      }
-	  }
-      }
+    // store for the moments in Accumulate()
+    block.insert(block.end(), coordinates.begin(), coordinates.end());
   npart++;  
   }
 }
 
+void SamplerAnalysis::Accumulate()
+{
+  moments.Add(block);
+  block.clear();
+}
+
 std::vector<double> SamplerAnalysis::Terminate(std::vector<double> emittance,
 					       bool useEmittanceFromFirstSampler)
 {
@@ -221,6 +233,24 @@ std::vector<double> SamplerAnalysis::Terminate(std::vector<double> emittance,
   // determine whether the input emittance is non-zero
   bool nonZeroEmittanceIn = !std::all_of(emittance.begin(), emittance.end(), [](double l) { return l==0; });
 
+  // power sums about the mean of all particles - the central moments below are
+  // independent of the offsets the sums are taken from, so this is exact
+  Accumulate();
+  npart = moments.N();
+  for (int a = 0; a < 6; ++a)
+    {offsets[a] = moments.Mean(a);}
+  for (int a = 0; a < 6; ++a)
+    {
+      for (int b = 0; b < 6; ++b)
+	{
+	  for (int j = 0; j <= 4; ++j)
+	    {
+	      for (int k = 0; k <= 4; ++k)
+		{powSums[a][b][j][k] = moments.CentralSum(a, b, j, k);}
+	    }
+	}
+    }
+
   // central moments
   for(int a=0;a<6;++a)
   {
@@ -386,6 +416,103 @@ std::vector<double> SamplerAnalysis::Terminate(std::vector<double> emittance,
   return emittanceOut;
 }
 
+void SamplerAnalysis::WriteOpticalFunctions(const std::vector<std::vector<std::vector<double> > >& opticalFunctions)
+{
+  std::vector<double> xOpticsPoint;
+  std::vector<double> yOpticsPoint;
+  std::vector<double> lOpticsPoint;
+  xOpticsPoint.resize(25);
+  yOpticsPoint.resize(25);
+  lOpticsPoint.resize(25);
+
+  // write optical functions
+  TTree* opticsTree = new TTree("Optics","Optics");
+  opticsTree->Branch("Emitt_x", &(xOpticsPoint[0]), "Emitt_x/D");
+  opticsTree->Branch("Emitt_y", &(yOpticsPoint[0]), "Emitt_y/D");
+  opticsTree->Branch("Alpha_x", &(xOpticsPoint[1]), "Alpha_x/D");
+  opticsTree->Branch("Alpha_y", &(yOpticsPoint[1]), "Alpha_y/D");
+  opticsTree->Branch("Beta_x",  &(xOpticsPoint[2]), "Beta_x/D");
+  opticsTree->Branch("Beta_y",  &(yOpticsPoint[2]), "Beta_y/D");
+  opticsTree->Branch("Gamma_x", &(xOpticsPoint[3]), "Gamma_x/D");
+  opticsTree->Branch("Gamma_y", &(yOpticsPoint[3]), "Gamma_y/D");
+  opticsTree->Branch("Disp_x",  &(xOpticsPoint[4]), "Disp_x/D");
+  opticsTree->Branch("Disp_y",  &(yOpticsPoint[4]), "Disp_y/D");
+  opticsTree->Branch("Disp_xp", &(xOpticsPoint[5]), "Disp_xp/D");
+  opticsTree->Branch("Disp_yp", &(yOpticsPoint[5]), "Disp_yp/D");
+  opticsTree->Branch("Mean_x",  &(xOpticsPoint[6]), "Mean_x/D");
+  opticsTree->Branch("Mean_y",  &(yOpticsPoint[6]), "Mean_y/D");
+  opticsTree->Branch("Mean_xp", &(xOpticsPoint[7]), "Mean_xp/D");
+  opticsTree->Branch("Mean_yp", &(yOpticsPoint[7]), "Mean_yp/D");
+  opticsTree->Branch("Sigma_x", &(xOpticsPoint[8]), "Sigma_x/D");
+  opticsTree->Branch("Sigma_y", &(yOpticsPoint[8]), "Sigma_y/D");
+  opticsTree->Branch("Sigma_xp",&(xOpticsPoint[9]), "Sigma_xp/D");
+  opticsTree->Branch("Sigma_yp",&(yOpticsPoint[9]), "Sigma_yp/D");
+  opticsTree->Branch("S"       ,&(xOpticsPoint[10]),"S/D");
+  opticsTree->Branch("Npart"   ,&(xOpticsPoint[11]),"Npart/D");
+
+  opticsTree->Branch("Sigma_Emitt_x", &(xOpticsPoint[12]), "Sigma_Emitt_x/D");
+  opticsTree->Branch("Sigma_Emitt_y", &(yOpticsPoint[12]), "Sigma_Emitt_y/D");
+  opticsTree->Branch("Sigma_Alpha_x", &(xOpticsPoint[13]), "Sigma_Alpha_x/D");
+  opticsTree->Branch("Sigma_Alpha_y", &(yOpticsPoint[13]), "Sigma_Alpha_y/D");
+  opticsTree->Branch("Sigma_Beta_x",  &(xOpticsPoint[14]), "Sigma_Beta_x/D");
+  opticsTree->Branch("Sigma_Beta_y",  &(yOpticsPoint[14]), "Sigma_Beta_y/D");
+  opticsTree->Branch("Sigma_Gamma_x", &(xOpticsPoint[15]), "Sigma_Gamma_x/D");
+  opticsTree->Branch("Sigma_Gamma_y", &(yOpticsPoint[15]), "Sigma_Gamma_y/D");
+  opticsTree->Branch("Sigma_Disp_x",  &(xOpticsPoint[16]), "Sigma_Disp_x/D");
+  opticsTree->Branch("Sigma_Disp_y",  &(yOpticsPoint[16]), "Sigma_Disp_y/D");
+  opticsTree->Branch("Sigma_Disp_xp", &(xOpticsPoint[17]), "Sigma_Disp_xp/D");
+  opticsTree->Branch("Sigma_Disp_yp", &(yOpticsPoint[17]), "Sigma_Disp_yp/D");
+  opticsTree->Branch("Sigma_Mean_x",  &(xOpticsPoint[18]), "Sigma_Mean_x/D");
+  opticsTree->Branch("Sigma_Mean_y",  &(yOpticsPoint[18]), "Sigma_Mean_y/D");
+  opticsTree->Branch("Sigma_Mean_xp", &(xOpticsPoint[19]), "Sigma_Mean_xp/D");
+  opticsTree->Branch("Sigma_Mean_yp", &(yOpticsPoint[19]), "Sigma_Mean_yp/D");
+  opticsTree->Branch("Sigma_Sigma_x", &(xOpticsPoint[20]), "Sigma_Sigma_x/D");
+  opticsTree->Branch("Sigma_Sigma_y", &(yOpticsPoint[20]), "Sigma_Sigma_y/D");
+  opticsTree->Branch("Sigma_Sigma_xp",&(xOpticsPoint[21]), "Sigma_Sigma_xp/D");
+  opticsTree->Branch("Sigma_Sigma_yp",&(yOpticsPoint[21]), "Sigma_Sigma_yp/D");
+
+  opticsTree->Branch("Mean_E",        &(lOpticsPoint[6]),  "Mean_E/D");
+  opticsTree->Branch("Mean_t",        &(lOpticsPoint[7]),  "Mean_t/D");
+  opticsTree->Branch("Sigma_E",       &(lOpticsPoint[8]),  "Sigma_E/D");
+  opticsTree->Branch("Sigma_t",       &(lOpticsPoint[9]),  "Sigma_t/D");
+  opticsTree->Branch("Sigma_Mean_E",  &(lOpticsPoint[18]), "Sigma_Mean_E/D");
+  opticsTree->Branch("Sigma_Mean_t",  &(lOpticsPoint[19]), "Sigma_Mean_t/D");
+  opticsTree->Branch("Sigma_Sigma_E", &(lOpticsPoint[20]), "Sigma_Sigma_E/D");
+  opticsTree->Branch("Sigma_Sigma_t", &(lOpticsPoint[21]), "Sigma_Sigma_t/D");
+
+  opticsTree->Branch("xyCorrelationCoefficent", &(xOpticsPoint[24]), "xyCorrelationCoefficent/D");
+
+  for (const auto& entry : opticalFunctions)
+    {
+      xOpticsPoint = entry[0];
+      yOpticsPoint = entry[1];
+      lOpticsPoint = entry[2];
+      opticsTree->Fill();
+    }
+  opticsTree->Write();
+}
+
+void SamplerAnalysis::WriteMoments(const std::vector<SamplerAnalysis*>& samplerAnalyses,
+				   bool emittanceOnTheFly)
+{
+  SamplerMoments entryMoments;
+  double S    = 0;
+  double mass = particleMass;
+  TTree* momentsTree = new TTree(momentsTreeName.c_str(), momentsTreeName.c_str());
+  momentsTree->Branch("S",                 &S,                 "S/D");
+  momentsTree->Branch("Mass",              &mass,              "Mass/D");
+  momentsTree->Branch("EmittanceOnTheFly", &emittanceOnTheFly, "EmittanceOnTheFly/O");
+  entryMoments.Branch(momentsTree);
+
+  for (const auto sa : samplerAnalyses)
+    {
+      S = sa->GetS();
+      entryMoments = sa->GetMoments();
+      momentsTree->Fill();
+    }
+  momentsTree->Write();
+}
+
 double SamplerAnalysis::powSumToCentralMoment(fourDArray&   powSumsIn,
 					      long long int npartIn,
 					      int a,
@@ -20,6 +20,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define SAMPLERANALYSIS_H
 
 #include "BDSOutputROOTEventSampler.hh"
+#include "SamplerMoments.hh"
+
+#include <string>
+#include <vector>
+
+class TTree;
 
 /**
  * @brief Analysis routines for an individual sampler.
@@ -40,6 +46,12 @@ public:
   SamplerAnalysis(BDSOutputROOTEventSampler<double>* samplerIn,
 		  bool debugIn = false);
 #endif
+
+  /// Construct from moments already accumulated, e.g. merged from several rebdsim
+  /// output files. There is no sampler data so Process() must not be used.
+  SamplerAnalysis(const SamplerMoments& momentsIn,
+		  double                SIn);
+  
   /// Initialisation of arrays for optical function calculations
   void CommonCtor();
   virtual ~SamplerAnalysis();
@@ -47,9 +59,16 @@ public:
   /// Initialise variables.
   void Initialise();
 
-  /// Loop over all entries in the sampler and accumulate power sums over variuos moments.
+  /// Loop over all entries in the sampler and store the coordinates of each primary.
+  /// The moments are only updated in Accumulate(). The argument is no longer used as
+  /// the moments are always taken about the running mean.
   void Process(bool firstTime = false);
 
+  /// Add all coordinates stored by Process() since the last call to the moments
+  /// and clear them. This is independent for each sampler so may be called for
+  /// different samplers from different threads.
+  void Accumulate();
+
   /// Calculate optical functions based on combinations of moments already accumulated.
   std::vector<double>  Terminate(std::vector<double> emittance,
 				 bool useEmittanceFromFirstSampler = true);
@@ -57,6 +76,30 @@ public:
   /// Accessor for optical functions
   std::vector<std::vector<double> > GetOpticalFunctions() {return optical;}
 
+  /// Accessor for the accumulated moments.
+  const SamplerMoments& GetMoments() const {return moments;}
+
+  /// Accessor for the S position of the sampler.
+  double GetS() const {return S;}
+
+  /// Write a tree called "Optics" with one entry per set of optical functions as
+  /// returned by GetOpticalFunctions() to the current directory.
+  static void WriteOpticalFunctions(const std::vector<std::vector<std::vector<double> > >& opticalFunctions);
+
+  /// Write a tree called "OpticsMoments" with one entry per sampler analysis holding
+  /// the moments so the optics may be merged with those of other files.
+  static void WriteMoments(const std::vector<SamplerAnalysis*>& samplerAnalyses,
+			   bool emittanceOnTheFly);
+
+  /// Name of the moments tree.
+  static const std::string momentsTreeName;
+
+  /// Set primary particle mass for optical functions.
+  static void SetParticleMass(double particleMassIn) {particleMass = particleMassIn;}
+
+  /// Accessor for the primary particle mass used for optical functions.
+  static double ParticleMass() {return particleMass;}
+
   /// Set primary particle mass for optical functions from sampler data
   static void UpdateMass(SamplerAnalysis* s);
 
@@ -80,9 +123,16 @@ protected:
   //6d phase space coordinates for each event
   std::vector<double> coordinates;
 
-  // initial values to use for mean subtraction.
+  // values the power sums are taken relative to - the mean after Terminate().
   std::vector<double> offsets;
 
+  /// Coordinates of the primaries not yet accumulated - 6 per particle.
+  std::vector<double> block; //!
+
+  /// Central moments of all primaries accumulated so far. Copied into powSums,
+  /// about the mean, in Terminate().
+  SamplerMoments moments; //!
+
   typedef std::vector<std::vector<double>>                           twoDArray;
   typedef std::vector<std::vector<std::vector<double>>>              threeDArray; 
   typedef std::vector<std::vector<std::vector<std::vector<double>>>> fourDArray;
@@ -0,0 +1,219 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "SamplerMoments.hh"
+
+#include "TTree.h"
+
+#include <array>
+#include <vector>
+
+namespace
+{
+  /// Binomial coefficients up to 4.
+  const double binomial[5][5] = {{1, 0, 0, 0, 0},
+                                 {1, 1, 0, 0, 0},
+                                 {1, 2, 1, 0, 0},
+                                 {1, 3, 3, 1, 0},
+                                 {1, 4, 6, 4, 1}};
+}
+
+SamplerMoments::SamplerMoments()
+{
+  Clear();
+}
+
+void SamplerMoments::Clear()
+{
+  n = 0;
+  mean.fill(0);
+  sums.fill(0);
+}
+
+int SamplerMoments::PairIndex(int a, int b)
+{
+  // number of pairs in the rows before a plus the offset in row a
+  return a*6 - (a*(a-1))/2 + (b - a);
+}
+
+double SamplerMoments::CentralSum(int a, int b, int j, int k) const
+{
+  if (a <= b)
+    {return sums[25*PairIndex(a,b) + 5*j + k];}
+  else
+    {return sums[25*PairIndex(b,a) + 5*k + j];}
+}
+
+void SamplerMoments::Shift(const double* in, double da, double db, double* out)
+{
+  // (x - (o + d))^j = sum_i C(j,i) (x - o)^i (-d)^(j-i)
+  double powA[5];
+  double powB[5];
+  powA[0] = 1;
+  powB[0] = 1;
+  for (int p = 1; p <= 4; ++p)
+    {
+      powA[p] = -da * powA[p-1];
+      powB[p] = -db * powB[p-1];
+    }
+  for (int j = 0; j <= 4; ++j)
+    {
+      for (int k = 0; k <= 4; ++k)
+        {
+          double result = 0;
+          for (int i = 0; i <= j; ++i)
+            {
+              double partial = 0;
+              for (int l = 0; l <= k; ++l)
+                {partial += binomial[k][l] * powB[k-l] * in[5*i + l];}
+              result += binomial[j][i] * powA[j-i] * partial;
+            }
+          out[5*j + k] = result;
+        }
+    }
+}
+
+void SamplerMoments::Add(const std::vector<double>& coordinates)
+{
+  const std::size_t nParticles = coordinates.size() / 6;
+  if (nParticles == 0)
+    {return;}
+
+  // power sums about the first particle of the block - build the powers of each
+  // coordinate once and add their outer product for each pair into a 5x5 block
+  const double* origin = coordinates.data();
+  std::array<double, nPairs*25> powerSums;
+  powerSums.fill(0);
+  double ladder[6][5];
+  for (std::size_t i = 0; i < nParticles; ++i)
+    {
+      const double* c = &coordinates[6*i];
+      for (int a = 0; a < 6; ++a)
+        {
+          double d  = c[a] - origin[a];
+          double d2 = d*d;
+          ladder[a][0] = 1;
+          ladder[a][1] = d;
+          ladder[a][2] = d2;
+          ladder[a][3] = d2*d;
+          ladder[a][4] = d2*d2;
+        }
+      double* s = powerSums.data();
+      for (int a = 0; a < 6; ++a)
+        {
+          for (int b = a; b < 6; ++b)
+            {
+              for (int j = 0; j <= 4; ++j)
+                {
+                  const double aj = ladder[a][j];
+                  for (int k = 0; k <= 4; ++k)
+                    {s[5*j + k] += aj*ladder[b][k];}
+                }
+              s += 25;
+            }
+        }
+    }
+
+  // mean of the block and its sums about that mean
+  const double nB = (double)nParticles;
+  std::array<double, 6> delta; // block mean - origin
+  for (int a = 0; a < 6; ++a)
+    {
+      int p = a < 5 ? PairIndex(a, 5) : PairIndex(5, 5);
+      delta[a] = (a < 5 ? powerSums[25*p + 5] : powerSums[25*p + 1]) / nB;
+    }
+  std::array<double, 6> meanB;
+  for (int a = 0; a < 6; ++a)
+    {meanB[a] = origin[a] + delta[a];}
+  std::array<double, nPairs*25> sumsB;
+  for (int a = 0; a < 6; ++a)
+    {
+      for (int b = a; b < 6; ++b)
+        {
+          int p = PairIndex(a,b);
+          Shift(&powerSums[25*p], delta[a], delta[b], &sumsB[25*p]);
+          // first order sums about the mean are zero by definition
+          sumsB[25*p + 1] = 0;
+          sumsB[25*p + 5] = 0;
+        }
+    }
+  Merge((long long int)nParticles, meanB, sumsB);
+}
+
+void SamplerMoments::Merge(const SamplerMoments& other)
+{
+  Merge(other.n, other.mean, other.sums);
+}
+
+void SamplerMoments::Merge(long long int nB,
+                           const std::array<double, 6>& meanB,
+                           const std::array<double, nPairs*25>& sumsB)
+{
+  if (nB == 0)
+    {return;}
+  if (n == 0)
+    {
+      n    = nB;
+      mean = meanB;
+      sums = sumsB;
+      return;
+    }
+
+  // move both sets of sums to the combined mean and add them
+  const double nTotal = (double)(n + nB);
+  const double fA = (double)nB / nTotal;
+  const double fB = (double)n  / nTotal;
+  std::array<double, 6> delta; // meanB - meanA
+  std::array<double, 6> newMean;
+  for (int a = 0; a < 6; ++a)
+    {
+      delta[a] = meanB[a] - mean[a];
+      newMean[a] = mean[a] + fA*delta[a];
+    }
+  double shiftedA[25];
+  double shiftedB[25];
+  for (int a = 0; a < 6; ++a)
+    {
+      for (int b = a; b < 6; ++b)
+        {
+          int p = PairIndex(a,b);
+          Shift(&sums[25*p],  fA*delta[a],  fA*delta[b],  shiftedA);
+          Shift(&sumsB[25*p], -fB*delta[a], -fB*delta[b], shiftedB);
+          for (int i = 0; i < 25; ++i)
+            {sums[25*p + i] = shiftedA[i] + shiftedB[i];}
+          sums[25*p + 1] = 0;
+          sums[25*p + 5] = 0;
+        }
+    }
+  n += nB;
+  mean = newMean;
+}
+
+void SamplerMoments::Branch(TTree* tree)
+{
+  tree->Branch("N",    &n,              "N/L");
+  tree->Branch("Mean", mean.data(),     "Mean[6]/D");
+  tree->Branch("Sums", sums.data(),     "Sums[525]/D");
+}
+
+void SamplerMoments::SetBranchAddress(TTree* tree)
+{
+  tree->SetBranchAddress("N",    &n);
+  tree->SetBranchAddress("Mean", mean.data());
+  tree->SetBranchAddress("Sums", sums.data());
+}
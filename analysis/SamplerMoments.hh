@@ -0,0 +1,90 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef SAMPLERMOMENTS_H
+#define SAMPLERMOMENTS_H
+
+#include <array>
+#include <vector>
+
+class TTree;
+
+/**
+ * @brief Mergeable central moments of the 6D phase space at a sampler.
+ *
+ * For each pair of coordinates (a,b) with a <= b, the sums over particles of
+ * (a - <a>)^j (b - <b>)^k are kept for j and k from 0 to 4, about the current mean.
+ * Particles are added in blocks. Each block is summed about its first particle, moved
+ * to the block mean and merged with the running sums using the binomial shift of
+ * the moments to the combined mean (as in Welford and Pebay). This avoids the loss
+ * of precision of raw power sums when the beam is far from the origin, and the sums
+ * from separate sets of particles can be merged exactly.
+ *
+ * @author Laurie Nevay
+ */
+
+class SamplerMoments
+{
+public:
+  SamplerMoments();
+  ~SamplerMoments(){;}
+
+  /// Reset to no particles.
+  void Clear();
+
+  /// Add a block of particles given as 6 coordinates each (x, xp, y, yp, p, t).
+  void Add(const std::vector<double>& coordinates);
+
+  /// Combine with another set of moments as if all of its particles had been added.
+  void Merge(const SamplerMoments& other);
+
+  /// Number of particles.
+  inline long long int N() const {return n;}
+
+  /// Mean of coordinate a.
+  inline double Mean(int a) const {return mean[a];}
+
+  /// Sum over particles of (a - <a>)^j (b - <b>)^k.
+  double CentralSum(int a, int b, int j, int k) const;
+
+  /// Create branches in a tree to write the moments from this instance.
+  void Branch(TTree* tree);
+
+  /// Set the addresses of the branches in a tree written with Branch() to this instance.
+  void SetBranchAddress(TTree* tree);
+
+  /// Number of distinct coordinate pairs (a,b) with a <= b.
+  static const int nPairs = 21;
+
+private:
+  /// Index of the 5x5 block of sums for the pair a <= b.
+  static int PairIndex(int a, int b);
+
+  /// Move a 5x5 block of sums about one origin to sums about an origin displaced
+  /// by da and db in the two coordinates.
+  static void Shift(const double* in, double da, double db, double* out);
+
+  /// Merge moments given by number, means and sums about the means.
+  void Merge(long long int nB, const std::array<double, 6>& meanB, const std::array<double, nPairs*25>& sumsB);
+
+  long long int n;
+  std::array<double, 6> mean;
+  std::array<double, nPairs*25> sums;
+};
+
+#endif
@@ -24,6 +24,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "HistogramAccumulatorMerge.hh"
 #include "HistogramAccumulatorSum.hh"
 #include "RBDSException.hh"
+#include "SamplerAnalysis.hh"
+#include "SamplerMoments.hh"
 
 #include "BDSOutputROOTEventHeader.hh"
 
@@ -41,6 +43,47 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <string>
 #include <vector>
 
+/// Merge the optics moments of a file into moments, one per sampler. Returns false
+/// if the file has no moments or they don't match those already accumulated.
+bool AccumulateOpticsMoments(TFile*                       f,
+                             std::vector<SamplerMoments>& moments,
+                             std::vector<double>&         sPositions,
+                             double&                      mass,
+                             bool&                        emittanceOnTheFly)
+{
+  TTree* mt = dynamic_cast<TTree*>(f->Get(SamplerAnalysis::momentsTreeName.c_str()));
+  if (!mt)
+    {return false;}
+  
+  SamplerMoments entryMoments;
+  double S          = 0;
+  double massIn     = 0;
+  bool   onTheFlyIn = false;
+  mt->SetBranchAddress("S",                 &S);
+  mt->SetBranchAddress("Mass",              &massIn);
+  mt->SetBranchAddress("EmittanceOnTheFly", &onTheFlyIn);
+  entryMoments.SetBranchAddress(mt);
+
+  bool first = moments.empty();
+  if (!first && (int)moments.size() != (int)mt->GetEntries())
+    {return false;}
+  for (int i = 0; i < (int)mt->GetEntries(); ++i)
+    {
+      mt->GetEntry(i);
+      if (first)
+        {
+          moments.push_back(entryMoments);
+          sPositions.push_back(S);
+          mass = massIn;
+          emittanceOnTheFly = onTheFlyIn;
+        }
+      else
+        {moments[i].Merge(entryMoments);}
+    }
+  mt->ResetBranchAddresses();
+  return true;
+}
+
 int main(int argc, char* argv[])
 {
   if (argc < 3)
@@ -129,6 +172,13 @@ int main(int argc, char* argv[])
   unsigned long long int nEventsInFile = 0;
   unsigned long long int nEventsInFileSkipped = 0;
   unsigned long long int nEventsRequested = 0;
+
+  // optics moments per sampler merged from all files
+  std::vector<SamplerMoments> opticsMoments;
+  std::vector<double> opticsS;
+  double opticsMass = 0;
+  bool emittanceOnTheFly = false;
+  bool mergeOptics = true;
   
   std::cout << "Combination of " << inputFiles.size() << " files beginning" << std::endl;
   // loop over files and accumulate
@@ -148,6 +198,13 @@ int main(int argc, char* argv[])
                 {RBDS::WarningMissingHistogram(histPath, file); continue;}
               hist.accumulator->Accumulate(h);
             }
+
+          if (mergeOptics)
+            {
+              mergeOptics = AccumulateOpticsMoments(f, opticsMoments, opticsS, opticsMass, emittanceOnTheFly);
+              if (!mergeOptics)
+                {std::cout << "No matching optics moments in " << file << " - optics will not be combined" << std::endl;}
+            }
           
           Header* h = new Header();
           TTree* ht = (TTree*)f->Get("Header");
@@ -180,6 +237,27 @@ int main(int argc, char* argv[])
       delete hist.accumulator; // this removes temporary histograms from the file
     }
 
+  // optical functions from the merged moments as if all events were analysed together
+  if (mergeOptics && !opticsMoments.empty())
+    {
+      SamplerAnalysis::SetParticleMass(opticsMass);
+      std::vector<SamplerAnalysis*> samplerAnalyses;
+      std::vector<std::vector<std::vector<double> > > opticalFunctions;
+      std::vector<double> emittance = {0,0,0,0};
+      for (int i = 0; i < (int)opticsMoments.size(); ++i)
+        {
+          SamplerAnalysis* sa = new SamplerAnalysis(opticsMoments[i], opticsS[i]);
+          emittance = sa->Terminate(emittance, !emittanceOnTheFly);
+          opticalFunctions.push_back(sa->GetOpticalFunctions());
+          samplerAnalyses.push_back(sa);
+        }
+      output->cd();
+      SamplerAnalysis::WriteOpticalFunctions(opticalFunctions);
+      SamplerAnalysis::WriteMoments(samplerAnalyses, emittanceOnTheFly);
+      for (auto sa : samplerAnalyses)
+        {delete sa;}
+    }
+
   headerOut->nOriginalEvents = nOriginalEvents;
   headerOut->nEventsInFile = nEventsInFile;
   headerOut->nEventsInFileSkipped = nEventsInFileSkipped;
@@ -0,0 +1,17 @@
+#!/bin/bash
+# Time bd-pools.gmad (G4Allocator pools) against bd-arena.gmad (event arena).
+# Both use the same seed so they simulate identical events.
+# usage: ./arenaTiming.sh [nEvents] [nRepeats]
+
+NEVENTS=${1:-1000}
+NREPEATS=${2:-3}
+TIMEFORMAT="%R"
+
+for model in bd-pools bd-arena
+do
+    for i in $(seq 1 $NREPEATS)
+    do
+	t=$( { time bdsim --file=$model.gmad --batch --ngenerate=$NEVENTS --seed=123 --output=none > /dev/null 2>&1; } 2>&1 )
+	echo "$model run $i: $t s"
+    done
+done
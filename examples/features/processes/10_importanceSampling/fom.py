@@ -0,0 +1,34 @@
+import pybdsim
+import sys
+
+histogramName = "Event/MergedHistograms/meshWall-nflux"
+
+def FigureOfMerit(basename):
+    """
+    Return the mean neutron flux, its relative error R, the total CPU time T
+    of the events and the figure of merit 1 / (R^2 T) for one run. The run
+    must have been merged with rebdsimHistoMerge to basename-histos.root.
+    """
+    d = pybdsim.Data.Load(basename+".root")
+    cpuTime = 0.0
+    for event in d.GetEventTree():
+        cpuTime += event.Summary.durationCPU
+
+    h = pybdsim.Data.Load(basename+"-histos.root").histogramspy[histogramName]
+    value = h.contents[0,0,0]
+    error = h.errors[0,0,0]
+    if value <= 0:
+        return value, 0.0, cpuTime, 0.0
+    relativeError = error / value
+    return value, relativeError, cpuTime, 1.0 / (relativeError**2 * cpuTime)
+
+def main(basenames):
+    results = [(b,) + FigureOfMerit(b) for b in basenames]
+    reference = results[0][4]
+    print("{:<20} {:>12} {:>8} {:>10} {:>12} {:>8}".format("run", "flux", "R", "T (s)", "FOM", "ratio"))
+    for name, value, relativeError, cpuTime, fom in results:
+        ratio = fom / reference if reference > 0 else float("nan")
+        print("{:<20} {:>12.4e} {:>8.4f} {:>10.1f} {:>12.4e} {:>8.2f}".format(name, value, relativeError, cpuTime, fom, ratio))
+
+if __name__ == "__main__":
+    main(sys.argv[1:])
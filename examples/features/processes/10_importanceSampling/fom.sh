@@ -0,0 +1,13 @@
+#!/bin/bash
+# Figure of merit of the neutron flux towards the back of the wall for the
+# analog, importance sampling and weight window versions of the same model.
+# usage: ./fom.sh [nEvents]
+
+NEVENTS=${1:-1000}
+
+for model in fom-analog fom-importance fom-weightwindows
+do
+    bdsim --file=$model.gmad --batch --ngenerate=$NEVENTS --outfile=$model
+    rebdsimHistoMerge $model.root $model-histos.root
+done
+python fom.py fom-analog fom-importance fom-weightwindows
@@ -246,6 +246,12 @@ protected:
 
   /// Doesn't change member variables, but may change their contents.
   virtual void AttachUserLimits() const;
+
+  /// Key describing the properties of this component that are applied to its logical
+  /// volumes besides their shape - type, lengths, angle, region and biasing. Derived
+  /// classes append their geometry parameters to this to identify geometry that may be
+  /// built once and shared between components.
+  G4String SharedGeometryKey() const;
   
   ///@{ Const protected member variable that may not be changed by derived classes
   const G4String   name;
@@ -269,6 +275,7 @@ protected:
   static G4bool      checkOverlaps;
   static G4bool      sensitiveOuter;
   static G4bool      sensitiveVacuum;
+  static G4bool      reuseIdenticalGeometry;
   static G4VisAttributes* containerVisAttr;
   /// @}
 
@@ -32,6 +32,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 class BDSApertureInfo;
 class BDSBeamline;
 class BDSFieldObjects;
+class BDSGeometryComponent;
 class BDSLinkComponent;
 class BDSRegion;
 class G4LogicalVolume;
@@ -131,6 +132,9 @@ public:
   /// Access region information. Will exit if not found.
   G4Region*         Region(const G4String& name) const;
 
+  /// Access all regions by name.
+  const std::map<G4String, BDSRegion*>& Regions() const {return regions;}
+
   /// Returns pointer to a set of logical volumes. If no set by that name exits, create it.
   std::set<G4LogicalVolume*>* VolumeSet(const G4String& name);
 
@@ -170,6 +174,13 @@ public:
   
   void RegisterLinkComponent(BDSLinkComponent* linkComponentIn) {linkComponents.insert(linkComponentIn);}
   inline const std::set<BDSLinkComponent*>& LinkComponents() const {return linkComponents;}
+
+  /// Register a piece of geometry that is identified by a content key so that it can
+  /// be placed by several components. The model takes ownership.
+  void RegisterSharedGeometry(const G4String& key, BDSGeometryComponent* component);
+
+  /// Access a previously registered piece of shared geometry. Returns nullptr if none.
+  BDSGeometryComponent* SharedGeometry(const G4String& key) const;
   
 private:
   BDSAcceleratorModel(); ///< Default constructor is private as singleton.
@@ -215,6 +226,9 @@ private:
   std::map<G4String, BDSScorerHistogramDef> scorerHistogramDefsMap;
   /// @}
   std::map<G4String, G4Transform3D> scorerMeshPlacements;
+
+  /// Geometry built once and reused by components with identical geometry.
+  std::map<G4String, BDSGeometryComponent*> sharedGeometry;
   
   std::set<BDSLinkComponent*> linkComponents;
 };
@@ -43,7 +43,8 @@ public:
   BDSArray1DCoords(G4int            nX,
                    G4double         xMinIn,
                    G4double         xMaxIn,
-                   BDSDimensionType dimensionIn = BDSDimensionType::x);
+                   BDSDimensionType dimensionIn = BDSDimensionType::x,
+                   G4bool           allocateDataIn = true);
   virtual ~BDSArray1DCoords(){;}
   
   /// Extract 2 points lying around coordinate x.
@@ -45,7 +45,8 @@ public:
 		   G4double xMinIn, G4double xMaxIn,
 		   G4double yMinIn, G4double yMaxIn,
 		   BDSDimensionType xDimensionIn = BDSDimensionType::x,
-		   BDSDimensionType yDimensionIn = BDSDimensionType::y);
+		   BDSDimensionType yDimensionIn = BDSDimensionType::y,
+		   G4bool           allocateDataIn = true);
   virtual ~BDSArray2DCoords(){;}
   
   /// Extract 2x2 points lying around coordinate x.
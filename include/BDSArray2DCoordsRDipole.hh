@@ -58,9 +58,6 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
  *
  * Some interfaces are overloaded and some aren't as are required to be (NX for example).
  * The ostream << writes both the raw array and the reflected version too.
- *
- * Note, by return a reference to a non-const member returnValue that may be updated by another
- * query, thread safety could be an issue.
  * 
  * @author Laurie Nevay
  */
@@ -87,10 +84,10 @@ public:
   /// @}
 
   /// @{ Overridden from BDSArray4D.
-  virtual const BDSFieldValue& GetConst(G4int x,
-					G4int y,
-					G4int z = 0,
-					G4int t = 0) const;
+  virtual BDSFieldValue GetConst(G4int x,
+				 G4int y,
+				 G4int z = 0,
+				 G4int t = 0) const;
 
   virtual G4bool Outside(G4int x,
 			 G4int y,
@@ -104,11 +101,6 @@ public:
 
   /// Delegate function to call polymorphic Print().
   friend std::ostream& operator<< (std::ostream& out, BDSArray2DCoordsRDipole const &a);
-
-private:
-  /// Must return by reference and the true data value may have to be reflected
-  /// in one or more dimensions.  Copy to this and return reference to it.
-  mutable BDSFieldValue returnValue;
 };
 
 #endif
@@ -22,6 +22,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldValue.hh"
 #include "BDSFourVector.hh"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <ostream>
 #include <vector>
 
@@ -43,6 +46,19 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
  * https://isocpp.org/wiki/faq/operator-overloading#matrix-subscript-op
  * 
  * The size cannot be changed after construction.
+ *
+ * The data may instead be held in memory owned elsewhere, such as a segment
+ * shared between processes (see BDSArraySharedStore), with UseExternalData()
+ * or UseExternalQuantisedData() in either layout. The array is then read-only.
+ *
+ * After loading, the data may be quantised to 16 bit integers with one scale factor
+ * per component (see Quantise()) to halve the memory used compared to float storage.
+ * Values are converted back to BDSFieldValue when accessed, so the interpolators are
+ * unchanged. A quantised array is also read-only and Data() returns nullptr.
+ *
+ * The data may also be rearranged into tiles of 4x4x4 points in x,y,z (see Tile()) so
+ * that the points around a location used by an interpolator are close together in
+ * memory. This only changes the storage - access by index is the same.
  * 
  * @author Laurie Nevay
  */
@@ -54,8 +70,14 @@ public:
   /// therefore the size must be known at construction time.
   BDSArray4D() = delete;
   /// At construction the size of the array must be known as this implementation
-  /// does not allow the size to be changed afterwards.
-  BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn);
+  /// does not allow the size to be changed afterwards. If allocateDataIn is false,
+  /// UseExternalData() must be called before the array is used.
+  BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn,
+	     G4bool allocateDataIn = true);
+  /// Copy the data unless it is external, in which case it is shared.
+  BDSArray4D(const BDSArray4D& other);
+  /// Assignment not used as the size is fixed.
+  BDSArray4D& operator=(const BDSArray4D&) = delete;
   virtual ~BDSArray4D(){;}
 
   /// @{ Access the number of elements in a given dimension.
@@ -66,6 +88,56 @@ public:
   inline BDSFourVector<G4int> NXYZT() const {return BDSFourVector<G4int>(NX(), NY(), NZ(), NT());}
   /// @}
 
+  /// Total number of values in the array.
+  inline std::size_t NValues() const {return (std::size_t)nX*nY*nZ*nT;}
+
+  /// Number of values stored. This is NValues() unless tiled, where partially
+  /// filled tiles at the upper edges are padded.
+  inline std::size_t NStored() const {return nStored;}
+
+  /// Contiguous data in t,z,y,x order (x fastest) unless tiled - NStored() long.
+  inline const BDSFieldValue* Data() const {return data;}
+
+  /// Use NStored() values held elsewhere instead of this array's own storage, which is
+  /// released. They are in t,z,y,x order, or in tiles if tiledIn is true (see Tile()).
+  /// The array becomes read-only. keepAliveIn is held until this array is deleted and
+  /// may own the memory (e.g. unmap it when released).
+  void UseExternalData(const BDSFieldValue* externalDataIn,
+		       std::shared_ptr<const void> keepAliveIn,
+		       G4bool tiledIn = false);
+
+  /// As UseExternalData() but for values already quantised with the given step (see
+  /// Quantise()) - 3 per point. The array becomes quantised.
+  void UseExternalQuantisedData(const std::int16_t* externalDataIn,
+				const BDSFieldValue& quantisationStepIn,
+				std::shared_ptr<const void> keepAliveIn,
+				G4bool tiledIn = false);
+
+  /// Whether the data is held elsewhere and therefore read-only.
+  inline G4bool ReadOnly() const {return readOnly;}
+
+  /// Replace the data with 16 bit integers scaled independently for each component so
+  /// that the largest magnitude of each uses the full range. The array becomes read-only.
+  /// Copies made afterwards share the quantised data.
+  void Quantise();
+
+  /// Rearrange the data into tiles of 4x4x4 points in x,y,z (dimensions of size 1 aren't
+  /// tiled). External data is copied so the array is then writable. Must be done before
+  /// Quantise().
+  void Tile();
+
+  /// Whether the data is stored in tiles.
+  inline G4bool Tiled() const {return tiled;}
+
+  /// Whether the data has been quantised.
+  inline G4bool Quantised() const {return quantisedData != nullptr;}
+
+  /// The value of one quantisation step for each component - i.e. the resolution.
+  inline BDSFieldValue QuantisationStep() const {return quantisationStep;}
+
+  /// Quantised data, 3 components per point, NStored() points long. nullptr if not quantised.
+  inline const std::int16_t* QuantisedData() const {return quantisedData;}
+
   /// Setter & (technically, a non-const) accessor.
   virtual BDSFieldValue& operator()(G4int x,
 				    G4int y = 0,
@@ -76,22 +148,22 @@ public:
   const BDSFieldValue& operator()(BDSFourVector<G4int>& pos)
   {return operator()(pos.x(), pos.y(), pos.z(), pos.t());}
 
-  /// Accessor only as returns const reference to data. By being named
-  /// this can be used explicitly to ensure const access - recommended main
-  /// main interface.
-  virtual const BDSFieldValue& GetConst(G4int x,
-					G4int y = 0,
-					G4int z = 0,
-					G4int t = 0) const;
+  /// Accessor only as returns a copy of the data. By being named this can be
+  /// used explicitly to ensure const access - recommended main interface.
+  /// Returned by value as the stored data may be quantised or reflected.
+  virtual BDSFieldValue GetConst(G4int x,
+				 G4int y = 0,
+				 G4int z = 0,
+				 G4int t = 0) const;
 
   /// Convenience shortcut to GetConst().
-  virtual const BDSFieldValue& operator()(G4int x,
-					  G4int y = 0,
-					  G4int z = 0,
-					  G4int t = 0) const;
+  virtual BDSFieldValue operator()(G4int x,
+				   G4int y = 0,
+				   G4int z = 0,
+				   G4int t = 0) const;
 
   /// Convenience accessor to operator().
-  const BDSFieldValue& operator()(const BDSFourVector<G4int>& pos) const
+  BDSFieldValue operator()(const BDSFourVector<G4int>& pos) const
   {return operator()(pos.x(), pos.y(), pos.z(), pos.t());}
 
   /// Return whether the indices are valid and lie within the array boundaries or not.
@@ -123,12 +195,51 @@ protected:
   const G4int nT;
   /// @}
 
-  /// Need to store a default value so it can be return by reference.
+  /// Value returned for indices outside the array.
   BDSFieldValue defaultValue;
   
 private:
-  /// A 1D array representing all the data.
-  std::vector<BDSFieldValue> data;
+  /// Storage of all the data unless external data is used.
+  std::vector<BDSFieldValue> ownedData;
+
+  /// All the data as a 1D array - either ownedData or external.
+  BDSFieldValue* data;
+
+  /// Holds any external storage for the lifetime of this array.
+  std::shared_ptr<const void> keepAlive;
+  G4bool readOnly;
+
+  /// Quantised data, 3 components per value in the same order as data, shared between
+  /// copies of this array. quantisedData points into it for quick access.
+  std::shared_ptr<const std::vector<std::int16_t> > quantisedStore;
+  const std::int16_t* quantisedData;
+  BDSFieldValue quantisationStep;
+
+  /// Compute the offset tables and size for the tiled layout and use it for Index().
+  /// Doesn't move any data.
+  void SetTiledLayout();
+
+  /// Check the layout of external data matches or set this array to it. External data
+  /// can't be used for an array with data already rearranged differently.
+  void MatchExternalLayout(G4bool tiledIn);
+
+  /// Position of a point in the data for the layout used. The tiled position is
+  /// separable so it is the sum of an offset for each dimension from small tables.
+  inline std::size_t Index(G4int x, G4int y, G4int z, G4int t) const
+  {
+    if (!tiled)
+      {return (((std::size_t)t*nZ + z)*nY + y)*nX + x;}
+    return t*tileStrideT + tileOffsetZ[z] + tileOffsetY[y] + tileOffsetX[x];
+  }
+
+  std::size_t nStored;
+  G4bool tiled;
+  /// @{ Offset in the tiled data for each index in a dimension.
+  std::vector<std::size_t> tileOffsetX;
+  std::vector<std::size_t> tileOffsetY;
+  std::vector<std::size_t> tileOffsetZ;
+  /// @}
+  std::size_t tileStrideT; ///< Offset in the tiled data between each t index.
 };
 
 #endif
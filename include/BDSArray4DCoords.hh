@@ -63,7 +63,8 @@ public:
                    BDSDimensionType xDimensionIn = BDSDimensionType::x,
                    BDSDimensionType yDimensionIn = BDSDimensionType::y,
                    BDSDimensionType zDimensionIn = BDSDimensionType::z,
-                   BDSDimensionType tDimensionIn = BDSDimensionType::t);
+                   BDSDimensionType tDimensionIn = BDSDimensionType::t,
+                   G4bool           allocateDataIn = true);
 
   virtual ~BDSArray4DCoords(){;} 
 
@@ -0,0 +1,144 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSARRAYSHAREDSTORE_H
+#define BDSARRAYSHAREDSTORE_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+class BDSArray4DCoords;
+
+/**
+ * @brief Store of field map arrays in POSIX shared memory between processes.
+ *
+ * Each field map is kept in a shared memory segment named from the user ID and a
+ * hash of the canonical file path, the format, the number of dimensions, the storage
+ * (tiled and / or quantised), the size of one field value and a hash of the file
+ * contents. The first process on a node to take the (file) lock for a map loads it,
+ * tiles and quantises it as required and copies the stored data into the segment along
+ * with the array coordinates. Any other process attaches to the segment read-only and
+ * builds an array on top of it without reading the file. The data is in exactly the
+ * layout of BDSArray4D so is used in place.
+ *
+ * The segment and lock files are only accessible by the user. A lock file serialises
+ * loading, attaching and removing a segment. Each process using a segment also holds a
+ * shared lock on a second "users" file. The last one to finish with it removes the
+ * segment and both files. If anything goes wrong, a warning is printed and
+ * the map is loaded privately instead.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSArraySharedStore
+{
+public:
+  /// Return an array for the map in filePath, either attached to an existing segment
+  /// or by calling load and publishing the result. formatName distinguishes maps loaded
+  /// from the same file differently. load must return the array already tiled and / or
+  /// quantised as given by tiled and quantised. The array returned is of the derived type
+  /// for nDim (e.g. BDSArray3DCoords for 3) if load returns that type.
+  static BDSArray4DCoords* LoadOrAttach(const G4String& filePath,
+					const G4String& formatName,
+					G4int nDim,
+					G4bool tiled,
+					G4bool quantised,
+					const std::function<BDSArray4DCoords*()>& load);
+
+  /// Hash of the contents of a file.
+  static std::uint64_t ContentHash(const G4String& filePath);
+
+private:
+  BDSArraySharedStore() = delete;
+  
+  /// Layout at the start of each segment - the data follows at dataOffset.
+  struct Header
+  {
+    char          identifier[8];
+    std::uint32_t version;
+    std::uint32_t complete;      ///< Set last once the data is written.
+    std::uint64_t contentHash;
+    std::uint32_t valueSize;     ///< sizeof(BDSFieldValue) - differs for FIELDDOUBLE.
+    std::int32_t  nDim;
+    std::int32_t  n[4];
+    std::int32_t  dimensionType[4];
+    double        min[4];
+    double        max[4];
+    std::uint32_t tiled;
+    std::uint32_t quantised;
+    double        quantisationStep[3];
+    std::uint64_t nStored;       ///< Number of points stored including any tile padding.
+    std::uint64_t dataOffset;
+  };
+
+  /// Open and exclusively lock the lock file. Returns -1 if not possible.
+  static int LockExclusive(const G4String& lockPath);
+
+  /// Build an array of the right type without data from the header.
+  static BDSArray4DCoords* CreateArray(const Header& header);
+
+  /// Attach to a segment of size bytes. Returns nullptr if it is incomplete or doesn't match.
+  /// If attached, the users file descriptor is closed when the mapping is released.
+  static BDSArray4DCoords* Attach(int fd,
+				  std::size_t size,
+				  std::uint64_t contentHash,
+				  G4int nDim,
+				  G4bool tiled,
+				  G4bool quantised,
+				  int usersFD,
+				  const G4String& shmName,
+				  const G4String& usersPath,
+				  const G4String& lockPath);
+
+  /// Copy the stored data of an array into the (empty) segment and switch the array to
+  /// use it. Returns false if it couldn't be published. If published, the users file
+  /// descriptor is closed when the mapping is released.
+  static G4bool Publish(int fd,
+			const G4String& shmName,
+			std::uint64_t contentHash,
+			G4int nDim,
+			BDSArray4DCoords* array,
+			int usersFD,
+			const G4String& usersPath,
+			const G4String& lockPath);
+
+  /// Keep a mapping and the shared lock on the users file until the last array using
+  /// it is deleted. Then unmap it and remove the segment and lock files if no other
+  /// process uses them.
+  static std::shared_ptr<const void> MappingOwner(void* address,
+						  std::size_t size,
+						  int usersFD,
+						  const G4String& shmName,
+						  const G4String& usersPath,
+						  const G4String& lockPath);
+
+  /// FNV-1a hash used for both the contents and the name.
+  static std::uint64_t Hash(const void* bytes,
+			    std::size_t length,
+			    std::uint64_t hash = 14695981039346656037ULL);
+
+  static const char          identifier[8];
+  static const std::uint32_t version;
+};
+
+#endif
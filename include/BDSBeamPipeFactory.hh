@@ -100,7 +100,12 @@ private:
   BDSBeamPipeFactoryBase* circularvacuum;
   BDSBeamPipeFactoryBase* clicpcl;
   BDSBeamPipeFactoryBase* pointsfile;
+  BDSBeamPipeFactoryBase* rectellipsepoints;
+  BDSBeamPipeFactoryBase* lhcpoints;
   /// @}
+
+  /// Cache of option to use extruded solids in place of nested booleans.
+  G4bool booleanFreeGeometry;
 };
 
 
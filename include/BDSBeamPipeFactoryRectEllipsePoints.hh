@@ -0,0 +1,86 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSBEAMPIPEFACTORYRECTELLIPSEPOINTS_H
+#define BDSBEAMPIPEFACTORYRECTELLIPSEPOINTS_H
+
+#include "BDSBeamPipeFactoryPoints.hh"
+
+#include "globals.hh"
+#include "G4TwoVector.hh"
+
+#include <vector>
+
+/**
+ * @brief Factory for rectellipse and lhc aperture beam pipes made from extruded solids.
+ * 
+ * This produces the same shape as BDSBeamPipeFactoryRectEllipse (and BDSBeamPipeFactoryLHC),
+ * i.e. the overlap of an ellipse and a rectangle, but the cross-section of each surface is
+ * computed as a polygon and extruded rather than built from the intersection of a
+ * G4EllipticalTube and a G4Box. The vacuum and container are therefore single
+ * G4ExtrudedSolids and the pipe a single subtraction, which are considerably cheaper to
+ * navigate than the nested booleans. The ellipse is approximated by an inscribed polygon.
+ * 
+ * For lhc style apertures, aper3 is the radius of a circle and aper4 is ignored.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSBeamPipeFactoryRectEllipsePoints: public BDSBeamPipeFactoryPoints
+{
+public:
+  explicit BDSBeamPipeFactoryRectEllipsePoints(G4bool circularIn = false);
+  virtual ~BDSBeamPipeFactoryRectEllipsePoints(){;}
+
+  /// Clip a clockwise convex polygon to the rectangle |x| <= halfX, |y| <= halfY.
+  /// Public and static so it may be tested independently.
+  static std::vector<G4TwoVector> ClipToRectangle(const std::vector<G4TwoVector>& polygon,
+						  G4double halfX,
+						  G4double halfY);
+  
+private:
+  /// Overloaded (required) from BDSBeamPipeFactoryPoints. The number of points
+  /// argument is ignored in favour of the finer nPointsPerTwoPi so the polygonal
+  /// ellipse is close to the true one.
+  virtual void GeneratePoints(G4double aper1,
+			      G4double aper2,
+			      G4double aper3,
+			      G4double aper4,
+			      G4double beamPipeThickness,
+			      G4int    pointsPerTwoPi = 40);
+
+  /// Calculate the radius of the solid used for intersection for angled faces.
+  virtual G4double CalculateIntersectionRadius(G4double aper1,
+					       G4double aper2,
+					       G4double aper3,
+					       G4double aper4,
+					       G4double beamPipeThickness);
+
+  /// Append the points of an ellipse with semi-axes a and b clipped to a rectangle
+  /// with half widths halfX and halfY in a clockwise direction.
+  void GenerateRectEllipse(std::vector<G4TwoVector>& vec,
+			   G4double halfX,
+			   G4double halfY,
+			   G4double a,
+			   G4double b);
+
+  const G4bool circular;        ///< Whether aper3 is a radius (lhc) rather than an ellipse semi-axis.
+  const G4int  nPointsPerTwoPi; ///< Number of points used for a complete ellipse.
+};
+  
+#endif
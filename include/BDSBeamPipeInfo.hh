@@ -100,6 +100,11 @@ public:
   /// Return an indicative inner extent for the beam pipe vacuum.
   G4double IndicativeRadiusInner() const;
 
+  /// Return a string that uniquely describes the geometry this information would produce,
+  /// i.e. all members at full precision. Used to identify identical beam pipes so they
+  /// can be built once and placed many times.
+  G4String GeometryKey() const;
+
   ///@{ Public member for direct access
   BDSBeamPipeType beamPipeType;
   G4double        aper1;
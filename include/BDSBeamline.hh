@@ -27,8 +27,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSExtentGlobal.hh"
 
 #include <iterator>
+#include <map>
 #include <ostream>
 #include <set>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 class BDSAcceleratorComponent;
@@ -128,10 +131,13 @@ public:
   inline const BDSBeamlineElement* GetLastItem() const {return back();}
 
   /// Get the ith placement of an element in the beam line. Returns null pointer if not found.
+  /// The placement name is looked up in a hash map first. Failing that, the elements whose
+  /// component name starts with the given name (e.g. uniquely modified ones) are searched.
   const BDSBeamlineElement* GetElement(G4String acceleratorComponentName, G4int i = 0) const;
 
-  /// Get the transform to the centre of the ith placement of element by name.  Uses
-  /// GetElement(). Exits if no such element found.
+  /// Get the transform to the centre of the ith placement of element by name. Uses
+  /// GetElement() and the placement transform cached in the element. Exits if no such
+  /// element found.
   G4Transform3D GetTransformForElement(const G4String& acceleratorComponentName, G4int i = 0) const;
   
   /// Get the total length of the beamline - the sum of the chord length of each element
@@ -185,7 +191,16 @@ public:
                                             G4double y = 0,
                                             G4int* indexOfFoundElement = nullptr) const;
 
-  /// Return the element in this beam line according to a given s coordinate.
+  /// As GetGlobalEuclideanTransform() but for an element that is already known, e.g. from
+  /// GetElementFromGlobalS(), so that repeated transforms in one element need no lookup.
+  /// No check is made that s lies within the element.
+  G4Transform3D GetGlobalEuclideanTransformInElement(const BDSBeamlineElement* element,
+                                                     G4double s,
+                                                     G4double x = 0,
+                                                     G4double y = 0) const;
+
+  /// Return the element in this beam line according to a given s coordinate. This uses
+  /// a uniform grid in s so the search is only over the few elements in one grid cell.
   const BDSBeamlineElement* GetElementFromGlobalS(G4double S,
                                                   G4int* indexOfFoundElement = nullptr) const;
   
@@ -237,6 +252,12 @@ public:
   /// Access the padding length between each element added to the beamline.
   static G4double PaddingLength() {return paddingLength;}
 
+  /// Rebuild the uniform grid in s used to find elements by s for all elements added.
+  /// This is done while adding each time the number of elements doubles. Elements added
+  /// since are found with a binary search over them, so this should be called once
+  /// the beam line is complete.
+  void UpdateSIndex();
+
   /// Return vector of indices for this beam line where element of type name 'type' is found.
   std::vector<G4int> GetIndicesOfElementsOfType(const G4String& type) const;
 
@@ -259,6 +280,11 @@ private:
   /// look up transforms by name.
   void RegisterElement(BDSBeamlineElement* element);
 
+  /// Equivalent to std::lower_bound over sEnd but using the grid in s to restrict the
+  /// binary search to one cell. Elements added since the grid was last built are
+  /// searched with a binary search.
+  std::vector<G4double>::const_iterator LowerBoundS(G4double S) const;
+
   G4double sInitial; ///< Cache the initial S so we can tell if a requested S is too low.
   G4double sMaximum;
 
@@ -289,13 +315,25 @@ private:
   static G4double paddingLength;
 
   /// Map of objects by placement name stored in this beam line.
-  std::map<G4String, BDSBeamlineElement*> components;
+  std::unordered_map<std::string, BDSBeamlineElement*> components;
+
+  /// Elements by component name in the order they appear in the beam line. This is
+  /// sorted by name so all names starting with a given name can be found quickly.
+  std::map<G4String, std::vector<BDSBeamlineElement*> > elementsByComponentName;
 
   /// Vector of s coordinates at the end of each element. This is intended
   /// so that an iterator pointing to the s position will be the correct
   /// index for the beamline element in the main BDSBeamlineVector element.
   /// This is filled in order so it's sorted by design.
   std::vector<G4double> sEnd;
+
+  ///@{ Uniform grid in s between sInitial and the end of the last indexed element. Each
+  /// entry is the index in sEnd of the first element that ends at or after the start of
+  /// that cell, with one extra entry for the end of the last cell.
+  std::vector<G4int> sIndexFirstElement;
+  G4double sIndexCellWidth;
+  G4int    sIndexNElements; ///< Number of elements in sEnd covered by the grid.
+  ///@}
 };
 
 #endif
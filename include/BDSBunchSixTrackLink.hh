@@ -22,8 +22,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSBunch.hh"
 #include "BDSParticleExternal.hh"
 
+#include <map>
+#include <utility>
 #include <vector>
 
+class BDSLinkParticleBatch;
 class BDSParticleCoordsFull;
 class BDSParticleDefinition;
 
@@ -35,6 +38,9 @@ class BDSParticleDefinition;
  * to aid memory management (avoid double deletion) we have a member in this class
  * for the current particle definition that is updated each time. The accessor is
  * overloaded to access that one instead of the base class one.
+ *
+ * Alternatively, a whole BDSLinkParticleBatch may be used in place without copying
+ * it. In this case, one particle definition is made per species and reused.
  * 
  * @author Laurie Nevay
  */
@@ -54,11 +60,16 @@ public:
 		   int   externalParticleID,
 		   int   externalParentID);
 
-  /// Delete all particle objects in the bunch and clear the vector.
+  /// Delete all particle objects in the bunch and clear the vector. Also forget
+  /// any particle batch.
   void ClearParticles();
 
+  /// Use this batch of particles (not owned) instead of the individually added
+  /// ones. It must remain valid while the particles are tracked. nullptr to unset.
+  void SetParticleBatch(const BDSLinkParticleBatch* batchIn);
+
   /// @{ Accessor.
-  inline size_t Size() const {return particles.size();}
+  inline size_t Size() const {return (size_t)size;}
   inline int    CurrentExternalParticleID() const {return currentExternalParticleID;}
   inline int    CurrentExternalParentID()   const {return currentExternalParentID;}
   /// @}
@@ -80,5 +91,12 @@ private:
 
   G4int size;         ///< Number of particles (1 counting).
   std::vector<BDSParticleExternal*> particles;
+
+  /// Get or make the particle definition for a species in the batch.
+  BDSParticleDefinition* BatchParticleDefinition(G4int pdgID, G4int charge, G4double totalEnergy);
+
+  const BDSLinkParticleBatch* batch; ///< Optional external particles used in place.
+  /// Particle definitions for the batch keyed by PDG ID and charge.
+  std::map<std::pair<G4int, G4int>, BDSParticleDefinition*> batchDefinitions;
 };
 #endif
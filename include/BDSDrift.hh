@@ -50,6 +50,11 @@ protected:
   /// Construct geometry.
   virtual void Build();
 
+  /// Whether the beam pipe may be shared with other identical drifts when the option
+  /// reuseIdenticalGeometry is used. Derived classes that place further volumes inside
+  /// the beam pipe must return false.
+  virtual G4bool BeamPipeMayBeShared() const {return true;}
+
 private:
   /// No default constructor.
   BDSDrift() = delete;
@@ -0,0 +1,174 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSEVENTARENA_H
+#define BDSEVENTARENA_H
+
+#include "globals.hh" // geant4 types / globals
+#include "G4Allocator.hh"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Event-scoped monotonic memory arena for hits and trajectories.
+ *
+ * Objects that only live for the duration of one event (hits, trajectories,
+ * trajectory points and primary vertex information) may be allocated from this
+ * arena instead of their individual G4Allocator pools. Allocation is a pointer
+ * bump and deletion does nothing. The whole arena is reset in one go once Geant4
+ * has deleted the event (see BDSRunManager::TerminateOneEvent). Memory blocks are
+ * kept between events so that, after the first few events, no further system
+ * allocations are required.
+ *
+ * The arena is only active if requested by the option useEventArena and it must
+ * not be (de)activated while any objects allocated from it exist. Objects that
+ * persist beyond an event (e.g. link sampler hits) must not use this.
+ */
+
+class BDSEventArena
+{
+public:
+  /// Singleton accessor.
+  static BDSEventArena* Instance();
+  
+  ~BDSEventArena();
+
+  /// Whether event-scoped objects should be allocated from the arena.
+  static inline G4bool Active() {return active;}
+
+  /// Turn on or off the use of the arena. Only to be used before any events.
+  void SetActive(G4bool activeIn);
+
+  /// Get a piece of memory of at least size bytes suitably aligned for any type.
+  inline void* Allocate(std::size_t size);
+
+  /// Rewind the arena to the start. All memory previously handed out is invalid after this.
+  void Reset();
+
+  /// @{ Accessor.
+  inline std::size_t BytesUsed()     const {return bytesUsedPreviousBlocks + (std::size_t)(cursor - blockStart);}
+  inline std::size_t BytesReserved() const {return bytesReserved;}
+  inline std::size_t NBlocks()       const {return blocks.size();}
+  /// @}
+
+  /// @{ Allocation for objects that would otherwise use plain new and delete.
+  static inline void* New(std::size_t size);
+  static inline void  Delete(void* p);
+  /// @}
+
+private:
+  /// Private constructor for singleton pattern.
+  BDSEventArena();
+
+  /// Move to the next block (or create a new one) with enough room for size bytes.
+  void* AllocateFromNextBlock(std::size_t size);
+
+  /// Round up to the maximum fundamental alignment.
+  static inline std::size_t Aligned(std::size_t size);
+
+  struct Block
+  {
+    char*       data;
+    std::size_t size;
+  };
+
+  static BDSEventArena* instance;
+  static G4bool active;
+  
+  std::vector<Block> blocks;
+  std::size_t currentBlock;
+  char* blockStart;
+  char* cursor;
+  char* blockEnd;
+  std::size_t bytesUsedPreviousBlocks;
+  std::size_t bytesReserved;
+  const std::size_t defaultBlockSize;
+};
+
+inline std::size_t BDSEventArena::Aligned(std::size_t size)
+{
+  const std::size_t alignment = alignof(std::max_align_t);
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+inline void* BDSEventArena::Allocate(std::size_t size)
+{
+  size = Aligned(size);
+  if (size <= (std::size_t)(blockEnd - cursor))
+    {
+      void* result = cursor;
+      cursor += size;
+      return result;
+    }
+  return AllocateFromNextBlock(size);
+}
+
+inline void* BDSEventArena::New(std::size_t size)
+{
+  if (active)
+    {return Instance()->Allocate(size);}
+  return ::operator new(size);
+}
+
+inline void BDSEventArena::Delete(void* p)
+{
+  if (!active)
+    {::operator delete(p);}
+}
+
+namespace BDS
+{
+  /// Allocate a T from the event arena if it is active, or else from the G4Allocator for that type.
+  template <class T>
+  inline void* EventAllocate(G4Allocator<T>& allocator)
+  {
+    if (BDSEventArena::Active())
+      {return BDSEventArena::Instance()->Allocate(sizeof(T));}
+    return (void*)allocator.MallocSingle();
+  }
+
+  /// Free a T to its G4Allocator, unless the event arena is active in which case nothing is
+  /// done as the memory is reclaimed when the arena is reset.
+  template <class T>
+  inline void EventFree(G4Allocator<T>& allocator, void* p)
+  {
+    if (!BDSEventArena::Active())
+      {allocator.FreeSingle((T*)p);}
+  }
+
+  /// Standard allocator so std containers used for event-scoped objects can use the arena.
+  template <class T>
+  struct EventArenaAllocator
+  {
+    typedef T value_type;
+    EventArenaAllocator() = default;
+    template <class U>
+    EventArenaAllocator(const EventArenaAllocator<U>&) {}
+    T* allocate(std::size_t n) {return static_cast<T*>(BDSEventArena::New(n*sizeof(T)));}
+    void deallocate(T* p, std::size_t) {BDSEventArena::Delete(p);}
+  };
+  
+  template <class T, class U>
+  inline bool operator==(const EventArenaAllocator<T>&, const EventArenaAllocator<U>&) {return true;}
+  template <class T, class U>
+  inline bool operator!=(const EventArenaAllocator<T>&, const EventArenaAllocator<U>&) {return false;}
+}
+
+#endif
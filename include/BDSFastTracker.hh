@@ -0,0 +1,96 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFASTTRACKER_H
+#define BDSFASTTRACKER_H
+
+#include "globals.hh" // geant4 types / globals
+
+#include <vector>
+
+class BDSBeamline;
+
+/**
+ * @brief Analytical transport of primaries through the linear start of a beam line.
+ *
+ * From the start of the beam line, the leading run of drifts and quadrupoles
+ * without tilts, offsets or samplers is used, as long as each quadrupole uses the
+ * BDSIntegratorQuadrupole integrator. Each element is applied as one step of that
+ * integrator, including its checks for paraxial particles and the radius of curvature,
+ * and drifts as a straight line. Particles are transported in batches stored as
+ * structures of arrays so the loop over particles for each element has no branches.
+ * A particle stops at the first element where it might reach the aperture, which is
+ * taken conservatively as the inner radius of the beam pipe, or where the integrator
+ * would use its backup stepper, so it can be tracked from there by Geant4.
+ */
+
+class BDSFastTracker
+{
+public:
+  /// Local curvilinear coordinates of a batch of particles. x and y are positions
+  /// and xp and yp the components of the unit momentum as in the integrators.
+  /// kappaFactor is the particle's charge over momentum including the Geant4 units
+  /// factor (i.e. FCof() / p).
+  struct Batch
+  {
+    std::vector<G4double> x;
+    std::vector<G4double> xp;
+    std::vector<G4double> y;
+    std::vector<G4double> yp;
+    std::vector<G4double> T;
+    std::vector<G4double> kappaFactor;
+    std::vector<G4double> velocity;
+    /// Index of the next element to be traversed. After Track() this is the
+    /// element each particle should be tracked from by Geant4. A negative value
+    /// means the particle is not to be transported.
+    std::vector<G4int>    elementIndex;
+
+    void Resize(std::size_t n);
+    std::size_t Size() const {return x.size();}
+  };
+
+  explicit BDSFastTracker(const BDSBeamline* beamlineIn);
+  ~BDSFastTracker(){;}
+
+  /// Transport all particles in the batch as far as possible.
+  void Track(Batch& batch) const;
+
+  /// Number of elements at the start of the beam line that can be fast tracked.
+  G4int NElements() const {return (G4int)elements.size();}
+
+  /// Beam line this was constructed for.
+  const BDSBeamline* Beamline() const {return beamline;}
+
+private:
+  BDSFastTracker() = delete;
+
+  /// Linear element summarised for transport.
+  struct Element
+  {
+    G4double length;
+    G4double bPrime;          ///< Field gradient as in BDSIntegratorQuadrupole. 0 for a drift.
+    G4double apertureRadius2; ///< Square of the radius that must not be reached.
+  };
+
+  const BDSBeamline*   beamline;
+  std::vector<Element> elements;
+  G4double backupStepperMomLimit;    ///< As in BDSIntegratorMag.
+  G4double minimumRadiusOfCurvature; ///< As given to BDSIntegratorQuadrupole by BDSFieldFactory.
+};
+
+#endif
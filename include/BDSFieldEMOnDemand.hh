@@ -0,0 +1,72 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDEMONDEMAND_H
+#define BDSFIELDEMONDEMAND_H
+#include "BDSFieldEM.hh"
+
+#include "G4ThreeVector.hh"
+#include "G4Types.hh"
+
+#include <mutex>
+#include <utility>
+
+class BDSFieldInfo;
+class BDSFieldEMInterpolated;
+
+/**
+ * @brief An electro-magnetic field map that is only loaded when first used.
+ *
+ * Only the header of the map is read at construction so the smallest spatial step
+ * and whether the field varies with time are known for the user limits. The
+ * map is loaded through BDSFieldLoader on the first call to GetField, once only
+ * even if several threads query the field at the same time. The transform and
+ * modulator are applied by this class, not the loaded field.
+ *
+ * This owns the loaded field.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSFieldEMOnDemand: public BDSFieldEM
+{
+public:
+  BDSFieldEMOnDemand() = delete;
+  explicit BDSFieldEMOnDemand(const BDSFieldInfo& infoIn);
+  virtual ~BDSFieldEMOnDemand();
+
+  /// Load the field map if this is the first call, then query it.
+  virtual std::pair<G4ThreeVector,G4ThreeVector> GetField(const G4ThreeVector& position,
+                                                          const G4double       t = 0) const;
+
+  virtual G4bool TimeVarying() const {return timeVarying;}
+
+  inline G4double SmallestSpatialStep() const {return smallestSpatialStep;}
+
+private:
+  /// Load the map. Only called through std::call_once.
+  void Load() const;
+
+  BDSFieldInfo* info; ///< Own copy of the recipe for loading.
+  mutable BDSFieldEMInterpolated* field;
+  mutable std::once_flag loadFlag;
+  G4double smallestSpatialStep;
+  G4bool   timeVarying;
+};
+
+#endif
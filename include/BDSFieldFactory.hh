@@ -120,13 +120,16 @@ private:
   /// Create an irregular (special) field.
   BDSFieldObjects* CreateFieldIrregular(const BDSFieldInfo& info);
 
-  /// Creat just the magnetic field object.
+  /// Creat just the magnetic field object. allowOnDemand is false for sub-fields that
+  /// must be a loaded BDSFieldMagInterpolated.
   BDSFieldMag* CreateFieldMagRaw(const BDSFieldInfo&      info,
 				 const BDSMagnetStrength* scalingStrength = nullptr,
-				 const G4String&          scalingKey      = "none");
+				 const G4String&          scalingKey      = "none",
+				 G4bool                   allowOnDemand   = true);
 
-  /// Creat just the electric field object.
-  BDSFieldE* CreateFieldERaw(const BDSFieldInfo& info);
+  /// Creat just the electric field object. allowOnDemand as for CreateFieldMagRaw.
+  BDSFieldE* CreateFieldERaw(const BDSFieldInfo& info,
+			     G4bool              allowOnDemand = true);
 
   /// Create a purely magnetic integrator. As it's purely magnetic, this
   /// requires a G4Mag_EqRhs* equation of motion instance.
@@ -200,5 +203,6 @@ private:
   static BDSPrimaryGeneratorAction* primaryGeneratorAction;
   
   G4bool useOldMultipoleOuterFields;
+  G4bool fieldMapOnDemand; ///< Cache of option to defer loading field maps until first used.
 };
 #endif
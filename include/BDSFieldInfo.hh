@@ -21,6 +21,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "BDSArrayReflectionType.hh"
 #include "BDSFieldFormat.hh"
+#include "BDSFieldMapLayout.hh"
+#include "BDSFieldMapPrecision.hh"
 #include "BDSFieldType.hh"
 #include "BDSIntegratorType.hh"
 #include "BDSInterpolatorType.hh"
@@ -126,6 +128,8 @@ public:
   inline G4bool              UsePlacementWorldTransform() const {return usePlacementWorldTransform;}
   inline const BDSArrayReflectionTypeSet& MagneticArrayReflectionType() const {return magneticArrayReflectionTypeSet;}
   inline const BDSArrayReflectionTypeSet& ElectricArrayReflectionType() const {return electricArrayReflectionTypeSet;}
+  inline BDSFieldMapPrecision MapPrecision()            const {return mapPrecision;}
+  inline BDSFieldMapLayout   MapLayout()                const {return mapLayout;}
   inline BDSModulatorInfo*   ModulatorInfo()            const {return modulatorInfo;}
   inline G4bool IgnoreUpdateOfMaximumStepSize() const {return ignoreUpdateOfMaximumStepSize;}
   inline G4bool              IsThin()                   const {return isThin;}
@@ -144,6 +148,8 @@ public:
   inline void SetMagneticInterpolatorType(BDSInterpolatorType typeIn) {magneticInterpolatorType = typeIn;}
   inline void SetMagneticArrayReflectionType(const BDSArrayReflectionTypeSet& typeIn) {magneticArrayReflectionTypeSet = typeIn;}
   inline void SetElectricArrayReflectionType(const BDSArrayReflectionTypeSet& typeIn) {electricArrayReflectionTypeSet = typeIn;}
+  inline void SetMapPrecision(BDSFieldMapPrecision mapPrecisionIn) {mapPrecision = mapPrecisionIn;}
+  inline void SetMapLayout(BDSFieldMapLayout mapLayoutIn) {mapLayout = mapLayoutIn;}
   inline void SetBScaling(G4double bScalingIn) {bScaling  = bScalingIn;}
   inline void SetAutoScale(G4bool autoScaleIn) {autoScale = autoScaleIn;}
   inline void SetScalingRadius(G4double poleTipRadiusIn) {poleTipRadius = poleTipRadiusIn;}
@@ -184,6 +190,10 @@ public:
   /// output stream
   friend std::ostream& operator<< (std::ostream &out, BDSFieldInfo const &info);
 
+  /// Return a string of every member and both transforms at full precision so that
+  /// identical field definitions have the same key, e.g. to share a volume with a field.
+  G4String DefinitionKey() const;
+
   static G4UserLimits* defaultUL; ///< Cache of default user limits
 
   /// Set thin to allow geant tracking error controls to be set seperately for thin elements
@@ -204,6 +214,8 @@ private:
   BDSFieldFormat           electricFieldFormat;
   BDSInterpolatorType      electricInterpolatorType;
   BDSArrayReflectionTypeSet electricArrayReflectionTypeSet;
+  BDSFieldMapPrecision     mapPrecision;   ///< Storage precision of any loaded map.
+  BDSFieldMapLayout        mapLayout;      ///< Memory layout of any loaded map.
   G4bool                   cacheTransforms;
   G4double                 eScaling;
   G4double                 bScaling;
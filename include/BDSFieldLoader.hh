@@ -20,11 +20,17 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSFIELDLOADER_H
 
 #include "BDSArrayReflectionType.hh"
+#include "BDSFieldFormat.hh"
+#include "BDSFieldMapLayout.hh"
+#include "BDSFieldMapPrecision.hh"
 #include "BDSInterpolatorType.hh"
 #include "G4String.hh"
 #include "G4Transform3D.hh"
 
 #include <array>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <set>
 
 class BDSArray1DCoords;
@@ -80,6 +86,30 @@ public:
   /// Main interface to load an electro-magnetic field.
   BDSFieldEMInterpolated*  LoadEMField(const BDSFieldInfo& info);
 
+  /// Whether a map in this format can have its loading deferred until it's first
+  /// used. This requires the header to be readable on its own - the BDSIM formats.
+  static G4bool CanDeferLoading(const BDSFieldFormat& format);
+
+  /// @{ Read only the header of the magnetic or electric map in a field definition and
+  /// return its coordinates without any data. The caller owns the result.
+  BDSArray4DCoords* LoadMagneticHeader(const BDSFieldInfo& info) const;
+  BDSArray4DCoords* LoadElectricHeader(const BDSFieldInfo& info) const;
+  /// @}
+
+  /// Record a field whose map loading has been deferred so it appears in the summary.
+  void RegisterDeferredField(const BDSFieldInfo& info);
+
+  /// @{ Load a field for an on demand field object on its first use. These may be called
+  /// from several threads at once so loading is serialised. The field is marked as used.
+  BDSFieldMagInterpolated* LoadMagFieldOnDemand(const BDSFieldInfo& info);
+  BDSFieldEInterpolated*   LoadEFieldOnDemand(const BDSFieldInfo& info);
+  BDSFieldEMInterpolated*  LoadEMFieldOnDemand(const BDSFieldInfo& info);
+  /// @}
+
+  /// Print which deferred field maps were loaded and which were never needed.
+  /// Nothing is printed if no loading was deferred.
+  void PrintDeferredFieldSummary() const;
+
 private:
   /// Private default constructor as singleton
   BDSFieldLoader();
@@ -92,6 +122,17 @@ private:
   static void EFilePathOK(const BDSFieldInfo& info);
   /// @}
 
+  /// Read the header of a BDSIM format map with the right loader (binary, gz or normal).
+  BDSArray4DCoords* LoadHeader(const G4String&       filePath,
+                               const BDSFieldFormat& format,
+                               const G4String&       definitionName) const;
+
+  /// Name used for a deferred field in the summary - the definition and its file(s).
+  static G4String DeferredFieldKey(const BDSFieldInfo& info);
+
+  /// Mark a deferred field as loaded. Must be called with onDemandMutex held.
+  void MarkDeferredFieldLoaded(const BDSFieldInfo& info);
+
   /// @{ Return the cached array if there is one - may return nullptr.
   BDSArray1DCoords* Get1DCached(const G4String& filePath);
   BDSArray2DCoords* Get2DCached(const G4String& filePath);
@@ -99,14 +140,54 @@ private:
   BDSArray4DCoords* Get4DCached(const G4String& filePath);
   /// @}
 
+  /// @{ Return the cached array or load it (possibly from shared memory) and cache it.
+  /// Quantised or tiled arrays are cached separately from the standard ones.
+  BDSArray2DCoords* LoadPoissonMag2D(const G4String&      filePath,
+                                     BDSFieldMapPrecision precision,
+                                     BDSFieldMapLayout    layout);
+  BDSArray1DCoords* LoadBDSIM1D(const G4String&      filePath,
+                                BDSFieldMapPrecision precision,
+                                BDSFieldMapLayout    layout);
+  BDSArray2DCoords* LoadBDSIM2D(const G4String&      filePath,
+                                BDSFieldMapPrecision precision,
+                                BDSFieldMapLayout    layout);
+  BDSArray3DCoords* LoadBDSIM3D(const G4String&      filePath,
+                                BDSFieldMapPrecision precision,
+                                BDSFieldMapLayout    layout);
+  BDSArray4DCoords* LoadBDSIM4D(const G4String&      filePath,
+                                BDSFieldMapPrecision precision,
+                                BDSFieldMapLayout    layout);
+  /// @}
+
+  /// Key for the array caches - the file path and the precision and layout if not the defaults.
+  static G4String CacheKey(const G4String&      filePath,
+                           BDSFieldMapPrecision precision,
+                           BDSFieldMapLayout    layout);
+
+  /// Tile and / or quantise a freshly loaded array as required and report it.
+  void ApplyStorage(BDSArray4DCoords*    array,
+                    const G4String&      filePath,
+                    BDSFieldMapPrecision precision,
+                    BDSFieldMapLayout    layout) const;
+
   /// @{ Utility function to use the right templated loader class (gz or normal).
-  BDSArray2DCoords* LoadPoissonMag2D(const G4String& filePath);
-  BDSArray1DCoords* LoadBDSIM1D(const G4String& filePath);
-  BDSArray2DCoords* LoadBDSIM2D(const G4String& filePath);
-  BDSArray3DCoords* LoadBDSIM3D(const G4String& filePath);
-  BDSArray4DCoords* LoadBDSIM4D(const G4String& filePath);
+  BDSArray2DCoords* ReadPoissonMag2D(const G4String& filePath);
+  BDSArray1DCoords* ReadBDSIM1D(const G4String& filePath);
+  BDSArray2DCoords* ReadBDSIM2D(const G4String& filePath);
+  BDSArray3DCoords* ReadBDSIM3D(const G4String& filePath);
+  BDSArray4DCoords* ReadBDSIM4D(const G4String& filePath);
   /// @}
 
+  /// Use read to load the file and apply the storage unless the fieldMapSharedMemory option
+  /// is on, in which case the stored array is attached from or published to shared memory
+  /// by BDSArraySharedStore.
+  BDSArray4DCoords* LoadOrAttach(const G4String&      filePath,
+                                 const G4String&      formatName,
+                                 G4int                nDim,
+                                 BDSFieldMapPrecision precision,
+                                 BDSFieldMapLayout    layout,
+                                 const std::function<BDSArray4DCoords*()>& read) const;
+
   /// Create the appropriate array operators (index and value) and assign to the pointers
   /// given by reference. Assumes valid pointer for reflectionTypes argument.
   void CreateOperators(const BDSArrayReflectionTypeSet* reflectionTypes,
@@ -155,35 +236,45 @@ private:
 					BDSInterpolatorType  interpolatorType,
 					const G4Transform3D& transform,
 					G4double             bScaling,
-					const BDSArrayReflectionTypeSet* reflection = nullptr);
+					const BDSArrayReflectionTypeSet* reflection = nullptr,
+					BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+					BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Load a 2D BDSIM format magnetic field.
   BDSFieldMagInterpolated* LoadBDSIM2DB(const G4String&      filePath,
 					BDSInterpolatorType  interpolatorType,
 					const G4Transform3D& transform,
 					G4double             bScaling,
-                                        const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                        BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                        BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Load a 3D BDSIM format magnetic field.
   BDSFieldMagInterpolated* LoadBDSIM3DB(const G4String&      filePath,
 					BDSInterpolatorType  interpolatorType,
 					const G4Transform3D& transform,
 					G4double             bScaling,
-                                        const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                        BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                        BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Load a 4D BDSIM format magnetic field.
   BDSFieldMagInterpolated* LoadBDSIM4DB(const G4String&      filePath,
 					BDSInterpolatorType  interpolatorType,
 					const G4Transform3D& transform,
 					G4double             bScaling,
-                                        const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                        BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                        BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Load a 2D poisson superfish B field map.
   BDSFieldMagInterpolated* LoadPoissonSuperFishB(const G4String&      filePath,
 						 BDSInterpolatorType  interpolatorType,
 						 const G4Transform3D& transform,
 						 G4double             bScaling,
-                                                 const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                                 const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                                 BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                                 BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Similar to LoadPoissonSuperFishB() but the data below y = x is reflected
   /// and the data relfected from one quadrant to all four at the array level.
@@ -191,7 +282,9 @@ private:
 						     BDSInterpolatorType  interpolatorType,
 						     const G4Transform3D& transform,
 						     G4double             bScaling,
-                                                     const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                                     const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                                     BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                                     BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Similar to LoadPoissonSuperFishB() but with appropriate reflections for
   /// a map for the positive quadrant reflected to all quadrants.
@@ -199,35 +292,45 @@ private:
 						       BDSInterpolatorType  interpolatorType,
 						       const G4Transform3D& transform,
 						       G4double             bScaling,
-                                                       const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                                       const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                                       BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                                       BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Load a 1D BDSIM format electric field.
   BDSFieldEInterpolated* LoadBDSIM1DE(const G4String&      filePath,
 				      BDSInterpolatorType  interpolatorType,
 				      const G4Transform3D& transform,
 				      G4double             eScaling,
-                                      const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                      const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                      BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                      BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Load a 2D BDSIM format electric field.
   BDSFieldEInterpolated* LoadBDSIM2DE(const G4String&      filePath,
 				      BDSInterpolatorType  interpolatorType,
 				      const G4Transform3D& transform,
 				      G4double             eScaling,
-                                      const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                      const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                      BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                      BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Load a 3D BDSIM format electric field.
   BDSFieldEInterpolated* LoadBDSIM3DE(const G4String&      filePath,
 				      BDSInterpolatorType  interpolatorType,
 				      const G4Transform3D& transform,
 				      G4double             eScaling,
-                                      const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                      const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                      BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                      BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
 
   /// Load a 4D BDSIM format electric field.
   BDSFieldEInterpolated* LoadBDSIM4DE(const G4String&      filePath,
 				      BDSInterpolatorType  interpolatorType,
 				      const G4Transform3D& transform,
 				      G4double             eScaling,
-                                      const BDSArrayReflectionTypeSet* reflection = nullptr);
+                                      const BDSArrayReflectionTypeSet* reflection = nullptr,
+                                      BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                      BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
 
   /// Load a 1D BDSIM format electro-magnetic field.
   BDSFieldEMInterpolated* LoadBDSIM1DEM(const G4String&      eFilePath,
@@ -238,7 +341,9 @@ private:
 					G4double             eScaling,
 					G4double             bScaling,
                                         const BDSArrayReflectionTypeSet* eReflection = nullptr,
-                                        const BDSArrayReflectionTypeSet* bReflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* bReflection = nullptr,
+                                        BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                        BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
 
   /// Load a 2D BDSIM format electro-magnetic field.
   BDSFieldEMInterpolated* LoadBDSIM2DEM(const G4String&      eFilePath,
@@ -249,7 +354,9 @@ private:
 					G4double             eScaling,
 					G4double             bScaling,
                                         const BDSArrayReflectionTypeSet* eReflection = nullptr,
-                                        const BDSArrayReflectionTypeSet* bReflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* bReflection = nullptr,
+                                        BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                        BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
   
   /// Load a 3D BDSIM format electro-magnetic field.
   BDSFieldEMInterpolated* LoadBDSIM3DEM(const G4String&      eFilePath,
@@ -260,7 +367,9 @@ private:
 					G4double             eScaling,
 					G4double             bScaling,
                                         const BDSArrayReflectionTypeSet* eReflection = nullptr,
-                                        const BDSArrayReflectionTypeSet* bReflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* bReflection = nullptr,
+                                        BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                        BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
 
   /// Load a 4D BDSIM format electro-magnetic field.
   BDSFieldEMInterpolated* LoadBDSIM4DEM(const G4String&      eFilePath,
@@ -271,7 +380,9 @@ private:
 					G4double             eScaling,
 					G4double             bScaling,
                                         const BDSArrayReflectionTypeSet* eReflection = nullptr,
-                                        const BDSArrayReflectionTypeSet* bReflection = nullptr);
+                                        const BDSArrayReflectionTypeSet* bReflection = nullptr,
+                                        BDSFieldMapPrecision precision = BDSFieldMapPrecision::standard,
+                                        BDSFieldMapLayout    layout    = BDSFieldMapLayout::linear);
 
   /// @{ Map of cached field map array.
   std::map<G4String, BDSArray1DCoords*> arrays1d;
@@ -279,6 +390,17 @@ private:
   std::map<G4String, BDSArray3DCoords*> arrays3d;
   std::map<G4String, BDSArray4DCoords*> arrays4d;
   /// @}
+
+  /// Number of field objects made for a deferred field definition and how many were loaded.
+  struct DeferredUsage
+  {
+    G4int nFields = 0;
+    G4int nLoaded = 0;
+  };
+  std::map<G4String, DeferredUsage> deferredFields;
+
+  /// Serialises on demand loading as the caches above aren't thread safe.
+  mutable std::mutex onDemandMutex;
 };
 
 #endif
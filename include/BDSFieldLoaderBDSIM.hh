@@ -62,6 +62,12 @@ public:
   BDSArray2DCoords* Load2D(const G4String& fileName); ///< Load a 2D array.
   BDSArray1DCoords* Load1D(const G4String& fileName); ///< Load a 1D array.
 
+  /// Read only the header of a file and return an array with the coordinates of the
+  /// map but no data allocated. Used to know the extent and spacing of a map without
+  /// loading it. The caller owns the result.
+  BDSArray4DCoords* LoadHeader(const G4String& fileName,
+                               const unsigned int nDim);
+
 private:
   /// Ensure any member variables are reset between usages.
   void CleanUp();
@@ -69,9 +75,10 @@ private:
   /// Close file and exit program in case of an error.
   void Terminate(const G4String& message = "");
 
-  /// General loader for any number of dimensions.
+  /// General loader for any number of dimensions. Optionally stop after the header.
   void Load(const G4String& fileName,
-	    const unsigned int nDim);
+	    const unsigned int nDim,
+	    G4bool headerOnly = false);
 
   /// Process on line of data. Index of 0 corresponds to a default value of field of 0.
   /// This allows various dimensional loading to use the same function.
@@ -0,0 +1,104 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDLOADERBDSIMBINARY_H
+#define BDSFIELDLOADERBDSIMBINARY_H
+
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <vector>
+
+class BDSArray4DCoords;
+class BDSArray3DCoords;
+class BDSArray2DCoords;
+class BDSArray1DCoords;
+
+/**
+ * @brief Loader for BDSIM format fields stored in binary.
+ *
+ * This holds the same information as the ASCII BDSIM format but can be read
+ * without parsing any text. The layout in native (little-endian) byte order is:
+ *
+ * - char[8]  "BDSIMFMB"
+ * - uint32   format version (1)
+ * - uint32   number of dimensions N (1 to 4)
+ * - N times: char[4] dimension name ("x", "y", "z" or "t" padded with zeros),
+ *            int32 number of points, double min, double max (cm or s)
+ * - the product of the numbers of points times double[3] field components (T or V/m)
+ *   with the first dimension varying fastest (the "xyzt" loop order)
+ *
+ * Files are recognised by their first 8 bytes so they can be used with the usual
+ * bdsim1d to bdsim4d formats.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSFieldLoaderBDSIMBinary
+{
+public:
+  /// One dimension described in the header.
+  struct Dimension
+  {
+    char     name; ///< One of x,y,z,t.
+    G4int    n;
+    G4double min;  ///< In cm or s.
+    G4double max;  ///< In cm or s.
+  };
+
+  BDSFieldLoaderBDSIMBinary();
+  ~BDSFieldLoaderBDSIMBinary();
+
+  BDSArray4DCoords* Load4D(const G4String& fileName); ///< Load a 4D array.
+  BDSArray3DCoords* Load3D(const G4String& fileName); ///< Load a 3D array.
+  BDSArray2DCoords* Load2D(const G4String& fileName); ///< Load a 2D array.
+  BDSArray1DCoords* Load1D(const G4String& fileName); ///< Load a 1D array.
+
+  /// Read only the header and return an array with the coordinates of the map
+  /// but no data allocated. The caller owns the result.
+  BDSArray4DCoords* LoadHeader(const G4String& fileName,
+                               const unsigned int nDim);
+
+  /// Whether the file starts with the identifier of this format.
+  static G4bool IsBinary(const G4String& fileName);
+
+  /// Write the identifier, version and dimensions. The field values should then
+  /// be written as 3 doubles per point in the order described above.
+  static void WriteHeader(std::ostream& out,
+                          const std::vector<Dimension>& dimensions);
+
+  static const char          identifier[8];
+  static const std::uint32_t version;
+
+private:
+  /// Close file and throw an exception.
+  void Terminate(const G4String& message = "");
+
+  /// General loader for any number of dimensions. Optionally stop after the header.
+  void Load(const G4String& fileName,
+            const unsigned int nDim,
+            G4bool headerOnly = false);
+
+  std::ifstream     file;
+  BDSArray4DCoords* result; ///< Resultant array from loading.
+};
+
+#endif
@@ -0,0 +1,49 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDMAPLAYOUT_H
+#define BDSFIELDMAPLAYOUT_H
+
+#include "BDSTypeSafeEnum.hh"
+
+#include "G4String.hh"
+
+/**
+ * @brief Type definition for the memory layout of a loaded field map.
+ *
+ * linear is x fastest, then y, z and t. tiled groups 4x4x4 points in x,y,z
+ * together so interpolation touches fewer separate regions of memory.
+ * 
+ * @author Laurie Nevay
+ */
+
+struct fieldmaplayout_def
+{
+  enum type {linear,
+	     tiled};
+};
+
+typedef BDSTypeSafeEnum<fieldmaplayout_def,int> BDSFieldMapLayout;
+
+namespace BDS
+{
+  /// Function that gives corresponding enum value for string (case-insensitive).
+  BDSFieldMapLayout DetermineFieldMapLayout(G4String layout);
+}
+
+#endif
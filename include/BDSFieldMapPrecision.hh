@@ -0,0 +1,51 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSFIELDMAPPRECISION_H
+#define BDSFIELDMAPPRECISION_H
+
+#include "BDSTypeSafeEnum.hh"
+
+#include "G4String.hh"
+
+/**
+ * @brief Type definition for the storage precision of a loaded field map.
+ *
+ * standard is the BDSFieldValue type BDSIM was compiled with (float by
+ * default or double with USE_FIELD_DOUBLE_PRECISION). int16 quantises the
+ * map after loading with one scale factor per component.
+ * 
+ * @author Laurie Nevay
+ */
+
+struct fieldmapprecision_def
+{
+  enum type {standard,
+	     int16};
+};
+
+typedef BDSTypeSafeEnum<fieldmapprecision_def,int> BDSFieldMapPrecision;
+
+namespace BDS
+{
+  /// Function that gives corresponding enum value for string (case-insensitive).
+  /// "float" or "double" are accepted only if they are the compiled field value type.
+  BDSFieldMapPrecision DetermineFieldMapPrecision(G4String precision);
+}
+
+#endif
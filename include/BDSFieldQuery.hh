@@ -35,7 +35,12 @@ class G4VPhysicalVolume;
  *  @brief Class for querying the Geant4 model for field at any point.
  *
  *  Output is a BDSIM-format field map. Unique files for electric and magnetic
- *  field maps as would be required to read the field maps back into BDSIM.
+ *  field maps as would be required to read the field maps back into BDSIM. This
+ *  may be text or the binary format of BDSFieldLoaderBDSIMBinary.
+ *
+ *  The points are evaluated in blocks and then written in order. A block may be
+ *  shared between several threads if NThreads() is greater than 1. These are started
+ *  once for each query and wait between blocks.
  *
  *  @author Laurie Nevay
  */
@@ -65,9 +70,32 @@ protected:
                              G4double tGlobal,
                              G4double fieldValue[6]);
 
+  /// As GetFieldValue() but from one of NThreads() threads. Only called concurrently
+  /// if NThreads() is greater than 1, so by default it calls GetFieldValue().
+  virtual void GetFieldValueForThread(G4int threadIndex,
+                                      const G4ThreeVector& globalXYZ,
+                                      const G4ThreeVector& globalDirection,
+                                      G4double tGlobal,
+                                      G4double fieldValue[6]);
+
+  /// Number of threads to evaluate a query with. The fields in the Geant4 model share
+  /// the static navigators of BDSAuxiliaryNavigator so this is 1 here.
+  virtual G4int NThreads(const BDSFieldQueryInfo* query) const;
+
   /// Warn the user if the fieldObject variable is use when it shouldn't be.
   virtual void CheckIfFieldObjectSpecified(const BDSFieldQueryInfo* query) const;
   
+  /// Apply a transform to the coordinates. Does not apply to time.
+  G4ThreeVector LocalToGlobalPoint(const G4AffineTransform& localToGlobalTransform,
+                                   G4double xLocal,
+				   G4double yLocal,
+				   G4double zLocal) const;
+
+  /// Convert a global field axis to a local one.
+  void GlobalToLocalAxisField(const G4AffineTransform& globalToLocalTransform,
+                              const G4double globalBEField[6],
+                              G4double localBEField[6]);
+  
 private:
   /// Throw an exception if the number of steps is >1 and the difference between max and min is 0.
   void CheckNStepsAndRange(const BDSFieldQueryInfo::QueryDimensionInfo& dimensionInfo,
@@ -89,26 +117,19 @@ private:
   /// Close any files if open.
   virtual void CloseFiles();
   
-  /// Apply a transform to the coordinates. Does not apply to time.
-  G4ThreeVector LocalToGlobalPoint(const G4AffineTransform& localToGlobalTransform,
-                                   G4double xLocal,
-				   G4double yLocal,
-				   G4double zLocal) const;
-
-  /// Convert a global field axis to a local one.
-  void GlobalToLocalAxisField(const G4AffineTransform& globalToLocalTransform,
-                              const G4double globalBEField[6],
-                              G4double localBEField[6]);
-  
   /// Write an entry ta line of the output file(s). The array is assumed to be Bx,By,Bz,Ex,Ey,Ez as in Geant4.
   virtual void WriteFieldValue(const G4ThreeVector& xyzGlobal,
                                G4double tGlobal,
                                const G4double fieldValue[6]);
+
+  /// Number of points evaluated before writing them out.
+  static const long long blockSize;
   
   std::ofstream oFileMagnetic;
   std::ofstream oFileElectric;
   G4bool queryMagnetic;
   G4bool queryElectric;
+  G4bool writeBinary;
   G4bool writeX;
   G4bool writeY;
   G4bool writeZ;
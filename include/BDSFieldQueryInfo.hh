@@ -68,7 +68,10 @@ public:
                     G4bool drawArrowsIn = true,
                     G4bool drawZeroValuePointsIn = true,
                     G4bool drawBoxesIn = true,
-                    G4double boxAlphaIn = 0.2);
+                    G4double boxAlphaIn = 0.2,
+                    G4bool binaryOutputIn = false,
+                    G4int nThreadsIn = 1,
+                    const G4String& errorReportInterpolatorIn = "");
 
   /// Alternative constructor with list of exact points to query.
   BDSFieldQueryInfo(const G4String& nameIn,
@@ -84,7 +87,9 @@ public:
                     G4bool drawArrowsIn = true,
 		    G4bool drawZeroValuePointsIn = true,
 		    G4bool drawBoxesIn = true,
-		    G4double boxAlphaIn = 0.2);
+		    G4double boxAlphaIn = 0.2,
+		    G4bool binaryOutputIn = false,
+		    G4int nThreadsIn = 1);
   ~BDSFieldQueryInfo();
   
   G4String name;
@@ -104,6 +109,9 @@ public:
   
   G4bool overwriteExistingFiles;
   G4bool printTransform;
+  G4bool binaryOutput; ///< Write BDSIM binary format instead of text.
+  G4int  nThreads;     ///< Only used when querying a field object directly.
+  G4String errorReportInterpolator; ///< Only used when querying a field object directly.
 
   G4String fieldObject; ///< Optional for use in interpolator.
   
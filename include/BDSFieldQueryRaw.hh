@@ -24,6 +24,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 
+#include <vector>
+
 class BDSFieldQueryInfo;
 class G4Field;
 
@@ -33,6 +35,16 @@ class G4Field;
  *  Output is a BDSIM-format field map. Unique files for electric and magnetic
  *  field maps as would be required to read the field maps back into BDSIM.
  *
+ *  If more than one copy of the field is given, the query is shared between
+ *  that many threads (up to nThreads of the query), each with its own copy.
+ *  The field objects are not navigated so each copy is independent.
+ *
+ *  If the query has an errorReportInterpolator, the map written for a regular
+ *  grid is loaded back in with that interpolator and compared to the queried
+ *  field at the centre of every cell of the grid. This is used to check a map
+ *  resampled onto a finer grid (e.g. from a cubic interpolated field) so that
+ *  a cheaper interpolator can be used in bdsim.
+ *
  *  @author Laurie Nevay
  */
 class BDSFieldQueryRaw: public BDSFieldQuery
@@ -44,6 +56,10 @@ public:
   /// Query the field in the Geant4 model according to information in query.
   void QueryFieldRaw(G4Field* field,
 		     const BDSFieldQueryInfo* query);
+
+  /// As above but with an independent copy of the same field for each thread.
+  void QueryFieldRaw(const std::vector<G4Field*>& fieldPerThread,
+		     const BDSFieldQueryInfo* query);
   
 protected:
   /// Get the electric and magnetic field at the specified coordinates. The navigator requires
@@ -53,6 +69,16 @@ protected:
 			     const G4ThreeVector& globalDirection,
 			     G4double tGlobal,
 			     G4double fieldValue[6]);
+
+  /// Use the field of this thread.
+  virtual void GetFieldValueForThread(G4int threadIndex,
+				      const G4ThreeVector& globalXYZ,
+				      const G4ThreeVector& globalDirection,
+				      G4double tGlobal,
+				      G4double fieldValue[6]);
+
+  /// The smaller of nThreads in the query and the number of field copies.
+  virtual G4int NThreads(const BDSFieldQueryInfo* query) const;
   
   /// Do the opposite for this class as it's only used for the interpolator and we want
   /// fieldObject to be specified.
@@ -64,7 +90,24 @@ private:
   using BDSFieldQuery::QueryField;
   /// @}
 
-  G4Field* field; ///< The field object to query.
+  /// Load the map just written with the errorReportInterpolator of the query and
+  /// print the maximum and rms difference to the queried field at the cell centres.
+  void ReportInterpolationError(const BDSFieldQueryInfo* query);
+
+  /// Compare the fields over the cell centres of the query grid for one of B or E. The
+  /// reference field is evaluated in global coordinates and the resampled one in local.
+  void CompareAtCellCentres(const BDSFieldQueryInfo* query,
+			    G4Field* resampledField,
+			    G4bool electric,
+			    const G4String& interpolatorName);
+
+  /// Evaluate a field at a point.
+  static void Evaluate(G4Field* fieldToQuery,
+		       const G4ThreeVector& globalXYZ,
+		       G4double tGlobal,
+		       G4double fieldValue[6]);
+
+  std::vector<G4Field*> fields; ///< The field object to query for each thread.
 };
 
 #endif
@@ -23,6 +23,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "G4String.hh"
 
+#include <cstdint>
 #include <vector>
 #include <map>
 
@@ -39,6 +40,28 @@ namespace BDS
 
   /// Get GDML Schema location included with BDSIM.
   G4String GDMLSchemaLocation();
+
+  /// Return the path in the GDML cache directory (option gdmlCacheDirectory) for the
+  /// preprocessed version of a file. The name includes GDMLCacheKey() so that any change
+  /// gives a new entry. Returns an empty string if no cache is in use.
+  G4String GDMLCacheFileName(const G4String& file,
+			     const G4String& variant);
+
+  /// Files a GDML file refers to - external entities (relative to the referring file)
+  /// and modular <file name="..."/> references (relative to the working directory as
+  /// in Geant4), followed recursively. Files that don't exist are included too.
+  std::vector<G4String> GDMLDependencies(const G4String& file);
+
+  /// 64 bit FNV-1a hash of the contents of a GDML file and all its dependencies, its
+  /// directory (schema paths are made relative to it), the Geant4 version and the variant
+  /// of preprocessing (which should include the prefix and the schema location if used).
+  std::uint64_t GDMLCacheKey(const G4String& file,
+			     const G4String& variant);
+
+  /// Copy a newly preprocessed file into the cache. Written to a unique name then
+  /// renamed so concurrent jobs sharing a cache never see a partial file.
+  void StoreInGDMLCache(const G4String& processedFile,
+			const G4String& cacheFile);
 }
 
 /**
@@ -139,6 +139,11 @@ public:
   /// Register another geometry component as belonging to this one. This component will
   /// then own and delete it as necessary.
   void RegisterDaughter(BDSGeometryComponent* anotherComponent) {allDaughters.insert(anotherComponent);}
+
+  /// Register another geometry component that is used by this one but owned elsewhere, e.g.
+  /// geometry reused between identical components. Its volumes are included in this component's
+  /// sets of logical, biasing and sensitive volumes but it will not be deleted by this one.
+  void RegisterSharedDaughter(BDSGeometryComponent* anotherComponent) {sharedDaughters.insert(anotherComponent);}
   
   /// Register a solid as belonging to this geometry component, which then becomes responsible
   /// for it. Note, the container solid given in the constructor is automatically registered.
@@ -239,6 +244,12 @@ protected:
   
   /// registry of all daughter geometry components
   std::set<BDSGeometryComponent*> allDaughters;
+
+  /// registry of daughter geometry components used but not owned by this component
+  std::set<BDSGeometryComponent*> sharedDaughters;
+
+  /// Union of owned and shared daughters for recursive queries of volumes.
+  std::set<BDSGeometryComponent*> DaughtersInUse() const;
   
   /// registry of all solids belonging to this component
   std::set<G4VSolid*> allSolids;
@@ -58,6 +58,10 @@ namespace BDS
   
   /// Inspect a G4EllipticalTube.
   std::pair<BDSExtent, BDSExtent> InspectEllipticalTube(const G4VSolid* solidIn);
+
+  /// Inspect a G4ExtrudedSolid. The extent is that of the polygon vertices at
+  /// each z section.
+  std::pair<BDSExtent, BDSExtent> InspectExtrudedSolid(const G4VSolid* solidIn);
 }
 
 #endif
@@ -130,6 +130,9 @@ public:
   inline G4bool   WriteSeedState()         const {return G4bool  (options.writeSeedState);}
   inline G4bool   UseASCIISeedState()      const {return G4bool  (options.useASCIISeedState);}
   inline G4String SeedStateFileName()      const {return G4String(options.seedStateFileName);}
+  inline G4bool   SeedPerEvent()           const {return G4bool  (options.seedPerEvent);}
+  inline G4bool   UseEventArena()          const {return G4bool  (options.useEventArena);}
+  inline G4bool   FastTrackPrimaries()     const {return G4bool  (options.fastTrackPrimaries);}
   inline G4String BDSIMPath()              const {return G4String(options.bdsimPath);}
   inline G4int    NGenerate()              const {return numberToGenerate;}
   inline G4bool   NGenerateSet()           const {return G4bool  (options.HasBeenSet("ngenerate"));}
@@ -209,6 +212,8 @@ public:
   inline G4double MinimumEpsilonStepThin()   const {return G4double(options.minimumEpsilonStepThin);}
   inline G4double MaximumEpsilonStepThin()   const {return G4double(options.maximumEpsilonStepThin);}
   inline G4String FieldModulator()           const {return G4String(options.fieldModulator);}
+  inline G4bool   FieldMapSharedMemory()     const {return G4bool  (options.fieldMapSharedMemory);}
+  inline G4bool   FieldMapOnDemand()         const {return G4bool  (options.fieldMapOnDemand);}
   inline G4double MaxTime()                  const {return G4double(options.maximumTrackingTime)*CLHEP::s;}
   inline G4double MaxStepLength()            const {return G4double(options.maximumStepLength)*CLHEP::m;}
   inline G4double MaxTrackLength()           const {return G4double(options.maximumTrackLength)*CLHEP::m;}
@@ -306,6 +311,8 @@ public:
   inline G4long   MaximumTracksPerEvent()    const {return G4long  (options.maximumTracksPerEvent);}
   inline G4double MinimumKineticEnergy()     const {return G4double(options.minimumKineticEnergy*CLHEP::GeV);}
   inline G4double MinimumKineticEnergyTunnel() const {return G4double(options.minimumKineticEnergyTunnel)*CLHEP::GeV;}
+  inline G4double RouletteKineticEnergy()    const {return G4double(options.rouletteKineticEnergy*CLHEP::GeV);}
+  inline G4double RouletteProbability()      const {return G4double(options.rouletteProbability);}
   inline G4double MinimumRange()             const {return G4double(options.minimumRange*CLHEP::m);}
   inline G4String ParticlesToExcludeFromCuts() const {return G4String(options.particlesToExcludeFromCuts);}
   inline G4String VacuumMaterial()           const {return G4String(options.vacMaterial);}
@@ -316,6 +323,12 @@ public:
   inline G4bool   AutoColourWorldGeometryFile()  const {return G4bool  (options.autoColourWorldGeometryFile);}
   inline G4String ImportanceWorldGeometryFile()  const {return G4String(options.importanceWorldGeometryFile);}
   inline G4String ImportanceVolumeMapFile()      const {return G4String(options.importanceVolumeMap);}
+  inline G4String ImportanceParticles()          const {return G4String(options.importanceParticles);}
+  inline G4bool   UseWeightWindows()             const {return G4bool  (options.useWeightWindows);}
+  inline G4String WeightWindowEnergyBounds()     const {return G4String(options.weightWindowEnergyBounds);}
+  inline G4double WeightWindowUpperLimitFactor() const {return G4double(options.weightWindowUpperLimitFactor);}
+  inline G4double WeightWindowSurvivalFactor()   const {return G4double(options.weightWindowSurvivalFactor);}
+  inline G4int    WeightWindowMaximumSplits()    const {return G4int   (options.weightWindowMaximumSplits);}
   inline G4double WorldVolumeMargin()        const {return G4double(options.worldVolumeMargin*CLHEP::m);}
   inline G4bool   YokeFields()               const {return G4bool  (options.yokeFields);}
   inline G4bool   YokeFieldsMatchLHCGeometry()const{return G4bool  (options.yokeFieldsMatchLHCGeometry);}
@@ -338,6 +351,8 @@ public:
   inline G4double CoilHeightFraction()       const {return G4double(options.coilHeightFraction);}
   inline G4bool   PreprocessGDML()           const {return G4bool  (options.preprocessGDML);}
   inline G4bool   PreprocessGDMLSchema()     const {return G4bool  (options.preprocessGDMLSchema);}
+  inline G4bool   ReuseIdenticalGeometry()   const {return G4bool  (options.reuseIdenticalGeometry);}
+  inline G4bool   BooleanFreeGeometry()      const {return G4bool  (options.booleanFreeGeometry);}
   inline G4int    NBinsX()                   const {return G4int   (options.nbinsx);}
   inline G4int    NBinsY()                   const {return G4int   (options.nbinsy);}
   inline G4int    NBinsZ()                   const {return G4int   (options.nbinsz);}
@@ -350,6 +365,7 @@ public:
   inline G4bool   UseScoringMap()            const {return G4bool  (options.useScoringMap);}
   inline G4bool   RemoveTemporaryFiles()     const {return G4bool  (options.removeTemporaryFiles);}
   inline G4String TemporaryDirectory()       const {return G4String(options.temporaryDirectory);}
+  inline G4String GDMLCacheDirectory()       const {return G4String(options.gdmlCacheDirectory);}
   inline G4bool   SampleElementsWithPoleface() const {return G4bool  (options.sampleElementsWithPoleface);}
   inline G4double NominalMatrixRelativeMomCut() const {return G4double (options.nominalMatrixRelativeMomCut);}
   inline G4bool   TeleporterFullTransform()  const {return G4bool  (options.teleporterFullTransform);}
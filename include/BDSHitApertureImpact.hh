@@ -19,6 +19,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSHITAPERTUREIMPACT_H
 #define BDSHITAPERTUREIMPACT_H
 
+#include "BDSEventArena.hh"
+
 #include "globals.hh"
 #include "G4VHit.hh"
 #include "G4ThreeVector.hh"
@@ -82,13 +84,13 @@ extern G4Allocator<BDSHitApertureImpact> BDSAllocatorApertureImpacts;
 inline void* BDSHitApertureImpact::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorApertureImpacts.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorApertureImpacts);
   return aHit;
 }
 
 inline void BDSHitApertureImpact::operator delete(void *aHit)
 {
-  BDSAllocatorApertureImpacts.FreeSingle((BDSHitApertureImpact*) aHit);
+  BDS::EventFree(BDSAllocatorApertureImpacts, aHit);
 }
 
 #endif
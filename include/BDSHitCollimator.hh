@@ -19,6 +19,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSHITCOLLIMATOR_H
 #define BDSHITCOLLIMATOR_H
 
+#include "BDSEventArena.hh"
+
 #include "globals.hh"
 #include "G4VHit.hh"
 #include "G4ThreeVector.hh"
@@ -70,13 +72,13 @@ extern G4Allocator<BDSHitCollimator> BDSAllocatorCollimator;
 inline void* BDSHitCollimator::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorCollimator.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorCollimator);
   return aHit;
 }
 
 inline void BDSHitCollimator::operator delete(void* aHit)
 {
-  BDSAllocatorCollimator.FreeSingle((BDSHitCollimator*) aHit);
+  BDS::EventFree(BDSAllocatorCollimator, aHit);
 }
 
 #endif
@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSHITENERGYDEPOSITION_H
 #define BDSHITENERGYDEPOSITION_H
 
+#include "BDSEventArena.hh"
 #include "BDSHitEnergyDepositionExtra.hh"
 
 #include "G4VHit.hh"
@@ -112,13 +113,13 @@ extern G4Allocator<BDSHitEnergyDeposition> BDSAllocatorEnergyDeposition;
 inline void* BDSHitEnergyDeposition::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorEnergyDeposition.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorEnergyDeposition);
   return aHit;
 }
 
 inline void BDSHitEnergyDeposition::operator delete(void *aHit)
 {
- BDSAllocatorEnergyDeposition.FreeSingle((BDSHitEnergyDeposition*) aHit);
+ BDS::EventFree(BDSAllocatorEnergyDeposition, aHit);
 }
 
 #endif
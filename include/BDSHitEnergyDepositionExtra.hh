@@ -19,6 +19,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSHITENERGYDEPOSITIONEXTRA_H
 #define BDSHITENERGYDEPOSITIONEXTRA_H
 
+#include "BDSEventArena.hh"
+
 #include "globals.hh"
 #include "G4THitsCollection.hh"
 #include "G4Allocator.hh"
@@ -95,13 +97,13 @@ extern G4Allocator<BDSHitEnergyDepositionExtra> BDSAllocatorEnergyDepositionExtr
 inline void* BDSHitEnergyDepositionExtra::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorEnergyDepositionExtra.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorEnergyDepositionExtra);
   return aHit;
 }
 
 inline void BDSHitEnergyDepositionExtra::operator delete(void *aHit)
 {
- BDSAllocatorEnergyDepositionExtra.FreeSingle((BDSHitEnergyDepositionExtra*) aHit);
+ BDS::EventFree(BDSAllocatorEnergyDepositionExtra, aHit);
 }
 
 #endif
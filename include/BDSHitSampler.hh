@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSHITSAMPLER_H
 #define BDSHITSAMPLER_H
 
+#include "BDSEventArena.hh"
 #include "BDSParticleCoordsFull.hh"
 
 #include "globals.hh"
@@ -77,13 +78,13 @@ extern G4Allocator<BDSHitSampler> BDSAllocatorSampler;
 inline void* BDSHitSampler::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorSampler.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorSampler);
   return aHit;
 }
 
 inline void BDSHitSampler::operator delete(void *aHit)
 {
-  BDSAllocatorSampler.FreeSingle((BDSHitSampler*) aHit);
+  BDS::EventFree(BDSAllocatorSampler, aHit);
 }
 
 #endif
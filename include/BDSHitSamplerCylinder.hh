@@ -18,6 +18,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSHITSAMPLERCYLINDER_H
 #define BDSHITSAMPLERCYLINDER_H
+#include "BDSEventArena.hh"
 #include "BDSParticleCoordsCylindrical.hh"
 
 #include "globals.hh"
@@ -80,13 +81,13 @@ extern G4Allocator<BDSHitSamplerCylinder> BDSAllocatorSamplerCylinder;
 inline void* BDSHitSamplerCylinder::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorSamplerCylinder.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorSamplerCylinder);
   return aHit;
 }
 
 inline void BDSHitSamplerCylinder::operator delete(void *aHit)
 {
-  BDSAllocatorSamplerCylinder.FreeSingle((BDSHitSamplerCylinder*) aHit);
+  BDS::EventFree(BDSAllocatorSamplerCylinder, aHit);
 }
 
 #endif
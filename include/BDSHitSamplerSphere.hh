@@ -18,6 +18,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSHITSAMPLERSPHERE_H
 #define BDSHITSAMPLERSPHERE_H
+#include "BDSEventArena.hh"
 #include "BDSParticleCoordsSpherical.hh"
 
 #include "globals.hh"
@@ -80,13 +81,13 @@ extern G4Allocator<BDSHitSamplerSphere> BDSAllocatorSamplerSphere;
 inline void* BDSHitSamplerSphere::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorSamplerSphere.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorSamplerSphere);
   return aHit;
 }
 
 inline void BDSHitSamplerSphere::operator delete(void *aHit)
 {
-  BDSAllocatorSamplerSphere.FreeSingle((BDSHitSamplerSphere*) aHit);
+  BDS::EventFree(BDSAllocatorSamplerSphere, aHit);
 }
 
 #endif
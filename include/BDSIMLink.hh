@@ -30,12 +30,15 @@ class BDSComponentConstructor;
 class BDSComponentFactoryUser;
 class BDSLinkComponent;
 class BDSLinkDetectorConstruction;
+class BDSLinkParticleBatch;
+class BDSLinkPrimaryGeneratorAction;
 class BDSOutput;
 class BDSParser;
 class BDSParticleCoordsFull;
 class BDSParticleDefinition;
 class BDSParticleExternal;
 class G4RunManager;
+class G4VPhysicalVolume;
 class G4VModularPhysicsList;
 
 /** 
@@ -84,6 +87,17 @@ public:
   /// from the standard input e.g. the executable option ngenerate and then the one specified
   /// in the input gmad files as an option.
   void BeamOn(int nGenerate=-1);
+
+  /// Track a whole batch of particles (e.g. one turn) in one run and return the
+  /// particles that reach the link samplers in particlesOut, which is cleared first.
+  /// The input is used in place and must be the only source of particles, i.e. the
+  /// bunch must be a BDSBunchSixTrackLink. Up to primariesPerEvent particles are put
+  /// in each event, which reduces the per event overhead. The returned particles are
+  /// still attributed to the right external parent. This is reduced to 1 if a maximum
+  /// number of tracks per event is set as that limit would then apply to several.
+  void TrackBatch(const BDSLinkParticleBatch& particlesIn,
+		  BDSLinkParticleBatch&       particlesOut,
+		  int                         primariesPerEvent = 1);
   
   void SelectLinkElement(const std::string& elementName, bool debug = false);
   void SelectLinkElement(int index, bool debug = false);
@@ -105,6 +119,16 @@ public:
                            double crystalAngle  = 0,
 			   bool   sampleIn      = false);
 
+  /// @{ Add several link elements at once. Between these, AddLinkCollimatorJaw does not
+  /// close the geometry, so the navigation voxels are only built once at the end.
+  void BeginLinkElementUpdate();
+  void EndLinkElementUpdate();
+  /// @}
+
+  /// If true, closing the geometry after adding link elements only rebuilds the
+  /// voxels of the new volumes and their mothers rather than the whole geometry.
+  inline void SetIncrementalGeometryUpdate(bool incrementalIn) {incrementalGeometryUpdate = incrementalIn;}
+
   BDSHitsCollectionSamplerLink* SamplerHits() const;
   void ClearSamplerHits() {runAction->ClearSamplerHits();}
   
@@ -133,6 +157,11 @@ private:
   /// The main function where everything is constructed.
   int Initialise(double minimumKineticEnergy = 0,
                  bool   protonsAndIonsOnly   = true);
+
+  /// @{ Open and close the geometry around adding link elements.
+  void OpenGeometryForUpdate();
+  void CloseGeometryAfterUpdate();
+  /// @}
   
   bool   ignoreSIGINT;         ///< For cmake testing.
   bool   usualPrintOut;        ///< Whether to allow the usual cout output.
@@ -148,7 +177,12 @@ private:
   G4RunManager* runManager;
   BDSLinkDetectorConstruction* construction;
   BDSLinkRunAction*  runAction;
+  BDSLinkPrimaryGeneratorAction* primaryGeneratorAction;
   /// @}
+
+  bool incrementalGeometryUpdate;            ///< Only reoptimise changed volumes.
+  bool inLinkElementUpdate;                  ///< Between Begin and EndLinkElementUpdate.
+  G4VPhysicalVolume* updateReferenceVolume;  ///< Volume the geometry was opened with if any.
   
   std::vector<BDSParticleExternal*> externalParticles;
   std::map<std::string, int>        nameToElementIndex;
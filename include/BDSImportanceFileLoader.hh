@@ -23,9 +23,14 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Types.hh"
 
 #include <map>
+#include <vector>
 
 /**
  * @brief A loader for importance values used in importance sampling.
+ *
+ * Each line is a physical volume name followed by one or more importance
+ * values. More than one value is only permitted with weight windows where
+ * there is one value per energy window.
  * 
  * @author Will Shields
  */
@@ -37,7 +42,7 @@ public:
   BDSImportanceFileLoader();
   ~BDSImportanceFileLoader();
 
-  std::map<G4String, G4double> Load(const G4String& fileName);
+  std::map<G4String, std::vector<G4double> > Load(const G4String& fileName);
 };
 
 #endif
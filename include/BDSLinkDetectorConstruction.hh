@@ -27,7 +27,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Version.hh"
 #include "G4VUserDetectorConstruction.hh"
 
+#include <set>
 #include <string>
+#include <vector>
 
 class BDSBeamline;
 class BDSBeamlineElement;
@@ -37,6 +39,7 @@ class BDSLinkRegistry;
 class BDSParticleDefinition;
 class G4Box;
 class G4ChannelingOptrMultiParticleChangeCrossSection;
+class G4LogicalVolume;
 class G4VPhysicalVolume;
 
 /**
@@ -88,6 +91,15 @@ public:
   inline G4int NumberOfElements() const {return linkBeamline ? (G4int)linkBeamline->size() : 0;}
   inline void SetSamplerWorldID(G4int samplerWorldIDIn) {samplerWorldID = samplerWorldIDIn;}
   inline const BDSBeamline* LinkBeamline() const {return linkBeamline;}
+  inline G4VPhysicalVolume* WorldPV() const {return worldPV;}
+
+  /// Build the navigation voxels for the volumes placed since the last call and rebuild
+  /// those of their mothers except the world, which is left to the geometry manager.
+  /// Used instead of optimising the whole geometry again when elements are added.
+  void OptimiseNewVolumes();
+
+  /// Forget the volumes placed so far, e.g. when the whole geometry is optimised.
+  inline void ClearNewVolumes() {newlyPlacedVolumes.clear();}
 
  private:
   /// Create the worldSolid if it doesn't exist and if not expand it to the extent of the
@@ -97,6 +109,13 @@ public:
   /// Place a beam line element in the world.
   G4int PlaceOneComponent(const BDSBeamlineElement* element, const G4String& originalName);
 
+  /// Build voxels for any logical volume in this tree that doesn't have them already.
+  void OptimiseVolumeTree(G4LogicalVolume* lv, std::set<G4LogicalVolume*>& visited) const;
+
+  /// Build (or not) the voxels for one logical volume with the same criteria as
+  /// G4GeometryManager.
+  static void BuildVoxels(G4LogicalVolume* lv);
+
   G4Box* worldSolid;
   G4VPhysicalVolume* worldPV;
   BDSExtent worldExtent;
@@ -118,6 +137,7 @@ public:
 
   std::map<std::string, G4int> nameToElementIndex; ///< Build up a copy here too.
   std::map<G4int, G4int> linkIDToBeamlineIndex;    ///< Special linkID to linkBeamline index
+  std::vector<G4VPhysicalVolume*> newlyPlacedVolumes; ///< Placed since last optimisation.
 };
 
 #endif
@@ -23,8 +23,14 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "globals.hh" // geant4 types / globals
 
+#include <vector>
+
 /**
  * @brief Simple extension to cache extra variables through an event.
+ *
+ * When there is more than one primary in the event, the external IDs of each
+ * are kept along with the index of the primary each track descends from so
+ * returned particles can be attributed to the right external parent.
  * 
  * @author Laurie Nevay
  */
@@ -38,10 +44,49 @@ public:
   {;}
   virtual ~BDSLinkEventInfo(){;}
 
-  void Flush() override {info->Flush(); externalParticleIDofPrimary=0; externalParentIDofPrimary=0;}
+  void Flush() override
+  {
+    info->Flush();
+    externalParticleIDofPrimary = 0;
+    externalParentIDofPrimary   = 0;
+    externalParticleIDs.clear();
+    externalParentIDs.clear();
+    primaryIndexOfTrack.clear();
+  }
+
+  /// Record the external IDs of a primary in the order the vertices are made.
+  void AddPrimary(G4int externalParticleID, G4int externalParentID)
+  {
+    if (externalParticleIDs.empty())
+      {
+	externalParticleIDofPrimary = externalParticleID;
+	externalParentIDofPrimary   = externalParentID;
+      }
+    externalParticleIDs.push_back(externalParticleID);
+    externalParentIDs.push_back(externalParentID);
+  }
+
+  inline G4int NPrimaries() const {return (G4int)externalParticleIDs.size();}
+
+  /// Record which primary a new track descends from. Must be called for each track as
+  /// it is stacked (in order of track ID). Geant4 numbers primaries from 1 in the order
+  /// of the vertices.
+  void RegisterTrack(G4int trackID, G4int parentID)
+  {
+    if ((G4int)primaryIndexOfTrack.size() <= trackID)
+      {primaryIndexOfTrack.resize((size_t)trackID + 1, 0);}
+    primaryIndexOfTrack[trackID] = parentID == 0 ? trackID - 1 : PrimaryIndex(parentID);
+  }
+
+  /// Index of the primary a track descends from. 0 if not known.
+  inline G4int PrimaryIndex(G4int trackID) const
+  {return trackID < (G4int)primaryIndexOfTrack.size() ? primaryIndexOfTrack[trackID] : 0;}
 
   G4int externalParticleIDofPrimary;
   G4int externalParentIDofPrimary;
+  std::vector<G4int> externalParticleIDs;
+  std::vector<G4int> externalParentIDs;
+  std::vector<G4int> primaryIndexOfTrack;
 };
 
 #endif
@@ -0,0 +1,104 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSLINKPARTICLEBATCH_H
+#define BDSLINKPARTICLEBATCH_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief A set of particles exchanged with an external tracker in one go.
+ *
+ * Structure of arrays where index i of each vector is particle i. Units are
+ * those of the external interface: m, rad, s and GeV. xp and yp are the
+ * transverse momenta normalised to the total momentum. charge is in units
+ * of eplus and is only used for ions; if empty, ions are fully stripped.
+ * 
+ * The same batch may be reused each turn - Clear() keeps the allocated
+ * memory so there is no allocation per turn once it has grown.
+ *
+ * Everything public for simplicity of the class.
+ * 
+ * @author Laurie Nevay
+ */
+
+class BDSLinkParticleBatch
+{
+public:
+  BDSLinkParticleBatch() = default;
+  ~BDSLinkParticleBatch() = default;
+
+  /// Number of particles.
+  inline size_t Size() const {return x.size();}
+
+  /// Remove all particles but keep the memory.
+  void Clear()
+  {
+    for (auto v : {&x, &xp, &y, &yp, &T, &totalEnergy, &weight})
+      {v->clear();}
+    for (auto v : {&pdgID, &charge, &externalParticleID, &externalParentID})
+      {v->clear();}
+  }
+
+  /// Reserve space for n particles in every array.
+  void Reserve(size_t n)
+  {
+    for (auto v : {&x, &xp, &y, &yp, &T, &totalEnergy, &weight})
+      {v->reserve(n);}
+    for (auto v : {&pdgID, &charge, &externalParticleID, &externalParentID})
+      {v->reserve(n);}
+  }
+
+  /// Append one particle.
+  void Append(double xIn,  double xpIn,
+	      double yIn,  double ypIn,
+	      double TIn,  double totalEnergyIn,
+	      double weightIn,
+	      int    pdgIDIn,
+	      int    chargeIn,
+	      int    externalParticleIDIn,
+	      int    externalParentIDIn)
+  {
+    x.push_back(xIn);
+    xp.push_back(xpIn);
+    y.push_back(yIn);
+    yp.push_back(ypIn);
+    T.push_back(TIn);
+    totalEnergy.push_back(totalEnergyIn);
+    weight.push_back(weightIn);
+    pdgID.push_back(pdgIDIn);
+    charge.push_back(chargeIn);
+    externalParticleID.push_back(externalParticleIDIn);
+    externalParentID.push_back(externalParentIDIn);
+  }
+
+  std::vector<double> x;           ///< m
+  std::vector<double> xp;          ///< rad
+  std::vector<double> y;           ///< m
+  std::vector<double> yp;          ///< rad
+  std::vector<double> T;           ///< s
+  std::vector<double> totalEnergy; ///< GeV
+  std::vector<double> weight;
+  std::vector<int>    pdgID;
+  std::vector<int>    charge;      ///< Ion charge in units of eplus - optional.
+  std::vector<int>    externalParticleID;
+  std::vector<int>    externalParentID;
+};
+
+#endif
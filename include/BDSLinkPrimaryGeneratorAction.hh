@@ -25,6 +25,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 class BDSBunch;
 class BDSLinkDetectorConstruction;
+class BDSLinkEventInfo;
 class BDSOutputLoader;
 class BDSPTCOneTurnMap;
 class G4Event;
@@ -51,14 +52,26 @@ public:
 
   /// Set the world extent that particle coordinates will be checked against.
   inline void SetWorldExtent(const BDSExtent worldExtentIn) {worldExtent = worldExtentIn;}
+
+  /// Put up to primariesPerEventIn primaries in each event until nPrimaries have been
+  /// generated. 1 (the default) is one primary per event.
+  inline void SetPrimariesPerEvent(G4int primariesPerEventIn, G4int nPrimaries)
+  {primariesPerEvent = primariesPerEventIn; primariesRemaining = nPrimaries;}
+  
+private:
+  /// Make one primary vertex from the next particle in the bunch. Returns false if the
+  /// particle could not be made or is not valid.
+  G4bool GeneratePrimary(G4Event* anEvent, BDSLinkEventInfo* eventInfo);
   
-private:  
   
   BDSBunch* bunch;                ///< BDSIM particle generator. 
   int*      currentElementIndex;  ///< External integer for which element to track in.
   BDSLinkDetectorConstruction* construction; ///< Cache of detector construction for link registry of transforms.
   G4bool    debug;
   G4ParticleGun* particleGun;     ///< Geant4 particle gun that creates single particles.
+  G4bool    seedPerEvent;         ///< Seed each event from the run seed and event index.
+  G4int     primariesPerEvent;    ///< Maximum number of primaries in one event.
+  G4int     primariesRemaining;   ///< Number of primaries still to generate with several per event.
   
   /// World extent that particle coordinates are checked against to ensure they're inside it.
   BDSExtent worldExtent;
@@ -23,10 +23,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Types.hh"
 #include "G4UserRunAction.hh"
 
+class BDSLinkEventInfo;
+class BDSLinkParticleBatch;
 class G4Run;
 
 /**
  * @brief Simplified run action to hold link hits.
+ *
+ * If an output batch is set, the returned particles are written straight into
+ * it instead of copying each hit.
  * 
  * @author Laurie Nevay
  */
@@ -40,10 +45,14 @@ public:
   virtual void BeginOfRunAction(const G4Run* aRun);
   virtual void EndOfRunAction(const G4Run* aRun);
 
+  /// Append the hits of one event. The event information (may be nullptr) gives the
+  /// external IDs of the primary or primaries.
   void AppendHits(G4int currentEventIndex,
-		              G4int externalParticleID,
-		              G4int externalParentID,
-		              const BDSHitsCollectionSamplerLink* hits);
+		  const BDSLinkEventInfo* eventInfo,
+		  const BDSHitsCollectionSamplerLink* hits);
+
+  /// Set a batch (not owned) to append returned particles to. nullptr to unset.
+  inline void SetOutputBatch(BDSLinkParticleBatch* outputBatchIn) {outputBatch = outputBatchIn;}
 
   BDSHitsCollectionSamplerLink* SamplerHits() const {return allHits;}
   void ClearSamplerHits() {delete allHits; allHits = nullptr;}
@@ -58,6 +67,7 @@ private:
   G4int nSecondariesToReturn;
   G4int nPrimariesToReturn;
   G4int maximumExternalParticleID;
+  BDSLinkParticleBatch* outputBatch;
 };
 
 #endif
@@ -59,6 +59,7 @@ public:
   virtual ~BDSMagnet();
   
   inline const BDSMagnetStrength* MagnetStrength() const {return vacuumFieldInfo ? vacuumFieldInfo->MagnetStrength() : nullptr;}
+  inline const BDSFieldInfo*      VacuumFieldInfo() const {return vacuumFieldInfo;}
 
   /// @ { Delete existing field info and replace.
   void SetOuterField(BDSFieldInfo* outerFieldInfoIn);
@@ -157,6 +158,10 @@ protected:
   /// The assembled outer magnet geometry
   BDSMagnetOuter* outer;
 
+  /// Whether the outer was built for an earlier magnet with identical geometry and
+  /// outer field and is shared, so the field is already attached to its volumes.
+  G4bool outerReused;
+
   /// Used to pass the placement offset to the field so that it can be offset from the
   /// local coordinates of the solid appropriately.
   G4Transform3D beamPipePlacementTransform;
@@ -130,6 +130,10 @@ public:
 				       G4double                  containerLength, // full length to make AccComp container
 				       const BDSMagnetOuterInfo* recipe,          // geometry recipe
 				       G4bool                    vertical);       // is it a vertical kicker?
+
+  /// Override the option booleanFreeGeometry for magnets built by this factory from
+  /// now on, e.g. to compare poles built with and without an intersection.
+  inline void SetBooleanFreeGeometry(G4bool booleanFreeGeometryIn) {booleanFreeGeometry = booleanFreeGeometryIn;}
   
 protected:
   // geometry parameters
@@ -176,6 +180,8 @@ protected:
   G4double endPieceOuterR;         ///< Outer radius for end piece container.
 
   G4VSolid* poleIntersectionSolid; ///< Solid used to chop off pole
+  G4bool    poleMatchesYoke;       ///< Whether the pole was built to fit the yoke without intersection.
+  G4bool    booleanFreeGeometry;   ///< Whether to build poles to fit a circular yoke rather than intersect them.
   G4VSolid* coilLeftSolid;         ///< Left coil solid for one pole built upright along y axis.
   G4VSolid* coilRightSolid;        ///< Right coil solid.
   G4VSolid* endPieceContainerSolid;///< End piece container solid.
@@ -240,6 +246,12 @@ protected:
 				     G4double        length,
 				     G4int           order);
 
+  /// Whether the inside of the yoke is a circle of radius yokeStartRadius. If so, and
+  /// the option booleanFreeGeometry is used, the pole is built with an arc at its outer
+  /// edge so no intersection with the yoke is required. Derived classes with other yoke
+  /// shapes should return false.
+  virtual G4bool YokeInnerEdgeIsCircular() const {return true;}
+
   virtual void CreateLogicalVolumes(const G4String& name,
 				    G4Colour*       colour,
 				    G4Material*     outerMaterial);
@@ -66,6 +66,9 @@ private:
 					   G4int    order,
                                            G4double magnetContainerLength,
 					   G4double magnetContainerRadiusIn);
+
+  /// The yoke is faceted so the poles must always be intersected with it.
+  virtual G4bool YokeInnerEdgeIsCircular() const {return false;}
   
   /// Factor by which number of polyhedra vertices is multiplied by.
   G4double factor;
@@ -66,6 +66,9 @@ private:
 				     G4double        length,
 				     G4int           orderIn);
 
+  /// The yoke is square so the poles must always be intersected with it.
+  virtual G4bool YokeInnerEdgeIsCircular() const {return false;}
+
   /// Build the logical volumes from the solids assigning materials and colours and cuts.
   /// This doesn't make use of any base class implementation as this class creates a
   /// vector of unique poles that must all be built individually into logical volumes.
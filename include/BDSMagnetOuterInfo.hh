@@ -78,6 +78,11 @@ public:
   G4Colour*             colour;
   G4bool                autoColour;
 
+  /// Return a string that uniquely describes the outer geometry this information would
+  /// produce. The name is purposively not included so differently named magnets that
+  /// would be geometrically identical have the same key.
+  G4String GeometryKey() const;
+
   inline G4double MinimumIntersectionRadiusRequired() const {return std::hypot(0.5*horizontalWidth, 0.5*horizontalWidth*vhRatio);}
 };
 
@@ -55,7 +55,7 @@ class BDSTrajectoryPointHit;
 class BDSHitEnergyDepositionGlobal;
 typedef G4THitsCollection<BDSHitEnergyDepositionGlobal> BDSHitsCollectionEnergyDepositionGlobal;
 class BDSTrajectoriesToStore;
-template <class T> class G4THitsMap;
+class G4VHitsCollection;
 
 class G4PrimaryVertex;
 
@@ -139,7 +139,7 @@ public:
                  const BDSTrajectoriesToStore*                  trajectories,
                  const BDSHitsCollectionCollimator*             collimatorHits,
                  const BDSHitsCollectionApertureImpacts*        apertureImpactHits,
-                 const std::map<G4String, G4THitsMap<G4double>*>& scorerHitsMap,
+                 const std::map<G4String, G4VHitsCollection*>&  scorerHitsMap,
                  const G4int                                    turnsTaken);
 
   /// Close a file and open a new one.
@@ -266,15 +266,16 @@ private:
   /// Fill aperture impact hits.
   void FillApertureImpacts(const BDSHitsCollectionApertureImpacts* hits);
 
-  /// Fill a map of scorer hits into the output.
-  void FillScorerHits(const std::map<G4String, G4THitsMap<G4double>*>& scorerHitsMap);
+  /// Fill a map of scorer hits into the output. Each collection may be either a
+  /// G4THitsMap<G4double> or a BDSScorerBufferCollection.
+  void FillScorerHits(const std::map<G4String, G4VHitsCollection*>& scorerHitsMap);
 
   /// Fill an individual scorer hits map into a particular output histogram.
   void FillScorerHitsIndividual(const G4String& hsitogramDefName,
-                                const G4THitsMap<G4double>* hitMap);
+                                const G4VHitsCollection* hitMap);
 
   void FillScorerHitsIndividualBLM(const G4String& histogramDefName,
-                                   const G4THitsMap<G4double>* hitMap);
+                                   const G4VHitsCollection* hitMap);
 
   /// Fill run level summary information. This also updates the header information for
   /// writing at the end of a file.
@@ -25,8 +25,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Types.hh"
 
 class BDSHistBinMapper;
+class BDSScorerBuffer;
+class G4HCofThisEvent;
+class G4Step;
+class G4TouchableHistory;
 
 /** @brief Primitive scorer for cell flux in a 4D mesh.
+ *
+ * The hits map of G4PSCellFlux is replaced by a BDSScorerBuffer that is reused
+ * for every event as a 4D mesh has many more cells than are typically hit.
  *
  * @author Eliott Ramoisiaux
  */
@@ -45,12 +52,26 @@ public:
 		  G4int ni = 1, G4int nj = 1, G4int nk = 1,
 		  G4int depi = 2, G4int depj = 1, G4int depk = 0);
   
-  virtual ~BDSPSCellFlux4D() override {;}
+  virtual ~BDSPSCellFlux4D() override;
+
+  virtual void Initialize(G4HCofThisEvent* HCE) override;
+  virtual void EndOfEvent(G4HCofThisEvent*) override {;}
+  virtual void clear() override;
+  virtual void PrintAll() override;
+
+  /// Whether to multiply the flux by the track weight (default true as in G4PSCellFlux).
+  /// G4PSCellFlux::Weighted() sets a private flag that isn't used by this scorer.
+  void SetWeighted(G4bool flag) {weighted = flag;}
   
 protected:
+  virtual G4bool ProcessHits(G4Step* aStep, G4TouchableHistory*) override;
   G4int GetIndex(G4Step* aStep) override;
   
 private:
+  G4int            HCID;     ///< Collection ID.
+  BDSScorerBuffer* buffer;   ///< Values for the current event.
+  G4bool           weighted; ///< Whether to multiply by the track weight.
+
   G4int fDepthi;
   G4int fDepthj;
   G4int fDepthk;
@@ -20,10 +20,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSPSCELLFLUXSCALED3D_H
 
 #include "globals.hh"
-#include "G4THitsMap.hh"
 #include "G4VPrimitiveScorer.hh"
 
+#include <map>
+
 class BDSHistBinMapper;
+class BDSScorerBuffer;
 class G4PhysicsVector;
 
 /**
@@ -34,7 +36,8 @@ class G4PhysicsVector;
  * default is none and just a factor of 1.
  *
  * The implementation also differs from G4PSCellFlux3D as we cache the volume
- * to avoid repeated calculation.
+ * to avoid repeated calculation, and the values are kept in a BDSScorerBuffer that
+ * is reused for every event rather than a new G4THitsMap.
  * 
  * @author Robin Tesse
  */
@@ -75,8 +78,8 @@ private:
   /// Define units -> taken from G4PSCellFlux
   void DefineUnitAndCategory() const;
 
-  G4int                 HCID3D;   ///< Collection ID.
-  G4THitsMap<G4double>* evtMap3D; ///< Hits map.
+  G4int            HCID3D; ///< Collection ID.
+  BDSScorerBuffer* buffer; ///< Values for the current event.
   
   /// @{ Depth in replica to look for each dimension.
   G4int fDepthi;
@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh" // Geant4 typedefs
 #include "G4Track.hh"
 
+#include <array>
 #include <vector>
 #include <set>
 
@@ -34,6 +35,12 @@ class BDSParticleDefinition;
  *
  * This class uses PTC units internally for calculating the result of the map.
  *
+ * The terms of the maptable are compiled at load time into one list of unique
+ * monomials, each with a coefficient for each of the five outputs. The monomials
+ * are sorted so that consecutive ones share the products of their leading powers,
+ * which are taken from power tables built once per evaluation. All five outputs
+ * are therefore calculated in a single pass without any calls to std::pow.
+ *
  * @author Stuart Walker.
  */
 
@@ -79,13 +86,24 @@ public:
 		   G4double& pz,
 		   G4int turnstaken);
 
+  /// PTC coordinates x, px, y, py, deltaP of one particle.
+  typedef std::array<G4double, 5> PTCCoordinates;
+
+  /// Apply one turn of the map to the coordinates of one particle. In and out
+  /// may be the same object.
+  void Evaluate(const PTCCoordinates& in,
+		PTCCoordinates&       out);
+
+  /// Number of unique monomials in the compiled map.
+  std::size_t NMonomials() const {return monomialPowers.size();}
+
 private:
-  G4double Evaluate(std::vector<PTCMapTerm>& terms,
-		    G4double x,
-		    G4double px,
-            G4double y,
-		    G4double py,
-		    G4double deltaP) const;
+  /// Merge a term read from the maptable into the compiled map.
+  void AddTerm(const PTCMapTerm& term,
+	       G4int             outputIndex);
+
+  /// Sort the monomials, work out the shared prefixes and size the power tables.
+  void CompileMap();
 
   G4double initialPrimaryMomentum;
   G4bool   beamOffsetS0;
@@ -101,11 +119,21 @@ private:
   G4double pyLastTurn;
   G4double deltaPLastTurn;
 
-  std::vector<PTCMapTerm> xTerms;
-  std::vector<PTCMapTerm> yTerms;
-  std::vector<PTCMapTerm> pxTerms;
-  std::vector<PTCMapTerm> pyTerms;
-  std::vector<PTCMapTerm> deltaPTerms;
+  /// Powers of x, px, y, py, deltaP for each unique monomial.
+  std::vector<std::array<G4int, 5> > monomialPowers;
+
+  /// Coefficient of each monomial for each output - 5 per monomial.
+  std::vector<G4double> monomialCoefficients;
+
+  /// Index of the first variable whose power differs from the previous monomial.
+  /// The product of the powers of the variables before this is reused.
+  std::vector<G4int> firstNewVariable;
+
+  /// Offset of each variable's power table in powerTable.
+  std::array<G4int, 5> powerTableOffset;
+
+  /// Scratch storage for x^0..x^n, px^0..px^n, etc.
+  std::vector<G4double> powerTable;
 };
 
 #endif
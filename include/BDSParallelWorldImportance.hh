@@ -27,6 +27,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4VUserParallelWorld.hh"
 
 #include <map>
+#include <set>
+#include <vector>
 
 class G4UserLimits;
 class G4VisAttributes;
@@ -41,6 +43,11 @@ namespace GMAD {
 /**
  * @brief Class that constructs a parallel importance world
  *
+ * The cells of this world are used either with an importance store (geometric
+ * splitting and Russian roulette) or with a weight window store. In the latter
+ * case the lower weight bound of a cell in each energy window is the inverse of
+ * the importance value given for that window.
+ *
  * @author Will Shields
  */
 
@@ -68,6 +75,9 @@ public:
   /// Create IStore for all importance sampling geometry cells.
   void AddIStore();
 
+  /// Create weight window store for all importance sampling geometry cells.
+  void AddWeightWindowStore();
+
   virtual void ConstructSD();
 
   /// World volume getter required in parallel world utilities.
@@ -91,7 +101,11 @@ private:
   BDSImportanceVolumeStore imVolumeStore;
 
   /// Container for all user placed physical volumes and corresponding importance values.
-  std::map<G4String, G4double> imVolumesAndValues;
+  /// There is one value per energy window, or one value for all energy windows.
+  std::map<G4String, std::vector<G4double> > imVolumesAndValues;
+
+  /// Upper kinetic energy bound of each weight window. The last is always DBL_MAX.
+  std::set<G4double> weightWindowUpperEnergyBounds;
 
   G4String imGeomFile;
   G4String imVolMap;
@@ -103,8 +117,11 @@ private:
   G4VisAttributes* visAttr;
   ///@}
 
-  /// Get importance value of a given physical volume name.
-  G4double GetCellImportanceValue(const G4String& cellName);
+  /// Get importance values of a given physical volume name.
+  std::vector<G4double> GetCellImportanceValues(const G4String& cellName);
+
+  /// Print the cells and their importance values if verbose.
+  void PrintCells() const;
 };
 
 #endif
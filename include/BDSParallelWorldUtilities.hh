@@ -53,10 +53,12 @@ namespace BDS
   void RegisterSamplerPhysics(const std::vector<G4ParallelWorldPhysics*>& processes,
 			      G4VModularPhysicsList* physicsList);
 
-  /// Get store, and prepare importance sampling for importance geometry sampler
+  /// Get store, and prepare importance sampling for importance geometry sampler. This
+  /// is a weight window store if weight windows are used.
   void AddIStore(const std::vector<G4VUserParallelWorld*>& worlds);
 
-  /// Create importance geometry sampler and register importance biasing with physics list
+  /// Create an importance geometry sampler for each particle in the option importanceParticles
+  /// and register importance or weight window biasing with physics list.
   void RegisterImportanceBiasing(const std::vector<G4VUserParallelWorld*>& worlds,
                                  G4VModularPhysicsList* physicsList);
 
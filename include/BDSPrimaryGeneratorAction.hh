@@ -20,12 +20,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #define BDSPRIMARYGENERATORACTION_H
 
 #include "BDSExtent.hh"
+#include "BDSFastTracker.hh"
 
 #include "globals.hh"
 #include "G4VUserPrimaryGeneratorAction.hh"
 
 class BDSBunch;
 class BDSOutputLoader;
+class BDSParticleCoords;
+class BDSParticleCoordsFullGlobal;
 class BDSPrimaryGeneratorFile;
 class BDSPTCOneTurnMap;
 class G4Event;
@@ -63,6 +66,10 @@ public:
 private:
   /// For a file-based event generator there are a few checks we have to do - put in a function to keep tidy.
   void GeneratePrimariesFromFile(G4Event* anEvent);
+
+  /// Transport the primary analytically through the linear elements at the start of the
+  /// beam line and return the global coordinates Geant4 should start tracking it from.
+  BDSParticleCoords FastTrack(const BDSParticleCoordsFullGlobal& coords);
   
   G4ParticleGun* particleGun;     ///< Geant4 particle gun that creates single particles.
   BDSBunch* bunch;                ///< BDSIM particle generator.
@@ -71,6 +78,7 @@ private:
   G4bool   recreate;              ///< Whether to load seed state at start of event from rootevent file.
   G4int    eventOffset;           ///< The offset in the file to read events from when setting the seed.
   G4bool   useASCIISeedState;     ///< Whether to use the ascii seed state each time.
+  G4bool   seedPerEvent;          ///< Seed each event from the run seed and event index.
   G4bool   ionPrimary;            ///< The primary particle will be an ion.
   G4bool   distrFileMatchLength;  ///< Match external file length for event generator.
   
@@ -85,6 +93,10 @@ private:
   BDSPTCOneTurnMap* oneTurnMap;
 
   BDSPrimaryGeneratorFile* generatorFromFile;
+
+  G4bool                 fastTrackPrimaries; ///< Cache of option.
+  BDSFastTracker*        fastTracker;        ///< Constructed on first use once the beam line exists.
+  BDSFastTracker::Batch  fastTrackBatch;     ///< Reused batch of one primary.
 };
 
 #endif
@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSPRIMARYVERTEXINFORMATION_H
 #define BDSPRIMARYVERTEXINFORMATION_H
 
+#include "BDSEventArena.hh"
 #include "BDSParticleCoordsFullGlobal.hh"
 
 #include "globals.hh"
@@ -51,6 +52,11 @@ public:
 			      G4int    nElectronsIn = 0);
   virtual ~BDSPrimaryVertexInformation(){;}
 
+  /// @{ Use the event arena if active as this only lives as long as the event.
+  inline void* operator new(size_t size) {return BDSEventArena::New(size);}
+  inline void  operator delete(void* p)  {BDSEventArena::Delete(p);}
+  /// @}
+
   /// Required implementation by virtual base class.
   virtual void Print() const;
 
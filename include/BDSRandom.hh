@@ -22,6 +22,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSTypeSafeEnum.hh"
 
 #include "G4String.hh"
+#include "G4Types.hh"
 
 #include <sstream>
 
@@ -60,7 +61,17 @@ namespace BDSRandom
   /// Load a seedstate.txt file and restore the engine to this status.
   void LoadSeedState(const G4String& inSeedFilename);
 
-  /// Set the seed state from a string.
+  /// Seed the engine for one event from the run seed, the Geant4 run ID and the
+  /// event ID. Uses independent MixMax streams if available, otherwise a hash of
+  /// the three numbers. Events can then be generated in any order.
+  void SetSeedForEvent(G4int runID, G4int eventID);
+
+  /// Compact string of the numbers used by SetSeedForEvent that SetSeedState
+  /// recognises, used instead of the full engine state.
+  G4String EventSeedState(G4int runID, G4int eventID);
+
+  /// Set the seed state from a string. This may be a full engine state or
+  /// the compact form from EventSeedState.
   void SetSeedState(const G4String& seedState);
   void SetSeedState(std::stringstream& seedState);
 }
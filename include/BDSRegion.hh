@@ -47,7 +47,10 @@ public:
 	    G4double rangeCutElectronsIn,
 	    G4double rangeCutPositronsIn,
 	    G4double rangeCutProtonsIn,
-	    G4double rangeCutPhotonsIn);
+	    G4double rangeCutPhotonsIn,
+	    G4double minimumKineticEnergyIn  = 0,
+	    G4double rouletteKineticEnergyIn = 0,
+	    G4double rouletteProbabilityIn   = 0);
   BDSRegion(const GMAD::Region& parserRegion,
 	    const BDSRegion*    defaultRegion);
 	    
@@ -60,6 +63,9 @@ public:
   G4double rangeCutPositrons;
   G4double rangeCutProtons;
   G4double rangeCutPhotons;
+  G4double minimumKineticEnergy;  ///< Applied to new tracks at stacking time. 0 for global default.
+  G4double rouletteKineticEnergy; ///< 0 for global default.
+  G4double rouletteProbability;   ///< 0 for global default.
   G4ProductionCuts* g4cuts;
   G4Region*         g4region;
   /// @}
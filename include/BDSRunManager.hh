@@ -48,11 +48,27 @@ public:
   /// For additional output.
   virtual void ProcessOneEvent(G4int i_event);
 
+  /// Run G4RunManager::TerminateOneEvent() which deletes the event (and therefore all its
+  /// hits and trajectories) and then reset the event arena if it's in use.
+  virtual void TerminateOneEvent();
+
   /// Run G4RunManager:AbortRun(), but give some print out feedback for the user.
   virtual void AbortRun(G4bool);
 
 protected:
   BDSExceptionHandler* exceptionHandler;
+
+private:
+  /// As G4RunManager::UpdateScoring() but only hits collections that are hits maps are
+  /// accumulated by the Geant4 scoring manager. G4ScoringManager::Accumulate() casts
+  /// every collection of a mesh to a G4THitsMap whereas BDSIM scorers that use a
+  /// BDSScorerBuffer register a BDSScorerBufferCollection. These are written to the
+  /// output by BDSIM in any case. BDSIM does not use the Geant4 score ntuple writer.
+  void UpdateScoringMeshes();
+
+  /// Whether any event has been kept by Geant4 (e.g. for visualisation) in which case
+  /// we cannot reset the event arena.
+  G4bool eventsKept;
 };
 #endif
 
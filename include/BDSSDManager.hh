@@ -36,6 +36,7 @@ class BDSSDEnergyDeposition;
 class BDSSDEnergyDepositionGlobal;
 class BDSLinkRegistry;
 class BDSMultiSensitiveDetectorOrdered;
+class BDSScoringMeshAnalytic;
 class BDSSDFilterPDGIDSet;
 class BDSSDSampler;
 class BDSSDSamplerCylinder;
@@ -163,6 +164,13 @@ public:
   /// Access the map of units for primitive scorers.
   inline const std::map<G4String, G4double>& PrimitiveScorerUnits() const {return primitiveScorerNameToUnit;}
 
+  /// Register an analytic scoring mesh with the G4SDManager (which owns it) and keep it
+  /// so every step can be given to it. Its scorers must be registered first.
+  void RegisterAnalyticScoringMesh(BDSScoringMeshAnalytic* mesh);
+
+  /// Access all analytic scoring meshes.
+  inline const std::vector<BDSScoringMeshAnalytic*>& AnalyticScoringMeshes() const {return analyticScoringMeshes;}
+
   /// If samplerLink member exists, set the registry to look up links for that SD.
   void SetLinkRegistry(BDSLinkRegistry* registry);
   inline void SetLinkMinimumEK(G4double minimumEKIn) {samplerLink->SetMinimumEK(minimumEKIn);}
@@ -232,6 +240,9 @@ private:
 
   /// Map of primitive scorer names to units.
   std::map<G4String, G4double> primitiveScorerNameToUnit;
+
+  /// Analytic scoring meshes that are given each step by the stepping action.
+  std::vector<BDSScoringMeshAnalytic*> analyticScoringMeshes;
   
   std::map<G4int, BDSSDSampler*> extraSamplersWithFilters;
   std::map<G4int, BDSSDSamplerCylinder*> extraSamplerCylindersWithFilters;
@@ -0,0 +1,124 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSSCORERBUFFER_H
+#define BDSSCORERBUFFER_H
+
+#include "globals.hh"
+#include "G4VHitsCollection.hh"
+
+#include <vector>
+
+/**
+ * @brief Values of a scorer for one event by global cell index, reused between events.
+ *
+ * The cells are kept in pages that are allocated the first time a cell in them is
+ * used and then kept for the rest of the run, so a mesh with many cells only needs
+ * memory for the regions that are hit and there is no allocation per hit or per event.
+ * The indices of the cells used in the event are recorded so that only those are read
+ * out and reset by Clear().
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSScorerBuffer
+{
+public:
+  explicit BDSScorerBuffer(G4int nCellsIn);
+  ~BDSScorerBuffer();
+
+  /// Add a value to a cell. Indices outside the buffer are ignored.
+  inline void Add(G4int index, G4double value)
+  {
+    if (index < 0 || index >= nCells)
+      {return;}
+    Page*& page = pages[index >> pageShift];
+    if (!page)
+      {page = new Page();}
+    G4int i = index & pageMask;
+    if (!page->used[i])
+      {
+        page->used[i] = true;
+        touched.push_back(index);
+      }
+    page->values[i] += value;
+  }
+
+  /// Value of a cell used in this event.
+  inline G4double Value(G4int index) const {return pages[index >> pageShift]->values[index & pageMask];}
+
+  /// Indices of the cells used in this event in the order they were first used.
+  inline const std::vector<G4int>& Touched() const {return touched;}
+
+  /// Reset only the cells used since the last call.
+  void Clear();
+
+  /// Number of cells in total.
+  inline G4int NCells() const {return nCells;}
+
+private:
+  BDSScorerBuffer() = delete;
+  BDSScorerBuffer(const BDSScorerBuffer&) = delete;
+  BDSScorerBuffer& operator=(const BDSScorerBuffer&) = delete;
+
+  static const G4int pageShift = 12;
+  static const G4int pageSize  = 1 << pageShift;
+  static const G4int pageMask  = pageSize - 1;
+
+  struct Page
+  {
+    Page();
+    G4double values[pageSize];
+    G4bool   used[pageSize];
+  };
+
+  G4int              nCells;
+  std::vector<Page*> pages;
+  std::vector<G4int> touched;
+};
+
+/**
+ * @brief Hits collection for one event that refers to a scorer buffer.
+ *
+ * The Geant4 event owns and deletes its hits collections, so this small object is
+ * made each event while the buffer it refers to belongs to the scorer.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSScorerBufferCollection: public G4VHitsCollection
+{
+public:
+  BDSScorerBufferCollection(const G4String&        detectorName,
+                            const G4String&        collectionName,
+                            const BDSScorerBuffer* bufferIn):
+    G4VHitsCollection(detectorName, collectionName),
+    buffer(bufferIn)
+  {;}
+  virtual ~BDSScorerBufferCollection(){;}
+
+  /// Number of cells used in this event.
+  virtual std::size_t GetSize() const {return buffer->Touched().size();}
+
+  inline const BDSScorerBuffer* Buffer() const {return buffer;}
+
+private:
+  const BDSScorerBuffer* buffer; ///< We don't own this.
+};
+
+#endif
@@ -0,0 +1,146 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BDSSCORINGMESHANALYTIC_H
+#define BDSSCORINGMESHANALYTIC_H
+
+#include "BDSScorerType.hh"
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4Transform3D.hh"
+#include "G4VSensitiveDetector.hh"
+
+#include <map>
+#include <set>
+#include <vector>
+
+class BDSHistBinMapper;
+class BDSPSCellFluxScaled3D;
+class BDSScorerBuffer;
+class BDSScorerMeshInfo;
+class G4HCofThisEvent;
+class G4Step;
+class G4TouchableHistory;
+class G4VPrimitiveScorer;
+
+/**
+ * @brief Scoring mesh without geometry that walks each step through the voxels.
+ *
+ * Rather than a parallel world of replicated volumes, which limits every step at
+ * each cell boundary, the pre and post step points of every step in the mass world
+ * are transformed into the local frame of the mesh and the chord between them is
+ * walked through the cells it crosses. The step length is shared between the cells in
+ * proportion to the length of the chord in each for the flux and the track is counted
+ * once in each for the population. The energy deposit isn't spread along the step, as
+ * most of it happens at discrete points, and is scored in the cell of the pre-step point
+ * (or post-step point for a step entering the mesh) as a Geant4 mesh would. The cell
+ * indices and volumes are the same as for BDSScoringMeshBox and BDSScoringMeshCylinder
+ * so the same histograms are produced.
+ *
+ * Only quantities that are integrals along the step are supported. The primitive
+ * scorers from BDSScorerFactory are used for their name, unit, filter and any
+ * conversion factor and are owned by this class. The values are kept in a BDSScorerBuffer
+ * per quantity that is reused for every event and is registered each event with
+ * the name "meshname/scorername" as for a Geant4 scoring mesh. ScoreStep() must be
+ * called for each step, which is done by BDSSteppingAction.
+ *
+ * @author Laurie Nevay
+ */
+
+class BDSScoringMeshAnalytic: public G4VSensitiveDetector
+{
+public:
+  BDSScoringMeshAnalytic(const G4String&          name,
+                         const BDSScorerMeshInfo& recipe,
+                         const G4Transform3D&     placementTransform);
+  virtual ~BDSScoringMeshAnalytic();
+
+  /// Add a quantity to score. This must be done before this sensitive detector is
+  /// registered with the G4SDManager. Throws an exception if the type is not supported.
+  void RegisterScorer(BDSScorerType scorerType,
+                      G4VPrimitiveScorer* scorer);
+
+  /// Reset the buffer of each quantity and register it with the event.
+  virtual void Initialize(G4HCofThisEvent* HCE);
+
+  /// Not attached to any volume so nothing to do here.
+  virtual G4bool ProcessHits(G4Step*, G4TouchableHistory*) {return false;}
+
+  /// Add the step to each quantity in the cells it crosses or deposits energy in.
+  void ScoreStep(const G4Step* step);
+
+  const BDSHistBinMapper* Mapper() const {return mapper;}
+
+private:
+  /// No default constructor.
+  BDSScoringMeshAnalytic() = delete;
+
+  /// One section of the chord of a step inside a cell.
+  struct Segment
+  {
+    G4int    i;        ///< Index in first dimension.
+    G4int    j;        ///< Index in second dimension.
+    G4int    k;        ///< Index in third dimension.
+    G4double fraction; ///< Fraction of the chord in this cell.
+    G4double volume;   ///< Volume of the cell.
+  };
+
+  /// One quantity scored in the mesh.
+  struct Quantity
+  {
+    BDSScorerType          scorerType;
+    G4VPrimitiveScorer*    scorer;
+    BDSPSCellFluxScaled3D* scaled;    ///< Same as scorer if it has conversion factors.
+    G4int                  HCID;
+    BDSScorerBuffer*       hits;
+    std::set<std::pair<G4int, G4int> > cellTracks; ///< Cell and track ID pairs counted for population.
+  };
+
+  /// Fill segments with the cells crossed by the straight line from a to b in local
+  /// coordinates of a box mesh using a 3D DDA walk.
+  void WalkBox(const G4ThreeVector& a, const G4ThreeVector& b);
+
+  /// Fill segments with the cells crossed by the straight line from a to b in local
+  /// coordinates of a cylindrical mesh. The crossings of the z planes, radial cylinders
+  /// and phi half planes are found and each interval between them is assigned a cell
+  /// from its midpoint.
+  void WalkCylinder(const G4ThreeVector& a, const G4ThreeVector& b);
+
+  /// Fill cell with the cell containing the point p in local coordinates. Returns false
+  /// if p is outside the mesh.
+  G4bool PointCell(const G4ThreeVector& p, Segment& cell) const;
+
+  /// Index of a coordinate in a uniform axis from low with width and n bins, clamped.
+  static G4int Bin(G4double value, G4double low, G4double width, G4int n);
+
+  G4bool                cylindrical;
+  HepGeom::Transform3D  globalToLocal;
+  G4int                 nSegment[3];
+  G4double              halfSize[3];   ///< x,y,z or r,-,z half size.
+  G4double              cellWidth[3];  ///< x,y,z or z,phi,r cell width.
+  G4double              boxCellVolume;
+  std::vector<G4double> cylinderCellVolume; ///< Cell volume by radial index.
+  BDSHistBinMapper*     mapper;
+
+  std::vector<Quantity> quantities;
+  std::vector<Segment>  segments; ///< Cache to avoid reallocation each step.
+  std::vector<G4double> crossings; ///< Cache to avoid reallocation each step.
+};
+
+#endif
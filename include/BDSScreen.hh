@@ -57,6 +57,8 @@ private:
   std::list<G4String> layerMaterials;
   
   virtual void Build();
+  /// The screen is placed inside the beam pipe so it must be unique.
+  virtual G4bool BeamPipeMayBeShared() const {return false;}
   void PlaceScreen();
   G4ThreeVector screenPos;
   G4RotationMatrix* screenRot;
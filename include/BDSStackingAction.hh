@@ -24,12 +24,23 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4UserStackingAction.hh"
 
 #include <set>
+#include <vector>
 
 class BDSGlobalConstants;
+class G4ParticleDefinition;
+class G4Region;
 class G4Track;
 
 /**
  * @brief BDSIM's Geant4 stacking action.
+ *
+ * The classification of each new track is done with a flat look up table per
+ * region indexed by the particle definition ID. These are built at the start of
+ * the first event (once all regions exist) from the options and any region specific
+ * settings. Each entry is a kinetic energy below which the particle is killed (0
+ * for never, DBL_MAX for always) and a kinetic energy below which secondaries are
+ * subject to Russian roulette. Ions created on the fly are added to the tables as
+ * they are encountered.
  */
 
 class BDSStackingAction: public G4UserStackingAction
@@ -39,11 +50,12 @@ public:
   virtual ~BDSStackingAction();
 
   /// Decide whether to kill tracks if they're neutrinos or we're killing all secondaries. Note
-  /// the event won't conserve energy with the stopSecondaries on.
+  /// the event won't conserve energy with the stopSecondaries on. Secondaries below the roulette
+  /// threshold survive with a given probability and have their weight increased accordingly.
   virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* aTrack);
   
   virtual void NewStage(); ///< We don't do anything here.
-  virtual void PrepareNewEvent(); ///< We don't do anything here.
+  virtual void PrepareNewEvent(); ///< Build classification tables if not done already.
 
   static G4double energyKilled;
 
@@ -51,12 +63,37 @@ private:
   /// Force use of supplied constructor.
   BDSStackingAction() = delete;
 
+  /// Classification settings for one region with per particle look up.
+  struct ClassificationTable
+  {
+    G4double minimumEK;           ///< Minimum kinetic energy for this region.
+    G4double rouletteEK;          ///< Secondaries below this are subject to roulette.
+    G4double rouletteProbability; ///< Survival probability for roulette.
+    std::vector<G4double> killEKs;     ///< Per particle ID kill threshold, -1 for not computed yet.
+    std::vector<G4double> rouletteEKs; ///< Per particle ID roulette threshold.
+  };
+
+  /// Build a table for each region and the default one.
+  void BuildTables();
+
+  /// Compute the entries for one particle in one table. Will extend the table if required.
+  void FillEntry(ClassificationTable& table, const G4ParticleDefinition* particle) const;
+
+  /// Get the table for the region the track is in.
+  inline ClassificationTable& TableForTrack(const G4Track* aTrack);
+
   G4bool killNeutrinos;     ///< Local copy of whether to kill neutrinos for tracking efficiency.
   G4bool stopSecondaries;   ///< Whether particles with parentID > 0 will be killed.
   G4long maxTracksPerEvent; ///< Maximum number of tracks before start killing.
   G4double minimumEK;
+  G4double rouletteEK;
+  G4double rouletteProbability;
   std::set<G4int> particlesToExcludeFromCuts;
- };
 
-#endif
+  G4bool tablesBuilt;
+  ClassificationTable defaultTable;
+  std::vector<ClassificationTable*> regionTables;  ///< Indexed by G4Region instance ID, nullptr for default.
+  std::vector<ClassificationTable*> tableStorage;  ///< Owned tables for regions.
+};
 
+#endif
@@ -22,8 +22,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4UserSteppingAction.hh"
 #include "G4Types.hh"
 
+#include <vector>
+
+class BDSScoringMeshAnalytic;
+
 /**
- * @brief Provide extra output for Geant4 through a verbose stepping action.
+ * @brief Provide extra output for Geant4 through a verbose stepping action and
+ * give each step to any analytic scoring meshes.
  */
 
 class BDSSteppingAction: public G4UserSteppingAction
@@ -35,8 +40,8 @@ public:
 		    G4int  verboseEventStopIn);
   virtual ~BDSSteppingAction();
 
-  /// If this event is verbose, then print out verbose stepping information
-  /// for this step.
+  /// Score the step in any analytic scoring meshes. If this event is verbose,
+  /// then print out verbose stepping information for this step.
   virtual void UserSteppingAction(const G4Step* step);
 
 private:
@@ -46,6 +51,10 @@ private:
   const G4bool verboseStep;
   const G4bool verboseEventStart;
   const G4bool verboseEventStop;
+
+  /// Analytic scoring meshes from BDSSDManager. These are only constructed with the
+  /// sensitive detectors so we keep a reference to the vector.
+  const std::vector<BDSScoringMeshAnalytic*>& analyticScoringMeshes;
 };
 
 #endif
@@ -18,6 +18,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSTRAJECTORY_H
 #define BDSTRAJECTORY_H
+#include "BDSEventArena.hh"
 #include "BDSTrajectoryOptions.hh"
 #include "BDSTrajectoryPoint.hh"
 #include "G4Trajectory.hh"
@@ -30,7 +31,8 @@ class G4Track;
 class G4TrajectoryContainer;
 class G4VTrajectoryPoint;
 
-typedef std::vector<BDSTrajectoryPoint*>  BDSTrajectoryPointsContainer;
+/// Storage of points uses the event arena when it is active.
+typedef std::vector<BDSTrajectoryPoint*, BDS::EventArenaAllocator<BDSTrajectoryPoint*> > BDSTrajectoryPointsContainer;
 
 /**
  * @brief Trajectory information from track including last scatter etc.
@@ -138,12 +140,12 @@ extern G4Allocator<BDSTrajectory> bdsTrajectoryAllocator;
 inline void* BDSTrajectory::operator new(size_t)
 {
   void* aTrajectory;
-  aTrajectory = (void*)bdsTrajectoryAllocator.MallocSingle();
+  aTrajectory = BDS::EventAllocate(bdsTrajectoryAllocator);
   return aTrajectory;
 }
 
 inline void BDSTrajectory::operator delete(void* aTrajectory)
-{bdsTrajectoryAllocator.FreeSingle((BDSTrajectory*)aTrajectory);}
+{BDS::EventFree(bdsTrajectoryAllocator, aTrajectory);}
 
 
 #endif
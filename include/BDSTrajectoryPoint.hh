@@ -18,6 +18,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSTRAJECTORYPOINT_H
 #define BDSTRAJECTORYPOINT_H
+#include "BDSEventArena.hh"
 #include "BDSTrajectoryPointIon.hh"
 #include "BDSTrajectoryPointLocal.hh"
 #include "BDSTrajectoryPointLink.hh"
@@ -206,13 +207,13 @@ extern G4Allocator<BDSTrajectoryPoint> bdsTrajectoryPointAllocator;
 inline void* BDSTrajectoryPoint::operator new(size_t)
 {
   void *aTrajectoryPoint;
-  aTrajectoryPoint = (void *) bdsTrajectoryPointAllocator.MallocSingle();
+  aTrajectoryPoint = BDS::EventAllocate(bdsTrajectoryPointAllocator);
   return aTrajectoryPoint;
 }
 
 inline void BDSTrajectoryPoint::operator delete(void *aTrajectoryPoint)
 {
-  bdsTrajectoryPointAllocator.FreeSingle((BDSTrajectoryPoint *) aTrajectoryPoint);
+  BDS::EventFree(bdsTrajectoryPointAllocator, aTrajectoryPoint);
 }
 
 inline G4bool BDSTrajectoryPoint::operator< (const BDSTrajectoryPoint& other) const
@@ -18,6 +18,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSTRAJECTORYPOINTION_H
 #define BDSTRAJECTORYPOINTION_H
+#include "BDSEventArena.hh"
+
 #include "globals.hh"
 #include "G4Allocator.hh"
 
@@ -58,13 +60,13 @@ extern G4Allocator<BDSTrajectoryPointIon> BDSAllocatorTrajectoryPointIon;
 inline void* BDSTrajectoryPointIon::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorTrajectoryPointIon.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorTrajectoryPointIon);
   return aHit;
 }
 
 inline void BDSTrajectoryPointIon::operator delete(void *aHit)
 {
- BDSAllocatorTrajectoryPointIon.FreeSingle((BDSTrajectoryPointIon*) aHit);
+ BDS::EventFree(BDSAllocatorTrajectoryPointIon, aHit);
 }
 
 #endif
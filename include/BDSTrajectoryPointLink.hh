@@ -18,6 +18,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSTRAJECTORYPOINTLINK_H
 #define BDSTRAJECTORYPOINTLINK_H
+#include "BDSEventArena.hh"
+
 #include "globals.hh"
 #include "G4Allocator.hh"
 
@@ -58,13 +60,13 @@ extern G4Allocator<BDSTrajectoryPointLink> BDSAllocatorTrajectoryPointLink;
 inline void* BDSTrajectoryPointLink::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorTrajectoryPointLink.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorTrajectoryPointLink);
   return aHit;
 }
 
 inline void BDSTrajectoryPointLink::operator delete(void *aHit)
 {
-  BDSAllocatorTrajectoryPointLink.FreeSingle((BDSTrajectoryPointLink*) aHit);
+  BDS::EventFree(BDSAllocatorTrajectoryPointLink, aHit);
 }
 
 #endif
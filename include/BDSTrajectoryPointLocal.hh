@@ -18,6 +18,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #ifndef BDSTRAJECTORYPOINTLOCAL_H
 #define BDSTRAJECTORYPOINTLOCAL_H
+#include "BDSEventArena.hh"
+
 #include "G4Allocator.hh"
 #include "G4ThreeVector.hh"
 
@@ -54,13 +56,13 @@ extern G4Allocator<BDSTrajectoryPointLocal> BDSAllocatorTrajectoryPointLocal;
 inline void* BDSTrajectoryPointLocal::operator new(size_t)
 {
   void* aHit;
-  aHit=(void*) BDSAllocatorTrajectoryPointLocal.MallocSingle();
+  aHit=BDS::EventAllocate(BDSAllocatorTrajectoryPointLocal);
   return aHit;
 }
 
 inline void BDSTrajectoryPointLocal::operator delete(void *aHit)
 {
-  BDSAllocatorTrajectoryPointLocal.FreeSingle((BDSTrajectoryPointLocal*) aHit);
+  BDS::EventFree(BDSAllocatorTrajectoryPointLocal, aHit);
 }
 
 #endif
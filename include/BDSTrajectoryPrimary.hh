@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef BDSTRAJECTORYPRIMARY_H
 #define BDSTRAJECTORYPRIMARY_H
 
+#include "BDSEventArena.hh"
 #include "BDSTrajectory.hh"
 
 #include "G4Allocator.hh"
@@ -105,11 +106,11 @@ extern G4Allocator<BDSTrajectoryPrimary> bdsTrajectoryPrimaryAllocator;
 inline void* BDSTrajectoryPrimary::operator new(size_t)
 {
   void* aTrajectory;
-  aTrajectory = (void*)bdsTrajectoryPrimaryAllocator.MallocSingle();
+  aTrajectory = BDS::EventAllocate(bdsTrajectoryPrimaryAllocator);
   return aTrajectory;
 }
 
 inline void BDSTrajectoryPrimary::operator delete(void* aTrajectory)
-{bdsTrajectoryPrimaryAllocator.FreeSingle((BDSTrajectoryPrimary*)aTrajectory);}
+{BDS::EventFree(bdsTrajectoryPrimaryAllocator, aTrajectory);}
 
 #endif
@@ -36,6 +36,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "parser/beam.h"
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -95,13 +96,22 @@ int main(int argc, char** argv)
 	  }
 	BDSFieldInfo* recipe = BDSFieldFactory::Instance()->GetDefinition(query->fieldObject);
 	recipe->SetProvideGlobalTransform(false);
-	BDSFieldObjects* completeField = BDSFieldFactory::Instance()->CreateField(*recipe);
-	G4Field* field = nullptr;
-	if (completeField)
-	  {field = completeField->GetField();}
-	if (!field)
+	// one copy of the field per thread - the loaded arrays are shared but the
+	// interpolators and any reflection wrappers are not thread safe
+	std::vector<G4Field*> fields;
+	for (G4int i = 0; i < std::max(1, query->nThreads); i++)
+	  {
+	    BDSFieldObjects* completeField = BDSFieldFactory::Instance()->CreateField(*recipe);
+	    G4Field* field = nullptr;
+	    if (completeField)
+	      {field = completeField->GetField();}
+	    if (!field)
+	      {break;}
+	    fields.push_back(field);
+	  }
+	if (fields.empty())
 	  {G4cout << "No field constructed - skipping" << G4endl; continue;}
-	querier.QueryFieldRaw(field, query);
+	querier.QueryFieldRaw(fields, query);
       }
   }
   catch (BDSException& e)
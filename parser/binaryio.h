@@ -0,0 +1,216 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef BINARYIO_H
+#define BINARYIO_H
+
+#include <cstdint>
+#include <istream>
+#include <list>
+#include <map>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GMAD
+{
+  /**
+   * @brief Helper functions for the binary lattice format.
+   *
+   * Values are written in native byte order. Containers and strings are
+   * prefixed by their size as a 64 bit unsigned integer. Reading throws
+   * std::runtime_error if the stream ends early.
+   *
+   * All overloads are declared before they are defined so that nested
+   * containers of any of the supported types can be written.
+   */
+
+  ///@{ Write a value to a binary stream.
+  template<typename T>
+  void BinaryWrite(std::ostream& out, const T& value);
+  void BinaryWrite(std::ostream& out, const std::string& value);
+  template<typename T>
+  void BinaryWrite(std::ostream& out, const std::list<T>& value);
+  template<typename T>
+  void BinaryWrite(std::ostream& out, const std::vector<T>& value);
+  template<typename T>
+  void BinaryWrite(std::ostream& out, const std::set<T>& value);
+  template<typename K, typename V>
+  void BinaryWrite(std::ostream& out, const std::map<K,V>& value);
+  ///@}
+
+  ///@{ Read a value written by BinaryWrite from a binary stream.
+  template<typename T>
+  void BinaryRead(std::istream& in, T& value);
+  void BinaryRead(std::istream& in, std::string& value);
+  template<typename T>
+  void BinaryRead(std::istream& in, std::list<T>& value);
+  template<typename T>
+  void BinaryRead(std::istream& in, std::vector<T>& value);
+  template<typename T>
+  void BinaryRead(std::istream& in, std::set<T>& value);
+  template<typename K, typename V>
+  void BinaryRead(std::istream& in, std::map<K,V>& value);
+  ///@}
+
+  /// Write the size of a container.
+  inline void BinaryWriteSize(std::ostream& out, std::size_t size)
+  {
+    uint64_t n = static_cast<uint64_t>(size);
+    out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  }
+
+  /// Read the size of a container.
+  inline std::size_t BinaryReadSize(std::istream& in)
+  {
+    uint64_t n = 0;
+    in.read(reinterpret_cast<char*>(&n), sizeof(n));
+    if (!in)
+      {throw std::runtime_error("unexpected end of binary file");}
+    return static_cast<std::size_t>(n);
+  }
+
+  template<typename T>
+  void BinaryWrite(std::ostream& out, const T& value)
+  {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "only arithmetic and enum types can be written directly");
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  inline void BinaryWrite(std::ostream& out, const std::string& value)
+  {
+    BinaryWriteSize(out, value.size());
+    out.write(value.data(), value.size());
+  }
+
+  template<typename T>
+  void BinaryWrite(std::ostream& out, const std::list<T>& value)
+  {
+    BinaryWriteSize(out, value.size());
+    for (const auto& v : value)
+      {BinaryWrite(out, v);}
+  }
+
+  template<typename T>
+  void BinaryWrite(std::ostream& out, const std::vector<T>& value)
+  {
+    BinaryWriteSize(out, value.size());
+    for (const auto& v : value)
+      {BinaryWrite(out, v);}
+  }
+
+  template<typename T>
+  void BinaryWrite(std::ostream& out, const std::set<T>& value)
+  {
+    BinaryWriteSize(out, value.size());
+    for (const auto& v : value)
+      {BinaryWrite(out, v);}
+  }
+
+  template<typename K, typename V>
+  void BinaryWrite(std::ostream& out, const std::map<K,V>& value)
+  {
+    BinaryWriteSize(out, value.size());
+    for (const auto& kv : value)
+      {
+        BinaryWrite(out, kv.first);
+        BinaryWrite(out, kv.second);
+      }
+  }
+
+  template<typename T>
+  void BinaryRead(std::istream& in, T& value)
+  {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "only arithmetic and enum types can be read directly");
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!in)
+      {throw std::runtime_error("unexpected end of binary file");}
+  }
+
+  inline void BinaryRead(std::istream& in, std::string& value)
+  {
+    std::size_t n = BinaryReadSize(in);
+    value.resize(n);
+    if (n > 0)
+      {in.read(&value[0], n);}
+    if (!in)
+      {throw std::runtime_error("unexpected end of binary file");}
+  }
+
+  template<typename T>
+  void BinaryRead(std::istream& in, std::list<T>& value)
+  {
+    value.clear();
+    std::size_t n = BinaryReadSize(in);
+    for (std::size_t i = 0; i < n; i++)
+      {
+        T v;
+        BinaryRead(in, v);
+        value.push_back(std::move(v));
+      }
+  }
+
+  template<typename T>
+  void BinaryRead(std::istream& in, std::vector<T>& value)
+  {
+    value.clear();
+    std::size_t n = BinaryReadSize(in);
+    for (std::size_t i = 0; i < n; i++)
+      {
+        T v;
+        BinaryRead(in, v);
+        value.push_back(std::move(v));
+      }
+  }
+
+  template<typename T>
+  void BinaryRead(std::istream& in, std::set<T>& value)
+  {
+    value.clear();
+    std::size_t n = BinaryReadSize(in);
+    for (std::size_t i = 0; i < n; i++)
+      {
+        T v;
+        BinaryRead(in, v);
+        value.insert(value.end(), std::move(v));
+      }
+  }
+
+  template<typename K, typename V>
+  void BinaryRead(std::istream& in, std::map<K,V>& value)
+  {
+    value.clear();
+    std::size_t n = BinaryReadSize(in);
+    for (std::size_t i = 0; i < n; i++)
+      {
+        K k;
+        V v;
+        BinaryRead(in, k);
+        BinaryRead(in, v);
+        value.emplace_hint(value.end(), std::move(k), std::move(v));
+      }
+  }
+}
+
+#endif
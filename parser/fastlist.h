@@ -203,10 +203,12 @@ namespace GMAD
 
   template <typename T>
     typename FastList<T>::FastListConstIterator FastList<T>::erase(const FastListConstIterator first, const FastListConstIterator last) {
-    FastListConstIterator it=first;
-    while (it!=last) {
-      // erase one by one
-      it = erase(it);
+    // erasing one by one searches all map entries with the same name each time, which
+    // is quadratic for names used many times, so erase from the list and rebuild the map
+    FastListConstIterator it = itsList.erase(first,last);
+    itsMap.clear();
+    for (FastListIterator listIt = itsList.begin(); listIt != itsList.end(); ++listIt) {
+      itsMap.insert(std::pair<std::string,FastListIterator>((*listIt).name,listIt));
     }
     return it;
   }
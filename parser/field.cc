@@ -58,6 +58,8 @@ void Field::clear()
   electricSubField = "";
   magneticReflection = "";
   electricReflection = "";
+  mapPrecision = "";
+  mapLayout    = "";
   fieldParameters = "";
 }
 
@@ -93,6 +95,8 @@ void Field::PublishMembers()
   publish("electricSubField",     &Field::electricSubField);
   publish("magneticReflection",   &Field::magneticReflection);
   publish("electricReflection",   &Field::electricReflection);
+  publish("mapPrecision",         &Field::mapPrecision);
+  publish("mapLayout",            &Field::mapLayout);
   publish("fieldParameters",      &Field::fieldParameters);
 }
 
@@ -121,5 +125,7 @@ void Field::print()const
             << "magneticSubField "     << magneticSubField     << std::endl
             << "magneticReflection "   << magneticReflection   << std::endl
             << "electricReflection "   << electricReflection   << std::endl
+            << "mapPrecision "         << mapPrecision         << std::endl
+            << "mapLayout "            << mapLayout            << std::endl
             << "fieldParameters "      << fieldParameters      << std::endl;
 }
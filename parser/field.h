@@ -80,6 +80,9 @@ namespace GMAD
 
     std::string magneticReflection;
     std::string electricReflection;
+
+    std::string mapPrecision; ///< Storage precision of the loaded field map(s).
+    std::string mapLayout;    ///< Memory layout of the loaded field map(s).
     
     std::string fieldParameters;
     
@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <cstdio>
 #include <iostream>
+#include <string>
 
 using namespace GMAD;
 
@@ -33,11 +34,21 @@ int main(int argc, char *argv[])
     std::cout << "GMAD parser needs an input file" << std::endl;
     return 1;
   }
-  if(argc>2) {
+  // optional binary output of the parsed input
+  const std::string binaryFlag = "--binary=";
+  std::string binaryFile;
+  if(argc==3 && std::string(argv[2]).compare(0, binaryFlag.size(), binaryFlag) == 0) {
+    binaryFile = std::string(argv[2]).substr(binaryFlag.size());
+  }
+  else if(argc>2) {
     std::cout << "GMAD parser needs only one input file" << std::endl;
+    std::cout << "Usage: gmad <input file> [--binary=<output file>]" << std::endl;
     return 1;
   }
-  Parser::Instance(std::string(argv[1]));
+  Parser* parser = Parser::Instance(std::string(argv[1]));
+  if(!binaryFile.empty()) {
+    parser->WriteBinary(binaryFile);
+    std::cout << "Binary lattice written to " << binaryFile << std::endl;
+  }
   return 0;
 }
-
@@ -206,6 +206,9 @@ void Options::PublishMembers()
   publish("writeSeedState",        &Options::writeSeedState);
   publish("useASCIISeedState",     &Options::useASCIISeedState);
   publish("seedStateFileName",     &Options::seedStateFileName);
+  publish("useEventArena",         &Options::useEventArena);
+  publish("seedPerEvent",          &Options::seedPerEvent);
+  publish("fastTrackPrimaries",    &Options::fastTrackPrimaries);
   publish("ngenerate",             &Options::nGenerate);
   publish("generatePrimariesOnly", &Options::generatePrimariesOnly);
   publish("exportGeometry",        &Options::exportGeometry);
@@ -281,6 +284,12 @@ void Options::PublishMembers()
   publish("autoColourWorldGeometryFile",    &Options::autoColourWorldGeometryFile);
   publish("importanceWorldGeometryFile",    &Options::importanceWorldGeometryFile);
   publish("importanceVolumeMap",  &Options::importanceVolumeMap);
+  publish("importanceParticles",  &Options::importanceParticles);
+  publish("useWeightWindows",     &Options::useWeightWindows);
+  publish("weightWindowEnergyBounds",     &Options::weightWindowEnergyBounds);
+  publish("weightWindowUpperLimitFactor", &Options::weightWindowUpperLimitFactor);
+  publish("weightWindowSurvivalFactor",   &Options::weightWindowSurvivalFactor);
+  publish("weightWindowMaximumSplits",    &Options::weightWindowMaximumSplits);
   publish("worldVolumeMargin",    &Options::worldVolumeMargin);
   publish("dontSplitSBends",      &Options::dontSplitSBends);
   publish("thinElementLength",    &Options::thinElementLength);
@@ -292,6 +301,8 @@ void Options::PublishMembers()
   publish("buildPoleFaceGeometry", &Options::buildPoleFaceGeometry);
   publish("preprocessGDML",       &Options::preprocessGDML);
   publish("preprocessGDMLSchema", &Options::preprocessGDMLSchema);
+  publish("reuseIdenticalGeometry", &Options::reuseIdenticalGeometry);
+  publish("booleanFreeGeometry",    &Options::booleanFreeGeometry);
   
   // tunnel options
   publish("buildTunnel",         &Options::buildTunnel);
@@ -314,6 +325,7 @@ void Options::PublishMembers()
 
   publish("removeTemporaryFiles", &Options::removeTemporaryFiles);
   publish("temporaryDirectory",   &Options::temporaryDirectory);
+  publish("gdmlCacheDirectory",   &Options::gdmlCacheDirectory);
 
   publish("samplerDiameter",&Options::samplerDiameter);
   
@@ -328,6 +340,8 @@ void Options::PublishMembers()
   publish("maximumTracksPerEvent",       &Options::maximumTracksPerEvent);
   publish("minimumKineticEnergy",        &Options::minimumKineticEnergy);
   publish("minimumKineticEnergyTunnel",  &Options::minimumKineticEnergyTunnel);
+  publish("rouletteKineticEnergy",       &Options::rouletteKineticEnergy);
+  publish("rouletteProbability",         &Options::rouletteProbability);
   publish("minimumRange",                &Options::minimumRange);
   publish("particlesToExcludeFromCuts",  &Options::particlesToExcludeFromCuts);
   
@@ -367,6 +381,8 @@ void Options::PublishMembers()
   // options which influence tracking
   publish("integratorSet",            &Options::integratorSet);
   publish("fieldModulator",           &Options::fieldModulator);
+  publish("fieldMapSharedMemory",     &Options::fieldMapSharedMemory);
+  publish("fieldMapOnDemand",         &Options::fieldMapOnDemand);
   publish("lengthSafety",             &Options::lengthSafety);
   publish("lengthSafetyLarge",        &Options::lengthSafetyLarge);
   publish("maximumTrackingTime",      &Options::maximumTrackingTime);
@@ -78,6 +78,9 @@ OptionsBase::OptionsBase()
   writeSeedState        = false;
   useASCIISeedState     = false;
   seedStateFileName     = "";
+  useEventArena         = false;
+  seedPerEvent          = false;
+  fastTrackPrimaries    = false;
   generatePrimariesOnly = false;
   exportGeometry        = false;
   exportType            = "gdml";
@@ -134,6 +137,8 @@ OptionsBase::OptionsBase()
 
   preprocessGDML       = true;
   preprocessGDMLSchema = true;
+  reuseIdenticalGeometry = false;
+  booleanFreeGeometry    = false;
 
   // geometry debugging
   // always split sbends into smaller chunks by default
@@ -166,6 +171,12 @@ OptionsBase::OptionsBase()
   autoColourWorldGeometryFile = true;
   importanceWorldGeometryFile = "";
   importanceVolumeMap  = "";
+  importanceParticles  = "neutron";
+  useWeightWindows     = false;
+  weightWindowEnergyBounds     = "";
+  weightWindowUpperLimitFactor = 5;
+  weightWindowSurvivalFactor   = 3;
+  weightWindowMaximumSplits    = 5;
   worldVolumeMargin = 5; //m
 
   vacuumPressure       = 1e-12;
@@ -189,6 +200,7 @@ OptionsBase::OptionsBase()
 
   removeTemporaryFiles = true;
   temporaryDirectory = "";
+  gdmlCacheDirectory = "";
   
   // samplers
   samplerDiameter     = 5; // m
@@ -204,6 +216,8 @@ OptionsBase::OptionsBase()
   maximumTracksPerEvent    = 0;   ///< 0 -> no action taken
   minimumKineticEnergy     = 0;
   minimumKineticEnergyTunnel = 0;
+  rouletteKineticEnergy    = 0;
+  rouletteProbability      = 1.0;
   minimumRange             = 0;
   particlesToExcludeFromCuts = "";
   defaultRangeCut          = 1e-3;
@@ -243,6 +257,8 @@ OptionsBase::OptionsBase()
   // tracking options
   integratorSet            = "bdsimmatrix";
   fieldModulator           = "";
+  fieldMapSharedMemory     = false;
+  fieldMapOnDemand         = false;
   lengthSafety             = 1e-9;   // be very careful adjusting this as it affects all the geometry
   lengthSafetyLarge        = 1e-6;   // be very careful adjusting this as it affects all the geometry
   maximumTrackingTime      = -1;      // s, nonsensical - used for testing
@@ -98,6 +98,9 @@ namespace GMAD
     bool writeSeedState;           ///< Write the seed state each event to a text file.
     bool useASCIISeedState;        ///< Whether to use the seed state from an ASCII file.
     std::string seedStateFileName; ///< Seed state file path.
+    bool seedPerEvent;             ///< Seed each event from the seed and event index rather than storing the full state.
+    bool useEventArena;            ///< Allocate hits and trajectories from an event-scoped arena.
+    bool fastTrackPrimaries;       ///< Analytically transport primaries through the linear start of the beam line.
 
     /// Whether to only generate primary coordinates and quit, or not.
     bool generatePrimariesOnly; 
@@ -166,6 +169,8 @@ namespace GMAD
     /// geometry control
     bool preprocessGDML;
     bool preprocessGDMLSchema;
+    bool reuseIdenticalGeometry;
+    bool booleanFreeGeometry;
 
     /// geometry debug, don't split bends into multiple segments
     bool      dontSplitSBends;
@@ -199,6 +204,12 @@ namespace GMAD
     bool        autoColourWorldGeometryFile;
     std::string importanceWorldGeometryFile;
     std::string importanceVolumeMap;
+    std::string importanceParticles; ///< Particle names to apply importance sampling to.
+    bool        useWeightWindows;
+    std::string weightWindowEnergyBounds;
+    double      weightWindowUpperLimitFactor;
+    double      weightWindowSurvivalFactor;
+    int         weightWindowMaximumSplits;
     // see verboseImportance
 
     double    worldVolumeMargin; ///< Padding margin for world volume size.
@@ -225,6 +236,7 @@ namespace GMAD
     
     bool removeTemporaryFiles;
     std::string temporaryDirectory;
+    std::string gdmlCacheDirectory;
     
     // sampler options
     double   samplerDiameter;
@@ -243,6 +255,8 @@ namespace GMAD
     long     maximumTracksPerEvent;
     double   minimumKineticEnergy;
     double   minimumKineticEnergyTunnel;
+    double   rouletteKineticEnergy;
+    double   rouletteProbability;
     double   minimumRange;
     std::string particlesToExcludeFromCuts;
     double   defaultRangeCut;
@@ -283,6 +297,8 @@ namespace GMAD
     // tracking related parameters
     std::string integratorSet;
     std::string fieldModulator;
+    bool     fieldMapSharedMemory; ///< Share loaded field maps between processes on a node.
+    bool     fieldMapOnDemand;     ///< Load field maps on their first use rather than at construction.
     double   lengthSafety;
     double   lengthSafetyLarge;
     double   maximumTrackingTime; ///< Maximum tracking time per track [s].
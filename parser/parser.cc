@@ -20,6 +20,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <list>
 #include <set>
@@ -32,9 +35,18 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <pwd.h>
 
 #include "array.h"
+#include "binaryio.h"
 #include "sym_table.h"
 
 namespace {
+  /// Identifier at the start of a binary file written by Parser::WriteBinary.
+  const char binaryMagic[8] = {'G','M','A','D','B','I','N','\0'};
+  /// Version of the binary format - increase when the layout of the file changes.
+  /// Published members are stored by name so adding or removing them does not.
+  const uint32_t binaryVersion = 1;
+  /// Known value to check the byte order of the machine that wrote the file.
+  const uint32_t binaryByteOrder = 0x01020304;
+
   // helper method
   // replace algorithm of all substring instances
   // from http://stackoverflow.com/questions/2896600/how-to-replace-all-occurrences-of-a-character-in-string
@@ -135,6 +147,12 @@ Parser::Parser(std::string name)
   std::string home(getpwuid(getuid())->pw_dir);
 
   replaceAll(name,tilde,home);
+
+  if (IsBinaryFile(name))
+    {
+      ReadBinary(name);
+      return;
+    }
   
   FILE *f = fopen(name.c_str(),"r");
 
@@ -185,6 +203,236 @@ void Parser::ParseFile(FILE *f)
   fclose(f);
 }
 
+bool Parser::IsBinaryFile(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  char magic[sizeof(binaryMagic)] = {};
+  in.read(magic, sizeof(magic));
+  return in && std::memcmp(magic, binaryMagic, sizeof(binaryMagic)) == 0;
+}
+
+void Parser::WriteBinary(const std::string& filename) const
+{
+  std::ofstream out(filename, std::ios::binary);
+  if (!out)
+    {
+      std::cerr << "gmad_parser> Can't open binary output file " << filename << std::endl;
+      exit(1);
+    }
+  out.write(binaryMagic, sizeof(binaryMagic));
+  BinaryWrite(out, binaryVersion);
+  BinaryWrite(out, binaryByteOrder);
+
+  BinaryWrite(out, current_line);
+  BinaryWrite(out, current_start);
+  BinaryWrite(out, current_end);
+
+  auto optionsLayout = options.WriteBinaryLayout(out);
+  options.WriteBinary(&options, optionsLayout, out);
+  BinaryWrite(out, options.setKeys);
+  auto beamLayout = beam.WriteBinaryLayout(out);
+  beam.WriteBinary(&beam, beamLayout, out);
+  BinaryWrite(out, beam.setKeys);
+
+  WriteBinaryList(beamline_list, out);
+  WriteBinaryList(placement_elements, out);
+  BinaryWriteSize(out, expandedSequences.size());
+  for (const auto& kv : expandedSequences)
+    {
+      BinaryWrite(out, kv.first);
+      WriteBinaryList(*kv.second, out);
+    }
+
+  WriteBinaryList(atom_list, out);
+  WriteBinaryList(colour_list, out);
+  WriteBinaryList(crystal_list, out);
+  WriteBinaryList(field_list, out);
+  WriteBinaryList(material_list, out);
+  WriteBinaryList(query_list, out);
+  WriteBinaryList(region_list, out);
+  WriteBinaryList(tunnel_list, out);
+  BinaryWriteSize(out, xsecbias_list.size());
+  for (const auto& bias : xsecbias_list)
+    {
+      BinaryWrite(out, bias.name);
+      BinaryWrite(out, bias.particle);
+      BinaryWrite(out, bias.process);
+      BinaryWrite(out, bias.processList);
+      BinaryWrite(out, bias.factor);
+      BinaryWrite(out, bias.flag);
+    }
+  WriteBinaryList(placement_list, out);
+  WriteBinaryList(cavitymodel_list, out);
+  WriteBinaryList(samplerplacement_list, out);
+  WriteBinaryList(scorer_list, out);
+  WriteBinaryList(scorermesh_list, out);
+  WriteBinaryList(aperture_list, out);
+  WriteBinaryList(blm_list, out);
+  WriteBinaryList(modulator_list, out);
+
+  BinaryWrite(out, samplerFilters);
+  BinaryWrite(out, samplerFilterIDToSet);
+  BinaryWrite(out, setToSamplerFilterID);
+
+  if (!out)
+    {
+      std::cerr << "gmad_parser> Error writing binary output file " << filename << std::endl;
+      exit(1);
+    }
+}
+
+void Parser::ReadBinary(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  try
+    {
+      char magic[sizeof(binaryMagic)] = {};
+      in.read(magic, sizeof(magic));
+      uint32_t version = 0;
+      BinaryRead(in, version);
+      if (version != binaryVersion)
+        {
+          throw std::runtime_error("binary format version " + std::to_string(version) +
+                                   " is not supported (expected " + std::to_string(binaryVersion) + ")");
+        }
+      uint32_t byteOrder = 0;
+      BinaryRead(in, byteOrder);
+      if (byteOrder != binaryByteOrder)
+        {throw std::runtime_error("file was written on a machine with a different byte order");}
+
+      BinaryRead(in, current_line);
+      BinaryRead(in, current_start);
+      BinaryRead(in, current_end);
+
+      auto optionsLayout = options.ReadBinaryLayout(in);
+      options.ReadBinary(&options, optionsLayout, in);
+      BinaryRead(in, options.setKeys);
+      auto beamLayout = beam.ReadBinaryLayout(in);
+      beam.ReadBinary(&beam, beamLayout, in);
+      BinaryRead(in, beam.setKeys);
+
+      ReadBinaryList(beamline_list, in);
+      ReadBinaryList(placement_elements, in);
+      std::size_t nSequences = BinaryReadSize(in);
+      for (std::size_t i = 0; i < nSequences; i++)
+        {
+          std::string name;
+          BinaryRead(in, name);
+          FastList<Element>* newLine = new FastList<Element>();
+          ReadBinaryList(*newLine, in);
+          expandedSequences[name] = newLine;
+        }
+
+      ReadBinaryList(atom_list, in);
+      ReadBinaryList(colour_list, in);
+      ReadBinaryList(crystal_list, in);
+      ReadBinaryList(field_list, in);
+      ReadBinaryList(material_list, in);
+      ReadBinaryList(query_list, in);
+      ReadBinaryList(region_list, in);
+      ReadBinaryList(tunnel_list, in);
+      std::size_t nBias = BinaryReadSize(in);
+      for (std::size_t i = 0; i < nBias; i++)
+        {
+          PhysicsBiasing bias;
+          BinaryRead(in, bias.name);
+          BinaryRead(in, bias.particle);
+          BinaryRead(in, bias.process);
+          BinaryRead(in, bias.processList);
+          BinaryRead(in, bias.factor);
+          BinaryRead(in, bias.flag);
+          xsecbias_list.push_back(bias);
+        }
+      ReadBinaryList(placement_list, in);
+      ReadBinaryList(cavitymodel_list, in);
+      ReadBinaryList(samplerplacement_list, in);
+      ReadBinaryList(scorer_list, in);
+      ReadBinaryList(scorermesh_list, in);
+      ReadBinaryList(aperture_list, in);
+      ReadBinaryList(blm_list, in);
+      ReadBinaryList(modulator_list, in);
+
+      BinaryRead(in, samplerFilters);
+      BinaryRead(in, samplerFilterIDToSet);
+      BinaryRead(in, setToSamplerFilterID);
+    }
+  catch (const std::runtime_error& e)
+    {
+      std::cerr << "gmad_parser> Can't read binary input file " << filename << ": " << e.what() << std::endl;
+      exit(1);
+    }
+}
+
+template <class C>
+void Parser::WriteBinaryList(const FastList<C>& list, std::ostream& out) const
+{
+  C prototype;
+  auto layout = prototype.WriteBinaryLayout(out);
+  BinaryWriteSize(out, list.size());
+  for (const auto& object : list)
+    {
+      prototype.WriteBinary(&object, layout, out);
+      WriteBinaryExtras(object, out);
+    }
+}
+
+template <class C>
+void Parser::ReadBinaryList(FastList<C>& list, std::istream& in)
+{
+  C object;
+  auto layout = object.ReadBinaryLayout(in);
+  std::size_t n = BinaryReadSize(in);
+  for (std::size_t i = 0; i < n; i++)
+    {
+      C newObject;
+      newObject.ReadBinary(&newObject, layout, in);
+      ReadBinaryExtras(newObject, in);
+      list.push_back(newObject);
+    }
+}
+
+template <class C>
+void Parser::WriteBinaryExtras(const C& /*object*/, std::ostream& /*out*/) const
+{;}
+
+template <class C>
+void Parser::ReadBinaryExtras(C& /*object*/, std::istream& /*in*/)
+{;}
+
+void Parser::WriteBinaryExtras(const Element& element, std::ostream& out) const
+{
+  BinaryWrite(out, static_cast<int>(element.type));
+  BinaryWrite(out, element.name);
+  BinaryWrite(out, element.biasMaterialList);
+  BinaryWrite(out, element.biasVacuumList);
+  BinaryWrite(out, element.samplerParticleSetID);
+  BinaryWrite(out, element.angleSet);
+  BinaryWrite(out, element.scalingFieldOuterSet);
+}
+
+void Parser::ReadBinaryExtras(Element& element, std::istream& in)
+{
+  int type = 0;
+  BinaryRead(in, type);
+  element.type = static_cast<ElementType>(type);
+  BinaryRead(in, element.name);
+  BinaryRead(in, element.biasMaterialList);
+  BinaryRead(in, element.biasVacuumList);
+  BinaryRead(in, element.samplerParticleSetID);
+  BinaryRead(in, element.angleSet);
+  BinaryRead(in, element.scalingFieldOuterSet);
+}
+
+void Parser::WriteBinaryExtras(const SamplerPlacement& samplerPlacement, std::ostream& out) const
+{
+  BinaryWrite(out, samplerPlacement.partIDSetID);
+}
+
+void Parser::ReadBinaryExtras(SamplerPlacement& samplerPlacement, std::istream& in)
+{
+  BinaryRead(in, samplerPlacement.partIDSetID);
+}
+
 void Parser::Initialise()
 {
   const int reserved = 1;
@@ -290,8 +538,21 @@ void Parser::write_table(std::string* name, ElementType type, bool isLine)
 
 void Parser::expand_sequences()
 {
+  std::set<std::string> usedSequences;
+  for (const auto& placement : placement_list)
+    {
+      if (!placement.sequence.empty())
+        {usedSequences.insert(placement.sequence);}
+    }
+  for (const auto& mesh : scorermesh_list)
+    {
+      if (!mesh.sequence.empty())
+        {usedSequences.insert(mesh.sequence);}
+    }
   for (const auto& name : sequences)
     {
+      if (usedSequences.find(name) == usedSequences.end())
+        {continue;}
       FastList<Element>* newLine = new FastList<Element>();
       expand_line(*newLine, name);
       expandedSequences[name] = newLine;
@@ -335,101 +596,8 @@ void Parser::expand_line(FastList<Element>& target,
   if (!line.lst)
     {return;} //list empty
     
-  // first expand the whole range 
-  std::list<Element>::iterator sit = line.lst->begin();
-  std::list<Element>::iterator eit = line.lst->end();
-  
-  // copy the list into the resulting list
-  switch(line.type)
-    {
-      case ElementType::_LINE:
-        {target.insert(target.end(),sit,eit); break;}
-      case ElementType::_REV_LINE:
-        {target.insert(target.end(),line.lst->rbegin(),line.lst->rend()); break;}
-      default:
-        {target.insert(target.end(),sit,eit); break;}
-    }
-  // bool to check if beamline is fully expanded
-  bool is_expanded = false;
-  
-  // parse starting from the second element until the list is expanded
-  int iteration = 0;
-    while (!is_expanded)
-    {
-      is_expanded = true;
-      // start at second element
-      std::list<Element>::iterator it = ++target.begin();
-      for (; it!=target.end(); ++it)
-        {
-          Element& element = *it; // alias
-          const ElementType& type = element.type;
-#ifdef BDSDEBUG 
-          std::cout << element.name << " , " << type << std::endl;
-#endif
-          // if list - expand further
-          if (type != ElementType::_LINE && type != ElementType::_REV_LINE)
-            {continue;}
-          is_expanded = false;
-          // lookup the line in main list
-          std::list<Element>::const_iterator tmpit = element_list.find(element.name);
-          std::list<Element>::const_iterator iterEnd = element_list.end();
-          if ( (tmpit != iterEnd) && ( (*tmpit).lst != nullptr) )
-            { // sublist found and not empty
-              const Element& list = *tmpit; // alias
-#ifdef BDSDEBUG
-              std::cout << "inserting sequence for " << element.name << " - " << list.name << " ...";
-#endif
-              if (type == ElementType::_LINE)
-                {target.insert(it,list.lst->begin(),list.lst->end());}
-              else if (type == ElementType::_REV_LINE)
-                {
-                  //iterate over list and invert any sublines contained within. SPM
-                  std::list<Element> tmpList;
-                  tmpList.insert(tmpList.end(),list.lst->begin(),list.lst->end());
-                  for (std::list<Element>::iterator itLineInverter = tmpList.begin();
-                       itLineInverter != tmpList.end(); ++itLineInverter)
-                    {
-                      if ( (*itLineInverter).type == ElementType::_LINE)
-                        {(*itLineInverter).type = ElementType::_REV_LINE;}
-                      else if ((*itLineInverter).type == ElementType::_REV_LINE)
-                        {(*itLineInverter).type = ElementType::_LINE;}
-                    }
-                  target.insert(it,tmpList.rbegin(),tmpList.rend());
-                }
-#ifdef BDSDEBUG
-              std::cout << "inserted" << std::endl;
-#endif
-              // delete the list pointer
-              target.erase(it--);
-            }
-          else if ( tmpit != iterEnd )
-            { // entry points to a scalar element type -
-              //transfer properties from the main list
-#ifdef BDSDEBUG 
-              std::cout << "keeping element..." << element.name << std::endl;
-#endif
-              // copy properties
-              element = (*tmpit);
-              
-#ifdef BDSDEBUG 
-              std::cout << "done" << std::endl;
-#endif
-            }
-          else
-            { // element of undefined type
-              std::cerr << "Error : Expanding line \"" << name << "\" : element \"" << element.name
-                        << "\" has not been defined! " << std::endl;
-              exit(1);
-            }
-        }
-      iteration++;
-      if ( iteration > MAX_EXPAND_ITERATIONS )
-        {
-          std::cerr << "Error : Line expansion of '" << name << "' seems to loop, " << std::endl
-                    << "possible recursive line definition, quitting" << std::endl;
-          exit(1);
-        }
-    }// while
+  // a reversed top level line reverses its items only, as it always has
+  expand_line_items(target, *line.lst, line.type == ElementType::_REV_LINE, false, name, 1);
     
   // leave only the desired range
   //
@@ -458,6 +626,55 @@ void Parser::expand_line(FastList<Element>& target,
     {target.push_back(*itTunnel);}
 }
 
+void Parser::expand_line_items(FastList<Element>& target,
+                               const std::list<Element>& items,
+                               bool reversed,
+                               bool invertSublines,
+                               const std::string& name,
+                               int depth)
+{
+  if (depth > MAX_EXPAND_ITERATIONS)
+    {
+      std::cerr << "Error : Line expansion of '" << name << "' seems to loop, " << std::endl
+                << "possible recursive line definition, quitting" << std::endl;
+      exit(1);
+    }
+
+  auto expandItem = [&](const Element& item)
+    {
+      // items in a line are references by name - '-subline' is reversed
+      bool reverseItem = item.type == ElementType::_REV_LINE;
+      if (invertSublines)
+        {reverseItem = !reverseItem;}
+      const auto search = element_list.find(item.name);
+      if (search == element_list.end())
+        {
+          std::cerr << "Error : Expanding line \"" << name << "\" : element \"" << item.name
+                    << "\" has not been defined! " << std::endl;
+          exit(1);
+        }
+      const Element& definition = *search;
+      if (definition.type == ElementType::_LINE || definition.type == ElementType::_REV_LINE)
+        {
+          if (definition.lst)
+            {expand_line_items(target, *definition.lst, reverseItem, reverseItem, name, depth + 1);}
+        }
+      else
+        {target.push_back(definition);}
+    };
+
+  if (reversed)
+    {
+      for (auto it = items.rbegin(); it != items.rend(); ++it)
+        {expandItem(*it);}
+    }
+  else
+    {
+      for (const auto& item : items)
+        {expandItem(item);}
+    }
+}
+
 const FastList<Element>& Parser::get_sequence(const std::string& name)
 {
   // search for previously queried beamlines
@@ -19,8 +19,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef PARSER_H
 #define PARSER_H
 
+#include <istream>
 #include <list>
 #include <map>
+#include <ostream>
 #include <set>
 #include <string>
 #include <vector>
@@ -206,6 +208,13 @@ namespace GMAD
     ///@}
     /// Beamline Access.
     const FastList<Element>& GetBeamline() const;
+
+    /// Write the fully parsed and expanded state (beamline, options, beam and all
+    /// defined objects) to a binary file. Such a file can be given instead of an
+    /// input gmad file and is then loaded directly without parsing.
+    void WriteBinary(const std::string& filename) const;
+    /// Whether the file is a binary file written by WriteBinary.
+    static bool IsBinaryFile(const std::string& filename);
     
   private:
     /// Set sampler
@@ -218,9 +227,29 @@ namespace GMAD
     void add_func(std::string name, double (*func)(double));
     void add_var(std::string name, double value, int is_reserved = 0);
 
-    /// Expand all sequences define with 'line' into FastLists.
+    /// Expand the sequences defined with 'line' that are used by placements or scorer
+    /// meshes into FastLists. Others aren't needed after parsing so aren't expanded.
     void expand_sequences();
 
+    /// Load the state from a binary file written by WriteBinary instead of parsing.
+    void ReadBinary(const std::string& filename);
+    ///@{ Write or read a list of published parser objects in binary form.
+    template <class C>
+    void WriteBinaryList(const FastList<C>& list, std::ostream& out) const;
+    template <class C>
+    void ReadBinaryList(FastList<C>& list, std::istream& in);
+    ///@}
+    ///@{ Write or read the members of a parser object that are not published.
+    template <class C>
+    void WriteBinaryExtras(const C& object, std::ostream& out) const;
+    template <class C>
+    void ReadBinaryExtras(C& object, std::istream& in);
+    void WriteBinaryExtras(const Element& element, std::ostream& out) const;
+    void ReadBinaryExtras(Element& element, std::istream& in);
+    void WriteBinaryExtras(const SamplerPlacement& samplerPlacement, std::ostream& out) const;
+    void ReadBinaryExtras(SamplerPlacement& samplerPlacement, std::istream& in);
+    ///@}
+
     // protected implementation (for inheritance to BDSParser - hackish)
   protected:
     /// Beam instance;
@@ -256,6 +285,17 @@ namespace GMAD
     /// maximum number of nested lines
     const int MAX_EXPAND_ITERATIONS = 50;
 
+    /// Append the contents of a line definition to the target, recursing into sublines
+    /// and copying each element definition exactly once. If reversed, the items are
+    /// taken in reverse order. If invertSublines, the direction of each subline in them
+    /// is inverted as is required for a reversed subline.
+    void expand_line_items(FastList<Element>& target,
+                           const std::list<Element>& items,
+                           bool reversed,
+                           bool invertSublines,
+                           const std::string& name,
+                           int depth);
+
     ///@{ temporary list for reading of arrays in parser
     std::list<double> tmparray;
     std::list<std::string> tmpstring;
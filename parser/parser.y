@@ -31,6 +31,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <iostream>
 #include <list>
 #include <string>
+
+/* sequences are right recursive so each item in a line uses parser stack - the
+   default limit of 10000 stops lines of more than a few thousand elements */
+#define YYMAXDEPTH 10000000
   
   using namespace GMAD;
 
@@ -19,14 +19,19 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef PUBLISHED_H
 #define PUBLISHED_H
 
+#include <algorithm>
 #include <cmath>
+#include <istream>
 #include <list>
+#include <map>
+#include <ostream>
 #include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "array.h" // our array header
+#include "binaryio.h"
 
 namespace GMAD
 {
@@ -49,7 +54,37 @@ class Published
 {
 public:
   bool NameExists(const std::string& name) const {return allNames.count(name) > 0;}
-  
+
+  /// Published members of type T in the order they are stored in a binary file. A
+  /// nullptr is used for a stored name that is not published (anymore) so it is skipped.
+  template<typename T>
+  struct BinaryMembers
+  {
+    std::vector<T C::*> members;
+  };
+
+  /// Order of the published members of all supported types in a binary file.
+  struct BinaryLayout:
+    BinaryMembers<double>, BinaryMembers<int>, BinaryMembers<bool>, BinaryMembers<long>,
+    BinaryMembers<std::string>, BinaryMembers<std::list<double>>,
+    BinaryMembers<std::list<int>>, BinaryMembers<std::list<std::string>>
+  {};
+
+  /// Write the names of all published members grouped by type and return the layout
+  /// that WriteBinary uses for each instance. Members published under more than one
+  /// name are only stored once.
+  BinaryLayout WriteBinaryLayout(std::ostream& out) const;
+  /// Read the names written by WriteBinaryLayout and match them to the published members.
+  BinaryLayout ReadBinaryLayout(std::istream& in) const;
+  /// Write the values of the published members of instance in the order of layout.
+  void WriteBinary(const C* instance, const BinaryLayout& layout, std::ostream& out) const;
+  /// Read the values written by WriteBinary into instance.
+  void ReadBinary(C* instance, const BinaryLayout& layout, std::istream& in) const;
+
+  /// Write every published name of instance with its value, one per line sorted by
+  /// type then name and with full precision, so the state of two instances can be compared.
+  void PrintPublished(const C* instance, std::ostream& out) const;
+
 protected:
   /// Make pointer to member from class C and type T with accessible with a name
   template<typename T>
@@ -82,6 +117,28 @@ private:
   /// Access to member pointer
   template<typename T>
   T C::* member(const std::string& name) const;
+
+  ///@{ Binary layout and value writing for the members of type T.
+  template<typename T>
+  void WriteBinaryNames(BinaryLayout& layout, std::ostream& out) const;
+  template<typename T>
+  void ReadBinaryNames(BinaryLayout& layout, std::istream& in) const;
+  template<typename T>
+  void WriteBinaryValues(const C* instance, const BinaryLayout& layout, std::ostream& out) const;
+  template<typename T>
+  void ReadBinaryValues(C* instance, const BinaryLayout& layout, std::istream& in) const;
+  ///@}
+
+  /// Print the published members of type T for PrintPublished.
+  template<typename T>
+  void PrintPublishedValues(const C* instance, std::ostream& out) const;
+  ///@{ Print a single value for PrintPublished. Strings are quoted.
+  template<typename T>
+  static void PrintPublishedValue(std::ostream& out, const T& value);
+  static void PrintPublishedValue(std::ostream& out, const std::string& value);
+  template<typename T>
+  static void PrintPublishedValue(std::ostream& out, const std::list<T>& value);
+  ///@}
   
   /// A cache of all names defined through publish().
   std::set<std::string> allNames;
@@ -252,6 +309,173 @@ void Published<C>::set(C* instance, const C* instance2, const std::string& name)
     }
 }
 
+template<typename C>
+typename Published<C>::BinaryLayout Published<C>::WriteBinaryLayout(std::ostream& out) const
+{
+  BinaryLayout layout;
+  WriteBinaryNames<double>(layout, out);
+  WriteBinaryNames<int>(layout, out);
+  WriteBinaryNames<bool>(layout, out);
+  WriteBinaryNames<long>(layout, out);
+  WriteBinaryNames<std::string>(layout, out);
+  WriteBinaryNames<std::list<double>>(layout, out);
+  WriteBinaryNames<std::list<int>>(layout, out);
+  WriteBinaryNames<std::list<std::string>>(layout, out);
+  return layout;
+}
+
+template<typename C>
+typename Published<C>::BinaryLayout Published<C>::ReadBinaryLayout(std::istream& in) const
+{
+  BinaryLayout layout;
+  ReadBinaryNames<double>(layout, in);
+  ReadBinaryNames<int>(layout, in);
+  ReadBinaryNames<bool>(layout, in);
+  ReadBinaryNames<long>(layout, in);
+  ReadBinaryNames<std::string>(layout, in);
+  ReadBinaryNames<std::list<double>>(layout, in);
+  ReadBinaryNames<std::list<int>>(layout, in);
+  ReadBinaryNames<std::list<std::string>>(layout, in);
+  return layout;
+}
+
+template<typename C>
+void Published<C>::WriteBinary(const C* instance, const BinaryLayout& layout, std::ostream& out) const
+{
+  WriteBinaryValues<double>(instance, layout, out);
+  WriteBinaryValues<int>(instance, layout, out);
+  WriteBinaryValues<bool>(instance, layout, out);
+  WriteBinaryValues<long>(instance, layout, out);
+  WriteBinaryValues<std::string>(instance, layout, out);
+  WriteBinaryValues<std::list<double>>(instance, layout, out);
+  WriteBinaryValues<std::list<int>>(instance, layout, out);
+  WriteBinaryValues<std::list<std::string>>(instance, layout, out);
+}
+
+template<typename C>
+void Published<C>::ReadBinary(C* instance, const BinaryLayout& layout, std::istream& in) const
+{
+  ReadBinaryValues<double>(instance, layout, in);
+  ReadBinaryValues<int>(instance, layout, in);
+  ReadBinaryValues<bool>(instance, layout, in);
+  ReadBinaryValues<long>(instance, layout, in);
+  ReadBinaryValues<std::string>(instance, layout, in);
+  ReadBinaryValues<std::list<double>>(instance, layout, in);
+  ReadBinaryValues<std::list<int>>(instance, layout, in);
+  ReadBinaryValues<std::list<std::string>>(instance, layout, in);
+}
+
+template<typename C>
+template<typename T>
+void Published<C>::WriteBinaryNames(BinaryLayout& layout, std::ostream& out) const
+{
+  // sort by name so the file does not depend on the hash table order
+  std::map<std::string, T C::*> sorted(attribute_map<T>().begin(), attribute_map<T>().end());
+  std::vector<std::string> names;
+  std::vector<T C::*>& members = static_cast<BinaryMembers<T>&>(layout).members;
+  for (const auto& kv : sorted)
+    {
+      if (std::find(members.begin(), members.end(), kv.second) != members.end())
+        {continue;} // alternative name for a member already stored
+      names.push_back(kv.first);
+      members.push_back(kv.second);
+    }
+  BinaryWrite(out, names);
+}
+
+template<typename C>
+template<typename T>
+void Published<C>::ReadBinaryNames(BinaryLayout& layout, std::istream& in) const
+{
+  std::vector<std::string> names;
+  BinaryRead(in, names);
+  const AttributeMap<T>& m = attribute_map<T>();
+  std::vector<T C::*>& members = static_cast<BinaryMembers<T>&>(layout).members;
+  for (const auto& name : names)
+    {
+      auto search = m.find(name);
+      members.push_back(search != m.end() ? search->second : nullptr);
+    }
+}
+
+template<typename C>
+template<typename T>
+void Published<C>::WriteBinaryValues(const C* instance, const BinaryLayout& layout, std::ostream& out) const
+{
+  for (auto mp : static_cast<const BinaryMembers<T>&>(layout).members)
+    {BinaryWrite(out, (instance)->*mp);}
+}
+
+template<typename C>
+template<typename T>
+void Published<C>::ReadBinaryValues(C* instance, const BinaryLayout& layout, std::istream& in) const
+{
+  for (auto mp : static_cast<const BinaryMembers<T>&>(layout).members)
+    {
+      if (mp)
+        {BinaryRead(in, (instance)->*mp);}
+      else
+        {
+          T unused;
+          BinaryRead(in, unused);
+        }
+    }
+}
+
+template<typename C>
+void Published<C>::PrintPublished(const C* instance, std::ostream& out) const
+{
+  std::streamsize oldPrecision = out.precision(17);
+  PrintPublishedValues<double>(instance, out);
+  PrintPublishedValues<int>(instance, out);
+  PrintPublishedValues<bool>(instance, out);
+  PrintPublishedValues<long>(instance, out);
+  PrintPublishedValues<std::string>(instance, out);
+  PrintPublishedValues<std::list<double>>(instance, out);
+  PrintPublishedValues<std::list<int>>(instance, out);
+  PrintPublishedValues<std::list<std::string>>(instance, out);
+  out.precision(oldPrecision);
+}
+
+template<typename C>
+template<typename T>
+void Published<C>::PrintPublishedValue(std::ostream& out, const T& value)
+{
+  out << value;
+}
+
+template<typename C>
+void Published<C>::PrintPublishedValue(std::ostream& out, const std::string& value)
+{
+  out << "\"" << value << "\"";
+}
+
+template<typename C>
+template<typename T>
+void Published<C>::PrintPublishedValue(std::ostream& out, const std::list<T>& value)
+{
+  out << "{";
+  for (const auto& v : value)
+    {
+      out << " ";
+      PrintPublishedValue(out, v);
+    }
+  out << " }";
+}
+
+template<typename C>
+template<typename T>
+void Published<C>::PrintPublishedValues(const C* instance, std::ostream& out) const
+{
+  std::map<std::string, T C::*> sorted(attribute_map<T>().begin(), attribute_map<T>().end());
+  for (const auto& kv : sorted)
+    {
+      out << kv.first << " = ";
+      PrintPublishedValue(out, (instance)->*(kv.second));
+      out << "\n";
+    }
+}
+
 template <typename C>
 template <typename T>
 T Published<C>::get(const C* instance, const std::string& name) const
@@ -50,6 +50,9 @@ void Query::clear()
   
   overwriteExistingFiles = true;
   printTransform = true;
+  binaryOutput = false;
+  nThreads = 1;
+  errorReportInterpolator = "";
   
   drawArrows = true;
   drawZeroValuePoints = true;
@@ -100,6 +103,9 @@ void Query::PublishMembers()
   
   publish("overwriteExistingFiles", &Query::overwriteExistingFiles);
   publish("printTransform",         &Query::printTransform);
+  publish("binaryOutput",           &Query::binaryOutput);
+  publish("nThreads",               &Query::nThreads);
+  publish("errorReportInterpolator", &Query::errorReportInterpolator);
   
   publish("drawArrows",             &Query::drawArrows);
   publish("drawZeroValuePoints",    &Query::drawZeroValuePoints);
@@ -145,6 +151,9 @@ void Query::print()const
 	    << "queryElectricField: "    << queryElectricField     << std::endl
 	    << "overwriteExistingFiles " << overwriteExistingFiles << std::endl
 	    << "printTransform "         << printTransform         << std::endl
+	    << "binaryOutput "           << binaryOutput           << std::endl
+	    << "nThreads "               << nThreads               << std::endl
+	    << "errorReportInterpolator " << errorReportInterpolator << std::endl
       << "drawArrows "             << drawArrows             << std::endl
       << "drawZeroValuePoints "    << drawZeroValuePoints    << std::endl
       << "drawBoxes "              << drawBoxes              << std::endl
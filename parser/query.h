@@ -58,6 +58,9 @@ namespace GMAD
     
     bool overwriteExistingFiles;
     bool printTransform;
+    bool binaryOutput; ///< Write BDSIM binary format field maps instead of text.
+    int  nThreads;     ///< Number of threads to use when querying a field object directly.
+    std::string errorReportInterpolator; ///< Interpolator to check the output with in bdsinterpolator.
     
     bool   drawArrows;
     bool   drawZeroValuePoints;
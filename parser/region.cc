@@ -36,6 +36,10 @@ void Region::clear()
   prodCutElectrons = 0.0;
   prodCutPositrons = 0.0;
   prodCutProtons   = 0.0;
+  // 0 means the global option is used
+  minimumKineticEnergy  = 0.0;
+  rouletteKineticEnergy = 0.0;
+  rouletteProbability   = 0.0;
 }
 
 void Region::PublishMembers()
@@ -46,6 +50,9 @@ void Region::PublishMembers()
   publish("prodCutElectrons",&Region::prodCutElectrons);
   publish("prodCutPositrons",&Region::prodCutPositrons);
   publish("prodCutProtons",  &Region::prodCutProtons);
+  publish("minimumKineticEnergy",  &Region::minimumKineticEnergy);
+  publish("rouletteKineticEnergy", &Region::rouletteKineticEnergy);
+  publish("rouletteProbability",   &Region::rouletteProbability);
 }
 
 void Region::print()const
@@ -56,6 +63,9 @@ void Region::print()const
 	    << prodCutPhotons   << " "
 	    << prodCutElectrons << " "
 	    << prodCutPositrons << " "
-	    << prodCutProtons
+	    << prodCutProtons   << " "
+	    << minimumKineticEnergy  << " "
+	    << rouletteKineticEnergy << " "
+	    << rouletteProbability
 	    << std::endl;
 }
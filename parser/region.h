@@ -42,6 +42,9 @@ namespace GMAD
     double   prodCutElectrons;
     double   prodCutPositrons;
     double   prodCutProtons;
+    double   minimumKineticEnergy;  ///< Applied at stacking time [GeV].
+    double   rouletteKineticEnergy; ///< Secondaries below this are subject to roulette [GeV].
+    double   rouletteProbability;   ///< Survival probability for roulette.
 
     /// constructor
     Region();
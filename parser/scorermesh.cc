@@ -46,6 +46,7 @@ void ScorerMesh::clear()
   eHigh = 1e4;
   eScale = "linear";
   eBinsEdgesFilenamePath = "";
+  analytic = false;
   sequence         = "";
   referenceElement = "";
   referenceElementNumber = 0;
@@ -82,6 +83,7 @@ void ScorerMesh::PublishMembers()
   publish("eHigh",         &ScorerMesh::eHigh);
   publish("eScale",        &ScorerMesh::eScale);
   publish("eBinsEdgesFilenamePath", &ScorerMesh::eBinsEdgesFilenamePath);
+  publish("analytic",      &ScorerMesh::analytic);
   publish("sequence",      &ScorerMesh::sequence);
   publish("referenceElement", &ScorerMesh::referenceElement);
   publish("referenceElementNumber", &ScorerMesh::referenceElementNumber);
@@ -114,6 +116,7 @@ void ScorerMesh::print()const
             << "eLow "          << eLow          << std::endl
             << "eHigh "         << eHigh         << std::endl
             << "eScale "        << eScale        << std::endl
+            << "analytic "      << analytic      << std::endl
             << "sequence "      << sequence      << std::endl
             << "referenceElement " << referenceElement << std::endl
             << "referenceElementNumber " << referenceElementNumber << std::endl
@@ -0,0 +1,106 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*
+ * Benchmark of parsing and expanding a large synthetic lattice.
+ *
+ * Writes a lattice in the style of one converted from MAD-X, with every element
+ * defined individually and used once in a single flat line, plus a nested line of
+ * repeated cells, then times the parser on it. The result is written to a binary
+ * file and the time to load that instead is compared.
+ */
+#include "parser.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace GMAD;
+
+int main(int argc, char *argv[])
+{
+  int nElements = 100000;
+  if (argc > 1)
+    {nElements = std::atoi(argv[1]);}
+  if (nElements < 4)
+    {
+      std::cout << "gmadBenchmark needs at least 4 elements" << std::endl;
+      return 1;
+    }
+  const std::string fileName = "benchmark_lattice_" + std::to_string(nElements) + ".gmad";
+
+  std::ofstream f(fileName);
+  for (int i = 0; i < nElements; i++)
+    {
+      const std::string n = std::to_string(i);
+      switch (i % 4)
+        {
+        case 0:
+          {f << "qf" << n << ": quadrupole, l=0.5*m, k1=" << 0.01 + 1e-7*i << ";\n"; break;}
+        case 2:
+          {f << "qd" << n << ": quadrupole, l=0.5*m, k1=" << -0.01 - 1e-7*i << ";\n"; break;}
+        default:
+          {f << "d" << n << ": drift, l=1*m, aper1=2*cm;\n"; break;}
+        }
+    }
+  f << "flat: line=(";
+  for (int i = 0; i < nElements; i++)
+    {
+      const std::string n = std::to_string(i);
+      f << (i % 4 == 0 ? "qf" : i % 4 == 2 ? "qd" : "d") << n;
+      f << (i < nElements - 1 ? (i % 10 == 9 ? ",\n" : ",") : ");\n");
+    }
+  // the same number of elements again built from nested repetition
+  const int nCells = nElements / 4;
+  f << "cell: line=(qf0, d1, qd2, d3);\n";
+  f << "arc: line=(" << nCells / 100 << "*cell);\n";
+  f << "ring: line=(100*arc, " << nCells % 100 << "*cell);\n";
+  f << "use, flat;\n";
+  f << "nested: placement, sequence=\"ring\", x=10*m;\n";
+  f << "beam, particle=\"proton\", energy=10*GeV;\n";
+  f.close();
+
+  auto start = std::chrono::steady_clock::now();
+  Parser* parser = Parser::Instance(fileName);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  int nFlat = parser->GetBeamline().size() - 1; // first entry is the line itself
+  int nNested = parser->get_sequence("ring").size() - 1;
+  std::cout << "parsed " << nElements << " definitions, expanded " << nFlat << " + " << nNested
+            << " elements in " << elapsed.count() << " s" << std::endl;
+  const std::string binaryFileName = "benchmark_lattice_" + std::to_string(nElements) + ".gmadb";
+  parser->WriteBinary(binaryFileName);
+  delete parser;
+
+  start = std::chrono::steady_clock::now();
+  parser = Parser::Instance(binaryFileName);
+  std::chrono::duration<double> elapsedBinary = std::chrono::steady_clock::now() - start;
+
+  int nFlatBinary = parser->GetBeamline().size() - 1;
+  int nNestedBinary = parser->get_sequence("ring").size() - 1;
+  std::cout << "loaded " << nFlatBinary << " + " << nNestedBinary << " elements from binary in "
+            << elapsedBinary.count() << " s" << std::endl;
+  delete parser;
+
+  int nExpected = nElements + 4*(100*(nCells/100) + nCells%100);
+  bool parsedOK = nFlat + nNested == nExpected;
+  bool binaryOK = nFlatBinary == nFlat && nNestedBinary == nNested;
+  return (parsedOK && binaryOK) ? 0 : 1;
+}
@@ -0,0 +1,214 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/*
+ * Round trip of the parsed state through a binary file.
+ *
+ * Parses the input file, writes the state to a binary file with Parser::WriteBinary
+ * and loads that again. The full state - the beamline, the options, the beam, every
+ * list of defined objects including fields and placements, the sequences and element
+ * definitions used by placements and the sampler particle filters - is printed with
+ * every published member at full precision for both and the two must be identical.
+ */
+#include "elementtype.h"
+#include "parser.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace GMAD;
+
+namespace
+{
+  /// Print the members of an element including those not published.
+  void PrintElement(const Element& element, std::ostream& out)
+  {
+    out << "element " << element.name << " type " << static_cast<int>(element.type) << "\n";
+    element.PrintPublished(&element, out);
+    out << "biasMaterialList =";
+    for (const auto& name : element.biasMaterialList)
+      {out << " " << name;}
+    out << "\nbiasVacuumList =";
+    for (const auto& name : element.biasVacuumList)
+      {out << " " << name;}
+    out << "\nsamplerParticleSetID = " << element.samplerParticleSetID
+        << "\nangleSet = " << element.angleSet
+        << "\nscalingFieldOuterSet = " << element.scalingFieldOuterSet << "\n";
+  }
+
+  void PrintSequence(const std::string& name, const FastList<Element>& sequence, std::ostream& out)
+  {
+    out << "sequence " << name << " of " << sequence.size() << "\n";
+    for (const auto& element : sequence)
+      {PrintElement(element, out);}
+  }
+
+  void PrintKeys(const std::vector<std::string>& keys, std::ostream& out)
+  {
+    out << "set keys =";
+    for (const auto& key : keys)
+      {out << " " << key;}
+    out << "\n";
+  }
+
+  /// Print every object in the list of parser class C.
+  template <class C>
+  void PrintList(Parser* parser, const std::string& className, std::ostream& out)
+  {
+    const FastList<C>& list = parser->GetList<C>();
+    out << className << " list of " << list.size() << "\n";
+    for (const auto& object : list)
+      {
+        out << className << "\n";
+        object.PrintPublished(&object, out);
+      }
+  }
+
+  /// The full state of the parser as text.
+  std::string PrintState(Parser* parser)
+  {
+    std::ostringstream out;
+    out << "line " << parser->current_line << " from " << parser->current_start
+        << " to " << parser->current_end << "\n";
+    PrintSequence("beamline", parser->GetBeamline(), out);
+
+    const Options& options = parser->GetGlobal<Options>();
+    out << "options\n";
+    options.PrintPublished(&options, out);
+    PrintKeys(options.KeysOfSetValues(), out);
+    const Beam& beam = parser->GetGlobal<Beam>();
+    out << "beam\n";
+    beam.PrintPublished(&beam, out);
+    PrintKeys(beam.KeysOfSetValues(), out);
+
+    PrintList<Atom>(parser, "atom", out);
+    PrintList<NewColour>(parser, "newcolour", out);
+    PrintList<Crystal>(parser, "crystal", out);
+    PrintList<Field>(parser, "field", out);
+    PrintList<Material>(parser, "material", out);
+    PrintList<Query>(parser, "query", out);
+    PrintList<Region>(parser, "region", out);
+    PrintList<Tunnel>(parser, "tunnel", out);
+    PrintList<Placement>(parser, "placement", out);
+    PrintList<CavityModel>(parser, "cavitymodel", out);
+    PrintList<SamplerPlacement>(parser, "samplerplacement", out);
+    PrintList<Scorer>(parser, "scorer", out);
+    PrintList<ScorerMesh>(parser, "scorermesh", out);
+    PrintList<Aperture>(parser, "aperture", out);
+    PrintList<BLMPlacement>(parser, "blm", out);
+    PrintList<Modulator>(parser, "modulator", out);
+    for (const auto& samplerPlacement : parser->GetList<SamplerPlacement>())
+      {out << "partIDSetID = " << samplerPlacement.partIDSetID << "\n";}
+
+    const auto& biases = parser->GetList<PhysicsBiasing, FastList<PhysicsBiasing>>();
+    out << "xsecbias list of " << biases.size() << "\n";
+    out.precision(17);
+    for (const auto& bias : biases)
+      {
+        out << "xsecbias " << bias.name << " particle " << bias.particle << " process " << bias.process << "\n";
+        for (const auto& process : bias.processList)
+          {out << " " << process;}
+        for (const auto& factor : bias.factor)
+          {out << " " << factor;}
+        for (const auto& flag : bias.flag)
+          {out << " " << static_cast<int>(flag);}
+        out << "\n";
+      }
+
+    // the sequences and element definitions that placements refer to
+    for (const auto& placement : parser->GetList<Placement>())
+      {
+        if (!placement.sequence.empty())
+          {PrintSequence(placement.sequence, parser->get_sequence(placement.sequence), out);}
+        if (!placement.bdsimElement.empty())
+          {
+            const Element* element = parser->find_placement_element_safe(placement.bdsimElement);
+            if (element)
+              {PrintElement(*element, out);}
+            else
+              {out << "placement element " << placement.bdsimElement << " missing\n";}
+          }
+      }
+    for (const auto& mesh : parser->GetList<ScorerMesh>())
+      {
+        if (!mesh.sequence.empty())
+          {PrintSequence(mesh.sequence, parser->get_sequence(mesh.sequence), out);}
+      }
+
+    out << "sampler filters\n";
+    for (const auto& kv : parser->GetSamplerFilterIDToSet())
+      {
+        out << kv.first << ":";
+        for (int id : kv.second)
+          {out << " " << id;}
+        out << "\n";
+      }
+    return out.str();
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc != 3)
+    {
+      std::cout << "usage: gmadRoundTrip <input.gmad> <output.gmadb>" << std::endl;
+      return 1;
+    }
+  const std::string fileName = argv[1];
+  const std::string binaryFileName = argv[2];
+
+  Parser* parser = Parser::Instance(fileName);
+  const std::string parsed = PrintState(parser);
+  parser->WriteBinary(binaryFileName);
+  delete parser;
+
+  parser = Parser::Instance(binaryFileName);
+  const std::string loaded = PrintState(parser);
+  delete parser;
+
+  if (parsed == loaded)
+    {
+      std::cout << "state loaded from " << binaryFileName << " matches " << fileName
+                << " (" << parsed.size() << " characters)" << std::endl;
+      return 0;
+    }
+
+  // report the first line that differs
+  std::istringstream parsedLines(parsed);
+  std::istringstream loadedLines(loaded);
+  std::string parsedLine;
+  std::string loadedLine;
+  int lineNumber = 1;
+  while (true)
+    {
+      bool moreParsed = static_cast<bool>(std::getline(parsedLines, parsedLine));
+      bool moreLoaded = static_cast<bool>(std::getline(loadedLines, loadedLine));
+      if (!moreParsed)
+        {parsedLine = "<end>";}
+      if (!moreLoaded)
+        {loadedLine = "<end>";}
+      if (parsedLine != loadedLine || (!moreParsed && !moreLoaded))
+        {break;}
+      lineNumber++;
+    }
+  std::cout << "state loaded from " << binaryFileName << " differs from " << fileName
+            << " at line " << lineNumber << ":\n  parsed: " << parsedLine
+            << "\n  loaded: " << loadedLine << std::endl;
+  return 1;
+}
@@ -35,6 +35,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <algorithm>
 #include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 #include <string>
 
 G4Material* BDSAcceleratorComponent::emptyMaterial   = nullptr;
@@ -43,6 +46,7 @@ G4double    BDSAcceleratorComponent::lengthSafety    = -1;
 G4bool      BDSAcceleratorComponent::checkOverlaps   = false;
 G4bool      BDSAcceleratorComponent::sensitiveOuter  = true;
 G4bool      BDSAcceleratorComponent::sensitiveVacuum = false;
+G4bool      BDSAcceleratorComponent::reuseIdenticalGeometry = false;
 G4VisAttributes* BDSAcceleratorComponent::containerVisAttr = nullptr;
 G4double    BDSAcceleratorComponent::lengthSafetyLarge = 0;
 
@@ -79,6 +83,7 @@ BDSAcceleratorComponent::BDSAcceleratorComponent(const G4String&      nameIn,
       checkOverlaps      = globals->CheckOverlaps();
       sensitiveOuter     = globals->SensitiveOuter();
       sensitiveVacuum    = globals->StoreELossVacuum();
+      reuseIdenticalGeometry = globals->ReuseIdenticalGeometry();
       containerVisAttr   = BDSGlobalConstants::Instance()->ContainerVisAttr();
     }
 
@@ -191,6 +196,19 @@ void BDSAcceleratorComponent::AttachUserLimits() const
     }
 }
 
+G4String BDSAcceleratorComponent::SharedGeometryKey() const
+{
+  std::ostringstream key;
+  key << std::setprecision(std::numeric_limits<G4double>::max_digits10);
+  key << type << "|" << arcLength << "|" << chordLength << "|" << angle << "|" << region << "|";
+  for (const auto& bias : biasVacuumList)
+    {key << bias << ",";}
+  key << "|";
+  for (const auto& bias : biasMaterialList)
+    {key << bias << ",";}
+  return G4String(key.str());
+}
+
 std::set<G4LogicalVolume*> BDSAcceleratorComponent::GetAcceleratorMaterialLogicalVolumes() const
 {
   // get full set minus ones marked to be excluded completely from biasing
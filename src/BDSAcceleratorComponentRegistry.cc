@@ -132,7 +132,7 @@ G4bool BDSAcceleratorComponentRegistry::IsRegistered(BDSAcceleratorComponent* co
 
 G4bool BDSAcceleratorComponentRegistry::IsRegisteredAllocated(const BDSAcceleratorComponent* component) const
 {
-  return std::find(allocatedComponents.begin(), allocatedComponents.end(), component) != allocatedComponents.end();
+  return allocatedComponents.find(const_cast<BDSAcceleratorComponent*>(component)) != allocatedComponents.end();
 }
 
 G4bool BDSAcceleratorComponentRegistry::IsRegistered(const G4String& name,
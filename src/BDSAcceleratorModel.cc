@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSFieldObjects.hh"
+#include "BDSGeometryComponent.hh"
 #include "BDSLinkComponent.hh"
 #include "BDSPhysicalVolumeInfoRegistry.hh"
 #include "BDSRegion.hh"
@@ -101,6 +102,9 @@ BDSAcceleratorModel::~BDSAcceleratorModel()
   for (auto& vr : volumeRegistries)
     {delete vr.second;}
 
+  for (auto& sg : sharedGeometry)
+    {delete sg.second;}
+
   G4cout << "BDSAcceleratorModel> Deletion complete" << G4endl;
 
   instance = nullptr;
@@ -134,6 +138,25 @@ const BDSBeamlineSet& BDSAcceleratorModel::BeamlineSet(const G4String& name) con
     {return search->second;}
 }
 
+void BDSAcceleratorModel::RegisterSharedGeometry(const G4String&       key,
+                                                 BDSGeometryComponent* component)
+{
+  auto search = sharedGeometry.find(key);
+  if (search != sharedGeometry.end())
+    {
+      if (search->second == component)
+        {return;}
+      delete search->second;
+    }
+  sharedGeometry[key] = component;
+}
+
+BDSGeometryComponent* BDSAcceleratorModel::SharedGeometry(const G4String& key) const
+{
+  auto search = sharedGeometry.find(key);
+  return search != sharedGeometry.end() ? search->second : nullptr;
+}
+
 void BDSAcceleratorModel::RegisterRegion(BDSRegion* region)
 {
   regions[region->name] = region;
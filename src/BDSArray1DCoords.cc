@@ -31,11 +31,14 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 BDSArray1DCoords::BDSArray1DCoords(G4int            nXIn,
 				   G4double         xMinIn,
 				   G4double         xMaxIn,
-				   BDSDimensionType dimensionIn):
+				   BDSDimensionType dimensionIn,
+				   G4bool           allocateDataIn):
   BDSArray2DCoords(nXIn,1,
 		   xMinIn,xMaxIn,
 		   0,   1,
-		   dimensionIn)
+		   dimensionIn,
+		   BDSDimensionType::y,
+		   allocateDataIn)
 {
   std::set<BDSDimensionType> allDims = {BDSDimensionType::x,
                                         BDSDimensionType::y,
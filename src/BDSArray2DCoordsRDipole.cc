@@ -27,8 +27,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 
 BDSArray2DCoordsRDipole::BDSArray2DCoordsRDipole(BDSArray2DCoords* arrayIn):
-  BDSArray2DCoords(*arrayIn),
-  returnValue(BDSFieldValue())
+  BDSArray2DCoords(*arrayIn)
 {;}
 
 G4bool BDSArray2DCoordsRDipole::OutsideCoords(G4double x,
@@ -64,10 +63,10 @@ G4int BDSArray2DCoordsRDipole::NearestY(G4double y) const
   return (G4int)round((y+yMax)/yStep);
 }
 
-const BDSFieldValue& BDSArray2DCoordsRDipole::GetConst(G4int x,
-						       G4int y,
-						       G4int z,
-						       G4int t) const
+BDSFieldValue BDSArray2DCoordsRDipole::GetConst(G4int x,
+						G4int y,
+						G4int z,
+						G4int t) const
 {
   if (Outside(x,y,z,t))
     {return defaultValue;}
@@ -114,7 +113,7 @@ const BDSFieldValue& BDSArray2DCoordsRDipole::GetConst(G4int x,
 	}
     }
 
-  returnValue = BDSArray2DCoords::GetConst(xi,yi,z,t);
+  BDSFieldValue returnValue = BDSArray2DCoords::GetConst(xi,yi,z,t);
   
   returnValue[0] = returnValue.x() * xr;
   returnValue[1] = returnValue.y() * yr;
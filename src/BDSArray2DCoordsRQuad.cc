@@ -27,8 +27,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 
 BDSArray2DCoordsRQuad::BDSArray2DCoordsRQuad(BDSArray2DCoords* arrayIn):
-  BDSArray2DCoords(*arrayIn),
-  returnValue(BDSFieldValue())
+  BDSArray2DCoords(*arrayIn)
 {;}
 
 G4bool BDSArray2DCoordsRQuad::OutsideCoords(G4double x,
@@ -63,10 +62,10 @@ G4int BDSArray2DCoordsRQuad::NearestY(G4double y) const
   return (G4int)round(ArrayCoordsFromY(y));
 }
 
-const BDSFieldValue& BDSArray2DCoordsRQuad::GetConst(G4int x,
-						     G4int y,
-						     G4int z,
-						     G4int t) const
+BDSFieldValue BDSArray2DCoordsRQuad::GetConst(G4int x,
+					      G4int y,
+					      G4int z,
+					      G4int t) const
 {
   if (Outside(x,y,z,t))
     {return defaultValue;}
@@ -122,7 +121,7 @@ const BDSFieldValue& BDSArray2DCoordsRQuad::GetConst(G4int x,
       swapResult = true;
     }
 
-  returnValue = BDSArray2DCoords::GetConst(xi,yi,z,t);
+  BDSFieldValue returnValue = BDSArray2DCoords::GetConst(xi,yi,z,t);
 
   if (swapResult)
     {
@@ -31,7 +31,8 @@ BDSArray3DCoords::BDSArray3DCoords(G4int nXIn, G4int nYIn, G4int nZIn,
 				   G4double zMinIn, G4double zMaxIn,
 				   BDSDimensionType xDimensionIn,
 				   BDSDimensionType yDimensionIn,
-				   BDSDimensionType zDimensionIn):
+				   BDSDimensionType zDimensionIn,
+				   G4bool           allocateDataIn):
   BDSArray4DCoords(nXIn,nYIn,nZIn,1,
 		   xMinIn,xMaxIn,
 		   yMinIn,yMaxIn,
@@ -39,7 +40,9 @@ BDSArray3DCoords::BDSArray3DCoords(G4int nXIn, G4int nYIn, G4int nZIn,
 		   0,   1,
 		   xDimensionIn,
 		   yDimensionIn,
-		   zDimensionIn)
+		   zDimensionIn,
+		   BDSDimensionType::t,
+		   allocateDataIn)
 {
   std::set<BDSDimensionType> allDims = {BDSDimensionType::x,
                                         BDSDimensionType::y,
@@ -23,40 +23,224 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "globals.hh" // geant4 types / globals
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 
-BDSArray4D::BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn):
+BDSArray4D::BDSArray4D(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTIn,
+		       G4bool allocateDataIn):
   nX(nXIn), nY(nYIn), nZ(nZIn), nT(nTIn),
   defaultValue(BDSFieldValue()),
-  data(std::vector<BDSFieldValue>(nTIn*nZIn*nYIn*nXIn))
+  data(nullptr),
+  readOnly(false),
+  quantisedData(nullptr),
+  quantisationStep(BDSFieldValue()),
+  nStored(NValues()),
+  tiled(false),
+  tileStrideT(0)
+{
+  if (allocateDataIn)
+    {
+      ownedData = std::vector<BDSFieldValue>(NValues());
+      data = ownedData.data();
+    }
+}
+
+BDSArray4D::BDSArray4D(const BDSArray4D& other):
+  nX(other.nX), nY(other.nY), nZ(other.nZ), nT(other.nT),
+  defaultValue(other.defaultValue),
+  ownedData(other.ownedData),
+  data(other.readOnly ? other.data : ownedData.data()),
+  keepAlive(other.keepAlive),
+  readOnly(other.readOnly),
+  quantisedStore(other.quantisedStore),
+  quantisedData(other.quantisedData),
+  quantisationStep(other.quantisationStep),
+  nStored(other.nStored),
+  tiled(other.tiled),
+  tileOffsetX(other.tileOffsetX),
+  tileOffsetY(other.tileOffsetY),
+  tileOffsetZ(other.tileOffsetZ),
+  tileStrideT(other.tileStrideT)
 {;}
 
+void BDSArray4D::UseExternalData(const BDSFieldValue* externalDataIn,
+				 std::shared_ptr<const void> keepAliveIn,
+				 G4bool tiledIn)
+{
+  if (!externalDataIn)
+    {throw BDSException(__METHOD_NAME__, "invalid external data");}
+  if (Quantised())
+    {throw BDSException(__METHOD_NAME__, "array is quantised - use UseExternalQuantisedData()");}
+  MatchExternalLayout(tiledIn);
+  std::vector<BDSFieldValue>().swap(ownedData); // release the memory
+  // only read through GetConst() from now on - operator() checks readOnly
+  data      = const_cast<BDSFieldValue*>(externalDataIn);
+  keepAlive = std::move(keepAliveIn);
+  readOnly  = true;
+}
+
+void BDSArray4D::UseExternalQuantisedData(const std::int16_t* externalDataIn,
+					  const BDSFieldValue& quantisationStepIn,
+					  std::shared_ptr<const void> keepAliveIn,
+					  G4bool tiledIn)
+{
+  if (!externalDataIn)
+    {throw BDSException(__METHOD_NAME__, "invalid external data");}
+  MatchExternalLayout(tiledIn);
+  std::vector<BDSFieldValue>().swap(ownedData); // release the memory
+  data = nullptr;
+  quantisedStore.reset();
+  quantisedData    = externalDataIn;
+  quantisationStep = quantisationStepIn;
+  keepAlive = std::move(keepAliveIn);
+  readOnly  = true;
+}
+
+void BDSArray4D::MatchExternalLayout(G4bool tiledIn)
+{
+  if (tiled == tiledIn)
+    {return;}
+  if (tiled)
+    {throw BDSException(__METHOD_NAME__, "array is tiled but external data is in t,z,y,x order");}
+  SetTiledLayout();
+}
+
+void BDSArray4D::SetTiledLayout()
+{
+  // 4 points per tiled dimension - a 4x4x4 cubic neighbourhood then spans at most 2 tiles
+  // in each dimension. A dimension with 1 point isn't tiled to avoid padding it.
+  auto tileSize = [](G4int n){return n > 1 ? 4 : 1;};
+  const G4int sX = tileSize(nX);
+  const G4int sY = tileSize(nY);
+  const G4int sZ = tileSize(nZ);
+  const std::size_t nTilesX = (nX + sX - 1) / sX;
+  const std::size_t nTilesY = (nY + sY - 1) / sY;
+  const std::size_t nTilesZ = (nZ + sZ - 1) / sZ;
+  const std::size_t tileVolume = (std::size_t)sX*sY*sZ;
+
+  // tiles are ordered x fastest as are the points within each tile
+  tileOffsetX.resize(nX);
+  for (G4int x = 0; x < nX; x++)
+    {tileOffsetX[x] = (x / sX)*tileVolume + (x % sX);}
+  tileOffsetY.resize(nY);
+  for (G4int y = 0; y < nY; y++)
+    {tileOffsetY[y] = (y / sY)*nTilesX*tileVolume + (y % sY)*sX;}
+  tileOffsetZ.resize(nZ);
+  for (G4int z = 0; z < nZ; z++)
+    {tileOffsetZ[z] = (z / sZ)*nTilesY*nTilesX*tileVolume + (z % sZ)*sY*sX;}
+  tileStrideT = nTilesZ*nTilesY*nTilesX*tileVolume;
+  nStored = tileStrideT*nT;
+  tiled   = true; // Index() now gives the tiled position
+}
+
+void BDSArray4D::Tile()
+{
+  if (tiled)
+    {return;}
+  if (Quantised())
+    {throw BDSException(__METHOD_NAME__, "array must be tiled before it is quantised");}
+  if (!data)
+    {throw BDSException(__METHOD_NAME__, "no data to tile");}
+
+  const BDSFieldValue* linearData = data;
+  SetTiledLayout();
+  std::vector<BDSFieldValue> tiledData(nStored);
+  std::size_t i = 0;
+  for (G4int t = 0; t < nT; t++)
+    {
+      for (G4int z = 0; z < nZ; z++)
+	{
+	  for (G4int y = 0; y < nY; y++)
+	    {
+	      for (G4int x = 0; x < nX; x++)
+		{tiledData[Index(x,y,z,t)] = linearData[i++];}
+	    }
+	}
+    }
+
+  ownedData.swap(tiledData); // linear data released at the end of this function
+  data = ownedData.data();
+  keepAlive.reset();
+  readOnly = false;
+}
+
+void BDSArray4D::Quantise()
+{
+  if (Quantised())
+    {return;}
+  if (!data)
+    {throw BDSException(__METHOD_NAME__, "no data to quantise");}
+
+  const std::size_t nValues = NStored();
+  BDSFieldValue maxMagnitude;
+  for (std::size_t i = 0; i < nValues; i++)
+    {
+      for (G4int c = 0; c < 3; c++)
+	{maxMagnitude[c] = std::max(maxMagnitude[c], (FIELDTYPET)std::abs(data[i][c]));}
+    }
+
+  // the symmetric range is used so +/- the maximum magnitude are both representable
+  const FIELDTYPET nSteps = (FIELDTYPET)std::numeric_limits<std::int16_t>::max();
+  for (G4int c = 0; c < 3; c++)
+    {quantisationStep[c] = maxMagnitude[c] > 0 ? maxMagnitude[c] / nSteps : (FIELDTYPET)1;}
+
+  auto store = std::make_shared<std::vector<std::int16_t> >(3*nValues);
+  std::int16_t* q = store->data();
+  for (std::size_t i = 0; i < nValues; i++)
+    {
+      for (G4int c = 0; c < 3; c++)
+	{q[3*i + c] = (std::int16_t)std::lround(data[i][c] / quantisationStep[c]);}
+    }
+
+  quantisedStore = std::move(store);
+  quantisedData  = quantisedStore->data();
+  std::vector<BDSFieldValue>().swap(ownedData); // release the memory
+  data = nullptr;
+  keepAlive.reset();
+  readOnly = true;
+}
+
 BDSFieldValue& BDSArray4D::operator()(G4int x,
 				      G4int y,
 				      G4int z,
 				      G4int t)
 {
   OutsideWarn(x,y,z,t); // keep as a warning as can't assign to invalid index
-  return data[t*nZ*nY*nX + z*nY*nX + y*nX + x];
+  if (readOnly)
+    {throw BDSException(__METHOD_NAME__, "array data is shared or quantised and read-only");}
+  return data[Index(x,y,z,t)];
 }
 
-const BDSFieldValue& BDSArray4D::GetConst(G4int x,
-					  G4int y,
-					  G4int z,
-					  G4int t) const
+BDSFieldValue BDSArray4D::GetConst(G4int x,
+				   G4int y,
+				   G4int z,
+				   G4int t) const
 {
   if (Outside(x,y,z,t))
     {return defaultValue;}
-  return data[t*nZ*nY*nX + z*nY*nX + y*nX + x];
+  std::size_t index = Index(x,y,z,t);
+  if (quantisedData)
+    {
+      const std::int16_t* q = quantisedData + 3*index;
+      return BDSFieldValue(q[0] * quantisationStep.x(),
+			   q[1] * quantisationStep.y(),
+			   q[2] * quantisationStep.z());
+    }
+  return data[index];
 }
   
-const BDSFieldValue& BDSArray4D::operator()(G4int x,
-					    G4int y,
-					    G4int z,
-					    G4int t) const
+BDSFieldValue BDSArray4D::operator()(G4int x,
+				     G4int y,
+				     G4int z,
+				     G4int t) const
 {
   return GetConst(x,y,z,t);
 }
@@ -41,8 +41,9 @@ BDSArray4DCoords::BDSArray4DCoords(G4int nXIn, G4int nYIn, G4int nZIn, G4int nTI
                                    BDSDimensionType xDimensionIn,
                                    BDSDimensionType yDimensionIn,
                                    BDSDimensionType zDimensionIn,
-                                   BDSDimensionType tDimensionIn):
-  BDSArray4D(nXIn,nYIn,nZIn,nTIn),
+                                   BDSDimensionType tDimensionIn,
+                                   G4bool           allocateDataIn):
+  BDSArray4D(nXIn,nYIn,nZIn,nTIn,allocateDataIn),
   xMin(xMinIn), xMax(xMaxIn),
   yMin(yMinIn), yMax(yMaxIn),
   zMin(zMinIn), zMax(zMaxIn),
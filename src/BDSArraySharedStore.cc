@@ -0,0 +1,417 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray1DCoords.hh"
+#include "BDSArray2DCoords.hh"
+#include "BDSArray3DCoords.hh"
+#include "BDSArray4DCoords.hh"
+#include "BDSArraySharedStore.hh"
+#include "BDSDebug.hh"
+#include "BDSDimensionType.hh"
+#include "BDSException.hh"
+#include "BDSFieldValue.hh"
+#include "BDSWarning.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+#include "G4Types.hh"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char          BDSArraySharedStore::identifier[8] = {'B','D','S','I','M','S','H','M'};
+const std::uint32_t BDSArraySharedStore::version = 2;
+
+namespace
+{
+  /// Close a file descriptor when leaving scope unless released. For a lock file,
+  /// this releases the lock.
+  struct FileDescriptorGuard
+  {
+    explicit FileDescriptorGuard(int fdIn): fd(fdIn) {;}
+    ~FileDescriptorGuard() {if (fd >= 0) {close(fd);}}
+    void Release() {fd = -1;}
+    int fd;
+  };
+
+  G4String Hex(std::uint64_t value)
+  {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)value);
+    return G4String(buffer);
+  }
+
+  /// Remove the segment and both lock files if usersFD holds the only lock on the users file.
+  /// Must only be called while holding the exclusive lock on lockPath.
+  G4bool RemoveIfUnused(int usersFD,
+			const G4String& shmName,
+			const G4String& usersPath,
+			const G4String& lockPath)
+  {
+    if (flock(usersFD, LOCK_EX | LOCK_NB) != 0)
+      {return false;}
+    shm_unlink(shmName.c_str());
+    unlink(usersPath.c_str());
+    unlink(lockPath.c_str());
+    return true;
+  }
+}
+
+BDSArray4DCoords* BDSArraySharedStore::LoadOrAttach(const G4String& filePath,
+						    const G4String& formatName,
+						    G4int nDim,
+						    G4bool tiled,
+						    G4bool quantised,
+						    const std::function<BDSArray4DCoords*()>& load)
+{
+  // __METHOD_NAME__ is confused by the std::function argument
+  const G4String methodName = "BDSArraySharedStore::LoadOrAttach> ";
+  std::uint64_t contentHash = 0;
+  try
+    {contentHash = ContentHash(filePath);}
+  catch (const BDSException&)
+    {return load();} // let the usual loader report the problem with the file
+
+  G4String canonicalPath = filePath;
+  if (char* resolved = realpath(filePath.c_str(), nullptr))
+    {
+      canonicalPath = G4String(resolved);
+      std::free(resolved);
+    }
+  const G4String uid = std::to_string((unsigned long)getuid());
+  std::string key = uid + "\n" + canonicalPath + "\n" + formatName + "\n" + std::to_string(nDim) + "\n";
+  key += std::string(tiled ? "tiled" : "linear") + "\n" + std::string(quantised ? "int16" : "standard") + "\n";
+  key += std::to_string(sizeof(BDSFieldValue)) + "\n" + Hex(contentHash);
+  // short name as some systems permit only 31 characters
+  G4String hashName = "bdsim" + uid + "_" + Hex(Hash(key.data(), key.size())).substr(0, 12);
+  G4String shmName  = "/" + hashName;
+  const char* tmpDir = std::getenv("TMPDIR");
+  G4String basePath  = G4String(tmpDir ? tmpDir : "/tmp") + "/" + hashName;
+  G4String lockPath  = basePath + ".lock";
+  G4String usersPath = basePath + ".users";
+
+  // the first process to take the lock loads and publishes while others wait
+  int lockFD = LockExclusive(lockPath);
+  if (lockFD < 0)
+    {
+      BDS::Warning(methodName, "unable to lock \"" + lockPath + "\" - loading \"" + filePath + "\" without shared memory");
+      return load();
+    }
+  FileDescriptorGuard lock(lockFD);
+
+  // every process using the segment holds a shared lock on this until it is finished with it
+  int usersFD = open(usersPath.c_str(), O_RDWR | O_CREAT | O_NOFOLLOW, 0600);
+  if (usersFD < 0 || flock(usersFD, LOCK_SH) != 0)
+    {
+      if (usersFD >= 0)
+	{close(usersFD);}
+      BDS::Warning(methodName, "unable to open \"" + usersPath + "\" - loading \"" + filePath + "\" without shared memory");
+      return load();
+    }
+  // if this process doesn't end up using the segment, it removes anything nobody else uses
+  FileDescriptorGuard users(usersFD);
+  auto giveUp = [&]()
+  {
+    RemoveIfUnused(usersFD, shmName, usersPath, lockPath);
+    return load();
+  };
+
+  int shmFD = shm_open(shmName.c_str(), O_RDWR | O_CREAT, 0600);
+  if (shmFD < 0)
+    {
+      BDS::Warning(methodName, "unable to open shared memory \"" + shmName + "\" - loading \"" + filePath + "\" without it");
+      return giveUp();
+    }
+  FileDescriptorGuard shm(shmFD);
+
+  struct stat status;
+  if (fstat(shmFD, &status) != 0 || status.st_uid != getuid())
+    {
+      BDS::Warning(methodName, "shared memory \"" + shmName + "\" not owned by this user - loading \"" + filePath + "\" without it");
+      return giveUp();
+    }
+  if (status.st_size > 0)
+    {
+      BDSArray4DCoords* attached = Attach(shmFD, (std::size_t)status.st_size, contentHash, nDim, tiled, quantised,
+					  usersFD, shmName, usersPath, lockPath);
+      if (attached)
+	{
+	  users.Release(); // now owned by the shared data of the array
+	  G4cout << methodName << "\"" << filePath << "\" attached from shared memory \"" << shmName << "\"" << G4endl;
+	  return attached;
+	}
+      // left by a process that failed while publishing or a hash collision - remove it
+      // so the next process can publish again and load this one privately
+      BDS::Warning(methodName, "invalid shared memory \"" + shmName + "\" removed - loading \"" + filePath + "\" without it");
+      shm_unlink(shmName.c_str());
+      return giveUp();
+    }
+
+  BDSArray4DCoords* result = load();
+  if (result && Publish(shmFD, shmName, contentHash, nDim, result, usersFD, usersPath, lockPath))
+    {users.Release();} // now owned by the shared data of the array
+  else
+    {RemoveIfUnused(usersFD, shmName, usersPath, lockPath);}
+  return result;
+}
+
+int BDSArraySharedStore::LockExclusive(const G4String& lockPath)
+{
+  // The last process to use a segment removes the lock file. A process that opened
+  // it before then locks a file that no longer has that path, so it tries again.
+  for (G4int attempt = 0; attempt < 10; attempt++)
+    {
+      int fd = open(lockPath.c_str(), O_RDWR | O_CREAT | O_NOFOLLOW, 0600);
+      if (fd < 0)
+	{return -1;}
+      struct stat fdStatus;
+      if (fstat(fd, &fdStatus) != 0 || fdStatus.st_uid != getuid() || flock(fd, LOCK_EX) != 0)
+	{close(fd); return -1;}
+      struct stat pathStatus;
+      if (stat(lockPath.c_str(), &pathStatus) == 0
+	  && pathStatus.st_dev == fdStatus.st_dev
+	  && pathStatus.st_ino == fdStatus.st_ino)
+	{return fd;}
+      close(fd);
+    }
+  return -1;
+}
+
+std::uint64_t BDSArraySharedStore::ContentHash(const G4String& filePath)
+{
+  std::ifstream file(filePath, std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    {throw BDSException(__METHOD_NAME__, "unable to open \"" + filePath + "\"");}
+  std::uint64_t hash = 14695981039346656037ULL;
+  std::vector<char> buffer(1 << 20);
+  while (file)
+    {
+      file.read(buffer.data(), (std::streamsize)buffer.size());
+      hash = Hash(buffer.data(), (std::size_t)file.gcount(), hash);
+    }
+  return hash;
+}
+
+std::shared_ptr<const void> BDSArraySharedStore::MappingOwner(void* address,
+							      std::size_t size,
+							      int usersFD,
+							      const G4String& shmName,
+							      const G4String& usersPath,
+							      const G4String& lockPath)
+{
+  auto release = [size, usersFD, shmName, usersPath, lockPath](const void* p)
+  {
+    munmap(const_cast<void*>(p), size);
+    int lockFD = LockExclusive(lockPath);
+    if (lockFD >= 0)
+      {
+	FileDescriptorGuard lock(lockFD);
+	RemoveIfUnused(usersFD, shmName, usersPath, lockPath);
+      }
+    close(usersFD);
+  };
+  return std::shared_ptr<const void>(address, release);
+}
+
+BDSArray4DCoords* BDSArraySharedStore::Attach(int fd,
+					      std::size_t size,
+					      std::uint64_t contentHash,
+					      G4int nDim,
+					      G4bool tiled,
+					      G4bool quantised,
+					      int usersFD,
+					      const G4String& shmName,
+					      const G4String& usersPath,
+					      const G4String& lockPath)
+{
+  void* address = size < sizeof(Header) ? MAP_FAILED : mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED)
+    {return nullptr;}
+  
+  Header header;
+  std::memcpy(&header, address, sizeof(Header));
+  std::size_t valueSize = quantised ? 3*sizeof(std::int16_t) : sizeof(BDSFieldValue);
+  G4bool valid = std::memcmp(header.identifier, identifier, sizeof(identifier)) == 0
+    && header.version     == version
+    && header.complete    == 1
+    && header.contentHash == contentHash
+    && header.valueSize   == sizeof(BDSFieldValue)
+    && header.nDim        == nDim
+    && header.tiled       == (std::uint32_t)tiled
+    && header.quantised   == (std::uint32_t)quantised
+    && header.dataOffset + header.nStored * valueSize <= size; // may be page rounded
+  if (!valid)
+    {
+      munmap(address, size);
+      return nullptr;
+    }
+
+  BDSArray4DCoords* result = CreateArray(header);
+  std::shared_ptr<const void> mapping = MappingOwner(address, size, usersFD, shmName, usersPath, lockPath);
+  const char* data = static_cast<const char*>(address) + header.dataOffset;
+  if (quantised)
+    {
+      BDSFieldValue step((FIELDTYPET)header.quantisationStep[0],
+			 (FIELDTYPET)header.quantisationStep[1],
+			 (FIELDTYPET)header.quantisationStep[2]);
+      result->UseExternalQuantisedData(reinterpret_cast<const std::int16_t*>(data), step, mapping, tiled);
+    }
+  else
+    {result->UseExternalData(reinterpret_cast<const BDSFieldValue*>(data), mapping, tiled);}
+  return result;
+}
+
+G4bool BDSArraySharedStore::Publish(int fd,
+				    const G4String& shmName,
+				    std::uint64_t contentHash,
+				    G4int nDim,
+				    BDSArray4DCoords* array,
+				    int usersFD,
+				    const G4String& usersPath,
+				    const G4String& lockPath)
+{
+  Header header;
+  std::memset(&header, 0, sizeof(Header));
+  std::memcpy(header.identifier, identifier, sizeof(identifier));
+  header.version     = version;
+  header.complete    = 0;
+  header.contentHash = contentHash;
+  header.valueSize   = sizeof(BDSFieldValue);
+  header.nDim        = nDim;
+  const G4int n[4]   = {array->NX(), array->NY(), array->NZ(), array->NT()};
+  const G4double minimum[4] = {array->XMin(), array->YMin(), array->ZMin(), array->TMin()};
+  const G4double maximum[4] = {array->XMax(), array->YMax(), array->ZMax(), array->TMax()};
+  const BDSDimensionType dimensions[4] = {array->FirstDimension(), array->SecondDimension(),
+					  array->ThirdDimension(), array->FourthDimension()};
+  for (G4int i = 0; i < 4; i++)
+    {
+      header.n[i]             = n[i];
+      header.min[i]           = minimum[i];
+      header.max[i]           = maximum[i];
+      header.dimensionType[i] = dimensions[i].underlying();
+    }
+  // the data is published as stored - tiled and / or quantised
+  const G4bool tiled     = array->Tiled();
+  const G4bool quantised = array->Quantised();
+  const BDSFieldValue step = array->QuantisationStep();
+  header.tiled     = tiled;
+  header.quantised = quantised;
+  for (G4int c = 0; c < 3; c++)
+    {header.quantisationStep[c] = step[c];}
+  header.nStored    = array->NStored();
+  header.dataOffset = ((sizeof(Header) + 63) / 64) * 64; // cache line aligned data
+  const void* source = quantised ? static_cast<const void*>(array->QuantisedData()) : static_cast<const void*>(array->Data());
+  std::size_t dataSize = array->NStored() * (quantised ? 3*sizeof(std::int16_t) : sizeof(BDSFieldValue));
+  std::size_t size     = header.dataOffset + dataSize;
+
+  if (ftruncate(fd, (off_t)size) != 0)
+    {
+      BDS::Warning(__METHOD_NAME__, "unable to size shared memory \"" + shmName + "\" - check the space in /dev/shm");
+      return false;
+    }
+  void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (address == MAP_FAILED)
+    {
+      BDS::Warning(__METHOD_NAME__, "unable to map shared memory \"" + shmName + "\"");
+      return false;
+    }
+  char* data = static_cast<char*>(address) + header.dataOffset;
+  std::memcpy(address, &header, sizeof(Header));
+  std::memcpy(data, source, dataSize);
+  // only complete once all the data is there
+  header.complete = 1;
+  std::memcpy(address, &header, sizeof(Header));
+  mprotect(address, size, PROT_READ);
+  
+  // use the shared copy in this process too so the private one is released
+  std::shared_ptr<const void> mapping = MappingOwner(address, size, usersFD, shmName, usersPath, lockPath);
+  if (quantised)
+    {array->UseExternalQuantisedData(reinterpret_cast<const std::int16_t*>(data), step, mapping, tiled);}
+  else
+    {array->UseExternalData(reinterpret_cast<const BDSFieldValue*>(data), mapping, tiled);}
+  G4cout << __METHOD_NAME__ << "published " << size / (1024.0*1024.0) << " MB to shared memory \"" << shmName << "\"" << G4endl;
+  return true;
+}
+
+BDSArray4DCoords* BDSArraySharedStore::CreateArray(const Header& h)
+{
+  const BDSDimensionType d[4] = {BDSDimensionType(h.dimensionType[0]), BDSDimensionType(h.dimensionType[1]),
+				 BDSDimensionType(h.dimensionType[2]), BDSDimensionType(h.dimensionType[3])};
+  BDSArray4DCoords* result = nullptr;
+  switch (h.nDim)
+    {
+    case 1:
+      {result = new BDSArray1DCoords(h.n[0], h.min[0], h.max[0], d[0], false); break;}
+    case 2:
+      {
+	result = new BDSArray2DCoords(h.n[0], h.n[1],
+				      h.min[0], h.max[0],
+				      h.min[1], h.max[1],
+				      d[0], d[1], false);
+	break;
+      }
+    case 3:
+      {
+	result = new BDSArray3DCoords(h.n[0], h.n[1], h.n[2],
+				      h.min[0], h.max[0],
+				      h.min[1], h.max[1],
+				      h.min[2], h.max[2],
+				      d[0], d[1], d[2], false);
+	break;
+      }
+    case 4:
+      {
+	result = new BDSArray4DCoords(h.n[0], h.n[1], h.n[2], h.n[3],
+				      h.min[0], h.max[0],
+				      h.min[1], h.max[1],
+				      h.min[2], h.max[2],
+				      h.min[3], h.max[3],
+				      d[0], d[1], d[2], d[3], false);
+	break;
+      }
+    default:
+      {throw BDSException(__METHOD_NAME__, "invalid number of dimensions " + std::to_string(h.nDim));}
+    }
+  return result;
+}
+
+std::uint64_t BDSArraySharedStore::Hash(const void* bytes,
+					std::size_t length,
+					std::uint64_t hash)
+{
+  const unsigned char* p = static_cast<const unsigned char*>(bytes);
+  for (std::size_t i = 0; i < length; i++)
+    {
+      hash ^= p[i];
+      hash *= 1099511628211ULL;
+    }
+  return hash;
+}
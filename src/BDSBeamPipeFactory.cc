@@ -29,10 +29,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSBeamPipeFactoryPointsFile.hh"
 #include "BDSBeamPipeFactoryRaceTrack.hh"
 #include "BDSBeamPipeFactoryRectEllipse.hh"
+#include "BDSBeamPipeFactoryRectEllipsePoints.hh"
 #include "BDSBeamPipeFactoryRhombus.hh"
 #include "BDSBeamPipeInfo.hh"
 #include "BDSBeamPipeType.hh"
 #include "BDSDebug.hh"
+#include "BDSGlobalConstants.hh"
 
 #include "globals.hh"                        // geant4 globals / types
 
@@ -59,6 +61,10 @@ BDSBeamPipeFactory::BDSBeamPipeFactory()
   circularvacuum = new BDSBeamPipeFactoryCircularVacuum();
   clicpcl        = new BDSBeamPipeFactoryClicPCL();
   pointsfile     = new BDSBeamPipeFactoryPointsFile();
+  rectellipsepoints = new BDSBeamPipeFactoryRectEllipsePoints();
+  lhcpoints         = new BDSBeamPipeFactoryRectEllipsePoints(true);
+
+  booleanFreeGeometry = BDSGlobalConstants::Instance()->BooleanFreeGeometry();
 }
 
 BDSBeamPipeFactory::~BDSBeamPipeFactory()
@@ -75,6 +81,8 @@ BDSBeamPipeFactory::~BDSBeamPipeFactory()
   delete circularvacuum;
   delete clicpcl;
   delete pointsfile;
+  delete rectellipsepoints;
+  delete lhcpoints;
   instance = nullptr;
 }
 
@@ -89,11 +97,11 @@ BDSBeamPipeFactoryBase* BDSBeamPipeFactory::GetAppropriateFactory(BDSBeamPipeTyp
     case BDSBeamPipeType::rectangular:
       {return rectangular; break;}
     case BDSBeamPipeType::lhc:
-      {return lhc; break;}
+      {return booleanFreeGeometry ? lhcpoints : lhc; break;}
     case BDSBeamPipeType::lhcdetailed:
       {return lhcdetailed; break;}
     case BDSBeamPipeType::rectellipse:
-      {return rectellipse; break;}
+      {return booleanFreeGeometry ? rectellipsepoints : rectellipse; break;}
     case BDSBeamPipeType::racetrack:
       {return racetrack; break;}
     case BDSBeamPipeType::octagonal:
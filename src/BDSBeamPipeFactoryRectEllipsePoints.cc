@@ -0,0 +1,139 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSBeamPipeFactoryPoints.hh"
+#include "BDSBeamPipeFactoryRectEllipsePoints.hh"
+
+#include "globals.hh"
+#include "G4TwoVector.hh"
+
+#include "CLHEP/Units/PhysicalConstants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+BDSBeamPipeFactoryRectEllipsePoints::BDSBeamPipeFactoryRectEllipsePoints(G4bool circularIn):
+  circular(circularIn),
+  nPointsPerTwoPi(128)
+{;}
+
+std::vector<G4TwoVector> BDSBeamPipeFactoryRectEllipsePoints::ClipToRectangle(const std::vector<G4TwoVector>& polygon,
+									  G4double halfX,
+									  G4double halfY)
+{
+  // Sutherland-Hodgman clipping against each edge of the rectangle in turn. Each edge
+  // is described by the coordinate (0 for x, 1 for y), the sign and the limit such that
+  // a point is inside if sign * p[coordinate] <= limit.
+  struct Edge
+  {
+    G4int    coordinate;
+    G4double sign;
+    G4double limit;
+  };
+  const Edge edges[4] = {{0, 1, halfX}, {1, -1, halfY}, {0, -1, halfX}, {1, 1, halfY}};
+
+  std::vector<G4TwoVector> result = polygon;
+  for (const auto& edge : edges)
+    {
+      if (result.empty())
+	{break;}
+      std::vector<G4TwoVector> input;
+      std::swap(input, result);
+      auto inside = [&edge](const G4TwoVector& p){return edge.sign * p[edge.coordinate] <= edge.limit;};
+      auto crossing = [&edge](const G4TwoVector& a, const G4TwoVector& b)
+      {
+	G4double t = (edge.sign*edge.limit - a[edge.coordinate]) / (b[edge.coordinate] - a[edge.coordinate]);
+	return a + t*(b - a);
+      };
+      G4TwoVector previous = input.back();
+      for (const auto& current : input)
+	{
+	  if (inside(current))
+	    {
+	      if (!inside(previous))
+		{result.push_back(crossing(previous, current));}
+	      result.push_back(current);
+	    }
+	  else if (inside(previous))
+	    {result.push_back(crossing(previous, current));}
+	  previous = current;
+	}
+    }
+
+  // remove coincident consecutive points that arise when a vertex lies on an edge
+  std::vector<G4TwoVector> unique;
+  for (const auto& p : result)
+    {
+      if (unique.empty() || (p - unique.back()).mag() > 1e-9*CLHEP::mm)
+	{unique.push_back(p);}
+    }
+  while (unique.size() > 1 && (unique.front() - unique.back()).mag() <= 1e-9*CLHEP::mm)
+    {unique.pop_back();}
+  return unique;
+}
+
+void BDSBeamPipeFactoryRectEllipsePoints::GenerateRectEllipse(std::vector<G4TwoVector>& vec,
+							      G4double halfX,
+							      G4double halfY,
+							      G4double a,
+							      G4double b)
+{
+  std::vector<G4TwoVector> ellipse;
+  AppendAngleEllipse(ellipse, 0, CLHEP::twopi, a, b, nPointsPerTwoPi);
+  std::vector<G4TwoVector> clipped = ClipToRectangle(ellipse, halfX, halfY);
+  vec.insert(vec.end(), clipped.begin(), clipped.end());
+}
+
+void BDSBeamPipeFactoryRectEllipsePoints::GeneratePoints(G4double aper1,
+							 G4double aper2,
+							 G4double aper3,
+							 G4double aper4,
+							 G4double beamPipeThickness,
+							 G4int    /*pointsPerTwoPi*/)
+{
+  if (circular)
+    {aper4 = aper3;}
+
+  // same offsets as the boolean construction in BDSBeamPipeFactoryRectEllipse
+  G4double inner = lengthSafetyLarge;
+  G4double outer = beamPipeThickness + lengthSafetyLarge;
+  G4double cont  = outer + lengthSafetyLarge;
+  GenerateRectEllipse(vacuumEdge,        aper1,         aper2,         aper3,         aper4);
+  GenerateRectEllipse(beamPipeInnerEdge, aper1 + inner, aper2 + inner, aper3 + inner, aper4 + inner);
+  GenerateRectEllipse(beamPipeOuterEdge, aper1 + outer, aper2 + outer, aper3 + outer, aper4 + outer);
+  GenerateRectEllipse(containerEdge,     aper1 + cont,  aper2 + cont,  aper3 + cont,  aper4 + cont);
+  G4double subR = beamPipeThickness + 2*lengthSafetyLarge;
+  G4double subE = beamPipeThickness + 3*lengthSafetyLarge;
+  GenerateRectEllipse(containerSubtractionEdge, aper1 + subR, aper2 + subR, aper3 + subE, aper4 + subE);
+
+  extentX = std::min(aper1, aper3) + cont;
+  extentY = std::min(aper2, aper4) + cont;
+}
+
+G4double BDSBeamPipeFactoryRectEllipsePoints::CalculateIntersectionRadius(G4double aper1,
+									  G4double aper2,
+									  G4double aper3,
+									  G4double aper4,
+									  G4double beamPipeThickness)
+{
+  if (circular)
+    {aper4 = aper3;}
+  // as for the angled face solid in BDSBeamPipeFactoryRectEllipse
+  return (std::max({aper1, aper2, aper3, aper4}) + beamPipeThickness) * 1.1;
+}
@@ -27,6 +27,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "globals.hh" // geant4 types / globals
 #include "G4Material.hh"
 
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
 
 BDSBeamPipeInfo::BDSBeamPipeInfo(BDSBeamPipeType      beamPipeTypeIn,
                                  G4double             aper1In,
@@ -263,6 +267,22 @@ G4double BDSBeamPipeInfo::IndicativeRadiusInner() const
   return ext.MinimumAbsTransverse();
 }
 
+G4String BDSBeamPipeInfo::GeometryKey() const
+{
+  std::ostringstream key;
+  key << std::setprecision(std::numeric_limits<G4double>::max_digits10);
+  key << beamPipeType.ToString() << "|"
+      << aper1 << "|" << aper2 << "|" << aper3 << "|" << aper4 << "|"
+      << aperOffsetX << "|" << aperOffsetY << "|"
+      << (vacuumMaterial ? vacuumMaterial->GetName() : "none") << "|"
+      << beamPipeThickness << "|"
+      << (beamPipeMaterial ? beamPipeMaterial->GetName() : "none") << "|"
+      << inputFaceNormal.x()  << "," << inputFaceNormal.y()  << "," << inputFaceNormal.z()  << "|"
+      << outputFaceNormal.x() << "," << outputFaceNormal.y() << "," << outputFaceNormal.z() << "|"
+      << pointsFileName << "|" << pointsUnit;
+  return G4String(key.str());
+}
+
 void BDSBeamPipeInfo::CheckRequiredParametersSet(G4bool setAper1,
                                                  G4bool setAper2,
                                                  G4bool setAper3,
@@ -58,7 +58,9 @@ BDSBeamline::BDSBeamline(const G4ThreeVector& initialGlobalPosition,
   totalAngle(0),
   previousReferencePositionEnd(initialGlobalPosition),
   previousSPositionEnd(sInitial),
-  transformHasJustBeenApplied(false)
+  transformHasJustBeenApplied(false),
+  sIndexCellWidth(0),
+  sIndexNElements(0)
 {
   // initialise extents
   maximumExtentPositive = G4ThreeVector(0,0,0);
@@ -547,6 +549,10 @@ void BDSBeamline::AddSingleComponent(BDSAcceleratorComponent* component,
 
   // register the s position at the end for curvilinear transform
   sEnd.push_back(sPositionEnd);
+  // rebuild the grid in s each time the number of elements doubles so the total
+  // cost stays linear - UpdateSIndex() is called again once the beam line is complete
+  if ((G4int)sEnd.size() >= 2*sIndexNElements)
+    {UpdateSIndex();}
 
   // register it by name
   RegisterElement(element);
@@ -636,6 +642,14 @@ G4Transform3D BDSBeamline::GetGlobalEuclideanTransform(G4double s, G4double x, G
   G4cout << "Element: " << *element << G4endl;
 #endif
 
+  return GetGlobalEuclideanTransformInElement(element, s, x, y);
+}
+
+G4Transform3D BDSBeamline::GetGlobalEuclideanTransformInElement(const BDSBeamlineElement* element,
+                                                                G4double s,
+                                                                G4double x,
+                                                                G4double y) const
+{
   G4double dx = 0;
   // G4double dy = 0; // currently magnets can only bend in local x so avoid extra calculation
 
@@ -687,7 +701,7 @@ const BDSBeamlineElement* BDSBeamline::GetElementFromGlobalS(G4double S,
                                                              G4int*   indexOfFoundElement) const
 {
   // find element that s position belongs to
-  auto lower = std::lower_bound(sEnd.begin(), sEnd.end(), S);
+  auto lower = LowerBoundS(S);
   G4int index = G4int(lower - sEnd.begin()); // subtract iterators to get index
   if (indexOfFoundElement)
     {*indexOfFoundElement = index;}
@@ -696,7 +710,7 @@ const BDSBeamlineElement* BDSBeamline::GetElementFromGlobalS(G4double S,
 
 BDSBeamline::const_iterator BDSBeamline::FindFromS(G4double S) const
 {
-  auto lower = std::lower_bound(sEnd.begin(), sEnd.end(), S);
+  auto lower = LowerBoundS(S);
   auto iter = begin();
   std::advance(iter, std::distance(sEnd.begin(), lower));
   return iter;
@@ -750,6 +764,56 @@ void BDSBeamline::RegisterElement(BDSBeamlineElement* element)
     {// not registered
       components[element->GetPlacementName()] = element;
     }
+  elementsByComponentName[element->GetName()].push_back(element);
+}
+
+void BDSBeamline::UpdateSIndex()
+{
+  sIndexNElements = (G4int)sEnd.size();
+  sIndexFirstElement.clear();
+  sIndexCellWidth = 0;
+  if (sEnd.empty())
+    {return;}
+  G4double sRange = sEnd.back() - sInitial;
+  if (sRange <= 0)
+    {return;} // no length to index - LowerBoundS falls back to a binary search
+  
+  // on average one element per cell
+  G4int nCells = sIndexNElements;
+  sIndexCellWidth = sRange / (G4double)nCells;
+  sIndexFirstElement.reserve(nCells + 1);
+  auto it = sEnd.begin();
+  for (G4int i = 0; i < nCells; i++)
+    {
+      G4double sCellStart = sInitial + i*sIndexCellWidth;
+      it = std::lower_bound(it, sEnd.end(), sCellStart);
+      sIndexFirstElement.push_back(G4int(it - sEnd.begin()));
+    }
+  sIndexFirstElement.push_back(sIndexNElements - 1);
+}
+
+std::vector<G4double>::const_iterator BDSBeamline::LowerBoundS(G4double S) const
+{
+  if (sIndexFirstElement.empty() || S > sEnd[sIndexNElements - 1])
+    {// beyond the grid - only elements added afterwards can contain S
+      auto searchStart = sIndexFirstElement.empty() ? sEnd.begin() : sEnd.begin() + sIndexNElements;
+      return std::lower_bound(searchStart, sEnd.end(), S);
+    }
+
+  // find the cell, correcting for any rounding in the division
+  G4int nCells = (G4int)sIndexFirstElement.size() - 1;
+  G4int cell = 0;
+  if (S > sInitial)
+    {cell = std::min((G4int)((S - sInitial) / sIndexCellWidth), nCells - 1);}
+  while (cell > 0 && S < sInitial + cell*sIndexCellWidth)
+    {cell--;}
+  while (cell < nCells - 1 && S >= sInitial + (cell+1)*sIndexCellWidth)
+    {cell++;}
+
+  // the element containing S lies between the first elements of this and the next cell
+  auto first = sEnd.begin() + sIndexFirstElement[cell];
+  auto last  = sEnd.begin() + sIndexFirstElement[cell+1] + 1;
+  return std::lower_bound(first, last, S);
 }
 
 const BDSBeamlineElement* BDSBeamline::GetElement(G4String acceleratorComponentName,
@@ -768,23 +832,21 @@ const BDSBeamlineElement* BDSBeamline::GetElement(G4String acceleratorComponentN
       // name for storing in the component registry.
       // Naming will be NAME_MOD_MODNUMBER_PLACEMENTNUMBER
       // Why not search registry? -> should be found from this beam line
-      // 1) search with starts with NAME
-      std::vector<const BDSBeamlineElement*> candidates;
-      std::for_each(this->begin(),
-                    this->end(),
-                    [&acceleratorComponentName,&candidates](const BDSBeamlineElement* el)
-                    {if (BDS::StartsWith(el->GetPlacementName(), acceleratorComponentName)){candidates.push_back(el);};});
-      
-      if (candidates.empty())
-        {return nullptr;} // nothing found
-      else
-        {// 2) of things that start with NAME, search for ones that end in _PLACEMENTNUMBER
-          auto foundItem = std::find_if(candidates.begin(),
-                                        candidates.end(),
+      // 1) component names that start with NAME are contiguous in the sorted map
+      // 2) of those, take the first in the beam line whose placement name ends in _PLACEMENTNUMBER
+      const BDSBeamlineElement* result = nullptr;
+      for (auto it = elementsByComponentName.lower_bound(acceleratorComponentName);
+           it != elementsByComponentName.end() && BDS::StartsWith(it->first, acceleratorComponentName);
+           ++it)
+        {
+          auto foundItem = std::find_if(it->second.begin(),
+                                        it->second.end(),
                                         [&suffix](const BDSBeamlineElement* el)
                                         {return BDS::EndsWith(el->GetPlacementName(), suffix);});
-          return foundItem != candidates.end() ? *foundItem : nullptr;
+          if (foundItem != it->second.end() && (!result || (*foundItem)->GetIndex() < result->GetIndex()))
+            {result = *foundItem;}
         }
+      return result;
     }
   else
     {return search->second;}
@@ -804,7 +866,7 @@ G4Transform3D BDSBeamline::GetTransformForElement(const G4String& acceleratorCom
       throw BDSException(__METHOD_NAME__, "");
     }
   else
-    {return G4Transform3D(*(result->GetRotationMiddle()), result->GetPositionMiddle());}
+    {return *(result->GetPlacementTransform());}
 }
 
 void BDSBeamline::UpdateExtents(BDSBeamlineElement* element)
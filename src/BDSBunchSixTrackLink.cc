@@ -20,7 +20,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSIonDefinition.hh"
+#include "BDSLinkParticleBatch.hh"
+#include "BDSParticleCoordsFull.hh"
 #include "BDSParticleDefinition.hh"
+#include "BDSPhysicsUtilities.hh"
 
 #include "globals.hh"
 #include "G4IonTable.hh"
@@ -28,6 +31,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ParticleTable.hh"
 #include "G4String.hh"
 
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 BDSBunchSixTrackLink::BDSBunchSixTrackLink():
@@ -36,11 +44,15 @@ BDSBunchSixTrackLink::BDSBunchSixTrackLink():
   currentExternalParticleID(0),
   currentExternalParentID(0),
   currentParticleDefinition(nullptr),
-  size(0)
+  size(0),
+  batch(nullptr)
 {;}
 
 BDSBunchSixTrackLink::~BDSBunchSixTrackLink()
-{;}
+{
+  for (auto& kv : batchDefinitions)
+    {delete kv.second;}
+}
 
 BDSParticleCoordsFull BDSBunchSixTrackLink::GetNextParticleLocal()
 {
@@ -52,6 +64,29 @@ BDSParticleCoordsFull BDSBunchSixTrackLink::GetNextParticleLocal()
 
   G4int ci = currentIndex;
   currentIndex++;
+
+  if (batch)
+    {
+      G4int    charge      = batch->charge.empty() ? 0 : batch->charge[ci];
+      G4double totalEnergy = batch->totalEnergy[ci] * CLHEP::GeV;
+      currentParticleDefinition = BatchParticleDefinition(batch->pdgID[ci], charge, totalEnergy);
+      particleDefinitionHasBeenUpdated = true;
+      UpdateIonDefinition();
+      currentExternalParticleID = batch->externalParticleID[ci];
+      currentExternalParentID   = batch->externalParentID[ci];
+      G4double xp = batch->xp[ci];
+      G4double yp = batch->yp[ci];
+      return BDSParticleCoordsFull(batch->x[ci] * CLHEP::m,
+				   batch->y[ci] * CLHEP::m,
+				   0,
+				   xp,
+				   yp,
+				   BDSBunch::CalculateZp(xp, yp, 1),
+				   batch->T[ci] * CLHEP::s,
+				   0,
+				   totalEnergy,
+				   batch->weight.empty() ? 1.0 : batch->weight[ci]);
+    }
   
   auto particle = particles[ci];
   currentParticleDefinition = particle->particleDefinition;
@@ -74,8 +109,49 @@ void BDSBunchSixTrackLink::AddParticle(BDSParticleDefinition*       particleDefi
   size = (G4int)particles.size();
 }
 
+void BDSBunchSixTrackLink::SetParticleBatch(const BDSLinkParticleBatch* batchIn)
+{
+  batch = batchIn;
+  currentIndex = 0;
+  size = batch ? (G4int)batch->Size() : (G4int)particles.size();
+}
+
+BDSParticleDefinition* BDSBunchSixTrackLink::BatchParticleDefinition(G4int    pdgID,
+                                                                    G4int    charge,
+                                                                    G4double totalEnergy)
+{
+  auto key = std::make_pair(pdgID, charge);
+  auto search = batchDefinitions.find(key);
+  if (search != batchDefinitions.end())
+    {return search->second;}
+
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+  G4ParticleDefinition* particleDef = nullptr;
+  if (pdgID > 1000000000) // nuclear code 10LZZZAAAI
+    {particleDef = particleTable->GetIonTable()->GetIon(pdgID);}
+  else
+    {particleDef = particleTable->FindParticle(pdgID);}
+  if (!particleDef)
+    {throw BDSException(__METHOD_NAME__, "particle with PDG ID \"" + std::to_string(pdgID) + "\" not found");}
+
+  // only the species matters for tracking so the energy of the first one seen is used
+  BDSParticleDefinition* result = nullptr;
+  if (BDS::IsIon(particleDef))
+    {
+      G4int a = particleDef->GetAtomicMass();
+      G4int z = particleDef->GetAtomicNumber();
+      BDSIonDefinition ionDef(a, z, charge == 0 ? z : charge); // copied by BDSParticleDefinition
+      result = new BDSParticleDefinition(particleDef, totalEnergy, 0, 0, 1, &ionDef, pdgID);
+    }
+  else
+    {result = new BDSParticleDefinition(particleDef, totalEnergy, 0, 0, 1);}
+  batchDefinitions[key] = result;
+  return result;
+}
+
 void BDSBunchSixTrackLink::ClearParticles()
 {
+  batch = nullptr;
   currentIndex = 0;
   size = 0;
   for (auto p : particles)
@@ -62,6 +62,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSScorerFactory.hh"
 #include "BDSScorerInfo.hh"
 #include "BDSScorerMeshInfo.hh"
+#include "BDSScoringMeshAnalytic.hh"
 #include "BDSScoringMeshBox.hh"
 #include "BDSScoringMeshCylinder.hh"
 #include "BDSSDEnergyDeposition.hh"
@@ -376,7 +377,7 @@ void BDSDetectorConstruction::BuildBeamlines()
     {
       if (placement.sequence.empty())
         {continue;} // no sequence specified -> just a placement
-      auto parserLine = BDSParser::Instance()->GetSequence(placement.sequence);
+      const auto& parserLine = BDSParser::Instance()->GetSequence(placement.sequence);
 
       // determine offset in world for extra beam line
       const BDSBeamline* mbl = mainBeamline.massWorld;
@@ -449,51 +450,53 @@ BDSBeamlineSet BDSDetectorConstruction::BuildBeamline(const GMAD::FastList<GMAD:
   if (beamLine.size() <= 1) // if an empty LINE it still has 1 item in it
     {throw BDSException(__METHOD_NAME__, "BDSIM requires the sequence defined with the use command to have at least one element.");}
 
-  for (auto elementIt = beamLine.begin(); elementIt != beamLine.end(); ++elementIt)
+  // find the previous and next thick element for each element in one pass each way
+  // rather than searching from every element, which is quadratic for long lattices
+  const G4double thinElementLength = BDSGlobalConstants::Instance()->ThinElementLength();
+  auto isThick = [thinElementLength](const GMAD::Element& el){return !el.isSpecial() && el.l > thinElementLength;};
+  std::vector<const GMAD::Element*> elements;
+  elements.reserve(beamLine.size());
+  for (const auto& el : beamLine)
+    {elements.push_back(&el);}
+  const std::size_t nElements = elements.size();
+  std::vector<const GMAD::Element*> prevElements(nElements, nullptr);
+  std::vector<const GMAD::Element*> nextElements(nElements, nullptr);
+  const GMAD::Element* lastThick = nullptr;
+  for (std::size_t i = 0; i < nElements; i++)
     {
-      // find next and previous element, but ignore special elements or thin elements.
-      const GMAD::Element* prevElement = nullptr;
-      auto prevIt = elementIt;
-      while (prevIt != beamLine.begin())
-        {
-          --prevIt;
-          if (prevIt->isSpecial() == false && prevIt->l > BDSGlobalConstants::Instance()->ThinElementLength())
-            {
-              prevElement = &(*prevIt);
-              break;
-            }
-        }
+      prevElements[i] = lastThick;
+      if (isThick(*elements[i]))
+        {lastThick = elements[i];}
+    }
+  lastThick = nullptr;
+  for (std::size_t i = nElements; i-- > 0;)
+    {
+      nextElements[i] = lastThick;
+      if (isThick(*elements[i]))
+        {lastThick = elements[i];}
+    }
 
-      const GMAD::Element* nextElement = nullptr;
-      auto nextIt = elementIt;
-      ++nextIt;
-      G4double nextElementInputFace = 0; // get poleface angle for next element whilst testing if next element exists
-      while (nextIt != beamLine.end())
-        {
-          if (nextIt->isSpecial() == false && nextIt->l > BDSGlobalConstants::Instance()->ThinElementLength())
-            {
-              nextElement = &(*nextIt);
-          //rotated entrance face of the next element may modify the exit face of the current element.
-          nextElementInputFace = nextElement->e1;
-          break;
-	    }
-	  ++nextIt;
-	}
-      BDSAcceleratorComponent* temp = theComponentFactory->CreateComponent(&(*elementIt),
-									   prevElement,
-									   nextElement,
-                     *integral);
+  for (std::size_t i = 0; i < nElements; i++)
+    {
+      const GMAD::Element* element = elements[i];
+      const GMAD::Element* nextElement = nextElements[i];
+      //rotated entrance face of the next element may modify the exit face of the current element.
+      G4double nextElementInputFace = nextElement ? nextElement->e1 : 0;
+      BDSAcceleratorComponent* temp = theComponentFactory->CreateComponent(element,
+                                                                           prevElements[i],
+                                                                           nextElement,
+                                                                           *integral);
       if (temp)
         {
           G4bool forceNoSamplerOnThisElement = false;
-          if ((!canSampleAngledFaces) && (BDS::IsFinite((*elementIt).e2)))
+          if ((!canSampleAngledFaces) && (BDS::IsFinite(element->e2)))
             {forceNoSamplerOnThisElement = true;}
           if ((!canSampleAngledFaces) && (BDS::IsFinite(nextElementInputFace)))
             {forceNoSamplerOnThisElement = true;}
           if (temp->GetType() == "dump") // don't sample after a dump as there'll be nothing
             {forceNoSamplerOnThisElement = true;}
-          BDSSamplerInfo* samplerInfo = forceNoSamplerOnThisElement ? nullptr : BuildSamplerInfo(&(*elementIt));
-          BDSTiltOffset* tiltOffset = BDSComponentFactory::CreateTiltOffset(&(*elementIt));
+          BDSSamplerInfo* samplerInfo = forceNoSamplerOnThisElement ? nullptr : BuildSamplerInfo(element);
+          BDSTiltOffset* tiltOffset = BDSComponentFactory::CreateTiltOffset(element);
           massWorld->AddComponent(temp, tiltOffset, samplerInfo, integral);
         }
     }
@@ -542,6 +545,9 @@ BDSBeamlineSet BDSDetectorConstruction::BuildBeamline(const GMAD::FastList<GMAD:
 	  massWorld->AddComponent(teleporter, nullptr, nullptr, integral);
 	}
     }
+
+  // index all elements by s now the beam line is complete
+  massWorld->UpdateSIndex();
   
   if (BDSGlobalConstants::Instance()->Survey())
     {
@@ -1364,11 +1370,17 @@ void BDSDetectorConstruction::ConstructScoringMeshes()
 
       BDSScoringMeshBox* scorerBox = nullptr;
       BDSScoringMeshCylinder* scorerCylindrical = nullptr;
+      BDSScoringMeshAnalytic* scorerAnalytic = nullptr;
       const BDSHistBinMapper* mapper = nullptr;
 
       G4String geometryType = BDS::LowerCase(G4String(mesh.geometryType));
 
-      if (geometryType == "box")
+      if (meshRecipe.analytic)
+        {// no geometry - each step is split between the cells it crosses
+          scorerAnalytic = new BDSScoringMeshAnalytic(meshName, meshRecipe, placement);
+          mapper = scorerAnalytic->Mapper();
+        }
+      else if (geometryType == "box")
         {// create a scoring box
           scorerBox = new BDSScoringMeshBox(meshName, meshRecipe, placement);
           mapper = scorerBox->Mapper();
@@ -1407,7 +1419,9 @@ void BDSDetectorConstruction::ConstructScoringMeshes()
           meshPrimitiveScorerUnits.push_back(psUnit);
 
           // sets the current ps but appends to list of multiple
-          if (geometryType == "box")
+          if (scorerAnalytic)
+            {scorerAnalytic->RegisterScorer(search->second.scorerType, ps);}
+          else if (geometryType == "box")
             {scorerBox->SetPrimitiveScorer(ps);} 
           else if (geometryType == "cylindrical")
             {scorerCylindrical->SetPrimitiveScorer(ps);}
@@ -1417,7 +1431,9 @@ void BDSDetectorConstruction::ConstructScoringMeshes()
           BDSAcceleratorModel::Instance()->RegisterScorerPlacement(meshName, placement);
         }
       
-      if (geometryType == "box")
+      if (scorerAnalytic)
+        {BDSSDManager::Instance()->RegisterAnalyticScoringMesh(scorerAnalytic);}
+      else if (geometryType == "box")
         {scManager->RegisterScoringMesh(scorerBox);} // sets the current ps but appends to list of multiple
       else if (geometryType == "cylindrical")
         {scManager->RegisterScoringMesh(scorerCylindrical);}// sets the current ps but appends to list of multiple
@@ -1461,7 +1477,9 @@ std::vector<BDSFieldQueryInfo*> BDSDetectorConstruction::PrepareFieldQueries(con
                                                     def.drawArrows,
                                                     def.drawZeroValuePoints,
                                                     def.drawBoxes,
-                                                    def.boxAlpha));
+                                                    def.boxAlpha,
+                                                    def.binaryOutput,
+                                                    def.nThreads));
         }
       else
         {
@@ -1487,7 +1505,10 @@ std::vector<BDSFieldQueryInfo*> BDSDetectorConstruction::PrepareFieldQueries(con
                                                     def.drawArrows,
                                                     def.drawZeroValuePoints,
                                                     def.drawBoxes,
-                                                    def.boxAlpha));
+                                                    def.boxAlpha,
+                                                    def.binaryOutput,
+                                                    def.nThreads,
+                                                    G4String(def.errorReportInterpolator)));
         }
     }
   return result;
@@ -17,6 +17,7 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSAcceleratorComponent.hh"
+#include "BDSAcceleratorModel.hh"
 #include "BDSDrift.hh"
 #include "BDSBeamPipe.hh"
 #include "BDSBeamPipeFactory.hh"
@@ -36,12 +37,31 @@ BDSDrift::~BDSDrift()
 
 void BDSDrift::Build()
 {
-  BDSBeamPipeFactory* factory = BDSBeamPipeFactory::Instance();
-  BDSBeamPipe* pipe = factory->CreateBeamPipe(name,
-					      chordLength,
-					      beamPipeInfo);
+  // A drift has no field so its beam pipe may be built once and placed by every
+  // drift with the same geometry if requested.
+  G4bool shareGeometry = reuseIdenticalGeometry && !fieldInfo && BeamPipeMayBeShared();
+  G4String geometryKey;
+  BDSBeamPipe* pipe = nullptr;
+  if (shareGeometry)
+    {
+      geometryKey = "drift|" + SharedGeometryKey() + "|" + beamPipeInfo->GeometryKey();
+      pipe = dynamic_cast<BDSBeamPipe*>(BDSAcceleratorModel::Instance()->SharedGeometry(geometryKey));
+    }
 
-  RegisterDaughter(pipe);
+  if (!pipe)
+    {
+      BDSBeamPipeFactory* factory = BDSBeamPipeFactory::Instance();
+      pipe = factory->CreateBeamPipe(name,
+				     chordLength,
+				     beamPipeInfo);
+      if (shareGeometry)
+	{BDSAcceleratorModel::Instance()->RegisterSharedGeometry(geometryKey, pipe);}
+    }
+
+  if (shareGeometry)
+    {RegisterSharedDaughter(pipe);}
+  else
+    {RegisterDaughter(pipe);}
   
   // make the beam pipe container, this object's container
   containerLogicalVolume = pipe->GetContainerLogicalVolume();
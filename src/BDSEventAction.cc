@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSAuxiliaryNavigator.hh"
 #include "BDSDebug.hh"
 #include "BDSEventAction.hh"
+#include "BDSEventArena.hh"
 #include "BDSEventInfo.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSHitEnergyDeposition.hh"
@@ -61,10 +62,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Run.hh"
 #include "G4SDManager.hh"
 #include "G4StackManager.hh"
-#include "G4THitsMap.hh"
 #include "G4TrajectoryContainer.hh"
 #include "G4TrajectoryPoint.hh"
 #include "G4TransportationManager.hh"
+#include "G4VHitsCollection.hh"
 
 #include <algorithm>
 #include <bitset>
@@ -331,11 +332,12 @@ void BDSEventAction::EndOfEventAction(const G4Event* evt)
   typedef BDSHitsCollectionThinThing tthc;
   tthc* thinThingHits = HCE ? dynamic_cast<tthc*>(HCE->GetHC(thinThingCollID)) : nullptr;
   
-  std::map<G4String, G4THitsMap<G4double>*> scorerHits;
+  // scorer hits are either G4THitsMap<G4double> or BDSScorerBufferCollection
+  std::map<G4String, G4VHitsCollection*> scorerHits;
   if (HCE)
     {
       for (const auto& nameIndex : scorerCollectionIDs)
-        {scorerHits[nameIndex.first] = dynamic_cast<G4THitsMap<G4double>*>(HCE->GetHC(nameIndex.second));}
+        {scorerHits[nameIndex.first] = HCE->GetHC(nameIndex.second);}
     }
   // primary hit something? we infer this by seeing if there are any energy
   // deposition hits at all - if there are, the primary must have 'hit' something.
@@ -451,6 +453,12 @@ void BDSEventAction::EndOfEventAction(const G4Event* evt)
       G4cout << "Trajectory point pool size:         " << aTrajectoryPointAllocator->GetAllocatedSize()    << G4endl;
 #endif
       G4cout << "Trajectory point primary pool size: " << bdsTrajectoryPrimaryAllocator.GetAllocatedSize() << G4endl;
+      if (BDSEventArena::Active())
+        {
+          BDSEventArena* arena = BDSEventArena::Instance();
+          G4cout << "Event arena used / reserved (B):    " << arena->BytesUsed() << " / " << arena->BytesReserved()
+                 << " in " << arena->NBlocks() << " blocks" << G4endl;
+        }
     }
 
   delete interestingTrajectories;
@@ -0,0 +1,100 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSEventArena.hh"
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+
+BDSEventArena* BDSEventArena::instance = nullptr;
+G4bool BDSEventArena::active = false;
+
+BDSEventArena* BDSEventArena::Instance()
+{
+  if (!instance)
+    {instance = new BDSEventArena();}
+  return instance;
+}
+
+BDSEventArena::BDSEventArena():
+  currentBlock(0),
+  blockStart(nullptr),
+  cursor(nullptr),
+  blockEnd(nullptr),
+  bytesUsedPreviousBlocks(0),
+  bytesReserved(0),
+  defaultBlockSize(4*1024*1024) // 4 MB
+{;}
+
+BDSEventArena::~BDSEventArena()
+{
+  for (auto& block : blocks)
+    {::operator delete(block.data);}
+  // active is deliberately left as is so any objects deleted after this
+  // are not handed back to the wrong allocator
+  instance = nullptr;
+}
+
+void BDSEventArena::SetActive(G4bool activeIn)
+{
+  active = activeIn;
+}
+
+void* BDSEventArena::AllocateFromNextBlock(std::size_t size)
+{
+  // size is already aligned
+  if (!blocks.empty())
+    {
+      bytesUsedPreviousBlocks += (std::size_t)(cursor - blockStart);
+      currentBlock++;
+    }
+  
+  // reuse an existing block from a previous event if it's big enough
+  while (currentBlock < blocks.size() && blocks[currentBlock].size < size)
+    {currentBlock++;}
+
+  if (currentBlock >= blocks.size())
+    {
+      Block block;
+      block.size = std::max(defaultBlockSize, size);
+      block.data = static_cast<char*>(::operator new(block.size));
+      bytesReserved += block.size;
+      blocks.push_back(block);
+      currentBlock = blocks.size() - 1;
+    }
+  
+  const Block& block = blocks[currentBlock];
+  blockStart = block.data;
+  blockEnd   = block.data + block.size;
+  cursor     = blockStart + size;
+  return blockStart;
+}
+
+void BDSEventArena::Reset()
+{
+  bytesUsedPreviousBlocks = 0;
+  currentBlock = 0;
+  if (blocks.empty())
+    {return;}
+  blockStart = blocks[0].data;
+  cursor     = blockStart;
+  blockEnd   = blockStart + blocks[0].size;
+}
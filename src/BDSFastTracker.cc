@@ -0,0 +1,191 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSAcceleratorComponent.hh"
+#include "BDSBeamline.hh"
+#include "BDSBeamlineElement.hh"
+#include "BDSBeamPipeInfo.hh"
+#include "BDSDebug.hh"
+#include "BDSFastTracker.hh"
+#include "BDSFieldInfo.hh"
+#include "BDSGlobalConstants.hh"
+#include "BDSIntegratorType.hh"
+#include "BDSMagnet.hh"
+#include "BDSMagnetStrength.hh"
+#include "BDSSamplerType.hh"
+#include "BDSTiltOffset.hh"
+#include "BDSUtilities.hh"
+
+#include "globals.hh" // geant4 types / globals
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+void BDSFastTracker::Batch::Resize(std::size_t n)
+{
+  x.resize(n);
+  xp.resize(n);
+  y.resize(n);
+  yp.resize(n);
+  T.resize(n);
+  kappaFactor.resize(n);
+  velocity.resize(n);
+  elementIndex.resize(n, 0);
+}
+
+BDSFastTracker::BDSFastTracker(const BDSBeamline* beamlineIn):
+  beamline(beamlineIn),
+  backupStepperMomLimit(BDSGlobalConstants::Instance()->BackupStepperMomLimit()),
+  minimumRadiusOfCurvature(10*CLHEP::cm)
+{
+  G4double lengthSafety = BDSGlobalConstants::Instance()->LengthSafety();
+  for (const auto element : *beamline)
+    {
+      G4String type = element->GetType();
+      if (type != "drift" && type != "quadrupole")
+        {break;}
+      // a sampler would miss the particle
+      if (element->GetSamplerType() != BDSSamplerType::none)
+        {break;}
+      const BDSTiltOffset* to = element->GetTiltOffset();
+      if (to && (to->HasFiniteTilt() || to->HasFiniteOffset()))
+        {break;}
+      const BDSBeamPipeInfo* bpi = element->GetBeamPipeInfo();
+      if (!bpi || BDS::IsFinite(bpi->aperOffsetX) || BDS::IsFinite(bpi->aperOffsetY))
+        {break;}
+
+      G4double bPrime = 0;
+      if (type == "quadrupole")
+        {
+          const auto magnet = dynamic_cast<const BDSMagnet*>(element->GetAcceleratorComponent());
+          if (!magnet || !magnet->VacuumFieldInfo())
+            {break;}
+          // only the thick matrix of BDSIntegratorQuadrupole is reproduced here
+          const BDSFieldInfo* fieldInfo = magnet->VacuumFieldInfo();
+          if (fieldInfo->IntegratorType() != BDSIntegratorType::quadrupole)
+            {break;}
+          // as in BDSIntegratorQuadrupole
+          bPrime = std::abs(fieldInfo->BRho()) * (*magnet->MagnetStrength())["k1"] / CLHEP::m2;
+        }
+
+      G4double radius = bpi->IndicativeRadiusInner() - lengthSafety;
+      if (radius <= 0)
+        {break;}
+      elements.push_back({element->GetChordLength(), bPrime, radius*radius});
+    }
+  G4cout << __METHOD_NAME__ << elements.size() << " elements at the start of the beam line will be fast tracked" << G4endl;
+}
+
+void BDSFastTracker::Track(Batch& batch) const
+{
+  const std::size_t n = batch.Size();
+  G4double* x  = batch.x.data();
+  G4double* xp = batch.xp.data();
+  G4double* y  = batch.y.data();
+  G4double* yp = batch.yp.data();
+  G4double* T  = batch.T.data();
+  const G4double* kappaFactor = batch.kappaFactor.data();
+  const G4double* velocity    = batch.velocity.data();
+  G4int* elementIndex = batch.elementIndex.data();
+  const G4double momLimit   = backupStepperMomLimit;
+  const G4double minRadius2 = minimumRadiusOfCurvature*minimumRadiusOfCurvature;
+
+  for (G4int e = 0; e < (G4int)elements.size(); e++)
+    {
+      const Element& el = elements[e];
+      const G4double h = el.length;
+      const G4bool isDrift = el.bPrime == 0;
+      // no branches in this loop so it can be vectorised - values are computed for all
+      // particles and only kept for those that are still in progress and stay inside
+      for (std::size_t i = 0; i < n; i++)
+        {
+          G4double x0  = x[i];
+          G4double y0  = y[i];
+          G4double xp0 = xp[i];
+          G4double yp0 = yp[i];
+          G4double zp0 = std::sqrt(std::max(0.0, 1.0 - xp0*xp0 - yp0*yp0));
+          G4bool forwards = zp0 > 1e-3;
+          G4double safeZp = forwards ? zp0 : 1.0;
+          // step length whose projection on the element axis is its length
+          G4double pathLength = h / safeZp;
+
+          // as BDSIntegratorQuadrupole - the thick matrix is only used for paraxial
+          // particles with a radius of curvature above the minimum, else the backup
+          // stepper would be used so Geant4 must take over
+          G4double kappa  = el.bPrime * kappaFactor[i];
+          G4double absK   = std::abs(kappa);
+          G4double ax = -zp0*x0;
+          G4double ay =  zp0*y0;
+          G4double az =  x0*xp0 - y0*yp0;
+          G4bool paraxial = zp0 >= 1.0 - momLimit && std::abs(xp0) <= momLimit && std::abs(yp0) <= momLimit;
+          G4bool curvatureOK = kappa*kappa*(ax*ax + ay*ay + az*az)*minRadius2 < 1.0;
+          G4bool matrixOK = isDrift || (paraxial && curvatureOK);
+
+          G4double rootK  = std::sqrt(absK*safeZp);
+          G4double rootKh = rootK*pathLength*safeZp;
+          G4bool   finite = rootK > 1e-10; // else a straight line as for AdvanceDriftMag
+          G4double safeRootK = finite ? rootK : 1.0;
+          G4double c  = finite ? std::cos(rootKh) : 1.0;
+          G4double s  = finite ? std::sin(rootKh)  / safeRootK : pathLength;
+          G4double ch = finite ? std::cosh(rootKh) : 1.0;
+          G4double sh = finite ? std::sinh(rootKh) / safeRootK : pathLength;
+          G4bool focusX = kappa >= 0;
+
+          // matrices as in BDSIntegratorQuadrupole
+          G4double X11 = focusX ? c : ch;
+          G4double X12 = focusX ? s : sh;
+          G4double X21 = focusX ? -absK*s : absK*sh;
+          G4double Y11 = focusX ? ch : c;
+          G4double Y12 = focusX ? sh : s;
+          G4double Y21 = focusX ? absK*sh : -absK*s;
+
+          G4double x1  = X11*x0 + X12*xp0;
+          G4double xp1 = X21*x0 + X11*xp0;
+          G4double y1  = Y11*y0 + Y12*yp0;
+          G4double yp1 = Y21*y0 + Y11*yp0;
+
+          // largest excursion in the element - bounded by the amplitude in a
+          // focussing plane, otherwise the larger of the values at either end
+          G4double safeK = finite ? absK*safeZp : 1.0;
+          G4double maxX = std::max(std::abs(x0), std::abs(x1));
+          G4double maxY = std::max(std::abs(y0), std::abs(y1));
+          G4double ampX = std::sqrt(x0*x0 + xp0*xp0/safeK);
+          G4double ampY = std::sqrt(y0*y0 + yp0*yp0/safeK);
+          maxX = finite &&  focusX ? ampX : maxX;
+          maxY = finite && !focusX ? ampY : maxY;
+          G4bool inside = maxX*maxX + maxY*maxY < el.apertureRadius2;
+          G4bool advance = forwards && matrixOK && inside && elementIndex[i] == e;
+
+          // path length from the mean forward component for the time of flight
+          G4double zp1 = std::sqrt(std::max(0.0, 1.0 - xp1*xp1 - yp1*yp1));
+          G4double meanZp = finite ? 0.5*(zp0 + zp1) : safeZp;
+          meanZp = meanZp > 1e-3 ? meanZp : 1.0;
+          G4double T1 = T[i] + (h / meanZp) / velocity[i];
+
+          x[i]  = advance ? x1  : x0;
+          xp[i] = advance ? xp1 : xp0;
+          y[i]  = advance ? y1  : y0;
+          yp[i] = advance ? yp1 : yp0;
+          T[i]  = advance ? T1  : T[i];
+          elementIndex[i] += advance ? 1 : 0;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray4DCoords.hh"
+#include "BDSFieldEMInterpolated.hh"
+#include "BDSFieldEMOnDemand.hh"
+#include "BDSFieldInfo.hh"
+#include "BDSFieldLoader.hh"
+
+#include "G4ThreeVector.hh"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+BDSFieldEMOnDemand::BDSFieldEMOnDemand(const BDSFieldInfo& infoIn):
+  info(new BDSFieldInfo(infoIn)),
+  field(nullptr),
+  smallestSpatialStep(std::numeric_limits<double>::max()),
+  timeVarying(false)
+{
+  BDSFieldLoader* loader = BDSFieldLoader::Instance();
+  for (BDSArray4DCoords* header : {loader->LoadElectricHeader(*info), loader->LoadMagneticHeader(*info)})
+    {
+      smallestSpatialStep = std::min(smallestSpatialStep, header->SmallestSpatialStep());
+      timeVarying = timeVarying || header->TimeVarying();
+      delete header;
+    }
+  loader->RegisterDeferredField(*info);
+}
+
+BDSFieldEMOnDemand::~BDSFieldEMOnDemand()
+{
+  delete field;
+  delete info;
+}
+
+std::pair<G4ThreeVector,G4ThreeVector> BDSFieldEMOnDemand::GetField(const G4ThreeVector& position,
+                                                                    const G4double       t) const
+{
+  // cheap after the first call - no lock is taken once the flag is set
+  std::call_once(loadFlag, &BDSFieldEMOnDemand::Load, this);
+  return field->GetField(position, t);
+}
+
+void BDSFieldEMOnDemand::Load() const
+{
+  field = BDSFieldLoader::Instance()->LoadEMFieldOnDemand(*info);
+}
@@ -28,12 +28,14 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldEGlobalPlacement.hh"
 #include "BDSFieldEInterpolated.hh"
 #include "BDSFieldEInterpolated2Layer.hh"
+#include "BDSFieldEOnDemand.hh"
 #include "BDSFieldESinusoid.hh"
 #include "BDSFieldEZero.hh"
 #include "BDSFieldEM.hh"
 #include "BDSFieldEMGlobal.hh"
 #include "BDSFieldEMGlobalPlacement.hh"
 #include "BDSFieldEMInterpolated.hh"
+#include "BDSFieldEMOnDemand.hh"
 #include "BDSFieldEMRFCavity.hh"
 #include "BDSFieldEMZero.hh"
 #include "BDSFieldFactory.hh"
@@ -56,12 +58,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldMagMultipoleOuterOld.hh"
 #include "BDSFieldMagMuonSpoiler.hh"
 #include "BDSFieldMagOctupole.hh"
+#include "BDSFieldMagOnDemand.hh"
 #include "BDSFieldMagQuadrupole.hh"
 #include "BDSFieldMagSextupole.hh"
 #include "BDSFieldMagSolenoidSheet.hh"
 #include "BDSFieldMagSkewOwn.hh"
 #include "BDSFieldMagUndulator.hh"
 #include "BDSFieldMagZero.hh"
+#include "BDSFieldMapLayout.hh"
+#include "BDSFieldMapPrecision.hh"
 #include "BDSFieldObjects.hh"
 #include "BDSFieldType.hh"
 #include "BDSGlobalConstants.hh"
@@ -163,7 +168,8 @@ BDSFieldFactory* BDSFieldFactory::Instance()
 }
 
 BDSFieldFactory::BDSFieldFactory():
-  useOldMultipoleOuterFields(false)
+  useOldMultipoleOuterFields(false),
+  fieldMapOnDemand(false)
 {
   G4double defaultRigidity = std::numeric_limits<double>::max();
   if (designParticle)
@@ -175,6 +181,7 @@ BDSFieldFactory::BDSFieldFactory():
       PrepareFieldDefinitions(BDSParser::Instance()->GetFields(), defaultRigidity);
     }
   useOldMultipoleOuterFields = BDSGlobalConstants::Instance()->UseOldMultipoleOuterFields();
+  fieldMapOnDemand = BDSGlobalConstants::Instance()->FieldMapOnDemand();
 }
 
 BDSFieldFactory::~BDSFieldFactory()
@@ -368,6 +375,21 @@ void BDSFieldFactory::PrepareFieldDefinitions(const std::vector<GMAD::Field>& de
           BDSArrayReflectionTypeSet ear = BDS::DetermineArrayReflectionTypeSet(electricReflection);
           info->SetElectricArrayReflectionType(ear);
         }
+      if (!definition.mapPrecision.empty() || !definition.mapLayout.empty())
+        {
+          try
+            {
+              if (!definition.mapPrecision.empty())
+                {info->SetMapPrecision(BDS::DetermineFieldMapPrecision(G4String(definition.mapPrecision)));}
+              if (!definition.mapLayout.empty())
+                {info->SetMapLayout(BDS::DetermineFieldMapLayout(G4String(definition.mapLayout)));}
+            }
+          catch (BDSException& e)
+            {
+              e.AppendToMessage("\nError in field definition \"" + definition.name + "\".");
+              throw e;
+            }
+        }
       
       info->SetNameOfParserDefinition(G4String(definition.name));
       if (BDSGlobalConstants::Instance()->Verbose())
@@ -583,7 +605,8 @@ BDSFieldObjects* BDSFieldFactory::CreateFieldMag(const BDSFieldInfo&      info,
 
 BDSFieldMag* BDSFieldFactory::CreateFieldMagRaw(const BDSFieldInfo&      info,
                                                 const BDSMagnetStrength* scalingStrength,
-                                                const G4String&          scalingKey)
+                                                const G4String&          scalingKey,
+                                                G4bool                   allowOnDemand)
 {
   BDSFieldMag* field = nullptr;
   const BDSMagnetStrength* strength = info.MagnetStrength();
@@ -598,6 +621,18 @@ BDSFieldMag* BDSFieldFactory::CreateFieldMagRaw(const BDSFieldInfo&      info,
     case BDSFieldType::bmap4d:
     case BDSFieldType::mokka:
       {
+        // a sub-field or auto-scaling needs the loaded map now
+        G4bool onDemand = fieldMapOnDemand && allowOnDemand
+          && info.MagneticSubFieldName().empty()
+          && !(info.AutoScale() && scalingStrength)
+          && BDSFieldLoader::CanDeferLoading(info.MagneticFormat());
+        if (onDemand)
+          {
+            BDSFieldMagOnDemand* fod = new BDSFieldMagOnDemand(info);
+            info.UpdateUserLimitsLengthMaximumStepSize(fod->SmallestSpatialStep(), true);
+            field = fod;
+            break;
+          }
         BDSFieldMagInterpolated* ff = BDSFieldLoader::Instance()->LoadMagField(info,
                                                                                scalingStrength,
                                                                                scalingKey);
@@ -848,7 +883,7 @@ BDSFieldMag* BDSFieldFactory::CreateFieldMagRaw(const BDSFieldInfo&      info,
               {throw BDSException(__METHOD_NAME__, "subfield specified for non-field map type field - not supported");}
   
       BDSFieldInfo* subFieldRecipe = new BDSFieldInfo(*(GetDefinition(info.MagneticSubFieldName())));
-      BDSFieldMag* subFieldRaw = CreateFieldMagRaw(*subFieldRecipe, scalingStrength, scalingKey);
+      BDSFieldMag* subFieldRaw = CreateFieldMagRaw(*subFieldRecipe, scalingStrength, scalingKey, false);
       auto subField = dynamic_cast<BDSFieldMagInterpolated*>(subFieldRaw);
       if (!subField)
         {throw BDSException(__METHOD_NAME__, "subfield type is not a field map type field - not supported");}
@@ -873,6 +908,16 @@ BDSFieldObjects* BDSFieldFactory::CreateFieldEM(const BDSFieldInfo& info)
     case BDSFieldType::ebmap3d:
     case BDSFieldType::ebmap4d:
       {
+        G4bool onDemand = fieldMapOnDemand
+          && info.ElectricFormat() == info.MagneticFormat()
+          && BDSFieldLoader::CanDeferLoading(info.ElectricFormat());
+        if (onDemand)
+          {
+            BDSFieldEMOnDemand* fod = new BDSFieldEMOnDemand(info);
+            info.UpdateUserLimitsLengthMaximumStepSize(fod->SmallestSpatialStep(), true);
+            field = fod;
+            break;
+          }
         BDSFieldEMInterpolated* ff = BDSFieldLoader::Instance()->LoadEMField(info);
         if (ff)
           {info.UpdateUserLimitsLengthMaximumStepSize(ff->SmallestSpatialStep(), true);}
@@ -944,7 +989,8 @@ BDSFieldObjects* BDSFieldFactory::CreateFieldE(const BDSFieldInfo& info)
   return completeField;
 }
 
-BDSFieldE* BDSFieldFactory::CreateFieldERaw(const BDSFieldInfo& info)
+BDSFieldE* BDSFieldFactory::CreateFieldERaw(const BDSFieldInfo& info,
+                                            G4bool              allowOnDemand)
 {
   BDSFieldE* field = nullptr;
   switch (info.FieldType().underlying())
@@ -958,6 +1004,17 @@ BDSFieldE* BDSFieldFactory::CreateFieldERaw(const BDSFieldInfo& info)
     case BDSFieldType::emap3d:
     case BDSFieldType::emap4d:
       {
+        // a sub-field needs the loaded map now
+        G4bool onDemand = fieldMapOnDemand && allowOnDemand
+          && info.ElectricSubFieldName().empty()
+          && BDSFieldLoader::CanDeferLoading(info.ElectricFormat());
+        if (onDemand)
+          {
+            BDSFieldEOnDemand* fod = new BDSFieldEOnDemand(info);
+            info.UpdateUserLimitsLengthMaximumStepSize(fod->SmallestSpatialStep(), true);
+            field = fod;
+            break;
+          }
         BDSFieldEInterpolated* ff = BDSFieldLoader::Instance()->LoadEField(info);
         if (ff)
           {info.UpdateUserLimitsLengthMaximumStepSize(ff->SmallestSpatialStep(), true);}
@@ -996,7 +1053,7 @@ BDSFieldE* BDSFieldFactory::CreateFieldERaw(const BDSFieldInfo& info)
         {throw BDSException(__METHOD_NAME__, "subfield specified for non-field map type field - not supported");}
       
       BDSFieldInfo* subFieldRecipe = new BDSFieldInfo(*(GetDefinition(info.ElectricSubFieldName())));
-      BDSFieldE* subFieldRaw = CreateFieldERaw(*subFieldRecipe);
+      BDSFieldE* subFieldRaw = CreateFieldERaw(*subFieldRecipe, false);
       auto subField = dynamic_cast<BDSFieldEInterpolated*>(subFieldRaw);
       if (!subField)
         {throw BDSException(__METHOD_NAME__, "subfield type is not a field map type field - not supported");}
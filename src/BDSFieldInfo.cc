@@ -18,6 +18,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSArrayReflectionType.hh"
 #include "BDSFieldInfo.hh"
+#include "BDSFieldMapLayout.hh"
+#include "BDSFieldMapPrecision.hh"
 #include "BDSFieldType.hh"
 #include "BDSIntegratorType.hh"
 #include "BDSInterpolatorType.hh"
@@ -33,7 +35,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4UserLimits.hh"
 
 #include <algorithm>
+#include <iomanip>
+#include <limits>
 #include <ostream>
+#include <sstream>
 
 G4UserLimits* BDSFieldInfo::defaultUL = nullptr;
 
@@ -52,6 +57,8 @@ BDSFieldInfo::BDSFieldInfo():
   electricFieldFormat(BDSFieldFormat::none),
   electricInterpolatorType(BDSInterpolatorType::nearest3d),
   electricArrayReflectionTypeSet(BDSArrayReflectionTypeSet()),
+  mapPrecision(BDSFieldMapPrecision::standard),
+  mapLayout(BDSFieldMapLayout::linear),
   cacheTransforms(true),
   eScaling(1.0),
   bScaling(1.0),
@@ -110,6 +117,8 @@ BDSFieldInfo::BDSFieldInfo(BDSFieldType             fieldTypeIn,
   electricFieldFormat(electricFieldFormatIn),
   electricInterpolatorType(electricInterpolatorTypeIn),
   electricArrayReflectionTypeSet(BDSArrayReflectionTypeSet()),
+  mapPrecision(BDSFieldMapPrecision::standard),
+  mapLayout(BDSFieldMapLayout::linear),
   cacheTransforms(cacheTransformsIn),
   eScaling(eScalingIn),
   bScaling(bScalingIn),
@@ -160,6 +169,8 @@ BDSFieldInfo::BDSFieldInfo(const BDSFieldInfo& other):
   electricFieldFormat(other.electricFieldFormat),
   electricInterpolatorType(other.electricInterpolatorType),
   electricArrayReflectionTypeSet(other.electricArrayReflectionTypeSet),
+  mapPrecision(other.mapPrecision),
+  mapLayout(other.mapLayout),
   cacheTransforms(other.cacheTransforms),
   eScaling(other.eScaling),
   bScaling(other.bScaling),
@@ -243,6 +254,8 @@ std::ostream& operator<< (std::ostream& out, BDSFieldInfo const& info)
   out << "E map file format:   " << info.electricFieldFormat      << G4endl;
   out << "E interpolator       " << info.electricInterpolatorType << G4endl;
   out << "E array reflection:  " << info.electricArrayReflectionTypeSet << G4endl;
+  out << "Map precision:       " << info.mapPrecision             << G4endl;
+  out << "Map layout:          " << info.mapLayout                << G4endl;
   out << "Transform caching:   " << info.cacheTransforms          << G4endl;
   out << "E Scaling:           " << info.eScaling                 << G4endl;
   out << "B Scaling:           " << info.bScaling                 << G4endl;
@@ -270,6 +283,18 @@ std::ostream& operator<< (std::ostream& out, BDSFieldInfo const& info)
   return out;
 }
 
+G4String BDSFieldInfo::DefinitionKey() const
+{
+  std::ostringstream key;
+  key << std::setprecision(std::numeric_limits<G4double>::max_digits10);
+  key << *this;
+  G4Transform3D field = Transform();
+  G4Transform3D beamline = TransformBeamline();
+  key << "Transform: " << field.getRotation() << field.getTranslation() << G4endl;
+  key << "Transform beam line: " << beamline.getRotation() << beamline.getTranslation() << G4endl;
+  return G4String(key.str());
+}
+
 void BDSFieldInfo::Translate(const G4ThreeVector& translationIn)
 {
   if (!transform)
@@ -40,6 +40,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSArrayOperatorValueReflectSolenoidZ.hh"
 #include "BDSArrayOperatorValueV.hh"
 #include "BDSArrayReflectionType.hh"
+#include "BDSArraySharedStore.hh"
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSFieldEInterpolated.hh"
@@ -56,13 +57,17 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldInfo.hh"
 #include "BDSFieldLoader.hh"
 #include "BDSFieldLoaderBDSIM.hh"
+#include "BDSFieldLoaderBDSIMBinary.hh"
 #include "BDSFieldLoaderPoisson.hh"
 #include "BDSFieldMagInterpolated.hh"
 #include "BDSFieldMagInterpolated1D.hh"
 #include "BDSFieldMagInterpolated2D.hh"
 #include "BDSFieldMagInterpolated3D.hh"
 #include "BDSFieldMagInterpolated4D.hh"
+#include "BDSFieldMapLayout.hh"
+#include "BDSFieldMapPrecision.hh"
 #include "BDSFieldValue.hh"
+#include "BDSGlobalConstants.hh"
 #include "BDSInterpolator1D.hh"
 #include "BDSInterpolator1DCubic.hh"
 #include "BDSInterpolator1DLinear.hh"
@@ -95,7 +100,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include <array>
 #include <cmath>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
 #include <set>
+#include <string>
 
 #ifdef USE_GZSTREAM
 #include "src-external/gzstream/gzstream.h"
@@ -143,6 +152,8 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadMagField(const BDSFieldInfo&      i
   G4double                    bScaling = info.BScaling();
   BDSArrayReflectionTypeSet reflection = info.MagneticArrayReflectionType();
   BDSArrayReflectionTypeSet* reflectionPointer = reflection.empty() ? nullptr : &reflection;
+  BDSFieldMapPrecision       precision = info.MapPrecision();
+  BDSFieldMapLayout             layout = info.MapLayout();
   
   BDSFieldMagInterpolated* result = nullptr;
   try
@@ -150,19 +161,19 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadMagField(const BDSFieldInfo&      i
   switch (format.underlying())
     {
     case BDSFieldFormat::bdsim1d:
-      {result = LoadBDSIM1DB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadBDSIM1DB(filePath, interpolatorType, transform, bScaling, reflectionPointer, precision, layout); break;}
     case BDSFieldFormat::bdsim2d:
-      {result = LoadBDSIM2DB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadBDSIM2DB(filePath, interpolatorType, transform, bScaling, reflectionPointer, precision, layout); break;}
     case BDSFieldFormat::bdsim3d:
-      {result = LoadBDSIM3DB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadBDSIM3DB(filePath, interpolatorType, transform, bScaling, reflectionPointer, precision, layout); break;}
     case BDSFieldFormat::bdsim4d:
-      {result = LoadBDSIM4DB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadBDSIM4DB(filePath, interpolatorType, transform, bScaling, reflectionPointer, precision, layout); break;}
     case BDSFieldFormat::poisson2d:
-      {result = LoadPoissonSuperFishB(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadPoissonSuperFishB(filePath, interpolatorType, transform, bScaling, reflectionPointer, precision, layout); break;}
     case BDSFieldFormat::poisson2dquad:
-      {result = LoadPoissonSuperFishBQuad(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadPoissonSuperFishBQuad(filePath, interpolatorType, transform, bScaling, reflectionPointer, precision, layout); break;}
     case BDSFieldFormat::poisson2ddipole:
-      {result = LoadPoissonSuperFishBDipole(filePath, interpolatorType, transform, bScaling, reflectionPointer); break;}
+      {result = LoadPoissonSuperFishBDipole(filePath, interpolatorType, transform, bScaling, reflectionPointer, precision, layout); break;}
     default:
       {break;}
     }
@@ -225,6 +236,8 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadEField(const BDSFieldInfo& info)
   G4double                    eScaling = info.EScaling();
   BDSArrayReflectionTypeSet reflection = info.ElectricArrayReflectionType();
   BDSArrayReflectionTypeSet* reflectionPointer = reflection.empty() ? nullptr : &reflection;
+  BDSFieldMapPrecision       precision = info.MapPrecision();
+  BDSFieldMapLayout             layout = info.MapLayout();
   
   BDSFieldEInterpolated* result = nullptr;
   try
@@ -232,13 +245,13 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadEField(const BDSFieldInfo& info)
   switch (format.underlying())
     {
     case BDSFieldFormat::bdsim1d:
-      {result = LoadBDSIM1DE(filePath, interpolatorType, transform, eScaling, reflectionPointer); break;}
+      {result = LoadBDSIM1DE(filePath, interpolatorType, transform, eScaling, reflectionPointer, precision, layout); break;}
     case BDSFieldFormat::bdsim2d:
-      {result = LoadBDSIM2DE(filePath, interpolatorType, transform, eScaling, reflectionPointer); break;}
+      {result = LoadBDSIM2DE(filePath, interpolatorType, transform, eScaling, reflectionPointer, precision, layout); break;}
     case BDSFieldFormat::bdsim3d:
-      {result = LoadBDSIM3DE(filePath, interpolatorType, transform, eScaling, reflectionPointer); break;}
+      {result = LoadBDSIM3DE(filePath, interpolatorType, transform, eScaling, reflectionPointer, precision, layout); break;}
     case BDSFieldFormat::bdsim4d:
-      {result = LoadBDSIM4DE(filePath, interpolatorType, transform, eScaling, reflectionPointer); break;}
+      {result = LoadBDSIM4DE(filePath, interpolatorType, transform, eScaling, reflectionPointer, precision, layout); break;}
     default:
       {break;}
     }
@@ -268,6 +281,8 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadEMField(const BDSFieldInfo& info)
   BDSArrayReflectionTypeSet* bReflectionPointer = bReflection.empty() ? nullptr : &bReflection;
   BDSArrayReflectionTypeSet eReflection = info.ElectricArrayReflectionType();
   BDSArrayReflectionTypeSet* eReflectionPointer = eReflection.empty() ? nullptr : &eReflection;
+  BDSFieldMapPrecision precision = info.MapPrecision();
+  BDSFieldMapLayout    layout    = info.MapLayout();
 
   // As the different dimension interpolators don't inherit each other, it's very
   // very hard to make a compact polymorphic construction routine here.  In future,
@@ -284,25 +299,25 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadEMField(const BDSFieldInfo& info)
     case BDSFieldFormat::bdsim1d:
       {
         result = LoadBDSIM1DEM(eFilePath, bFilePath, eIntType, bIntType, transform,
-                               eScaling, bScaling, eReflectionPointer, bReflectionPointer);
+                               eScaling, bScaling, eReflectionPointer, bReflectionPointer, precision, layout);
         break;
       }
     case BDSFieldFormat::bdsim2d:
       {
         result = LoadBDSIM2DEM(eFilePath, bFilePath, eIntType, bIntType, transform,
-                               eScaling, bScaling, eReflectionPointer, bReflectionPointer);
+                               eScaling, bScaling, eReflectionPointer, bReflectionPointer, precision, layout);
         break;
       }
     case BDSFieldFormat::bdsim3d:
       {
         result = LoadBDSIM3DEM(eFilePath, bFilePath, eIntType, bIntType, transform,
-                               eScaling, bScaling, eReflectionPointer, bReflectionPointer);
+                               eScaling, bScaling, eReflectionPointer, bReflectionPointer, precision, layout);
         break;
       }
     case BDSFieldFormat::bdsim4d:
       {
         result = LoadBDSIM4DEM(eFilePath, bFilePath, eIntType, bIntType, transform,
-                               eScaling, bScaling, eReflectionPointer, bReflectionPointer);
+                               eScaling, bScaling, eReflectionPointer, bReflectionPointer, precision, layout);
         break;
       }
     default:
@@ -337,6 +352,142 @@ void BDSFieldLoader::EFilePathOK(const BDSFieldInfo& info)
     }
 }
 
+G4bool BDSFieldLoader::CanDeferLoading(const BDSFieldFormat& format)
+{
+  switch (format.underlying())
+    {
+    case BDSFieldFormat::bdsim1d:
+    case BDSFieldFormat::bdsim2d:
+    case BDSFieldFormat::bdsim3d:
+    case BDSFieldFormat::bdsim4d:
+      {return true;}
+    default:
+      {return false;}
+    }
+}
+
+BDSArray4DCoords* BDSFieldLoader::LoadMagneticHeader(const BDSFieldInfo& info) const
+{
+  BFilePathOK(info);
+  return LoadHeader(info.MagneticFile(), info.MagneticFormat(), info.NameOfParserDefinition());
+}
+
+BDSArray4DCoords* BDSFieldLoader::LoadElectricHeader(const BDSFieldInfo& info) const
+{
+  EFilePathOK(info);
+  return LoadHeader(info.ElectricFile(), info.ElectricFormat(), info.NameOfParserDefinition());
+}
+
+BDSArray4DCoords* BDSFieldLoader::LoadHeader(const G4String&       filePath,
+                                             const BDSFieldFormat& format,
+                                             const G4String&       definitionName) const
+{
+  if (!CanDeferLoading(format))
+    {throw BDSException(__METHOD_NAME__, "format \"" + format.ToString() + "\" cannot be loaded on demand");}
+  
+  unsigned int nDim = (unsigned int)BDS::NDimensionsOfFieldFormat(format);
+  BDSArray4DCoords* result = nullptr;
+  try
+    {
+      if (BDSFieldLoaderBDSIMBinary::IsBinary(filePath))
+        {
+          BDSFieldLoaderBDSIMBinary loader;
+          result = loader.LoadHeader(filePath, nDim);
+        }
+      else if (filePath.rfind("gz") != std::string::npos)
+        {
+#ifdef USE_GZSTREAM
+          BDSFieldLoaderBDSIM<igzstream> loader;
+          result = loader.LoadHeader(filePath, nDim);
+#else
+          throw BDSException(__METHOD_NAME__, "Compressed file loading - but BDSIM not compiled with ZLIB.");
+#endif
+        }
+      else
+        {
+          BDSFieldLoaderBDSIM<std::ifstream> loader;
+          result = loader.LoadHeader(filePath, nDim);
+        }
+    }
+  catch (BDSException& e)
+    {
+      e.AppendToMessage("\nError in field definition \"" + definitionName + "\".");
+      throw e;
+    }
+  return result;
+}
+
+G4String BDSFieldLoader::DeferredFieldKey(const BDSFieldInfo& info)
+{
+  G4String files = info.MagneticFile();
+  if (!info.ElectricFile().empty())
+    {
+      if (!files.empty())
+        {files += ", ";}
+      files += info.ElectricFile();
+    }
+  return "\"" + info.NameOfParserDefinition() + "\" (" + files + ")";
+}
+
+void BDSFieldLoader::RegisterDeferredField(const BDSFieldInfo& info)
+{
+  std::lock_guard<std::mutex> lock(onDemandMutex);
+  deferredFields[DeferredFieldKey(info)].nFields++;
+}
+
+void BDSFieldLoader::MarkDeferredFieldLoaded(const BDSFieldInfo& info)
+{
+  deferredFields[DeferredFieldKey(info)].nLoaded++;
+}
+
+BDSFieldMagInterpolated* BDSFieldLoader::LoadMagFieldOnDemand(const BDSFieldInfo& info)
+{
+  std::lock_guard<std::mutex> lock(onDemandMutex);
+  G4cout << __METHOD_NAME__ << "first use of field \"" << info.NameOfParserDefinition() << "\" - loading" << G4endl;
+  BDSFieldMagInterpolated* result = LoadMagField(info);
+  MarkDeferredFieldLoaded(info);
+  return result;
+}
+
+BDSFieldEInterpolated* BDSFieldLoader::LoadEFieldOnDemand(const BDSFieldInfo& info)
+{
+  std::lock_guard<std::mutex> lock(onDemandMutex);
+  G4cout << __METHOD_NAME__ << "first use of field \"" << info.NameOfParserDefinition() << "\" - loading" << G4endl;
+  BDSFieldEInterpolated* result = LoadEField(info);
+  MarkDeferredFieldLoaded(info);
+  return result;
+}
+
+BDSFieldEMInterpolated* BDSFieldLoader::LoadEMFieldOnDemand(const BDSFieldInfo& info)
+{
+  std::lock_guard<std::mutex> lock(onDemandMutex);
+  G4cout << __METHOD_NAME__ << "first use of field \"" << info.NameOfParserDefinition() << "\" - loading" << G4endl;
+  BDSFieldEMInterpolated* result = LoadEMField(info);
+  MarkDeferredFieldLoaded(info);
+  return result;
+}
+
+void BDSFieldLoader::PrintDeferredFieldSummary() const
+{
+  std::lock_guard<std::mutex> lock(onDemandMutex);
+  if (deferredFields.empty())
+    {return;}
+
+  G4int nUsed = 0;
+  for (const auto& kv : deferredFields)
+    {nUsed += kv.second.nLoaded > 0 ? 1 : 0;}
+  G4cout << __METHOD_NAME__ << nUsed << " of " << deferredFields.size()
+         << " field maps loaded on demand were used" << G4endl;
+  for (const auto& kv : deferredFields)
+    {
+      const DeferredUsage& usage = kv.second;
+      G4cout << (usage.nLoaded > 0 ? "  used     " : "  not used ") << kv.first;
+      if (usage.nLoaded > 0)
+        {G4cout << " - loaded by " << usage.nLoaded << " of " << usage.nFields << " field objects";}
+      G4cout << G4endl;
+    }
+}
+
 BDSArray1DCoords* BDSFieldLoader::Get1DCached(const G4String& filePath)
 {
   auto result = arrays1d.find(filePath);
@@ -373,12 +524,75 @@ BDSArray4DCoords* BDSFieldLoader::Get4DCached(const G4String& filePath)
     {return nullptr;}
 }
 
-BDSArray2DCoords* BDSFieldLoader::LoadPoissonMag2D(const G4String& filePath)
+G4String BDSFieldLoader::CacheKey(const G4String&      filePath,
+                                  BDSFieldMapPrecision precision,
+                                  BDSFieldMapLayout    layout)
+{
+  G4String key = filePath;
+  if (precision != BDSFieldMapPrecision::standard)
+    {key += "#" + precision.ToString();}
+  if (layout != BDSFieldMapLayout::linear)
+    {key += "#" + layout.ToString();}
+  return key;
+}
+
+void BDSFieldLoader::ApplyStorage(BDSArray4DCoords*    array,
+                                  const G4String&      filePath,
+                                  BDSFieldMapPrecision precision,
+                                  BDSFieldMapLayout    layout) const
+{
+  if (layout == BDSFieldMapLayout::tiled)
+    {array->Tile();} // must be before quantising
+  if (precision == BDSFieldMapPrecision::int16)
+    {
+      array->Quantise();
+      G4cout << "BDSFieldLoader> quantised \"" << filePath << "\" to int16 with resolution "
+             << array->QuantisationStep() << " (file units)" << G4endl;
+    }
+}
+
+BDSArray4DCoords* BDSFieldLoader::LoadOrAttach(const G4String&      filePath,
+                                               const G4String&      formatName,
+                                               G4int                nDim,
+                                               BDSFieldMapPrecision precision,
+                                               BDSFieldMapLayout    layout,
+                                               const std::function<BDSArray4DCoords*()>& read) const
 {
-  BDSArray2DCoords* cached = Get2DCached(filePath);
+  // the array is shared as stored so only the process that publishes it tiles or quantises it
+  auto load = [&]()
+  {
+    BDSArray4DCoords* result = read();
+    if (result)
+      {ApplyStorage(result, filePath, precision, layout);}
+    return result;
+  };
+  if (BDSGlobalConstants::Instance()->FieldMapSharedMemory())
+    {
+      return BDSArraySharedStore::LoadOrAttach(filePath, formatName, nDim,
+                                               layout == BDSFieldMapLayout::tiled,
+                                               precision == BDSFieldMapPrecision::int16,
+                                               load);
+    }
+  else
+    {return load();}
+}
+
+BDSArray2DCoords* BDSFieldLoader::LoadPoissonMag2D(const G4String&      filePath,
+                                                   BDSFieldMapPrecision precision,
+                                                   BDSFieldMapLayout    layout)
+{
+  G4String key = CacheKey(filePath, precision, layout);
+  BDSArray2DCoords* cached = Get2DCached(key);
   if (cached)
     {return cached;}
 
+  BDSArray2DCoords* result = static_cast<BDSArray2DCoords*>(LoadOrAttach(filePath, "poisson2d", 2, precision, layout, [&](){return ReadPoissonMag2D(filePath);}));
+  arrays2d[key] = result;
+  return result;
+}
+
+BDSArray2DCoords* BDSFieldLoader::ReadPoissonMag2D(const G4String& filePath)
+{
   BDSArray2DCoords* result = nullptr;
   if (filePath.rfind("gz") != std::string::npos)
     {
@@ -394,20 +608,34 @@ BDSArray2DCoords* BDSFieldLoader::LoadPoissonMag2D(const G4String& filePath)
       BDSFieldLoaderPoisson<std::ifstream> loader;
       result = loader.LoadMag2D(filePath);
     }
-  arrays2d[filePath] = result;
-  return result;  
+  return result;
 }
 
-BDSArray1DCoords* BDSFieldLoader::LoadBDSIM1D(const G4String& filePath)
+BDSArray1DCoords* BDSFieldLoader::LoadBDSIM1D(const G4String&      filePath,
+                                              BDSFieldMapPrecision precision,
+                                              BDSFieldMapLayout    layout)
 {
-  BDSArray1DCoords* cached = Get1DCached(filePath);
+  G4String key = CacheKey(filePath, precision, layout);
+  BDSArray1DCoords* cached = Get1DCached(key);
   if (cached)
     {return cached;}
 
+  BDSArray1DCoords* result = static_cast<BDSArray1DCoords*>(LoadOrAttach(filePath, "bdsim1d", 1, precision, layout, [&](){return ReadBDSIM1D(filePath);}));
+  arrays1d[key] = result;
+  return result;
+}
+
+BDSArray1DCoords* BDSFieldLoader::ReadBDSIM1D(const G4String& filePath)
+{
   // Don't want to template this class and there's no base class pointer
   // for BDSFieldLoader so unfortunately, there's a wee bit of repetition.
   BDSArray1DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
+  if (BDSFieldLoaderBDSIMBinary::IsBinary(filePath))
+    {
+      BDSFieldLoaderBDSIMBinary loader;
+      result = loader.Load1D(filePath);
+    }
+  else if (filePath.rfind("gz") != std::string::npos)
     {
 #ifdef USE_GZSTREAM
       BDSFieldLoaderBDSIM<igzstream> loader;
@@ -421,18 +649,32 @@ BDSArray1DCoords* BDSFieldLoader::LoadBDSIM1D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load1D(filePath);
     }
-  arrays1d[filePath] = result;
   return result;
 }
 
-BDSArray2DCoords* BDSFieldLoader::LoadBDSIM2D(const G4String& filePath)
+BDSArray2DCoords* BDSFieldLoader::LoadBDSIM2D(const G4String&      filePath,
+                                              BDSFieldMapPrecision precision,
+                                              BDSFieldMapLayout    layout)
 {
-  BDSArray2DCoords* cached = Get2DCached(filePath);
+  G4String key = CacheKey(filePath, precision, layout);
+  BDSArray2DCoords* cached = Get2DCached(key);
   if (cached)
     {return cached;}
-  
+
+  BDSArray2DCoords* result = static_cast<BDSArray2DCoords*>(LoadOrAttach(filePath, "bdsim2d", 2, precision, layout, [&](){return ReadBDSIM2D(filePath);}));
+  arrays2d[key] = result;
+  return result;
+}
+
+BDSArray2DCoords* BDSFieldLoader::ReadBDSIM2D(const G4String& filePath)
+{
   BDSArray2DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
+  if (BDSFieldLoaderBDSIMBinary::IsBinary(filePath))
+    {
+      BDSFieldLoaderBDSIMBinary loader;
+      result = loader.Load2D(filePath);
+    }
+  else if (filePath.rfind("gz") != std::string::npos)
     {
 #ifdef USE_GZSTREAM
       BDSFieldLoaderBDSIM<igzstream> loader;
@@ -446,18 +688,32 @@ BDSArray2DCoords* BDSFieldLoader::LoadBDSIM2D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load2D(filePath);
     }
-  arrays2d[filePath] = result;
   return result;
 }
 
-BDSArray3DCoords* BDSFieldLoader::LoadBDSIM3D(const G4String& filePath)
+BDSArray3DCoords* BDSFieldLoader::LoadBDSIM3D(const G4String&      filePath,
+                                              BDSFieldMapPrecision precision,
+                                              BDSFieldMapLayout    layout)
 {
-  BDSArray3DCoords* cached = Get3DCached(filePath);
+  G4String key = CacheKey(filePath, precision, layout);
+  BDSArray3DCoords* cached = Get3DCached(key);
   if (cached)
     {return cached;}
 
+  BDSArray3DCoords* result = static_cast<BDSArray3DCoords*>(LoadOrAttach(filePath, "bdsim3d", 3, precision, layout, [&](){return ReadBDSIM3D(filePath);}));
+  arrays3d[key] = result;
+  return result;
+}
+
+BDSArray3DCoords* BDSFieldLoader::ReadBDSIM3D(const G4String& filePath)
+{
   BDSArray3DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos )
+  if (BDSFieldLoaderBDSIMBinary::IsBinary(filePath))
+    {
+      BDSFieldLoaderBDSIMBinary loader;
+      result = loader.Load3D(filePath);
+    }
+  else if (filePath.rfind("gz") != std::string::npos )
     {
 #ifdef USE_GZSTREAM
       BDSFieldLoaderBDSIM<igzstream> loader;
@@ -470,19 +726,33 @@ BDSArray3DCoords* BDSFieldLoader::LoadBDSIM3D(const G4String& filePath)
     {
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load3D(filePath);
-}
-  arrays3d[filePath] = result;
+    }
   return result;
 }
 
-BDSArray4DCoords* BDSFieldLoader::LoadBDSIM4D(const G4String& filePath)
+BDSArray4DCoords* BDSFieldLoader::LoadBDSIM4D(const G4String&      filePath,
+                                              BDSFieldMapPrecision precision,
+                                              BDSFieldMapLayout    layout)
 {
-  BDSArray4DCoords* cached = Get4DCached(filePath);
+  G4String key = CacheKey(filePath, precision, layout);
+  BDSArray4DCoords* cached = Get4DCached(key);
   if (cached)
     {return cached;}
 
+  BDSArray4DCoords* result = LoadOrAttach(filePath, "bdsim4d", 4, precision, layout, [&](){return ReadBDSIM4D(filePath);});
+  arrays4d[key] = result;
+  return result;
+}
+
+BDSArray4DCoords* BDSFieldLoader::ReadBDSIM4D(const G4String& filePath)
+{
   BDSArray4DCoords* result = nullptr;
-  if (filePath.rfind("gz") != std::string::npos)
+  if (BDSFieldLoaderBDSIMBinary::IsBinary(filePath))
+    {
+      BDSFieldLoaderBDSIMBinary loader;
+      result = loader.Load4D(filePath);
+    }
+  else if (filePath.rfind("gz") != std::string::npos)
     {
 #ifdef USE_GZSTREAM
       BDSFieldLoaderBDSIM<igzstream> loader;
@@ -496,7 +766,6 @@ BDSArray4DCoords* BDSFieldLoader::LoadBDSIM4D(const G4String& filePath)
       BDSFieldLoaderBDSIM<std::ifstream> loader;
       result = loader.Load4D(filePath);
     }
-  arrays4d[filePath] = result;
   return result;
 }
 
@@ -805,11 +1074,13 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadBDSIM1DB(const G4String&      fileP
                                                       BDSInterpolatorType  interpolatorType,
                                                       const G4Transform3D& transform,
                                                       G4double             bScaling,
-                                                      const BDSArrayReflectionTypeSet* reflection)
+                                                      const BDSArrayReflectionTypeSet* reflection,
+                                                      BDSFieldMapPrecision precision,
+                                                      BDSFieldMapLayout    layout)
 
 {
   G4double   bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray1DCoords*  array = LoadBDSIM1D(filePath);
+  BDSArray1DCoords*  array = LoadBDSIM1D(filePath, precision, layout);
   BDSArray1DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator1D*    ar = CreateInterpolator1D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated1D(ar, transform, bScalingUnits);
@@ -820,10 +1091,12 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadBDSIM2DB(const G4String&      fileP
                                                       BDSInterpolatorType  interpolatorType,
                                                       const G4Transform3D& transform,
                                                       G4double             bScaling,
-                                                      const BDSArrayReflectionTypeSet* reflection)
+                                                      const BDSArrayReflectionTypeSet* reflection,
+                                                      BDSFieldMapPrecision precision,
+                                                      BDSFieldMapLayout    layout)
 {
   G4double   bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray2DCoords*  array = LoadBDSIM2D(filePath);
+  BDSArray2DCoords*  array = LoadBDSIM2D(filePath, precision, layout);
   BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator2D*    ar = CreateInterpolator2D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated2D(ar, transform, bScalingUnits);
@@ -834,10 +1107,12 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadBDSIM3DB(const G4String&      fileP
                                                       BDSInterpolatorType  interpolatorType,
                                                       const G4Transform3D& transform,
                                                       G4double             bScaling,
-                                                      const BDSArrayReflectionTypeSet* reflection)
+                                                      const BDSArrayReflectionTypeSet* reflection,
+                                                      BDSFieldMapPrecision precision,
+                                                      BDSFieldMapLayout    layout)
 {
   G4double   bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray3DCoords*  array = LoadBDSIM3D(filePath);
+  BDSArray3DCoords*  array = LoadBDSIM3D(filePath, precision, layout);
   BDSArray3DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator3D*    ar = CreateInterpolator3D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated3D(ar, transform, bScalingUnits);
@@ -848,10 +1123,12 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadBDSIM4DB(const G4String&      fileP
                                                       BDSInterpolatorType  interpolatorType,
                                                       const G4Transform3D& transform,
                                                       G4double             bScaling,
-                                                      const BDSArrayReflectionTypeSet* reflection)
+                                                      const BDSArrayReflectionTypeSet* reflection,
+                                                      BDSFieldMapPrecision precision,
+                                                      BDSFieldMapLayout    layout)
 {
   G4double   bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray4DCoords*  array = LoadBDSIM4D(filePath);
+  BDSArray4DCoords*  array = LoadBDSIM4D(filePath, precision, layout);
   BDSArray4DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator4D*    ar = CreateInterpolator4D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated4D(ar, transform, bScalingUnits);
@@ -862,10 +1139,12 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadPoissonSuperFishB(const G4String&
                                                                BDSInterpolatorType  interpolatorType,
                                                                const G4Transform3D& transform,
                                                                G4double             bScaling,
-                                                               const BDSArrayReflectionTypeSet* reflection)
+                                                               const BDSArrayReflectionTypeSet* reflection,
+                                                               BDSFieldMapPrecision precision,
+                                                               BDSFieldMapLayout    layout)
 {
   G4double   bScalingUnits = bScaling * CLHEP::gauss;
-  BDSArray2DCoords*  array = LoadPoissonMag2D(filePath);
+  BDSArray2DCoords*  array = LoadPoissonMag2D(filePath, precision, layout);
   BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator2D*    ar = CreateInterpolator2D(arrayR, interpolatorType);
   BDSFieldMagInterpolated* result = new BDSFieldMagInterpolated2D(ar, transform, bScalingUnits);
@@ -876,10 +1155,12 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadPoissonSuperFishBQuad(const G4Strin
                                                                    BDSInterpolatorType  interpolatorType,
                                                                    const G4Transform3D& transform,
                                                                    G4double             bScaling,
-                                                                   const BDSArrayReflectionTypeSet* /*reflection*/)
+                                                                   const BDSArrayReflectionTypeSet* /*reflection*/,
+                                                                   BDSFieldMapPrecision precision,
+                                                                   BDSFieldMapLayout    layout)
 {
   G4double  bScalingUnits = bScaling * CLHEP::gauss;
-  BDSArray2DCoords* array = LoadPoissonMag2D(filePath);
+  BDSArray2DCoords* array = LoadPoissonMag2D(filePath, precision, layout);
   //BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   if (std::abs(array->XStep() - array->YStep()) > 1e-9)
     {throw BDSException(__METHOD_NAME__, "asymmetric grid spacing for reflected quadrupole will result in a distorted field map - please regenerate the map with even spatial samples.");}
@@ -893,10 +1174,12 @@ BDSFieldMagInterpolated* BDSFieldLoader::LoadPoissonSuperFishBDipole(const G4Str
                                                                      BDSInterpolatorType  interpolatorType,
                                                                      const G4Transform3D& transform,
                                                                      G4double             bScaling,
-                                                                     const BDSArrayReflectionTypeSet* /*reflection*/)
+                                                                     const BDSArrayReflectionTypeSet* /*reflection*/,
+                                                                     BDSFieldMapPrecision precision,
+                                                                     BDSFieldMapLayout    layout)
 {
   G4double  bScalingUnits = bScaling * CLHEP::gauss;
-  BDSArray2DCoords* array = LoadPoissonMag2D(filePath);
+  BDSArray2DCoords* array = LoadPoissonMag2D(filePath, precision, layout);
   //BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSArray2DCoordsRDipole* rArray = new BDSArray2DCoordsRDipole(array);
   BDSInterpolator2D*           ar = CreateInterpolator2D(rArray, interpolatorType);
@@ -908,10 +1191,12 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadBDSIM1DE(const G4String&      filePat
                                                     BDSInterpolatorType  interpolatorType,
                                                     const G4Transform3D& transform,
                                                     G4double             eScaling,
-                                                    const BDSArrayReflectionTypeSet* reflection)
+                                                    const BDSArrayReflectionTypeSet* reflection,
+                                                    BDSFieldMapPrecision precision,
+                                                    BDSFieldMapLayout    layout)
 {
   G4double   eScalingUnits = eScaling * CLHEP::volt/CLHEP::m;
-  BDSArray1DCoords*  array = LoadBDSIM1D(filePath);
+  BDSArray1DCoords*  array = LoadBDSIM1D(filePath, precision, layout);
   BDSArray1DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator1D*    ar = CreateInterpolator1D(arrayR, interpolatorType);
   BDSFieldEInterpolated* result = new BDSFieldEInterpolated1D(ar, transform, eScalingUnits);
@@ -922,10 +1207,12 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadBDSIM2DE(const G4String&      filePat
                                                     BDSInterpolatorType  interpolatorType,
                                                     const G4Transform3D& transform,
                                                     G4double             eScaling,
-                                                    const BDSArrayReflectionTypeSet* reflection)
+                                                    const BDSArrayReflectionTypeSet* reflection,
+                                                    BDSFieldMapPrecision precision,
+                                                    BDSFieldMapLayout    layout)
 {
   G4double   eScalingUnits = eScaling * CLHEP::volt/CLHEP::m;
-  BDSArray2DCoords*  array = LoadBDSIM2D(filePath);
+  BDSArray2DCoords*  array = LoadBDSIM2D(filePath, precision, layout);
   BDSArray2DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator2D*    ar = CreateInterpolator2D(arrayR, interpolatorType);
   BDSFieldEInterpolated* result = new BDSFieldEInterpolated2D(ar, transform, eScalingUnits);
@@ -936,10 +1223,12 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadBDSIM3DE(const G4String&      filePat
                                                     BDSInterpolatorType  interpolatorType,
                                                     const G4Transform3D& transform,
                                                     G4double             eScaling,
-                                                    const BDSArrayReflectionTypeSet* reflection)
+                                                    const BDSArrayReflectionTypeSet* reflection,
+                                                    BDSFieldMapPrecision precision,
+                                                    BDSFieldMapLayout    layout)
 {
   G4double   eScalingUnits = eScaling * CLHEP::volt/CLHEP::m;
-  BDSArray3DCoords*  array = LoadBDSIM3D(filePath);
+  BDSArray3DCoords*  array = LoadBDSIM3D(filePath, precision, layout);
   BDSArray3DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator3D*    ar = CreateInterpolator3D(arrayR, interpolatorType);
   BDSFieldEInterpolated* result = new BDSFieldEInterpolated3D(ar, transform, eScalingUnits);
@@ -950,10 +1239,12 @@ BDSFieldEInterpolated* BDSFieldLoader::LoadBDSIM4DE(const G4String&      filePat
                                                     BDSInterpolatorType  interpolatorType,
                                                     const G4Transform3D& transform,
                                                     G4double             eScaling,
-                                                    const BDSArrayReflectionTypeSet* reflection)
+                                                    const BDSArrayReflectionTypeSet* reflection,
+                                                    BDSFieldMapPrecision precision,
+                                                    BDSFieldMapLayout    layout)
 {
   G4double   eScalingUnits = eScaling * CLHEP::volt/CLHEP::m;
-  BDSArray4DCoords*  array = LoadBDSIM4D(filePath);
+  BDSArray4DCoords*  array = LoadBDSIM4D(filePath, precision, layout);
   BDSArray4DCoords* arrayR = CreateArrayReflected(array, reflection);
   BDSInterpolator4D*    ar = CreateInterpolator4D(arrayR, interpolatorType);
   BDSFieldEInterpolated* result = new BDSFieldEInterpolated4D(ar, transform, eScalingUnits);
@@ -968,12 +1259,14 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadBDSIM1DEM(const G4String&      eFile
                                                       G4double             eScaling,
                                                       G4double             bScaling,
                                                       const BDSArrayReflectionTypeSet* eReflection,
-                                                      const BDSArrayReflectionTypeSet* bReflection)
+                                                      const BDSArrayReflectionTypeSet* bReflection,
+                                                      BDSFieldMapPrecision precision,
+                                                      BDSFieldMapLayout    layout)
 {
   G4double    eScalingUnits = eScaling * CLHEP::volt / CLHEP::m;
   G4double    bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray1DCoords* eArray  = LoadBDSIM1D(eFilePath);
-  BDSArray1DCoords* bArray  = LoadBDSIM1D(bFilePath);
+  BDSArray1DCoords* eArray  = LoadBDSIM1D(eFilePath, precision, layout);
+  BDSArray1DCoords* bArray  = LoadBDSIM1D(bFilePath, precision, layout);
   BDSArray1DCoords* eArrayR = CreateArrayReflected(eArray, eReflection);
   BDSArray1DCoords* bArrayR = CreateArrayReflected(bArray, bReflection);
   BDSInterpolator1D*   eInt = CreateInterpolator1D(eArrayR, eInterpolatorType);
@@ -991,12 +1284,14 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadBDSIM2DEM(const G4String&      eFile
                                                       G4double             eScaling,
                                                       G4double             bScaling,
                                                       const BDSArrayReflectionTypeSet* eReflection,
-                                                      const BDSArrayReflectionTypeSet* bReflection)
+                                                      const BDSArrayReflectionTypeSet* bReflection,
+                                                      BDSFieldMapPrecision precision,
+                                                      BDSFieldMapLayout    layout)
 {
   G4double    eScalingUnits = eScaling * CLHEP::volt / CLHEP::m;
   G4double    bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray2DCoords*  eArray = LoadBDSIM2D(eFilePath);
-  BDSArray2DCoords*  bArray = LoadBDSIM2D(bFilePath);
+  BDSArray2DCoords*  eArray = LoadBDSIM2D(eFilePath, precision, layout);
+  BDSArray2DCoords*  bArray = LoadBDSIM2D(bFilePath, precision, layout);
   BDSArray2DCoords* eArrayR = CreateArrayReflected(eArray, eReflection);
   BDSArray2DCoords* bArrayR = CreateArrayReflected(bArray, bReflection);
   BDSInterpolator2D*   eInt = CreateInterpolator2D(eArrayR, eInterpolatorType);
@@ -1014,12 +1309,14 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadBDSIM3DEM(const G4String&      eFile
                                                       G4double             eScaling,
                                                       G4double             bScaling,
                                                       const BDSArrayReflectionTypeSet* eReflection,
-                                                      const BDSArrayReflectionTypeSet* bReflection)
+                                                      const BDSArrayReflectionTypeSet* bReflection,
+                                                      BDSFieldMapPrecision precision,
+                                                      BDSFieldMapLayout    layout)
 {
   G4double    eScalingUnits = eScaling * CLHEP::volt / CLHEP::m;
   G4double    bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray3DCoords*  eArray = LoadBDSIM3D(eFilePath);
-  BDSArray3DCoords*  bArray = LoadBDSIM3D(bFilePath);
+  BDSArray3DCoords*  eArray = LoadBDSIM3D(eFilePath, precision, layout);
+  BDSArray3DCoords*  bArray = LoadBDSIM3D(bFilePath, precision, layout);
   BDSArray3DCoords* eArrayR = CreateArrayReflected(eArray, eReflection);
   BDSArray3DCoords* bArrayR = CreateArrayReflected(bArray, bReflection);
   BDSInterpolator3D*   eInt = CreateInterpolator3D(eArrayR, eInterpolatorType);
@@ -1037,12 +1334,14 @@ BDSFieldEMInterpolated* BDSFieldLoader::LoadBDSIM4DEM(const G4String&      eFile
                                                       G4double             eScaling,
                                                       G4double             bScaling,
                                                       const BDSArrayReflectionTypeSet* eReflection,
-                                                      const BDSArrayReflectionTypeSet* bReflection)
+                                                      const BDSArrayReflectionTypeSet* bReflection,
+                                                      BDSFieldMapPrecision precision,
+                                                      BDSFieldMapLayout    layout)
 {
   G4double    eScalingUnits = eScaling * CLHEP::volt / CLHEP::m;
   G4double    bScalingUnits = bScaling * CLHEP::tesla;
-  BDSArray4DCoords*  eArray = LoadBDSIM4D(eFilePath);
-  BDSArray4DCoords*  bArray = LoadBDSIM4D(bFilePath);
+  BDSArray4DCoords*  eArray = LoadBDSIM4D(eFilePath, precision, layout);
+  BDSArray4DCoords*  bArray = LoadBDSIM4D(bFilePath, precision, layout);
   BDSArray4DCoords* eArrayR = CreateArrayReflected(eArray, eReflection);
   BDSArray4DCoords* bArrayR = CreateArrayReflected(bArray, bReflection);
   BDSInterpolator4D*   eInt = CreateInterpolator4D(eArrayR, eInterpolatorType);
@@ -125,9 +125,18 @@ BDSArray4DCoords* BDSFieldLoaderBDSIM<T>::Load4D(const G4String& fileName)
   return result;
 }
 
+template <class T>
+BDSArray4DCoords* BDSFieldLoaderBDSIM<T>::LoadHeader(const G4String& fileName,
+                                                     const unsigned int nDim)
+{
+  Load(fileName, nDim, true);
+  return result;
+}
+
 template <class T>
 void BDSFieldLoaderBDSIM<T>::Load(const G4String& fileName,
-                                  const unsigned int nDim)
+                                  const unsigned int nDim,
+                                  G4bool headerOnly)
 {
   G4String functionName = "BDSIM Field Format> ";
   CleanUp();
@@ -143,7 +152,7 @@ void BDSFieldLoaderBDSIM<T>::Load(const G4String& fileName,
   if (!validFile)
     {throw BDSException(__METHOD_NAME__, "Invalid file name or no such file named \"" + fileName + "\"");}
   else
-    {G4cout << functionName << "Loading \"" << fileName << "\"" << G4endl;}
+    {G4cout << functionName << (headerOnly ? "Reading header of \"" : "Loading \"") << fileName << "\"" << G4endl;}
 
   // temporary variables
   unsigned long xIndex = 0;
@@ -290,7 +299,8 @@ void BDSFieldLoaderBDSIM<T>::Load(const G4String& fileName,
                 result = new BDSArray1DCoords(n1,
                                               header[keys.min] * unit,
                                               header[keys.max] * unit,
-                                              firstDim);
+                                              firstDim,
+                                              !headerOnly);
                 break;
               }
             case 2:
@@ -309,7 +319,8 @@ void BDSFieldLoaderBDSIM<T>::Load(const G4String& fileName,
                                               header[sKeys.min] * sUnit,
                                               header[sKeys.max] * sUnit,
                                               firstDim,
-                                              secondDim);
+                                              secondDim,
+                                              !headerOnly);
                 break;
               }
             case 3:
@@ -335,7 +346,8 @@ void BDSFieldLoaderBDSIM<T>::Load(const G4String& fileName,
                                               header[tKeys.max] * tUnit,
                                               firstDim,
                                               secondDim,
-                                              thirdDim);
+                                              thirdDim,
+                                              !headerOnly);
                 break;
               }
             case 4:
@@ -348,7 +360,10 @@ void BDSFieldLoaderBDSIM<T>::Load(const G4String& fileName,
                                               header["xmin"] * CLHEP::cm, header["xmax"] * CLHEP::cm,
                                               header["ymin"] * CLHEP::cm, header["ymax"] * CLHEP::cm,
                                               header["zmin"] * CLHEP::cm, header["zmax"] * CLHEP::cm,
-                                              header["tmin"] * CLHEP::s,  header["tmax"] * CLHEP::s);
+                                              header["tmin"] * CLHEP::s,  header["tmax"] * CLHEP::s,
+                                              BDSDimensionType::x, BDSDimensionType::y,
+                                              BDSDimensionType::z, BDSDimensionType::t,
+                                              !headerOnly);
                 break;
               }
             default:
@@ -358,6 +373,12 @@ void BDSFieldLoaderBDSIM<T>::Load(const G4String& fileName,
           continue;
         }
     }
+
+  if (headerOnly)
+    {
+      file.close();
+      return;
+    }
   
   // now only read data - two loops, one for each way of looping
   if (loopOrder == "tzyx")
@@ -0,0 +1,261 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray1DCoords.hh"
+#include "BDSArray2DCoords.hh"
+#include "BDSArray3DCoords.hh"
+#include "BDSArray4DCoords.hh"
+#include "BDSDebug.hh"
+#include "BDSDimensionType.hh"
+#include "BDSException.hh"
+#include "BDSFieldLoaderBDSIMBinary.hh"
+#include "BDSFieldValue.hh"
+
+#include "globals.hh"
+#include "G4String.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+const char          BDSFieldLoaderBDSIMBinary::identifier[8] = {'B','D','S','I','M','F','M','B'};
+const std::uint32_t BDSFieldLoaderBDSIMBinary::version       = 1;
+
+BDSFieldLoaderBDSIMBinary::BDSFieldLoaderBDSIMBinary():
+  result(nullptr)
+{;}
+
+BDSFieldLoaderBDSIMBinary::~BDSFieldLoaderBDSIMBinary()
+{;}
+
+G4bool BDSFieldLoaderBDSIMBinary::IsBinary(const G4String& fileName)
+{
+  std::ifstream in(fileName, std::ios::binary);
+  if (!in.is_open())
+    {return false;}
+  char start[8];
+  in.read(start, sizeof(start));
+  return in.gcount() == (std::streamsize)sizeof(start) && std::memcmp(start, identifier, sizeof(start)) == 0;
+}
+
+void BDSFieldLoaderBDSIMBinary::WriteHeader(std::ostream& out,
+                                            const std::vector<Dimension>& dimensions)
+{
+  out.write(identifier, sizeof(identifier));
+  out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+  std::uint32_t nDim = (std::uint32_t)dimensions.size();
+  out.write(reinterpret_cast<const char*>(&nDim), sizeof(nDim));
+  for (const auto& dim : dimensions)
+    {
+      char name[4] = {dim.name, 0, 0, 0};
+      std::int32_t n = dim.n;
+      out.write(name, sizeof(name));
+      out.write(reinterpret_cast<const char*>(&n),       sizeof(n));
+      out.write(reinterpret_cast<const char*>(&dim.min), sizeof(dim.min));
+      out.write(reinterpret_cast<const char*>(&dim.max), sizeof(dim.max));
+    }
+}
+
+void BDSFieldLoaderBDSIMBinary::Terminate(const G4String& message)
+{
+  file.close();
+  throw BDSException("BDSFieldLoaderBDSIMBinary", message);
+}
+
+BDSArray1DCoords* BDSFieldLoaderBDSIMBinary::Load1D(const G4String& fileName)
+{
+  Load(fileName,1);
+  return static_cast<BDSArray1DCoords*>(result);
+}
+
+BDSArray2DCoords* BDSFieldLoaderBDSIMBinary::Load2D(const G4String& fileName)
+{
+  Load(fileName,2);
+  return static_cast<BDSArray2DCoords*>(result);
+}
+
+BDSArray3DCoords* BDSFieldLoaderBDSIMBinary::Load3D(const G4String& fileName)
+{
+  Load(fileName,3);
+  return static_cast<BDSArray3DCoords*>(result);
+}
+
+BDSArray4DCoords* BDSFieldLoaderBDSIMBinary::Load4D(const G4String& fileName)
+{
+  Load(fileName,4);
+  return result;
+}
+
+BDSArray4DCoords* BDSFieldLoaderBDSIMBinary::LoadHeader(const G4String& fileName,
+                                                        const unsigned int nDim)
+{
+  Load(fileName, nDim, true);
+  return result;
+}
+
+void BDSFieldLoaderBDSIMBinary::Load(const G4String& fileName,
+                                     const unsigned int nDim,
+                                     G4bool headerOnly)
+{
+  G4String functionName = "BDSIM Binary Field Format> ";
+  result = nullptr;
+  
+  file.open(fileName, std::ios::binary);
+  if (!file.is_open())
+    {throw BDSException(__METHOD_NAME__, "Invalid file name or no such file named \"" + fileName + "\"");}
+  else
+    {G4cout << functionName << (headerOnly ? "Reading header of \"" : "Loading \"") << fileName << "\"" << G4endl;}
+
+  char start[8];
+  std::uint32_t fileVersion = 0;
+  std::uint32_t fileNDim    = 0;
+  file.read(start, sizeof(start));
+  file.read(reinterpret_cast<char*>(&fileVersion), sizeof(fileVersion));
+  file.read(reinterpret_cast<char*>(&fileNDim),    sizeof(fileNDim));
+  if (!file || std::memcmp(start, identifier, sizeof(start)) != 0)
+    {Terminate(functionName + "\"" + fileName + "\" is not a BDSIM binary field map");}
+  if (fileVersion != version)
+    {Terminate(functionName + "unsupported version " + std::to_string(fileVersion) + " - expected " + std::to_string(version));}
+  if (fileNDim != nDim)
+    {Terminate(functionName + "file has " + std::to_string(fileNDim) + " dimensions but a " + std::to_string(nDim) + "D field is being loaded");}
+
+  std::vector<Dimension> dims(nDim);
+  std::vector<BDSDimensionType> dimTypes;
+  std::vector<G4double> units;
+  for (auto& dim : dims)
+    {
+      char name[4];
+      std::int32_t n = 0;
+      file.read(name, sizeof(name));
+      file.read(reinterpret_cast<char*>(&n),       sizeof(n));
+      file.read(reinterpret_cast<char*>(&dim.min), sizeof(dim.min));
+      file.read(reinterpret_cast<char*>(&dim.max), sizeof(dim.max));
+      if (!file)
+        {Terminate(functionName + "unexpected end of file in header");}
+      if (n < 1)
+        {Terminate(functionName + "Number of points in dimension must be greater than 0 -> see \"n" + G4String(std::string(1, name[0])) + "\"");}
+      dim.name = name[0];
+      dim.n    = (G4int)n;
+      dimTypes.push_back(BDS::DetermineDimensionType(G4String(std::string(1, dim.name))));
+      units.push_back(dim.name == 't' ? CLHEP::s : CLHEP::cm);
+    }
+
+  // always in xyzt order from the first dimension
+  G4int n1 = 1, n2 = 1, n3 = 1, n4 = 1;
+  switch (nDim)
+    {
+    case 1:
+      {
+        n1 = dims[0].n;
+        result = new BDSArray1DCoords(n1, dims[0].min * units[0], dims[0].max * units[0], dimTypes[0], !headerOnly);
+        break;
+      }
+    case 2:
+      {
+        n1 = dims[0].n;
+        n2 = dims[1].n;
+        result = new BDSArray2DCoords(n1, n2,
+                                      dims[0].min * units[0], dims[0].max * units[0],
+                                      dims[1].min * units[1], dims[1].max * units[1],
+                                      dimTypes[0],
+                                      dimTypes[1],
+                                      !headerOnly);
+        break;
+      }
+    case 3:
+      {
+        n1 = dims[0].n;
+        n2 = dims[1].n;
+        n3 = dims[2].n;
+        result = new BDSArray3DCoords(n1, n2, n3,
+                                      dims[0].min * units[0], dims[0].max * units[0],
+                                      dims[1].min * units[1], dims[1].max * units[1],
+                                      dims[2].min * units[2], dims[2].max * units[2],
+                                      dimTypes[0],
+                                      dimTypes[1],
+                                      dimTypes[2],
+                                      !headerOnly);
+        break;
+      }
+    case 4:
+      {
+        if (dims[0].name != 'x' || dims[1].name != 'y' || dims[2].name != 'z' || dims[3].name != 't')
+          {Terminate(functionName + "4D field maps must have the dimensions x, y, z, t in order");}
+        n1 = dims[0].n;
+        n2 = dims[1].n;
+        n3 = dims[2].n;
+        n4 = dims[3].n;
+        result = new BDSArray4DCoords(n1, n2, n3, n4,
+                                      dims[0].min * CLHEP::cm, dims[0].max * CLHEP::cm,
+                                      dims[1].min * CLHEP::cm, dims[1].max * CLHEP::cm,
+                                      dims[2].min * CLHEP::cm, dims[2].max * CLHEP::cm,
+                                      dims[3].min * CLHEP::s,  dims[3].max * CLHEP::s,
+                                      BDSDimensionType::x, BDSDimensionType::y,
+                                      BDSDimensionType::z, BDSDimensionType::t,
+                                      !headerOnly);
+        break;
+      }
+    default:
+      {Terminate(functionName + "invalid number of dimensions"); break;}
+    }
+
+  if (headerOnly)
+    {
+      file.close();
+      return;
+    }
+
+  // read one row of the first dimension at a time
+  float maximumFieldValue = 0;
+  float minimumFieldValue = 0;
+  std::vector<G4double> row(3 * (std::size_t)n1);
+  for (G4int l = 0; l < n4; l++)
+    {
+      for (G4int k = 0; k < n3; k++)
+        {
+          for (G4int j = 0; j < n2; j++)
+            {
+              file.read(reinterpret_cast<char*>(row.data()), (std::streamsize)(row.size() * sizeof(G4double)));
+              if (!file)
+                {
+                  delete result;
+                  result = nullptr;
+                  Terminate(functionName + "unexpected end of file in field values");
+                }
+              for (G4int i = 0; i < n1; i++)
+                {
+                  BDSFieldValue fv((FIELDTYPET)row[3*i], (FIELDTYPET)row[3*i+1], (FIELDTYPET)row[3*i+2]);
+                  (*result)(i, j, k, l) = fv;
+                  float mag = fv.mag();
+                  maximumFieldValue = std::max(maximumFieldValue, mag);
+                  minimumFieldValue = std::min(minimumFieldValue, mag);
+                }
+            }
+        }
+    }
+  
+  file.close();
+  G4cout << functionName << "Loaded " << (long long)n1*n2*n3*n4 << " points from file" << G4endl;
+  G4cout << functionName << "(Min | Max) field magnitudes in loaded file (before scaling): (" << minimumFieldValue << " | " << maximumFieldValue << ")" << G4endl;
+}
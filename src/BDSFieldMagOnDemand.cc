@@ -0,0 +1,61 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray4DCoords.hh"
+#include "BDSFieldMagInterpolated.hh"
+#include "BDSFieldMagOnDemand.hh"
+#include "BDSFieldInfo.hh"
+#include "BDSFieldLoader.hh"
+
+#include "G4ThreeVector.hh"
+
+#include <limits>
+#include <mutex>
+
+BDSFieldMagOnDemand::BDSFieldMagOnDemand(const BDSFieldInfo& infoIn):
+  info(new BDSFieldInfo(infoIn)),
+  field(nullptr),
+  smallestSpatialStep(std::numeric_limits<double>::max()),
+  timeVarying(false)
+{
+  BDSFieldLoader* loader = BDSFieldLoader::Instance();
+  BDSArray4DCoords* header = loader->LoadMagneticHeader(*info);
+  smallestSpatialStep = header->SmallestSpatialStep();
+  timeVarying = header->TimeVarying();
+  delete header;
+  loader->RegisterDeferredField(*info);
+}
+
+BDSFieldMagOnDemand::~BDSFieldMagOnDemand()
+{
+  delete field;
+  delete info;
+}
+
+G4ThreeVector BDSFieldMagOnDemand::GetField(const G4ThreeVector& position,
+                                            const G4double       t) const
+{
+  // cheap after the first call - no lock is taken once the flag is set
+  std::call_once(loadFlag, &BDSFieldMagOnDemand::Load, this);
+  return field->GetField(position, t);
+}
+
+void BDSFieldMagOnDemand::Load() const
+{
+  field = BDSFieldLoader::Instance()->LoadMagFieldOnDemand(*info);
+}
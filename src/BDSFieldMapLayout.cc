@@ -0,0 +1,59 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSFieldMapLayout.hh"
+#include "BDSUtilities.hh"
+
+#include "G4String.hh"
+
+#include <map>
+#include <string>
+
+// dictionary for BDSFieldMapLayout for reflexivity
+template<>
+std::map<BDSFieldMapLayout, std::string>* BDSFieldMapLayout::dictionary =
+  new std::map<BDSFieldMapLayout, std::string> ({
+                                                 {BDSFieldMapLayout::linear, "linear"},
+                                                 {BDSFieldMapLayout::tiled,  "tiled"}
+    });
+
+BDSFieldMapLayout BDS::DetermineFieldMapLayout(G4String layout)
+{
+  std::map<G4String, BDSFieldMapLayout> types;
+  types["linear"] = BDSFieldMapLayout::linear;
+  types["tiled"]  = BDSFieldMapLayout::tiled;
+  
+  layout = BDS::LowerCase(layout);
+
+  auto result = types.find(layout);
+  if (result == types.end())
+    {// it's not a valid key
+      G4String msg = "\"" + layout + "\" is not a valid field map layout\n";
+      msg += "Available field map layouts are:\n";
+      for (const auto& it : types)
+        {msg += "\"" + it.first + "\"\n";}
+      throw BDSException(__METHOD_NAME__, msg);
+    }
+
+#ifdef BDSDEBUG
+  G4cout << __METHOD_NAME__ << "determined field map layout to be " << result->second << G4endl;
+#endif
+  return result->second;
+}
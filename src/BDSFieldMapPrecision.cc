@@ -0,0 +1,78 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSFieldMapPrecision.hh"
+#include "BDSFieldValue.hh"
+#include "BDSUtilities.hh"
+
+#include "G4String.hh"
+
+#include <map>
+#include <string>
+
+// dictionary for BDSFieldMapPrecision for reflexivity
+template<>
+std::map<BDSFieldMapPrecision, std::string>* BDSFieldMapPrecision::dictionary =
+  new std::map<BDSFieldMapPrecision, std::string> ({
+                                                    {BDSFieldMapPrecision::standard, "standard"},
+                                                    {BDSFieldMapPrecision::int16,    "int16"}
+    });
+
+BDSFieldMapPrecision BDS::DetermineFieldMapPrecision(G4String precision)
+{
+  std::map<G4String, BDSFieldMapPrecision> types;
+  types["standard"] = BDSFieldMapPrecision::standard;
+  types["int16"]    = BDSFieldMapPrecision::int16;
+#ifdef FIELDDOUBLE
+  types["double"]   = BDSFieldMapPrecision::standard;
+  const G4String otherType = "float";
+#else
+  types["float"]    = BDSFieldMapPrecision::standard;
+  const G4String otherType = "double";
+#endif
+  
+  precision = BDS::LowerCase(precision);
+
+  if (precision == otherType)
+    {
+      G4String msg = "field map precision \"" + precision + "\" requires BDSIM to be compiled with ";
+#ifdef FIELDDOUBLE
+      msg += "USE_FIELD_DOUBLE_PRECISION off";
+#else
+      msg += "USE_FIELD_DOUBLE_PRECISION on";
+#endif
+      throw BDSException(__METHOD_NAME__, msg);
+    }
+
+  auto result = types.find(precision);
+  if (result == types.end())
+    {// it's not a valid key
+      G4String msg = "\"" + precision + "\" is not a valid field map precision\n";
+      msg += "Available field map precisions are:\n";
+      for (const auto& it : types)
+        {msg += "\"" + it.first + "\"\n";}
+      throw BDSException(__METHOD_NAME__, msg);
+    }
+
+#ifdef BDSDEBUG
+  G4cout << __METHOD_NAME__ << "determined field map precision to be " << result->second << G4endl;
+#endif
+  return result->second;
+}
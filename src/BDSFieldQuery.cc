@@ -19,6 +19,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSAuxiliaryNavigator.hh"
 #include "BDSDebug.hh"
 #include "BDSException.hh"
+#include "BDSFieldLoaderBDSIMBinary.hh"
 #include "BDSFieldQuery.hh"
 #include "BDSFieldQueryInfo.hh"
 #include "BDSUtilities.hh"
@@ -36,16 +37,24 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
 #include <iomanip>
+#include <ios>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 G4Navigator* BDSFieldQuery::navigator = new G4Navigator();
+const long long BDSFieldQuery::blockSize = 1 << 16;
 
 BDSFieldQuery::BDSFieldQuery():
   queryMagnetic(false),
   queryElectric(false),
+  writeBinary(false),
   writeX(false),
   writeY(false),
   writeZ(false),
@@ -67,6 +76,7 @@ void BDSFieldQuery::CleanUp()
   CloseFiles();
   queryMagnetic = false;
   queryElectric = false;
+  writeBinary = false;
   writeX = false;
   writeY = false;
   writeZ = false;
@@ -137,7 +147,6 @@ void BDSFieldQuery::QueryField(const BDSFieldQueryInfo* query)
     {tStep = 1.0;}
   CheckNStepsAndRange(query->tInfo, "t", query->name);
   
-  G4ThreeVector xyzGlobal = G4ThreeVector();
   const G4AffineTransform& localToGlobalTransform = query->globalTransform;
   G4AffineTransform globalToLocalTransform = localToGlobalTransform.Inverse();
   
@@ -145,37 +154,152 @@ void BDSFieldQuery::QueryField(const BDSFieldQueryInfo* query)
   localToGlobalTransform.ApplyAxisTransform(generalUnitZ);
   
   OpenFiles(query);
+
+  // points are numbered with x varying fastest, then y, z and t as in the output
+  const long long nX = query->xInfo.n;
+  const long long nXY = nX * query->yInfo.n;
+  const long long nXYZ = nXY * query->zInfo.n;
+  const long long nPoints = nXYZ * query->tInfo.n;
+  auto LocalPoint = [&](long long index, G4double& xLocal, G4double& yLocal, G4double& zLocal, G4double& tLocal)
+  {
+    xLocal = xMin + (G4double)(index % nX) * xStep;
+    yLocal = yMin + (G4double)((index / nX) % query->yInfo.n) * yStep;
+    zLocal = zMin + (G4double)((index / nXY) % query->zInfo.n) * zStep;
+    tLocal = tMin + (G4double)(index / nXYZ) * tStep;
+  };
+
+  const G4int nThreads = std::max(1, NThreads(query));
+  if (nThreads > 1)
+    {G4cout << "FieldQuery> using " << nThreads << " threads" << G4endl;}
   
-  G4double globalFieldValue[6];
-  G4double localFieldValue[6];
+  std::vector<G4double> blockValues(6 * (std::size_t)std::min(blockSize, nPoints));
+  std::vector<std::exception_ptr> threadExceptions(nThreads);
+  auto Evaluate = [&](G4int threadIndex, long long blockStart, long long first, long long last)
+  {
+    try
+      {
+        G4double xLocal, yLocal, zLocal, tLocal;
+        G4double globalFieldValue[6];
+        for (long long index = first; index < last; index++)
+          {
+            LocalPoint(index, xLocal, yLocal, zLocal, tLocal);
+            G4ThreeVector xyzGlobal = LocalToGlobalPoint(localToGlobalTransform, xLocal, yLocal, zLocal);
+            GetFieldValueForThread(threadIndex, xyzGlobal, generalUnitZ, tLocal, globalFieldValue);
+            GlobalToLocalAxisField(globalToLocalTransform,
+                                   globalFieldValue,
+                                   &blockValues[6 * (std::size_t)(index - blockStart)]);
+          }
+      }
+    catch (...)
+      {threadExceptions[threadIndex] = std::current_exception();}
+  };
+  // contiguous share of a block for each thread
+  auto EvaluateShare = [&](G4int threadIndex, long long blockStart, long long blockEnd)
+  {
+    const long long share = (blockEnd - blockStart + nThreads - 1) / nThreads;
+    long long first = std::min(blockEnd, blockStart + threadIndex * share);
+    long long last  = std::min(blockEnd, first + share);
+    Evaluate(threadIndex, blockStart, first, last);
+  };
+
+  // The worker threads are started once for the query. For each block, this thread
+  // evaluates the first share, waits for the workers to finish theirs and then writes
+  // the block out while the workers wait for the next one.
+  std::mutex blockMutex;
+  std::condition_variable blockReady;
+  std::condition_variable blockDone;
+  long long currentBlockStart = 0;
+  long long currentBlockEnd   = 0;
+  G4int blockNumber           = 0;
+  G4int sharesRemaining       = 0;
+  G4bool finished             = false;
+  auto Worker = [&](G4int threadIndex)
+  {
+    G4int lastBlockNumber = 0;
+    while (true)
+      {
+        long long workerBlockStart;
+        long long workerBlockEnd;
+        {
+          std::unique_lock<std::mutex> lock(blockMutex);
+          blockReady.wait(lock, [&]{return finished || blockNumber != lastBlockNumber;});
+          if (finished)
+            {return;}
+          lastBlockNumber  = blockNumber;
+          workerBlockStart = currentBlockStart;
+          workerBlockEnd   = currentBlockEnd;
+        }
+        EvaluateShare(threadIndex, workerBlockStart, workerBlockEnd);
+        {
+          std::lock_guard<std::mutex> lock(blockMutex);
+          sharesRemaining--;
+        }
+        blockDone.notify_one();
+      }
+  };
+  std::vector<std::thread> workers;
+  for (G4int threadIndex = 1; threadIndex < nThreads; threadIndex++)
+    {workers.emplace_back(Worker, threadIndex);}
+  auto StopWorkers = [&]()
+  {
+    {
+      std::lock_guard<std::mutex> lock(blockMutex);
+      finished = true;
+    }
+    blockReady.notify_all();
+    for (auto& worker : workers)
+      {worker.join();}
+    workers.clear();
+  };
   
-  G4double tLocal = tMin;
-  for (G4int i = 0; i < query->tInfo.n; i++)
+  G4int percentReported = 0;
+  for (long long blockStart = 0; blockStart < nPoints; blockStart += blockSize)
     {
-      G4double zLocal = zMin;
-      for (G4int j = 0; j < query->zInfo.n; j++)
+      const long long blockEnd = std::min(blockStart + blockSize, nPoints);
+      if (workers.empty())
+        {Evaluate(0, blockStart, blockStart, blockEnd);}
+      else
+        {
+          {
+            std::lock_guard<std::mutex> lock(blockMutex);
+            currentBlockStart = blockStart;
+            currentBlockEnd   = blockEnd;
+            sharesRemaining   = (G4int)workers.size();
+            blockNumber++;
+          }
+          blockReady.notify_all();
+          EvaluateShare(0, blockStart, blockEnd);
+          std::unique_lock<std::mutex> lock(blockMutex);
+          blockDone.wait(lock, [&]{return sharesRemaining == 0;});
+        }
+      for (const auto& exception : threadExceptions)
         {
-          G4double yLocal = yMin;
-          for (G4int k = 0; k < query->yInfo.n; k++)
+          if (exception)
             {
-              G4double xLocal = xMin;
-              for (G4int l = 0; l < query->xInfo.n; l++)
-                {
-                  xyzGlobal = LocalToGlobalPoint(localToGlobalTransform, xLocal, yLocal, zLocal);
-                  GetFieldValue(xyzGlobal, generalUnitZ, tLocal, globalFieldValue);
-                  GlobalToLocalAxisField(globalToLocalTransform,
-                                         globalFieldValue,
-                                         localFieldValue);
-                  WriteFieldValue({xLocal, yLocal, zLocal}, tLocal, localFieldValue);
-                  
-                  xLocal += xStep;
-                }
-              yLocal += yStep;
+              StopWorkers();
+              CloseFiles();
+              std::rethrow_exception(exception);
+            }
+        }
+      
+      G4double xLocal, yLocal, zLocal, tLocal;
+      for (long long index = blockStart; index < blockEnd; index++)
+        {
+          LocalPoint(index, xLocal, yLocal, zLocal, tLocal);
+          WriteFieldValue({xLocal, yLocal, zLocal}, tLocal, &blockValues[6 * (std::size_t)(index - blockStart)]);
+        }
+
+      if (nPoints > blockSize)
+        {
+          G4int percent = (G4int)(100 * blockEnd / nPoints);
+          if (percent / 10 > percentReported / 10)
+            {
+              G4cout << "FieldQuery> " << std::setw(3) << percent << "% (" << blockEnd << " / " << nPoints << " points)" << G4endl;
+              percentReported = percent;
             }
-          zLocal += zStep;
         }
-      tLocal += tStep;
     }
+  StopWorkers();
   
   CloseFiles();
   G4cout << "FieldQuery> Complete" << G4endl;
@@ -210,6 +334,12 @@ void BDSFieldQuery::CheckIfFieldObjectSpecified(const BDSFieldQueryInfo* query)
 
 void BDSFieldQuery::QuerySpecificPoints(const BDSFieldQueryInfo* query)
 {
+  if (query->binaryOutput)
+    {
+      G4String msg = "\"binaryOutput\" cannot be used with a points file in query \"" + query->name;
+      msg += "\" as the binary format is only for a regular grid";
+      throw BDSException(__METHOD_NAME__, msg);
+    }
   const std::vector<BDSFourVector<G4double>> points = query->pointsToQuery;
   
   G4cout << "FieldQuery> \"" << query->name << "\" with N points: "
@@ -262,6 +392,7 @@ void BDSFieldQuery::OpenFiles(const BDSFieldQueryInfo* query)
       writeZ = query->zInfo.n > 1;
       writeT = query->tInfo.n > 1;
     }
+  writeBinary = query->binaryOutput;
   
   if (query->queryMagnetic)
     {
@@ -272,7 +403,7 @@ void BDSFieldQuery::OpenFiles(const BDSFieldQueryInfo* query)
 	  throw BDSException(__METHOD_NAME__, msg);
 	}
       queryMagnetic = true;
-      oFileMagnetic.open(query->outfileMagnetic);
+      oFileMagnetic.open(query->outfileMagnetic, writeBinary ? std::ios::out | std::ios::binary : std::ios::out);
       WriteHeader(oFileMagnetic, query);
     }
   
@@ -285,7 +416,7 @@ void BDSFieldQuery::OpenFiles(const BDSFieldQueryInfo* query)
 	  throw BDSException(__METHOD_NAME__, msg);
 	}
       queryElectric = true;
-      oFileElectric.open(query->outfileElectric);
+      oFileElectric.open(query->outfileElectric, writeBinary ? std::ios::out | std::ios::binary : std::ios::out);
       WriteHeader(oFileElectric, query);
     }
 }
@@ -293,6 +424,21 @@ void BDSFieldQuery::OpenFiles(const BDSFieldQueryInfo* query)
 void BDSFieldQuery::WriteHeader(std::ofstream& out,
                                 const BDSFieldQueryInfo* query) const
 {
+  if (writeBinary)
+    {
+      std::vector<BDSFieldLoaderBDSIMBinary::Dimension> dimensions;
+      if (writeX)
+        {dimensions.push_back({'x', query->xInfo.n, query->xInfo.min/CLHEP::cm, query->xInfo.max/CLHEP::cm});}
+      if (writeY)
+        {dimensions.push_back({'y', query->yInfo.n, query->yInfo.min/CLHEP::cm, query->yInfo.max/CLHEP::cm});}
+      if (writeZ)
+        {dimensions.push_back({'z', query->zInfo.n, query->zInfo.min/CLHEP::cm, query->zInfo.max/CLHEP::cm});}
+      if (writeT)
+        {dimensions.push_back({'t', query->tInfo.n, query->tInfo.min/CLHEP::s,  query->tInfo.max/CLHEP::s});}
+      BDSFieldLoaderBDSIMBinary::WriteHeader(out, dimensions);
+      return;
+    }
+  
   G4String columns = "!    ";
   if (writeX)
     {
@@ -381,10 +527,42 @@ void BDSFieldQuery::GetFieldValue(const G4ThreeVector& globalXYZ,
     }
 }
 
+void BDSFieldQuery::GetFieldValueForThread(G4int /*threadIndex*/,
+                                           const G4ThreeVector& globalXYZ,
+                                           const G4ThreeVector& globalDirection,
+                                           G4double tGlobal,
+                                           G4double fieldValue[6])
+{
+  GetFieldValue(globalXYZ, globalDirection, tGlobal, fieldValue);
+}
+
+G4int BDSFieldQuery::NThreads(const BDSFieldQueryInfo* query) const
+{
+  if (query->nThreads > 1)
+    {BDS::Warning("\"nThreads\" in query \"" + query->name + "\" is only used by bdsinterpolator - using 1 thread");}
+  return 1;
+}
+
 void BDSFieldQuery::WriteFieldValue(const G4ThreeVector& xyzLocal,
                                     G4double tLocal,
                                     const G4double fieldValue[6])
 {
+  if (writeBinary)
+    {// coordinates are implicit in the binary format
+      if (queryMagnetic)
+        {
+          const G4double b[3] = {fieldValue[0] / CLHEP::tesla, fieldValue[1] / CLHEP::tesla, fieldValue[2] / CLHEP::tesla};
+          oFileMagnetic.write(reinterpret_cast<const char*>(b), sizeof(b));
+        }
+      if (queryElectric)
+        {
+          const G4double eUnit = CLHEP::volt/CLHEP::m;
+          const G4double e[3] = {fieldValue[3] / eUnit, fieldValue[4] / eUnit, fieldValue[5] / eUnit};
+          oFileElectric.write(reinterpret_cast<const char*>(e), sizeof(e));
+        }
+      return;
+    }
+  
   if (queryMagnetic)
     {
       if (writeX)
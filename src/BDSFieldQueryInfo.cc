@@ -35,7 +35,10 @@ BDSFieldQueryInfo::BDSFieldQueryInfo(const G4String& nameIn,
                                      G4bool drawArrowsIn,
                                      G4bool drawZeroValuePointsIn,
                                      G4bool drawBoxesIn,
-                                     G4double boxAlphaIn):
+                                     G4double boxAlphaIn,
+                                     G4bool binaryOutputIn,
+                                     G4int nThreadsIn,
+                                     const G4String& errorReportInterpolatorIn):
   name(nameIn),
   outfileMagnetic(outfileMagneticIn),
   outfileElectric(outfileElectricIn),
@@ -48,6 +51,9 @@ BDSFieldQueryInfo::BDSFieldQueryInfo(const G4String& nameIn,
   globalTransform(globalTransformIn),
   overwriteExistingFiles(overwriteExistingFilesIn),
   printTransform(printTransformIn),
+  binaryOutput(binaryOutputIn),
+  nThreads(nThreadsIn),
+  errorReportInterpolator(errorReportInterpolatorIn),
   fieldObject(fieldObjectIn),
   checkParameters(checkParametersIn),
   drawArrows(drawArrowsIn),
@@ -69,7 +75,9 @@ BDSFieldQueryInfo::BDSFieldQueryInfo(const G4String& nameIn,
                                      G4bool drawArrowsIn,
                                      G4bool drawZeroValuePointsIn,
                                      G4bool drawBoxesIn,
-                                     G4double boxAlphaIn):
+                                     G4double boxAlphaIn,
+                                     G4bool binaryOutputIn,
+                                     G4int nThreadsIn):
   name(nameIn),
   outfileMagnetic(outfileMagneticIn),
   outfileElectric(outfileElectricIn),
@@ -79,6 +87,9 @@ BDSFieldQueryInfo::BDSFieldQueryInfo(const G4String& nameIn,
   pointsColumnNames(pointsColumnNamesIn),
   overwriteExistingFiles(overwriteExistingFilesIn),
   printTransform(false),
+  binaryOutput(binaryOutputIn),
+  nThreads(nThreadsIn),
+  errorReportInterpolator(""),
   fieldObject(fieldObjectIn),
   checkParameters(checkParametersIn),
   drawArrows(drawArrowsIn),
@@ -16,17 +16,37 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSFieldEInterpolated.hh"
+#include "BDSFieldFormat.hh"
+#include "BDSFieldInfo.hh"
+#include "BDSFieldLoader.hh"
+#include "BDSFieldMagInterpolated.hh"
 #include "BDSFieldQueryInfo.hh"
 #include "BDSFieldQueryRaw.hh"
+#include "BDSFieldType.hh"
+#include "BDSIntegratorType.hh"
+#include "BDSInterpolatorType.hh"
 #include "BDSWarning.hh"
 
+#include "globals.hh"
+#include "G4AffineTransform.hh"
 #include "G4Field.hh"
 #include "G4String.hh"
 #include "G4ThreeVector.hh"
+#include "G4Transform3D.hh"
 #include "G4Types.hh"
 
-BDSFieldQueryRaw::BDSFieldQueryRaw():
-  field(nullptr)
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+BDSFieldQueryRaw::BDSFieldQueryRaw()
 {;}
 
 BDSFieldQueryRaw::~BDSFieldQueryRaw()
@@ -35,21 +55,180 @@ BDSFieldQueryRaw::~BDSFieldQueryRaw()
 void BDSFieldQueryRaw::QueryFieldRaw(G4Field* fieldIn,
 				     const BDSFieldQueryInfo* query)
 {
-  field = fieldIn;
+  QueryFieldRaw(std::vector<G4Field*>{fieldIn}, query);
+}
+
+void BDSFieldQueryRaw::QueryFieldRaw(const std::vector<G4Field*>& fieldPerThread,
+				     const BDSFieldQueryInfo* query)
+{
+  fields = fieldPerThread;
   QueryField(query);
+  if (query && !query->errorReportInterpolator.empty())
+    {ReportInterpolationError(query);}
+  fields.clear();
 }
 
 void BDSFieldQueryRaw::GetFieldValue(const G4ThreeVector& globalXYZ,
 				     const G4ThreeVector& /*globalDirection*/,
 				     G4double tGlobal,
 				     G4double fieldValue[6])
+{
+  Evaluate(fields.empty() ? nullptr : fields[0], globalXYZ, tGlobal, fieldValue);
+}
+
+void BDSFieldQueryRaw::GetFieldValueForThread(G4int threadIndex,
+					      const G4ThreeVector& globalXYZ,
+					      const G4ThreeVector& /*globalDirection*/,
+					      G4double tGlobal,
+					      G4double fieldValue[6])
+{
+  Evaluate(threadIndex < (G4int)fields.size() ? fields[threadIndex] : nullptr, globalXYZ, tGlobal, fieldValue);
+}
+
+G4int BDSFieldQueryRaw::NThreads(const BDSFieldQueryInfo* query) const
+{
+  return std::max(1, std::min(query->nThreads, (G4int)fields.size()));
+}
+
+void BDSFieldQueryRaw::ReportInterpolationError(const BDSFieldQueryInfo* query)
+{
+  if (query->SpecificPoints())
+    {
+      BDS::Warning("\"errorReportInterpolator\" is only used for a regular grid - ignored in query \"" + query->name + "\"");
+      return;
+    }
+  
+  // the loaders only accept the dimensions written (i.e. with more than one point)
+  const std::array<G4int, 4> ns = {query->xInfo.n, query->yInfo.n, query->zInfo.n, query->tInfo.n};
+  G4int nDim = (G4int)std::count_if(ns.begin(), ns.end(), [](G4int n){return n > 1;});
+  if (nDim == 0)
+    {
+      BDS::Warning("Only 1 point in query \"" + query->name + "\" - no interpolation error to report");
+      return;
+    }
+  
+  BDSInterpolatorType interpolatorType = BDS::DetermineInterpolatorType(query->errorReportInterpolator);
+  if (BDS::InterpolatorTypeIsAuto(interpolatorType))
+    {interpolatorType = BDS::InterpolatorTypeSpecificFromAuto(nDim, interpolatorType);}
+  if (BDS::NDimensionsOfInterpolatorType(interpolatorType) != nDim)
+    {
+      G4String msg = "\"errorReportInterpolator\" \"" + query->errorReportInterpolator + "\" in query \"" + query->name;
+      msg += "\" is not for a " + std::to_string(nDim) + "D field map - use an \"auto\" interpolator";
+      throw BDSException(__METHOD_NAME__, msg);
+    }
+  
+  const std::array<BDSFieldFormat, 4> formats = {BDSFieldFormat::bdsim1d, BDSFieldFormat::bdsim2d,
+                                                 BDSFieldFormat::bdsim3d, BDSFieldFormat::bdsim4d};
+  const BDSFieldFormat format = formats[nDim - 1];
+  G4cout << "FieldQuery> Interpolation error of \"" << query->name << "\" with " << interpolatorType
+         << " at the centre of each cell w.r.t. the queried field" << G4endl;
+  
+  if (query->queryMagnetic)
+    {
+      const std::array<BDSFieldType, 4> types = {BDSFieldType::bmap1d, BDSFieldType::bmap2d,
+                                                 BDSFieldType::bmap3d, BDSFieldType::bmap4d};
+      BDSFieldInfo info(types[nDim - 1], 0, BDSIntegratorType::none, nullptr, false, G4Transform3D(),
+                        query->outfileMagnetic, format, interpolatorType);
+      BDSFieldMagInterpolated* resampled = BDSFieldLoader::Instance()->LoadMagField(info);
+      CompareAtCellCentres(query, resampled, false, interpolatorType.ToString());
+      delete resampled;
+    }
+  if (query->queryElectric)
+    {
+      const std::array<BDSFieldType, 4> types = {BDSFieldType::emap1d, BDSFieldType::emap2d,
+                                                 BDSFieldType::emap3d, BDSFieldType::emap4d};
+      BDSFieldInfo info(types[nDim - 1], 0, BDSIntegratorType::none, nullptr, false, G4Transform3D(),
+                        "", BDSFieldFormat::bdsim1d, BDSInterpolatorType::nearest3d,
+                        query->outfileElectric, format, interpolatorType);
+      BDSFieldEInterpolated* resampled = BDSFieldLoader::Instance()->LoadEField(info);
+      CompareAtCellCentres(query, resampled, true, interpolatorType.ToString());
+      delete resampled;
+    }
+}
+
+void BDSFieldQueryRaw::CompareAtCellCentres(const BDSFieldQueryInfo* query,
+					    G4Field* resampledField,
+					    G4bool electric,
+					    const G4String& interpolatorName)
+{
+  if (!resampledField)
+    {return;}
+  
+  // cell centres are half a step from each point - a single point isn't a dimension of the map
+  const std::array<const BDSFieldQueryInfo::QueryDimensionInfo*, 4> dims = {&query->xInfo, &query->yInfo,
+                                                                             &query->zInfo, &query->tInfo};
+  std::array<long long, 4> nCells;
+  std::array<G4double, 4> first;
+  std::array<G4double, 4> step;
+  long long nTotal = 1;
+  for (G4int i = 0; i < 4; i++)
+    {
+      const auto& d = *dims[i];
+      nCells[i] = d.n > 1 ? d.n - 1 : 1;
+      step[i]   = d.n > 1 ? (d.max - d.min) / (G4double)(d.n - 1) : 0;
+      first[i]  = d.min + 0.5*step[i];
+      nTotal   *= nCells[i];
+    }
+  
+  const G4AffineTransform& localToGlobalTransform = query->globalTransform;
+  G4AffineTransform globalToLocalTransform = localToGlobalTransform.Inverse();
+  const G4int offset = electric ? 3 : 0;
+  const G4double unit = electric ? CLHEP::volt/CLHEP::m : CLHEP::tesla;
+  
+  G4double maxDiff = 0;
+  G4double sumDiff2 = 0;
+  G4double maxReference = 0;
+  G4double worstLocal[4] = {0,0,0,0};
+  G4double globalValue[6];
+  G4double referenceValue[6];
+  G4double resampledValue[6];
+  for (long long index = 0; index < nTotal; index++)
+    {
+      long long remainder = index;
+      G4double local[4];
+      for (G4int i = 0; i < 4; i++)
+	{
+	  local[i] = first[i] + (G4double)(remainder % nCells[i]) * step[i];
+	  remainder /= nCells[i];
+	}
+      G4ThreeVector xyzGlobal = LocalToGlobalPoint(localToGlobalTransform, local[0], local[1], local[2]);
+      GetFieldValue(xyzGlobal, G4ThreeVector(0,0,1), local[3], globalValue);
+      GlobalToLocalAxisField(globalToLocalTransform, globalValue, referenceValue);
+      Evaluate(resampledField, G4ThreeVector(local[0], local[1], local[2]), local[3], resampledValue);
+      
+      G4ThreeVector reference(referenceValue[offset], referenceValue[offset+1], referenceValue[offset+2]);
+      G4ThreeVector resampled(resampledValue[offset], resampledValue[offset+1], resampledValue[offset+2]);
+      G4double diff = (resampled - reference).mag();
+      sumDiff2 += diff*diff;
+      maxReference = std::max(maxReference, reference.mag());
+      if (diff > maxDiff)
+	{
+	  maxDiff = diff;
+	  std::copy(local, local + 4, worstLocal);
+	}
+    }
+  
+  G4String unitName = electric ? " V/m" : " T";
+  G4cout << "FieldQuery> " << (electric ? "E" : "B") << " \"" << interpolatorName << "\" over " << nTotal << " cell centres:" << G4endl;
+  G4cout << "FieldQuery>   max |dF| = " << maxDiff / unit << unitName << " at (x,y,z,t) = ("
+	 << worstLocal[0] / CLHEP::cm << ", " << worstLocal[1] / CLHEP::cm << ", "
+	 << worstLocal[2] / CLHEP::cm << ") cm, " << worstLocal[3] / CLHEP::s << " s" << G4endl;
+  G4cout << "FieldQuery>   rms |dF| = " << std::sqrt(sumDiff2 / (G4double)nTotal) / unit << unitName << G4endl;
+  if (maxReference > 0)
+    {G4cout << "FieldQuery>   max |dF| / max |F| = " << maxDiff / maxReference << G4endl;}
+}
+
+void BDSFieldQueryRaw::Evaluate(G4Field* fieldToQuery,
+				const G4ThreeVector& globalXYZ,
+				G4double tGlobal,
+				G4double fieldValue[6])
 {
   for (G4int i = 0; i < 6; i++)
     {fieldValue[i] = 0;}
-  if (!field)
+  if (!fieldToQuery)
     {return;}
   G4double position[4] = {globalXYZ.x(), globalXYZ.y(),globalXYZ.z(), tGlobal};
-  field->GetFieldValue(position, fieldValue);
+  fieldToQuery->GetFieldValue(position, fieldValue);
 }
 
 void BDSFieldQueryRaw::CheckIfFieldObjectSpecified(const BDSFieldQueryInfo* query) const
@@ -20,8 +20,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSGDMLPreprocessor.hh"
+#include "BDSGlobalConstants.hh"
 #include "BDSTemporaryFiles.hh"
 #include "BDSUtilities.hh"
+#include "BDSWarning.hh"
 
 #include <xercesc/dom/DOM.hpp>
 #include <xercesc/framework/LocalFileFormatTarget.hpp>
@@ -36,15 +38,23 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Version.hh"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
+#include <iomanip>
 #include <istream>
 #include <map>
 #include <ostream>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 #include <regex>
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace xercesc;
 
 G4String BDS::PreprocessGDML(const G4String& file,
@@ -53,10 +63,18 @@ G4String BDS::PreprocessGDML(const G4String& file,
 {
   if (BDS::EndsWith(file, ".gmad"))
     {throw BDSException(__METHOD_NAME__, "trying to read a GMAD file (\"" + file + "\") as a GDML file - check file or change extension.");}
+  G4String cacheFile = BDS::GDMLCacheFileName(file, "prefix_" + prefix + (preprocessSchema ? "_schema_" + BDS::GDMLSchemaLocation() : ""));
+  if (!cacheFile.empty() && BDS::FileExists(cacheFile))
+    {
+      G4cout << __METHOD_NAME__ << "using cached preprocessed file \"" << cacheFile << "\"" << G4endl;
+      return cacheFile;
+    }
   BDSGDMLPreprocessor processor;
   G4String processedFile = processor.PreprocessFile(file,
 						    prefix,
 						    preprocessSchema);
+  if (!cacheFile.empty())
+    {BDS::StoreInGDMLCache(processedFile, cacheFile);}
   return processedFile;
 }
 
@@ -72,6 +90,13 @@ G4String BDS::PreprocessGDMLSchemaOnly(const G4String& file)
   else
     {G4cout << __METHOD_NAME__ << "updating GDML Schema to local copy for file:\n \"" << file << "\"" << G4endl;}
 
+  G4String cacheFile = BDS::GDMLCacheFileName(file, "schema_" + BDS::GDMLSchemaLocation());
+  if (!cacheFile.empty() && BDS::FileExists(cacheFile))
+    {
+      G4cout << __METHOD_NAME__ << "using cached preprocessed file \"" << cacheFile << "\"" << G4endl;
+      return cacheFile;
+    }
+
   // create new temporary file that modified gdml can be written to.
   G4String newFile = BDSTemporaryFiles::Instance()->CreateTemporaryFile(file);
 
@@ -103,6 +128,8 @@ G4String BDS::PreprocessGDMLSchemaOnly(const G4String& file)
       i++;
     }
   outFile.close();
+  if (!cacheFile.empty())
+    {BDS::StoreInGDMLCache(newFile, cacheFile);}
   return newFile;
 }
 
@@ -126,6 +153,161 @@ G4String BDS::GDMLSchemaLocation()
    {throw BDSException(__METHOD_NAME__, "ERROR: local GDML schema could not be found!");}
 }
 
+G4String BDS::GDMLCacheFileName(const G4String& file,
+				const G4String& variant)
+{
+  G4String cacheDir = BDSGlobalConstants::Instance()->GDMLCacheDirectory();
+  if (cacheDir.empty())
+    {return "";}
+  if (cacheDir.back() != '/')
+    {cacheDir += "/";}
+  if (!BDS::DirectoryExists(cacheDir) && mkdir(cacheDir.c_str(), 0755) != 0 && !BDS::DirectoryExists(cacheDir))
+    {
+      BDS::Warning(__METHOD_NAME__, "unable to create GDML cache directory \"" + cacheDir + "\" - not caching");
+      return "";
+    }
+
+  if (!BDS::FileExists(file))
+    {return "";} // let the preprocessor report the missing file
+  std::uint64_t hash = BDS::GDMLCacheKey(file, variant);
+
+  G4String path = "";
+  G4String fileName = "";
+  BDS::SplitPathAndFileName(file, path, fileName);
+  G4String name = "";
+  G4String extension = "";
+  BDS::SplitFileAndExtension(fileName, name, extension);
+  std::stringstream ss;
+  ss << cacheDir << name << "_" << std::hex << std::setw(16) << std::setfill('0') << hash << extension;
+  return G4String(ss.str());
+}
+
+std::vector<G4String> BDS::GDMLDependencies(const G4String& file)
+{
+  std::vector<G4String> result;
+  std::set<std::string> found = {file};
+  std::vector<G4String> toScan = {file};
+  // only a short snippet after each tag is matched so large files are scanned quickly
+  const std::regex entity("<!ENTITY\\s+(%\\s+)?\\S+\\s+SYSTEM\\s+[\"']([^\"']+)[\"']");
+  const std::regex module("<file\\s+name\\s*=\\s*[\"']([^\"']+)[\"']");
+  while (!toScan.empty())
+    {
+      G4String current = toScan.back();
+      toScan.pop_back();
+      std::ifstream inputFile(current.c_str());
+      if (!inputFile.is_open())
+	{continue;}
+      std::stringstream buffer;
+      buffer << inputFile.rdbuf();
+      const std::string contents = buffer.str();
+      G4String path = "";
+      G4String fileName = "";
+      BDS::SplitPathAndFileName(current, path, fileName);
+
+      auto addDependency = [&](const std::string& dependency)
+			   {
+			     if (found.insert(dependency).second)
+			       {
+				 result.emplace_back(dependency);
+				 toScan.emplace_back(dependency);
+			       }
+			   };
+      auto scan = [&](const std::string& tag, const std::regex& expression, std::size_t group, G4bool relativeToFile)
+		  {
+		    for (std::size_t pos = contents.find(tag); pos != std::string::npos; pos = contents.find(tag, pos + 1))
+		      {
+			std::string snippet = contents.substr(pos, 1024);
+			std::smatch match;
+			if (!std::regex_search(snippet, match, expression, std::regex_constants::match_continuous))
+			  {continue;}
+			std::string dependency = match[group].str();
+			if (dependency.find("://") != std::string::npos)
+			  {continue;} // remote - can't be followed
+			if (relativeToFile && dependency[0] != '/' && path != "./")
+			  {dependency = path + dependency;}
+			addDependency(dependency);
+		      }
+		  };
+      scan("<!ENTITY", entity, 2, true); // relative to the referring file as in XML
+      scan("<file",    module, 1, false);// relative to the working directory as in Geant4
+    }
+  return result;
+}
+
+std::uint64_t BDS::GDMLCacheKey(const G4String& file,
+				const G4String& variant)
+{
+  // 64 bit FNV-1a - fast and stable across platforms
+  const std::uint64_t fnvPrime = 1099511628211ULL;
+  std::uint64_t hash = 14695981039346656037ULL;
+  auto addBytes = [&hash,fnvPrime](const char* data, std::size_t n)
+		  {
+		    for (std::size_t i = 0; i < n; i++)
+		      {
+			hash ^= (std::uint64_t)(unsigned char)data[i];
+			hash *= fnvPrime;
+		      }
+		  };
+  auto addString = [&addBytes](const std::string& value)
+		   {
+		     std::string entry = value + "\n";
+		     addBytes(entry.data(), entry.size());
+		   };
+  std::vector<char> buffer(1<<16);
+  auto addFile = [&](const G4String& fileName)
+		 {
+		   addString(fileName);
+		   std::ifstream inputFile(fileName.c_str(), std::ios::binary);
+		   if (!inputFile.is_open())
+		     {
+		       addString("<missing>");
+		       return;
+		     }
+		   while (inputFile)
+		     {
+		       inputFile.read(buffer.data(), (std::streamsize)buffer.size());
+		       addBytes(buffer.data(), (std::size_t)inputFile.gcount());
+		     }
+		 };
+
+  // the preprocessor writes the directory of the file into relative schema locations
+  G4String path = "";
+  G4String fileName = "";
+  BDS::SplitPathAndFileName(file, path, fileName);
+  char* realPath = realpath(path.c_str(), nullptr);
+  addString(realPath ? std::string(realPath) : std::string(path));
+  std::free(realPath);
+  addString(std::to_string(G4VERSION_NUMBER));
+  addString(variant);
+  addFile(file);
+  for (const auto& dependency : BDS::GDMLDependencies(file))
+    {addFile(dependency);}
+  return hash;
+}
+
+void BDS::StoreInGDMLCache(const G4String& processedFile,
+			   const G4String& cacheFile)
+{
+  G4String partialFile = cacheFile + ".partial_" + std::to_string(getpid());
+  {
+    std::ifstream in(processedFile.c_str(), std::ios::binary);
+    std::ofstream out(partialFile.c_str(), std::ios::binary);
+    if (!in.is_open() || !out.is_open())
+      {
+	BDS::Warning(__METHOD_NAME__, "unable to write \"" + partialFile + "\" - not caching");
+	return;
+      }
+    out << in.rdbuf();
+  }
+  if (std::rename(partialFile.c_str(), cacheFile.c_str()) != 0)
+    {
+      std::remove(partialFile.c_str());
+      BDS::Warning(__METHOD_NAME__, "unable to store \"" + cacheFile + "\" in the GDML cache");
+    }
+  else
+    {G4cout << __METHOD_NAME__ << "stored preprocessed file in cache as \"" << cacheFile << "\"" << G4endl;}
+}
+
 BDSGDMLPreprocessor::BDSGDMLPreprocessor()
 {
   //ignoreNodes = {"setup"};
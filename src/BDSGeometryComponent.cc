@@ -196,10 +196,17 @@ void BDSGeometryComponent::InheritObjects(BDSGeometryComponent* component)
   RegisterUserLimits(component->GetAllUserLimits());
 }
 
+std::set<BDSGeometryComponent*> BDSGeometryComponent::DaughtersInUse() const
+{
+  std::set<BDSGeometryComponent*> result(allDaughters);
+  result.insert(sharedDaughters.begin(), sharedDaughters.end());
+  return result;
+}
+
 std::set<G4LogicalVolume*> BDSGeometryComponent::GetAllLogicalVolumes() const
 {
   std::set<G4LogicalVolume*> result(allLogicalVolumes);
-  for (auto it : allDaughters)
+  for (auto it : DaughtersInUse())
     {
       auto dLVs = it->GetAllLogicalVolumes();
       result.insert(dLVs.begin(), dLVs.end());
@@ -211,7 +218,7 @@ std::set<G4LogicalVolume*> BDSGeometryComponent::GetAllBiasingVolumes() const
 {
   std::set<G4LogicalVolume*> result(allLogicalVolumes);
 
-  for (auto it : allDaughters) // do the same recursively for daughters
+  for (auto it : DaughtersInUse()) // do the same recursively for daughters
     {
       auto dLVs = it->GetAllBiasingVolumes();
       result.insert(dLVs.begin(), dLVs.end());
@@ -229,7 +236,7 @@ std::map<G4LogicalVolume*, BDSSDType> BDSGeometryComponent::GetAllSensitiveVolum
 {
   // start by copy sensitive volumes belonging to this object
   std::map<G4LogicalVolume*, BDSSDType> result(sensitivity);
-  for (auto it : allDaughters)
+  for (auto it : DaughtersInUse())
     {
       auto dSVs = it->GetAllSensitiveVolumes();
       result.insert(dSVs.begin(), dSVs.end()); // copy into result map
@@ -242,7 +249,7 @@ void BDSGeometryComponent::AttachSensitiveDetectors()
   BDSSDManager* sdm = BDSSDManager::Instance();
   for (auto mapping : sensitivity)
     {mapping.first->SetSensitiveDetector(sdm->SensitiveDetector(mapping.second, !overrideSensitivity));}
-  for (auto daughter : allDaughters)
+  for (auto daughter : DaughtersInUse())
     {daughter->AttachSensitiveDetectors();}
 }
 
@@ -26,6 +26,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4CutTubs.hh"
 #include "G4DisplacedSolid.hh"
 #include "G4EllipticalTube.hh"
+#include "G4ExtrudedSolid.hh"
 #include "G4IntersectionSolid.hh"
 #include "G4SubtractionSolid.hh"
 #include "G4Tubs.hh"
@@ -33,6 +34,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Version.hh"
 #include "G4VSolid.hh"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 // for Geant4.10.2 and below we have a different algorithm as some accessors are not available
@@ -61,6 +64,8 @@ std::pair<BDSExtent, BDSExtent> BDS::DetermineExtents(const G4VSolid* solid)
     {return BDS::InspectCutTubs(solid);}
   else if (className == "G4EllipticalTube")
     {return BDS::InspectEllipticalTube(solid);}
+  else if (className == "G4ExtrudedSolid")
+    {return BDS::InspectExtrudedSolid(solid);}
   else
     {
       G4ThreeVector low, high;
@@ -231,3 +236,38 @@ std::pair<BDSExtent, BDSExtent> BDS::InspectEllipticalTube(const G4VSolid* solid
   BDSExtent inner(0, 0, dZ);
   return std::make_pair(outer, inner);
 }
+
+std::pair<BDSExtent, BDSExtent> BDS::InspectExtrudedSolid(const G4VSolid* solidIn)
+{
+  const G4ExtrudedSolid* solid = dynamic_cast<const G4ExtrudedSolid*>(solidIn);
+  if (!solid)
+    {return std::make_pair(BDSExtent(), BDSExtent());}
+
+  // extruded solids are used in place of booleans, so give the actual (possibly
+  // asymmetric) transverse extent of the polygon including any offset and scaling
+  G4double xMin = std::numeric_limits<G4double>::max();
+  G4double yMin = std::numeric_limits<G4double>::max();
+  G4double xMax = std::numeric_limits<G4double>::lowest();
+  G4double yMax = std::numeric_limits<G4double>::lowest();
+  G4double zMin = std::numeric_limits<G4double>::max();
+  G4double zMax = std::numeric_limits<G4double>::lowest();
+  const std::vector<G4TwoVector> polygon = solid->GetPolygon();
+  for (G4int i = 0; i < solid->GetNofZSections(); i++)
+    {
+      G4ExtrudedSolid::ZSection section = solid->GetZSection(i);
+      zMin = std::min(zMin, section.fZ);
+      zMax = std::max(zMax, section.fZ);
+      for (const auto& vertex : polygon)
+        {
+          G4TwoVector v = section.fScale*vertex + section.fOffset;
+          xMin = std::min(xMin, v.x());
+          xMax = std::max(xMax, v.x());
+          yMin = std::min(yMin, v.y());
+          yMax = std::max(yMax, v.y());
+        }
+    }
+
+  BDSExtent outer(xMin, xMax, yMin, yMax, zMin, zMax);
+  BDSExtent inner(0, 0, 0, 0, zMin, zMax);
+  return std::make_pair(outer, inner);
+}
@@ -51,6 +51,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSDetectorConstruction.hh"
 #include "BDSEventAction.hh"
+#include "BDSEventArena.hh"
 #include "BDSException.hh"
 #include "BDSFieldFactory.hh"
 #include "BDSFieldLoader.hh"
@@ -302,9 +303,12 @@ int BDSIM::Initialise()
   G4int verboseSteppingEventStart = globals->VerboseSteppingEventStart();
   G4int verboseSteppingEventStop  = BDS::VerboseEventStop(verboseSteppingEventStart,
                                                           globals->VerboseSteppingEventContinueFor());
-  if (globals->VerboseSteppingBDSIM())
+  const auto& scoringMeshes = BDSParser::Instance()->GetScorerMesh();
+  G4bool analyticScoringMeshes = std::any_of(scoringMeshes.begin(), scoringMeshes.end(),
+                                             [](const GMAD::ScorerMesh& mesh){return mesh.analytic;});
+  if (globals->VerboseSteppingBDSIM() || analyticScoringMeshes)
     {
-      runManager->SetUserAction(new BDSSteppingAction(true,
+      runManager->SetUserAction(new BDSSteppingAction(globals->VerboseSteppingBDSIM(),
                                                       verboseSteppingEventStart,
                                                       verboseSteppingEventStop));
     }
@@ -448,6 +452,7 @@ BDSIM::~BDSIM()
     {;} // ignore any exception as this is a destructor
   
   delete runManager;
+  delete BDSEventArena::Instance(); // only after the run manager has deleted any events
   delete bdsBunch;
   delete parser;
 
@@ -25,8 +25,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4EventManager.hh" // Geant4 includes
 #include "G4GeometryManager.hh"
 #include "G4GeometryTolerance.hh"
+#include "G4LogicalVolume.hh"
 #include "G4Version.hh"
 #include "G4VModularPhysicsList.hh"
+#include "G4VPhysicalVolume.hh"
 
 #include "BDSAcceleratorModel.hh"
 #include "BDSAperturePointsLoader.hh"
@@ -49,6 +51,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSLinkComponent.hh"
 #include "BDSLinkDetectorConstruction.hh"
 #include "BDSLinkEventAction.hh"
+#include "BDSLinkParticleBatch.hh"
 #include "BDSLinkPrimaryGeneratorAction.hh"
 #include "BDSLinkRunAction.hh"
 #include "BDSLinkRunManager.hh"
@@ -68,7 +71,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSTemporaryFiles.hh"
 #include "BDSUtilities.hh"
 #include "BDSVisManager.hh"
+#include "BDSWarning.hh"
 
+#include <algorithm>
 #include <map>
 #include <set>
 
@@ -85,6 +90,10 @@ BDSIMLink::BDSIMLink(BDSBunch* bunchIn):
   runManager(nullptr),
   construction(nullptr),
   runAction(nullptr),
+  primaryGeneratorAction(nullptr),
+  incrementalGeometryUpdate(false),
+  inLinkElementUpdate(false),
+  updateReferenceVolume(nullptr),
   currentElementIndex(0),
   userPhysicsList(nullptr)
 {;}
@@ -102,6 +111,10 @@ BDSIMLink::BDSIMLink(int argc, char** argv, bool usualPrintOutIn):
   runManager(nullptr),
   construction(nullptr),
   runAction(nullptr),
+  primaryGeneratorAction(nullptr),
+  incrementalGeometryUpdate(false),
+  inLinkElementUpdate(false),
+  updateReferenceVolume(nullptr),
   currentElementIndex(0),
   userPhysicsList(nullptr)
 {
@@ -297,7 +310,7 @@ int BDSIMLink::Initialise(double minimumKineticEnergy,
     }
   */
   
-  auto primaryGeneratorAction = new BDSLinkPrimaryGeneratorAction(bdsBunch, &currentElementIndex, construction, trackerDebug);
+  primaryGeneratorAction = new BDSLinkPrimaryGeneratorAction(bdsBunch, &currentElementIndex, construction, trackerDebug);
   construction->SetPrimaryGeneratorAction(primaryGeneratorAction);
   runManager->SetUserAction(primaryGeneratorAction);
   //BDSFieldFactory::SetPrimaryGeneratorAction(primaryGeneratorAction);
@@ -392,6 +405,39 @@ void BDSIMLink::BeamOn(int nGenerate)
     } 
 }
 
+void BDSIMLink::TrackBatch(const BDSLinkParticleBatch& particlesIn,
+			   BDSLinkParticleBatch&       particlesOut,
+			   int                         primariesPerEvent)
+{
+  particlesOut.Clear();
+  if (initialisationResult > 1 || !initialised || particlesIn.Size() == 0)
+    {return;}
+  auto bunchSTL = dynamic_cast<BDSBunchSixTrackLink*>(bdsBunch);
+  if (!bunchSTL)
+    {throw BDSException(__METHOD_NAME__, "the bunch must be a BDSBunchSixTrackLink to track a batch");}
+
+  // a limit on the number of tracks is per event so would change with several primaries
+  if (primariesPerEvent > 1 && BDSGlobalConstants::Instance()->MaximumTracksPerEvent() > 0)
+    {
+      BDS::Warning(__METHOD_NAME__, "maximumTracksPerEvent is set - using one primary per event");
+      primariesPerEvent = 1;
+    }
+  primariesPerEvent = std::max(1, primariesPerEvent);
+  
+  G4int nParticles = (G4int)particlesIn.Size();
+  G4int nEvents    = (nParticles + primariesPerEvent - 1) / primariesPerEvent;
+
+  bunchSTL->SetParticleBatch(&particlesIn);
+  primaryGeneratorAction->SetPrimariesPerEvent(primariesPerEvent, nParticles);
+  runAction->SetOutputBatch(&particlesOut);
+  BeamOn(nEvents);
+  
+  // back to the individually added particles and hits
+  bunchSTL->SetParticleBatch(nullptr);
+  primaryGeneratorAction->SetPrimariesPerEvent(1, 0);
+  runAction->SetOutputBatch(nullptr);
+}
+
 BDSIMLink::~BDSIMLink()
 {
   /// Termination & clean up.
@@ -519,9 +565,8 @@ int BDSIMLink::AddLinkCollimatorJaw(const std::string& collimatorName,
 				     double crystalAngle,
 				     bool   sampleIn)
 {
-  G4GeometryManager* gm = G4GeometryManager::GetInstance();
-  if (gm->IsGeometryClosed())
-    {gm->OpenGeometry();}
+  if (!inLinkElementUpdate)
+    {OpenGeometryForUpdate();}
 
   G4int linkID = construction->AddLinkCollimatorJaw(collimatorName,
 				     materialName,
@@ -541,15 +586,66 @@ int BDSIMLink::AddLinkCollimatorJaw(const std::string& collimatorName,
   // update this class's nameToElementIndex map
   nameToElementIndex = construction->NameToElementIndex();
   linkIDToBeamlineIndex = construction->LinkIDToBeamlineIndex();
-  
+
+  if (!inLinkElementUpdate)
+    {CloseGeometryAfterUpdate();}
+  return (int)linkID;
+}
+
+void BDSIMLink::BeginLinkElementUpdate()
+{
+  if (inLinkElementUpdate)
+    {return;}
+  OpenGeometryForUpdate();
+  inLinkElementUpdate = true;
+}
+
+void BDSIMLink::EndLinkElementUpdate()
+{
+  if (!inLinkElementUpdate)
+    {return;}
+  inLinkElementUpdate = false;
+  CloseGeometryAfterUpdate();
+}
+
+void BDSIMLink::OpenGeometryForUpdate()
+{
+  updateReferenceVolume = nullptr;
+  G4GeometryManager* gm = G4GeometryManager::GetInstance();
+  if (!gm->IsGeometryClosed())
+    {return;}
+  if (incrementalGeometryUpdate)
+    {// opening with a daughter of the world only clears the voxels of the world and
+      // of each logical volume down the chain of first daughters (GetDaughter(0))
+      // below it, which are rebuilt when closing - not the rest of its tree
+      G4LogicalVolume* worldLV = construction->WorldPV()->GetLogicalVolume();
+      if (worldLV->GetNoDaughters() > 0)
+	{updateReferenceVolume = worldLV->GetDaughter(0);}
+    }
+  gm->OpenGeometry(updateReferenceVolume); // nullptr -> whole geometry
+}
+
+void BDSIMLink::CloseGeometryAfterUpdate()
+{
   if (bdsOutput)
     {bdsOutput->UpdateSamplers();}
 
   /// Close the geometry in preparation for running - everything is now fixed.
-  G4bool bCloseGeometry = gm->CloseGeometry();
+  G4GeometryManager* gm = G4GeometryManager::GetInstance();
+  G4bool bCloseGeometry = false;
+  if (updateReferenceVolume)
+    {
+      bCloseGeometry = gm->CloseGeometry(true, false, updateReferenceVolume);
+      construction->OptimiseNewVolumes();
+    }
+  else
+    {
+      bCloseGeometry = gm->CloseGeometry();
+      construction->ClearNewVolumes();
+    }
+  updateReferenceVolume = nullptr;
   if (!bCloseGeometry)
     {throw BDSException(__METHOD_NAME__, "error - geometry not closed.");}
-  return (int)linkID;
 }
 
 BDSHitsCollectionSamplerLink* BDSIMLink::SamplerHits() const
@@ -46,7 +46,7 @@ BDSImportanceFileLoader<T>::~BDSImportanceFileLoader()
 {;}
 
 template <class T>
-std::map<G4String, G4double> BDSImportanceFileLoader<T>::Load(const G4String& fileName)
+std::map<G4String, std::vector<G4double> > BDSImportanceFileLoader<T>::Load(const G4String& fileName)
 {
   T file;
 
@@ -65,47 +65,44 @@ std::map<G4String, G4double> BDSImportanceFileLoader<T>::Load(const G4String& fi
     {G4cout << "BDSImportanceFileLoader::Load> loading \"" << fileName << "\"" << G4endl;}
 
   std::string line;
-  std::map<G4String, G4double> importance;
+  std::map<G4String, std::vector<G4double> > importance;
   G4int lineNum = 1;
   while (std::getline(file, line))
     { // read a line only if it's not a blank one
       std::istringstream liness(line);
       std::string volume;
-      std::string importanceValueString;
 
       // skip a line if it's only whitespace
       if (std::all_of(line.begin(), line.end(), isspace))
         {continue;}
 
-      liness >> volume >> importanceValueString;
+      liness >> volume;
 
-      // exit if anything after the importance value
-      if (!liness.eof())
-	{
-	  std::string remainder;
-	  liness >> remainder;
-	  G4String message = "Error: Unknown value \"" + remainder + "\" in line " + std::to_string(lineNum) + " of the importanceMapFile";
-          throw BDSException(message);
-	}
+      // one or more importance values - one per energy window with weight windows
+      std::vector<G4double> importanceValues;
+      std::string importanceValueString;
+      while (liness >> importanceValueString)
+        {
+          G4double importanceValue = 0;
+          try
+            {importanceValue = std::stod(importanceValueString);}
+          catch (...)
+            {
+              G4String message = "Error: Cell \"" + volume + "\" has importance value \"" + importanceValueString + "\"";
+              message += " in line " + std::to_string(lineNum) + " of the importanceMapFile, importance value must be numeric.";
+              throw BDSException(message);
+            }
+          importanceValues.push_back(importanceValue);
+        }
 
       // exit if no importance value is supplied
-      if (importanceValueString.empty())
+      if (importanceValues.empty())
         {
           G4String message = "No importance value was found for cell \"" + volume + "\" in the importanceMapFile.";
           throw BDSException(message);
         }
-
-      G4double importanceValue = 0;
-      try
-	{importanceValue = std::stod(importanceValueString);}
-      catch (...)
-	{
-	  G4String message = "Error: Cell \"" + volume + "\" has importance value \"" + importanceValueString + "\",";
-          message += " importance value must be numeric.";
-          throw BDSException(message);
-	}
       
-      importance[volume] = importanceValue;
+      importance[volume] = importanceValues;
 
       lineNum += 1;
     }
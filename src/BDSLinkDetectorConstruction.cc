@@ -48,15 +48,19 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "parser/elementtype.h"
 
 #include "G4Box.hh"
+#include "G4LogicalVolume.hh"
 #include "G4PVPlacement.hh"
+#include "G4SmartVoxelHeader.hh"
 #include "G4String.hh"
 #include "G4ThreeVector.hh"
 #include "G4Types.hh"
 #include "G4Version.hh"
 #include "G4VisAttributes.hh"
+#include "G4VPhysicalVolume.hh"
 #if G4VERSION_NUMBER > 1039
 #include "G4ChannelingOptrMultiParticleChangeCrossSection.hh"
 #endif
+#include "voxeldefs.hh"
 
 #include <set>
 #include <vector>
@@ -180,6 +184,7 @@ G4VPhysicalVolume* BDSLinkDetectorConstruction::Construct()
     }
 
   delete componentFactory;
+  newlyPlacedVolumes.clear(); // the whole geometry will be optimised
 
   return worldPV;
 }
@@ -377,6 +382,7 @@ G4int BDSLinkDetectorConstruction::PlaceOneComponent(const BDSBeamlineElement* e
   G4String placementName = element->GetPlacementName() + "_pv";
   G4int copyNumber = element->GetCopyNo();
   std::set<G4VPhysicalVolume*> pvs = element->PlaceElement(placementName, worldPV, false, copyNumber, true);
+  newlyPlacedVolumes.insert(newlyPlacedVolumes.end(), pvs.begin(), pvs.end());
 
   auto lc = dynamic_cast<BDSLinkComponent*>(element->GetAcceleratorComponent());
   if (!lc)
@@ -404,17 +410,62 @@ G4int BDSLinkDetectorConstruction::PlaceOneComponent(const BDSBeamlineElement* e
       G4int samplerID = BDSSamplerRegistry::Instance()->RegisterSampler(samplerName, sampler, samplerPosition, sStart, element);
 
       G4LogicalVolume* samplerWorldLV = samplerWorld->WorldLV();
-      new G4PVPlacement(samplerPosition,
-                        sampler->GetContainerLogicalVolume(),
-			samplerName + "_pv",
-			samplerWorldLV,
-			false,
-			samplerID,
-			false);
+      auto samplerPV = new G4PVPlacement(samplerPosition,
+					 sampler->GetContainerLogicalVolume(),
+					 samplerName + "_pv",
+					 samplerWorldLV,
+					 false,
+					 samplerID,
+					 false);
+      newlyPlacedVolumes.push_back(samplerPV);
     }
   return linkID;
 }
 
+void BDSLinkDetectorConstruction::OptimiseNewVolumes()
+{
+  G4LogicalVolume* worldLV = worldPV->GetLogicalVolume();
+  std::set<G4LogicalVolume*> mothers;
+  std::set<G4LogicalVolume*> visited;
+  for (auto pv : newlyPlacedVolumes)
+    {
+      G4LogicalVolume* mother = pv->GetMotherLogical();
+      if (mother && mother != worldLV)
+	{mothers.insert(mother);}
+      OptimiseVolumeTree(pv->GetLogicalVolume(), visited);
+    }
+  // these have new daughters so the existing voxels are wrong
+  for (auto mother : mothers)
+    {
+      delete mother->GetVoxelHeader();
+      mother->SetVoxelHeader(nullptr);
+      BuildVoxels(mother);
+    }
+  newlyPlacedVolumes.clear();
+}
+
+void BDSLinkDetectorConstruction::OptimiseVolumeTree(G4LogicalVolume* lv,
+						     std::set<G4LogicalVolume*>& visited) const
+{
+  if (!visited.insert(lv).second)
+    {return;} // already done - logical volumes may be shared
+  if (!lv->GetVoxelHeader())
+    {BuildVoxels(lv);}
+  for (G4int i = 0; i < (G4int)lv->GetNoDaughters(); i++)
+    {OptimiseVolumeTree(lv->GetDaughter(i)->GetLogicalVolume(), visited);}
+}
+
+void BDSLinkDetectorConstruction::BuildVoxels(G4LogicalVolume* lv)
+{
+  G4int nDaughters = (G4int)lv->GetNoDaughters();
+  G4bool optimise = lv->IsToOptimise() && nDaughters >= kMinVoxelVolumesLevel1;
+  G4bool replicated = nDaughters == 1
+    && lv->GetDaughter(0)->IsReplicated()
+    && lv->GetDaughter(0)->GetRegularStructureId() != 1;
+  if (optimise || replicated)
+    {lv->SetVoxelHeader(new G4SmartVoxelHeader(lv));}
+}
+
 void BDSLinkDetectorConstruction::BuildPhysicsBias()
 {
 #if G4VERSION_NUMBER > 1039
@@ -36,8 +36,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4PropagatorInField.hh"
 #include "G4Run.hh"
 #include "G4SDManager.hh"
-#include "G4THitsMap.hh"
 #include "G4TransportationManager.hh"
+#include "G4VHitsCollection.hh"
 #include "G4VUserEventInformation.hh"
 
 #include <map>
@@ -111,21 +111,14 @@ void BDSLinkEventAction::EndOfEventAction(const G4Event* evt)
   std::vector<shc*> allSamplerHits = {sampHC};
   
   G4VUserEventInformation* evtInfoG4 = evt->GetUserInformation();
-  BDSLinkEventInfo* evtInfo = dynamic_cast<BDSLinkEventInfo*>(evtInfoG4);
-  G4int primaryExternalParticleID = 0;
-  G4int primaryExternalParentID   = 0;
-  if (evtInfo)
-    {
-      primaryExternalParticleID = evtInfo->externalParticleIDofPrimary;
-      primaryExternalParentID   = evtInfo->externalParentIDofPrimary;
-    }
+  const BDSLinkEventInfo* evtInfo = dynamic_cast<BDSLinkEventInfo*>(evtInfoG4);
   
   if (!samplerLink)
     {return;}
   if (samplerLink->entries() <= 0)
     {return;}
   else
-    {runAction->AppendHits(currentEventIndex, primaryExternalParticleID, primaryExternalParentID, samplerLink);}
+    {runAction->AppendHits(currentEventIndex, evtInfo, samplerLink);}
 
   output->FillEvent(nullptr,
 		    evt->GetPrimaryVertex(),
@@ -145,6 +138,6 @@ void BDSLinkEventAction::EndOfEventAction(const G4Event* evt)
                     nullptr,
                     nullptr,
                     nullptr,
-                    std::map<G4String, G4THitsMap<G4double>*>(),
+                    std::map<G4String, G4VHitsCollection*>(),
                     BDSGlobalConstants::Instance()->TurnsTaken());
 }
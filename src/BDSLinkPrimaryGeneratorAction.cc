@@ -22,6 +22,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSEventInfo.hh"
 #include "BDSException.hh"
 #include "BDSExtent.hh"
+#include "BDSGlobalConstants.hh"
 #include "BDSIonDefinition.hh"
 #include "BDSLinkDetectorConstruction.hh"
 #include "BDSLinkEventInfo.hh"
@@ -33,8 +34,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Event.hh"
 #include "G4IonTable.hh"
 #include "G4ParticleGun.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
 #include "G4Types.hh"
 
+#include <algorithm>
+
 BDSLinkPrimaryGeneratorAction::BDSLinkPrimaryGeneratorAction(BDSBunch* bunchIn,
 							     int*      currentElementIndexIn,
 							     BDSLinkDetectorConstruction* constructionIn,
@@ -43,9 +48,13 @@ BDSLinkPrimaryGeneratorAction::BDSLinkPrimaryGeneratorAction(BDSBunch* bunchIn,
   currentElementIndex(currentElementIndexIn),
   construction(constructionIn),
   debug(debugIn),
-  particleGun(nullptr)
+  particleGun(nullptr),
+  seedPerEvent(false),
+  primariesPerEvent(1),
+  primariesRemaining(0)
 {
   particleGun = new G4ParticleGun(1); // 1-particle gun
+  seedPerEvent = BDSGlobalConstants::Instance()->SeedPerEvent();
   
   particleGun->SetParticleMomentumDirection(G4ThreeVector(0.,0.,1.));
   particleGun->SetParticlePosition(G4ThreeVector());
@@ -62,26 +71,55 @@ void BDSLinkPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
   // always save seed state in output
   BDSLinkEventInfo* eventInfo = new BDSLinkEventInfo();
   anEvent->SetUserInformation(eventInfo);
-  eventInfo->SetSeedStateAtStart(BDSRandom::GetSeedState());
+  if (seedPerEvent)
+    {// each call to the link is a new run so the run ID makes the stream unique
+      G4int runID = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+      BDSRandom::SetSeedForEvent(runID, anEvent->GetEventID());
+      eventInfo->SetSeedStateAtStart(BDSRandom::EventSeedState(runID, anEvent->GetEventID()));
+    }
+  else
+    {eventInfo->SetSeedStateAtStart(BDSRandom::GetSeedState());}
 
+  if (primariesPerEvent < 2)
+    {
+      if (!GeneratePrimary(anEvent, eventInfo))
+	{
+	  anEvent->SetEventAborted();
+	  G4cout << "Aborting this event (#" << anEvent->GetEventID() << ")" << G4endl;
+	}
+      return;
+    }
+
+  // several primaries - a bad one is skipped rather than losing the others
+  G4int nThisEvent = std::min(primariesPerEvent, primariesRemaining);
+  primariesRemaining -= nThisEvent;
+  for (G4int i = 0; i < nThisEvent; i++)
+    {GeneratePrimary(anEvent, eventInfo);}
+  if (anEvent->GetNumberOfPrimaryVertex() == 0)
+    {anEvent->SetEventAborted();}
+}
+
+G4bool BDSLinkPrimaryGeneratorAction::GeneratePrimary(G4Event* anEvent,
+                                                      BDSLinkEventInfo* eventInfo)
+{
   BDSParticleCoordsFull coords;
+  G4int externalParticleID = 0;
+  G4int externalParentID   = 0;
   try
     {
       coords = bunch->GetNextParticleLocal();
       auto bunchSTL = dynamic_cast<BDSBunchSixTrackLink*>(bunch);
       if (bunchSTL)
 	{
-	  eventInfo->externalParticleIDofPrimary = bunchSTL->CurrentExternalParticleID();
-	  eventInfo->externalParentIDofPrimary   = bunchSTL->CurrentExternalParentID();
+	  externalParticleID = bunchSTL->CurrentExternalParticleID();
+	  externalParentID   = bunchSTL->CurrentExternalParentID();
 	}
     }
   catch (const BDSException& exception)
-    {// we couldn't safely generate a particle -> abort
+    {// we couldn't safely generate a particle
       // could be because of user input file
-      anEvent->SetEventAborted();
       G4cout << exception.what() << G4endl;
-      G4cout << "Aborting this event (#" << anEvent->GetEventID() << ")" << G4endl;
-      return;
+      return false;
     }
 
   BDSParticleCoordsFullGlobal cg;
@@ -117,8 +155,7 @@ void BDSLinkPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
       G4cout << __METHOD_NAME__ << "Event #" << anEvent->GetEventID()
 	     << " - Particle kinetic energy smaller than 0! "
 	     << "This will not be tracked." << G4endl;
-      anEvent->SetEventAborted();
-      return;
+      return false;
     }
 
   // check the coordinates are valid
@@ -126,8 +163,8 @@ void BDSLinkPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
     {
       G4cerr << __METHOD_NAME__ << "point: " << cg.global
 	     << "mm lies outside the world volume with extent ("
-	     << worldExtent << " - event aborted!" << G4endl << G4endl;
-      anEvent->SetEventAborted();
+	     << worldExtent << " - not tracked!" << G4endl << G4endl;
+      return false;
     }
 
 #ifdef BDSDEBUG
@@ -144,11 +181,14 @@ void BDSLinkPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 
   particleGun->GeneratePrimaryVertex(anEvent);
 
-  // set the weight
-  auto vertex = anEvent->GetPrimaryVertex();
+  // set the weight of the vertex just made
+  auto vertex = anEvent->GetPrimaryVertex(anEvent->GetNumberOfPrimaryVertex() - 1);
   vertex->SetWeight(cg.local.weight);
   //vertex->Print();
 
+  // keep the external IDs in the same order as the vertices (and so the track IDs)
+  eventInfo->AddPrimary(externalParticleID, externalParentID);
+
   // associate full set of coordinates with vertex for writing to output after event
   //vertex->SetUserInformation(new BDSPrimaryVertexInformation(coords,
   //							     bunch->ParticleDefinition()));
@@ -156,4 +196,5 @@ void BDSLinkPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 #ifdef BDSDEBUG
   vertex->Print();
 #endif
+  return true;
 }
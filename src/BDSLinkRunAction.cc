@@ -19,13 +19,18 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSAuxiliaryNavigator.hh"
 #include "BDSHitSamplerLink.hh"
 #include "BDSLinkEventAction.hh"
+#include "BDSLinkEventInfo.hh"
+#include "BDSLinkParticleBatch.hh"
 #include "BDSLinkRunAction.hh"
 
+#include "CLHEP/Units/SystemOfUnits.h"
+
 BDSLinkRunAction::BDSLinkRunAction():
   allHits(nullptr),
   nSecondariesToReturn(0),
   nPrimariesToReturn(0),
-  maximumExternalParticleID(0)
+  maximumExternalParticleID(0),
+  outputBatch(nullptr)
 {;}
 
 BDSLinkRunAction::~BDSLinkRunAction()
@@ -57,29 +62,62 @@ void BDSLinkRunAction::EndOfRunAction(const G4Run* /*aRun*/)
 {;}
 
 void BDSLinkRunAction::AppendHits(G4int currentEventIndex,
-				  G4int externalParticleID,
-				  G4int externalParentID,
+				  const BDSLinkEventInfo* eventInfo,
 				  const BDSHitsCollectionSamplerLink* hits)
 {
   if (!hits)
     {return;}
+  G4bool severalPrimaries = eventInfo && eventInfo->NPrimaries() > 1;
   for (G4int i = 0; i < (G4int)hits->entries(); i++)
     {
-      auto hit = new BDSHitSamplerLink(*(*hits)[i]);
-      hit->eventID = currentEventIndex;
-      if (hit->parentID == 0)
-	{// use same ones from event which are the original ones for this primary
-	  hit->externalParticleID = externalParticleID;
-	  hit->externalParentID   = externalParentID;
-	  nPrimariesToReturn++;
+      const BDSHitSamplerLink* eventHit = (*hits)[i];
+      // the external IDs of the primary this particle descends from
+      G4int externalParticleID = 0;
+      G4int externalParentID   = 0;
+      if (severalPrimaries)
+	{
+	  G4int primaryIndex = eventInfo->PrimaryIndex(eventHit->trackID);
+	  externalParticleID = eventInfo->externalParticleIDs[primaryIndex];
+	  externalParentID   = eventInfo->externalParentIDs[primaryIndex];
 	}
+      else if (eventInfo)
+	{
+	  externalParticleID = eventInfo->externalParticleIDofPrimary;
+	  externalParentID   = eventInfo->externalParentIDofPrimary;
+	}
+
+      if (eventHit->parentID == 0)
+	{nPrimariesToReturn++;}
       else
 	{// new secondary - give it a new index (caching that), and new parentID
 	  maximumExternalParticleID++;
-	  hit->externalParticleID = maximumExternalParticleID;
-	  hit->externalParentID   = externalParticleID;
+	  externalParentID   = externalParticleID;
+	  externalParticleID = maximumExternalParticleID;
 	  nSecondariesToReturn++;
 	}
-      allHits->insert(hit);
+
+      if (outputBatch)
+	{
+	  const BDSParticleCoordsFull& coords = eventHit->coords;
+	  outputBatch->Append(coords.x / CLHEP::m,
+			      coords.xp,
+			      coords.y / CLHEP::m,
+			      coords.yp,
+			      coords.T / CLHEP::s,
+			      coords.totalEnergy / CLHEP::GeV,
+			      coords.weight,
+			      eventHit->pdgID,
+			      (G4int)eventHit->charge,
+			      externalParticleID,
+			      externalParentID);
+	}
+      else
+	{
+	  auto hit = new BDSHitSamplerLink(*eventHit);
+	  hit->eventID = currentEventIndex;
+	  hit->externalParticleID = externalParticleID;
+	  hit->externalParentID   = externalParentID;
+	  allHits->insert(hit);
+	}
     }
 }
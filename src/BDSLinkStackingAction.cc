@@ -17,11 +17,13 @@ You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSGlobalConstants.hh"
+#include "BDSLinkEventInfo.hh"
 #include "BDSLinkStackingAction.hh"
 #include "BDSPhysicsUtilities.hh"
 #include "BDSRunManager.hh"
 
 #include "G4Event.hh"
+#include "G4EventManager.hh"
 #include "G4Track.hh"
 #include "G4TrackStatus.hh"
 #include "G4Types.hh"
@@ -38,7 +40,8 @@ BDSLinkStackingAction::BDSLinkStackingAction(const BDSGlobalConstants* globals,
   pdgIDsToAllow(pdgIDsToAllowIn),
   emptyPDGIDs(pdgIDsToAllow.empty()),
   protonsAndIonsOnly(protonsAndIonsOnlyIn),
-  minimumEK(minimumEKIn)
+  minimumEK(minimumEKIn),
+  multiPrimaryEventInfo(nullptr)
 {
   killNeutrinos     = globals->KillNeutrinos();
   stopSecondaries   = globals->StopSecondaries();
@@ -54,6 +57,9 @@ G4ClassificationOfNewTrack BDSLinkStackingAction::ClassifyNewTrack(const G4Track
 {
   G4ClassificationOfNewTrack result = fUrgent;
 
+  if (multiPrimaryEventInfo)
+    {multiPrimaryEventInfo->RegisterTrack(aTrack->GetTrackID(), aTrack->GetParentID());}
+
   if (aTrack->GetTrackID() > maxTracksPerEvent)
     {result = fKill;}
   else if (aTrack->GetKineticEnergy() <= minimumEK)
@@ -90,4 +96,13 @@ G4ClassificationOfNewTrack BDSLinkStackingAction::ClassifyNewTrack(const G4Track
   return result;
 }
 
-
+void BDSLinkStackingAction::PrepareNewEvent()
+{
+  multiPrimaryEventInfo = nullptr;
+  const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+  if (!event)
+    {return;}
+  auto eventInfo = dynamic_cast<BDSLinkEventInfo*>(event->GetUserInformation());
+  if (eventInfo && eventInfo->NPrimaries() > 1)
+    {multiPrimaryEventInfo = eventInfo;}
+}
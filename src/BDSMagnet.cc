@@ -16,6 +16,7 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSAcceleratorModel.hh"
 #include "BDSBeamPipe.hh"
 #include "BDSBeamPipeFactory.hh"
 #include "BDSBeamPipeInfo.hh"
@@ -45,6 +46,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
 class G4Userlimits;
 
 BDSMagnet::BDSMagnet(BDSMagnetType       typeIn,
@@ -65,6 +70,7 @@ BDSMagnet::BDSMagnet(BDSMagnetType       typeIn,
   placeBeamPipe(false),
   magnetOuterOffset(G4ThreeVector(0,0,0)),
   outer(nullptr),
+  outerReused(false),
   beamPipePlacementTransform(G4Transform3D()),
   isThin(isThinIn)
 {
@@ -194,12 +200,43 @@ void BDSMagnet::BuildVacuumField()
 void BDSMagnet::BuildOuter()
 {
   G4double outerLength = chordLength - 2*lengthSafety;
-  // The outerFieldInfo is required only so we don't reuse geometry when we need a unique field on it.
-  outer = BDSMagnetOuterFactory::Instance()->CreateMagnetOuter(magnetType,
-                                                               magnetOuterInfo,
-                                                               outerLength,
-                                                               chordLength,
-                                                               beampipe);
+
+  // The outer may be built once and placed in every magnet with identical geometry.
+  // Fields are attached to logical volumes, so a shared outer can only have one field
+  // and the outer field definition (including the vacuum strength it is scaled by) is
+  // part of the key. The field is converted to the local frame of each placement as
+  // it's used. Bent magnets are excluded as the face normals of the outer are updated
+  // in place below.
+  G4bool shareGeometry = reuseIdenticalGeometry && !BDS::IsFinite(angle)
+    && magnetOuterInfo->geometryType != BDSMagnetGeometryType::external;
+  G4String geometryKey;
+  if (shareGeometry)
+    {
+      std::ostringstream key;
+      key << std::setprecision(std::numeric_limits<G4double>::max_digits10);
+      key << "magnet|" << magnetType.ToString() << "|" << SharedGeometryKey() << "|" << outerLength
+          << "|" << magnetOuterInfo->GeometryKey() << "|" << (beamPipeInfo ? beamPipeInfo->GeometryKey() : G4String("none"));
+      if (outerFieldInfo)
+        {
+          key << "|" << outerFieldInfo->DefinitionKey();
+          if (vacuumFieldInfo && vacuumFieldInfo->MagnetStrength())
+            {key << "|" << *(vacuumFieldInfo->MagnetStrength());}
+        }
+      geometryKey = G4String(key.str());
+      outer = dynamic_cast<BDSMagnetOuter*>(BDSAcceleratorModel::Instance()->SharedGeometry(geometryKey));
+      outerReused = outer != nullptr;
+    }
+
+  if (!outer)
+    {
+      outer = BDSMagnetOuterFactory::Instance()->CreateMagnetOuter(magnetType,
+                                                                   magnetOuterInfo,
+                                                                   outerLength,
+                                                                   chordLength,
+                                                                   beampipe);
+      if (outer && shareGeometry)
+        {BDSAcceleratorModel::Instance()->RegisterSharedGeometry(geometryKey, outer);}
+    }
 
   if (outer)
     {
@@ -213,11 +250,16 @@ void BDSMagnet::BuildOuter()
       // zero coordinate of the container solid
       SetPlacementOffset(contOffset);
 
-      RegisterDaughter(outer);
+      if (shareGeometry)
+        {RegisterSharedDaughter(outer);}
+      else
+        {RegisterDaughter(outer);}
       InheritExtents(container, contOffset); // update extents
 
-      // Only clear after extents etc have been used
-      outer->ClearMagnetContainer();
+      // Only clear after extents etc have been used. A shared outer keeps its
+      // container for the next magnet that uses it.
+      if (!shareGeometry)
+        {outer->ClearMagnetContainer();}
       
       endPieceBefore = outer->EndPieceBefore();
       endPieceAfter  = outer->EndPieceAfter();
@@ -236,12 +278,16 @@ void BDSMagnet::BuildOuterField()
       G4String scalingKey = DetermineScalingKey(magnetType);
       
       BDSMagnetStrength* scalingStrength = vacuumFieldInfo ? vacuumFieldInfo->MagnetStrength() : nullptr;
-      G4LogicalVolume* vol = outer->GetContainerLogicalVolume();
-      BDSFieldBuilder::Instance()->RegisterFieldForConstruction(outerFieldInfo,
-                                                                vol,
-                                                                true,
-                                                                scalingStrength,
-                                                                scalingKey);
+      // a shared outer already has the same field from the magnet it was built for
+      if (!outerReused)
+        {
+          G4LogicalVolume* vol = outer->GetContainerLogicalVolume();
+          BDSFieldBuilder::Instance()->RegisterFieldForConstruction(outerFieldInfo,
+                                                                    vol,
+                                                                    true,
+                                                                    scalingStrength,
+                                                                    scalingKey);
+        }
       // Attach to the container but don't propagate to daughter volumes. This ensures
       // any gap between the beam pipe and the outer also has a field.
       BDSFieldBuilder::Instance()->RegisterFieldForConstruction(outerFieldInfo,
@@ -253,7 +299,7 @@ void BDSMagnet::BuildOuterField()
       // in the case of LHC-style geometry, override the second beam pipe (which is a daughter of the outer)
       // field to be the opposite sign of the main vacuum field (same strength)
       auto mgt = magnetOuterInfo->geometryType;
-      if (mgt == BDSMagnetGeometryType::lhcleft || mgt == BDSMagnetGeometryType::lhcright)
+      if (!outerReused && (mgt == BDSMagnetGeometryType::lhcleft || mgt == BDSMagnetGeometryType::lhcright))
         {
           std::set<BDSGeometryComponent*> daughtersSet = outer->GetAllDaughters();
           std::vector<BDSGeometryComponent*> daughters(daughtersSet.begin(), daughtersSet.end());
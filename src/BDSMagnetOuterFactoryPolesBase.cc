@@ -73,7 +73,8 @@ BDSMagnetOuterFactoryPolesBase::BDSMagnetOuterFactoryPolesBase(G4double poleStop
   poleTipFraction(0.2),
   poleAnnulusFraction(0.1),
   bendHeightFraction(0.7),
-  poleStopFactor(poleStopFactorIn)
+  poleStopFactor(poleStopFactorIn),
+  booleanFreeGeometry(BDSGlobalConstants::Instance()->BooleanFreeGeometry())
 {
   // now the base class constructor should be called first which
   // should call clean up (in the derived class) which should initialise
@@ -107,6 +108,7 @@ void BDSMagnetOuterFactoryPolesBase::CleanUpPolesBase()
   endPieceInnerR        = 0;
   endPieceOuterR        = 0;
   poleIntersectionSolid = nullptr;
+  poleMatchesYoke       = false;
   coilLeftSolid         = nullptr;
   coilRightSolid        = nullptr;
   endPieceContainerSolid = nullptr;
@@ -393,9 +395,31 @@ void BDSMagnetOuterFactoryPolesBase::CreatePoleSolid(const G4String& name,
   for (G4int i = 0; i < (G4int)xEllipse.size()-1; i++)
     {points.emplace_back(xEllipse[i], ellipsoidCentreY-yEllipse[i]);}
   points.emplace_back(poleSquareWidth*0.5, poleSquareStartRadius);
-  // top points are x poleStopFactor for unambiguous intersection later on
-  points.emplace_back(poleSquareWidth*0.5, poleFinishRadius*poleStopFactor);
-  points.emplace_back(-poleSquareWidth*0.5, poleFinishRadius*poleStopFactor);
+  // For a circular yoke, the outer edge of the pole can be made as an arc that matches
+  // the inside of the yoke rather than intersecting it with a cylinder afterwards. This
+  // avoids a boolean solid for every pole.
+  G4double poleEdgeRadius = yokeStartRadius - lengthSafetyLarge;
+  G4double poleEdgeHalfWidth = 0.5*poleSquareWidth;
+  poleMatchesYoke = booleanFreeGeometry && YokeInnerEdgeIsCircular()
+    && poleEdgeRadius > poleEdgeHalfWidth
+    && std::sqrt(std::pow(poleEdgeRadius,2) - std::pow(poleEdgeHalfWidth,2)) > poleSquareStartRadius;
+  if (poleMatchesYoke)
+    {
+      // clockwise from +x to -x across the top of the pole
+      const G4int nArcPoints = 8;
+      G4double arcHalfAngle = std::asin(poleEdgeHalfWidth / poleEdgeRadius);
+      for (G4int i = 0; i <= nArcPoints; i++)
+        {
+          G4double arcAngle = arcHalfAngle * (1.0 - 2.0*(G4double)i/(G4double)nArcPoints);
+          points.emplace_back(poleEdgeRadius*std::sin(arcAngle), poleEdgeRadius*std::cos(arcAngle));
+        }
+    }
+  else
+    {
+      // top points are x poleStopFactor for unambiguous intersection later on
+      points.emplace_back(poleSquareWidth*0.5, poleFinishRadius*poleStopFactor);
+      points.emplace_back(-poleSquareWidth*0.5, poleFinishRadius*poleStopFactor);
+    }
   points.emplace_back(-poleSquareWidth*0.5, poleSquareStartRadius);
   // add bottom right quadrant - miss out first point so don't reach apex.
   // required start index is of course size()-1 also.
@@ -542,7 +566,10 @@ void BDSMagnetOuterFactoryPolesBase::CreateYokeAndContainerSolid(const G4String&
 void BDSMagnetOuterFactoryPolesBase::IntersectPoleWithYoke(const G4String& name,
                                                            G4double      /*length*/,
                                                            G4int         /*order*/)
-{ 
+{
+  if (poleMatchesYoke)
+    {return;} // already built to fit inside the yoke
+  
   // cut pole here with knowledge of yoke shape.
   poleSolid = new G4IntersectionSolid(name + "_pole_solid",   // name
                                       poleSolid,              // solid a
@@ -24,6 +24,10 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4Colour.hh"
 #include "G4Material.hh"
 
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
 BDSMagnetOuterInfo::BDSMagnetOuterInfo():
   name("not_specified"),
   geometryType(BDSMagnetGeometryType::cylindrical),
@@ -77,3 +81,22 @@ BDSMagnetOuterInfo::BDSMagnetOuterInfo(const G4String&         nameIn,
   colour(colourIn),
   autoColour(autoColourIn)
 {;}
+
+G4String BDSMagnetOuterInfo::GeometryKey() const
+{
+  std::ostringstream key;
+  key << std::setprecision(std::numeric_limits<G4double>::max_digits10);
+  key << geometryType.ToString() << "|"
+      << horizontalWidth << "|"
+      << (outerMaterial ? outerMaterial->GetName() : "none") << "|"
+      << innerRadius << "|" << vhRatio << "|"
+      << angleIn << "|" << angleOut << "|"
+      << yokeOnLeft << hStyle << buildEndPieces << autoColour << "|"
+      << coilWidthFraction << "|" << coilHeightFraction << "|"
+      << geometryTypeAndPath << "|";
+  if (colour)
+    {key << colour->GetRed() << "," << colour->GetGreen() << "," << colour->GetBlue() << "," << colour->GetAlpha();}
+  else
+    {key << "none";}
+  return G4String(key.str());
+}
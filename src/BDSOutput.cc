@@ -56,6 +56,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSParticleDefinition.hh"
 #include "BDSPrimaryVertexInformation.hh"
 #include "BDSPrimaryVertexInformationV.hh"
+#include "BDSScorerBuffer.hh"
 #include "BDSScorerHistogramDef.hh"
 #include "BDSSDManager.hh"
 #include "BDSStackingAction.hh"
@@ -87,6 +88,31 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+namespace {
+  /// Call fill(index, value) for each cell of a scorer hits collection. The
+  /// BDSIM scorers keep a buffer where only the cells used in the event are
+  /// visited, otherwise it is a G4THitsMap from a Geant4 scorer.
+  template <typename F>
+  void ForEachScorerHit(const G4VHitsCollection* collection, F fill)
+  {
+    if (const auto bufferCollection = dynamic_cast<const BDSScorerBufferCollection*>(collection))
+      {
+        const BDSScorerBuffer* buffer = bufferCollection->Buffer();
+        for (G4int index : buffer->Touched())
+          {fill(index, buffer->Value(index));}
+      }
+    else if (const auto hitMap = dynamic_cast<const G4THitsMap<G4double>*>(collection))
+      {
+#if G4VERSION < 1039
+        for (const auto& hit : *hitMap->GetMap())
+#else
+        for (const auto& hit : *hitMap)
+#endif
+          {fill(hit.first, *hit.second);}
+      }
+  }
+}
+
 const std::set<G4String> BDSOutput::protectedNames = {
   "Event", "Histos", "Info", "Primary", "PrimaryGlobal",
   "Eloss", "ElossVacuum", "ElossTunnel", "ElossWorld", "ElossWorldExit",
@@ -313,7 +339,7 @@ void BDSOutput::FillEvent(const BDSEventInfo*                            info,
                           const BDSTrajectoriesToStore*                  trajectories,
                           const BDSHitsCollectionCollimator*             collimatorHits,
                           const BDSHitsCollectionApertureImpacts*        apertureImpactHits,
-                          const std::map<G4String, G4THitsMap<G4double>*>& scorerHits,
+                          const std::map<G4String, G4VHitsCollection*>& scorerHits,
                           const G4int                                    turnsTaken)
 {
   // Clear integrals in this class -> here instead of BDSOutputStructures as
@@ -1124,15 +1150,11 @@ void BDSOutput::FillApertureImpacts(const BDSHitsCollectionApertureImpacts* hits
     }
 }
 
-void BDSOutput::FillScorerHits(const std::map<G4String, G4THitsMap<G4double>*>& scorerHitsMap)
+void BDSOutput::FillScorerHits(const std::map<G4String, G4VHitsCollection*>& scorerHitsMap)
 {
   for (const auto& nameHitsMap : scorerHitsMap)
     {
-#if G4VERSION < 1039
       if (nameHitsMap.second->GetSize() == 0)
-#else
-      if (nameHitsMap.second->size() == 0)
-#endif
 #ifdef BDSDEBUG
         {G4cout << nameHitsMap.first << " empty" << G4endl; continue;}
 #else
@@ -1143,7 +1165,7 @@ void BDSOutput::FillScorerHits(const std::map<G4String, G4THitsMap<G4double>*>&
 }
 
 void BDSOutput::FillScorerHitsIndividual(const G4String& histogramDefName,
-                                         const G4THitsMap<G4double>* hitMap)
+                                         const G4VHitsCollection* hitMap)
 {
   if (BDS::StrContains(histogramDefName, "blm_"))
     {return FillScorerHitsIndividualBLM(histogramDefName, hitMap);}
@@ -1156,17 +1178,13 @@ void BDSOutput::FillScorerHitsIndividual(const G4String& histogramDefName,
       const BDSHistBinMapper& mapper = scorerCoordinateMaps.at(histogramDefName);
       TH3D* hist = evtHistos->Get3DHistogram(histIndex);
       G4int x,y,z,e;
-#if G4VERSION < 1039
-      for (const auto& hit : *hitMap->GetMap())
-#else
-      for (const auto& hit : *hitMap)
-#endif
+      ForEachScorerHit(hitMap, [&](G4int index, G4double value)
         {
           // convert from scorer global index to 3d i,j,k index of 3d scorer
-          mapper.IJKLFromGlobal(hit.first, x,y,z,e);
+          mapper.IJKLFromGlobal(index, x,y,z,e);
           G4int rootGlobalIndex = (hist->GetBin(x + 1, y + 1, z + 1)); // convert to root system (add 1 to avoid underflow bin)
-          evtHistos->Set3DHistogramBinContent(histIndex, rootGlobalIndex, *hit.second / unit);
-        }
+          evtHistos->Set3DHistogramBinContent(histIndex, rootGlobalIndex, value / unit);
+        });
       runHistos->AccumulateHistogram3D(histIndex, evtHistos->Get3DHistogram(histIndex));
     }
   
@@ -1177,37 +1195,29 @@ void BDSOutput::FillScorerHitsIndividual(const G4String& histogramDefName,
       // avoid using [] operator for map as we have no default constructor for BDSHistBinMapper3D
       const BDSHistBinMapper& mapper = scorerCoordinateMaps.at(histogramDefName);
       G4int x,y,z,e;
-#if G4VERSION < 1039
-      for (const auto& hit : *hitMap->GetMap())
-#else
-      for (const auto& hit : *hitMap)
-#endif
+      ForEachScorerHit(hitMap, [&](G4int index, G4double value)
         {
           // convert from scorer global index to 4d i,j,k,e index of 4d scorer
-          mapper.IJKLFromGlobal(hit.first, x,y,z,e);
-          evtHistos->Set4DHistogramBinContent(histIndex, x, y, z, e - 1, *hit.second / unit); // - 1 to go back to the Boost Histogram indexing (-1 for the underflow bin)
-        }
+          mapper.IJKLFromGlobal(index, x,y,z,e);
+          evtHistos->Set4DHistogramBinContent(histIndex, x, y, z, e - 1, value / unit); // - 1 to go back to the Boost Histogram indexing (-1 for the underflow bin)
+        });
       runHistos->AccumulateHistogram4D(histIndex, evtHistos->Get4DHistogram(histIndex));
     }
 }
 
 void BDSOutput::FillScorerHitsIndividualBLM(const G4String& histogramDefName,
-                                            const G4THitsMap<G4double>* hitMap)
+                                            const G4VHitsCollection* hitMap)
 {
   G4int histIndex = blmCollectionNameToHistogramID[histogramDefName];
-#if G4VERSION < 1039
-  for (const auto& hit : *hitMap->GetMap())
-#else
-  for (const auto& hit : *hitMap)
-#endif
+  G4double unit = BDS::MapGetWithDefault(histIndexToUnits1D, histIndex, 1.0);
+  ForEachScorerHit(hitMap, [&](G4int index, G4double value)
     {
 #ifdef BDSDEBUG
-      G4cout << "Filling hist " << histIndex << ", bin: " << hit.first+1 << " value: " << *hit.second << G4endl;
+      G4cout << "Filling hist " << histIndex << ", bin: " << index+1 << " value: " << value << G4endl;
 #endif
-      G4double unit = BDS::MapGetWithDefault(histIndexToUnits1D, histIndex, 1.0);
-      evtHistos->Fill1DHistogram(histIndex,hit.first, *hit.second / unit);
-      runHistos->Fill1DHistogram(histIndex,hit.first, *hit.second / unit);
-    }
+      evtHistos->Fill1DHistogram(histIndex, index, value / unit);
+      runHistos->Fill1DHistogram(histIndex, index, value / unit);
+    });
 }
 
 void BDSOutput::FillRunInfoAndUpdateHeader(const BDSEventInfo* info,
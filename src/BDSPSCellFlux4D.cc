@@ -18,6 +18,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
 #include "BDSPSCellFlux4D.hh"
 #include "BDSHistBinMapper.hh"
+#include "BDSScorerBuffer.hh"
 
 #ifdef USE_BOOST
 #include <boost/variant.hpp>
@@ -25,14 +26,21 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <iostream>
 
+#include "G4HCofThisEvent.hh"
+#include "G4Step.hh"
 #include "G4String.hh"
+#include "G4TouchableHistory.hh"
 #include "G4Types.hh"
+#include "G4VSensitiveDetector.hh"
 
 BDSPSCellFlux4D::BDSPSCellFlux4D(const G4String&         name,
 				 const BDSHistBinMapper* mapperIn,
 				 G4int ni,   G4int nj,   G4int nk,
 				 G4int depi, G4int depj, G4int depk):
   G4PSCellFlux3D(name,ni,nj,nk,depi,depj,depk),
+  HCID(-1),
+  buffer(nullptr),
+  weighted(true),
   fDepthi(depi),
   fDepthj(depj),
   fDepthk(depk),
@@ -45,12 +53,67 @@ BDSPSCellFlux4D::BDSPSCellFlux4D(const G4String&         name,
 				 G4int ni,   G4int nj,   G4int nk,
 				 G4int depi, G4int depj, G4int depk):
   G4PSCellFlux3D(name, unit, ni, nj, nk, depi, depj, depk),
+  HCID(-1),
+  buffer(nullptr),
+  weighted(true),
   fDepthi(depi),
   fDepthj(depj),
   fDepthk(depk),
   mapper(mapperIn)
 {;}
 
+BDSPSCellFlux4D::~BDSPSCellFlux4D()
+{
+  delete buffer;
+}
+
+void BDSPSCellFlux4D::Initialize(G4HCofThisEvent* HCE)
+{
+  if (!buffer)
+    {
+      G4int nCells = (G4int)(mapper->NBinsI() * mapper->NBinsJ() * mapper->NBinsK() * mapper->NBinsL());
+      buffer = new BDSScorerBuffer(nCells);
+    }
+  buffer->Clear();
+  if (HCID < 0)
+    {HCID = GetCollectionID(0);}
+  HCE->AddHitsCollection(HCID, new BDSScorerBufferCollection(detector->GetName(), GetName(), buffer));
+}
+
+void BDSPSCellFlux4D::clear()
+{
+  if (buffer)
+    {buffer->Clear();}
+}
+
+void BDSPSCellFlux4D::PrintAll()
+{
+  G4cout << " MultiFunctionalDet  " << detector->GetName() << G4endl;
+  G4cout << " PrimitiveScorer " << GetName() << G4endl;
+  if (!buffer)
+    {return;}
+  G4cout << " Number of entries " << buffer->Touched().size() << G4endl;
+  for (G4int index : buffer->Touched())
+    {G4cout << "  copy no.: " << index << "  cell flux : " << buffer->Value(index) / GetUnitValue() << " [" << GetUnit() << "]" << G4endl;}
+}
+
+G4bool BDSPSCellFlux4D::ProcessHits(G4Step* aStep, G4TouchableHistory*)
+{
+  // as G4PSCellFlux::ProcessHits but filling the buffer
+  G4double stepLength = aStep->GetStepLength();
+  if (stepLength == 0)
+    {return false;}
+
+  const G4VTouchable* touchable = aStep->GetPreStepPoint()->GetTouchable();
+  G4int replicaIndex = touchable->GetReplicaNumber(indexDepth);
+  G4double cellFlux = stepLength / ComputeVolume(aStep, replicaIndex);
+  if (weighted)
+    {cellFlux *= aStep->GetPreStepPoint()->GetWeight();}
+
+  buffer->Add(GetIndex(aStep), cellFlux);
+  return true;
+}
+
 G4int BDSPSCellFlux4D::GetIndex(G4Step* aStep)
 {
   const G4VTouchable* touchable = aStep->GetPreStepPoint()->GetTouchable();
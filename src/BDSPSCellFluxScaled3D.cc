@@ -19,11 +19,13 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSDebug.hh"
 #include "BDSException.hh"
 #include "BDSHistBinMapper.hh"
+#include "BDSScorerBuffer.hh"
 #include "BDSScorerConversionLoader.hh"
 #include "BDSPSCellFluxScaled3D.hh"
 #include "BDSUtilities.hh"
 
 #include "G4PhysicsVector.hh"
+#include "G4HCofThisEvent.hh"
 #include "G4String.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4Types.hh"
@@ -50,7 +52,7 @@ BDSPSCellFluxScaled3D::BDSPSCellFluxScaled3D(const G4String&         scorerName,
                                              G4int depk):
   G4VPrimitiveScorer(scorerName),
   HCID3D(-1),
-  evtMap3D(nullptr),
+  buffer(nullptr),
   fDepthi(depi),fDepthj(depj),fDepthk(depk),
   conversionFactor(nullptr),
   mapper(mapperIn)
@@ -97,6 +99,7 @@ BDSPSCellFluxScaled3D::BDSPSCellFluxScaled3D(const G4String&         scorerName,
 BDSPSCellFluxScaled3D::~BDSPSCellFluxScaled3D()
 {
   delete conversionFactor;
+  delete buffer;
 }
 
 G4bool BDSPSCellFluxScaled3D::ProcessHits(G4Step* aStep, G4TouchableHistory*)
@@ -128,7 +131,7 @@ G4bool BDSPSCellFluxScaled3D::ProcessHits(G4Step* aStep, G4TouchableHistory*)
   radiationQuantity = cellFlux * factor;
   G4int index = GetIndex(aStep);
 
-  evtMap3D->add(index, radiationQuantity);
+  buffer->Add(index, radiationQuantity);
   return true;
 }
 
@@ -140,11 +143,15 @@ G4double BDSPSCellFluxScaled3D::GetConversionFactor(G4int  /*particleID*/,
 
 void BDSPSCellFluxScaled3D::Initialize(G4HCofThisEvent* HCE)
 {
-  evtMap3D = new G4THitsMap<G4double>(detector->GetName(),
-				      GetName());
+  if (!buffer)
+    {
+      G4int nCells = (G4int)(mapper->NBinsI() * mapper->NBinsJ() * mapper->NBinsK() * mapper->NBinsL());
+      buffer = new BDSScorerBuffer(nCells);
+    }
+  buffer->Clear();
   if (HCID3D < 0)
     {HCID3D = GetCollectionID(0);}
-  HCE->AddHitsCollection(HCID3D, evtMap3D);
+  HCE->AddHitsCollection(HCID3D, new BDSScorerBufferCollection(detector->GetName(), GetName(), buffer));
 }
 
 void BDSPSCellFluxScaled3D::EndOfEvent(G4HCofThisEvent* /*HEC*/)
@@ -152,7 +159,8 @@ void BDSPSCellFluxScaled3D::EndOfEvent(G4HCofThisEvent* /*HEC*/)
 
 void BDSPSCellFluxScaled3D::clear()
 {
-  evtMap3D->clear();
+  if (buffer)
+    {buffer->Clear();}
 }
 
 G4int BDSPSCellFluxScaled3D::GetIndex(G4Step* aStep)
@@ -29,11 +29,15 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <fstream>
+#include <numeric>
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
 				   const BDSParticleDefinition* designParticle):
@@ -44,7 +48,8 @@ BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
   pxLastTurn(0),
   yLastTurn(0),
   pyLastTurn(0),
-  deltaPLastTurn(0)
+  deltaPLastTurn(0),
+  powerTableOffset{0, 0, 0, 0, 0}
 {
   referenceMomentum = designParticle->Momentum();
   mass = designParticle->Mass();
@@ -80,30 +85,81 @@ BDSPTCOneTurnMap::BDSPTCOneTurnMap(const G4String& maptableFile,
 
       PTCMapTerm term{coefficient, nx, npx, ny, npy, ndeltaP};
 
-      switch (nVector)
-	{
-	case 1:
-	  {xTerms.push_back(term); break;}
-	case 2:
-	  {pxTerms.push_back(term); break;}
-	case 3:
-	  {yTerms.push_back(term);  break;}
-	case 4:
-	  {pyTerms.push_back(term); break;}
-	case 5:
-	  {deltaPTerms.push_back(term); break;}
-	default:
-	  {
-	    throw BDSException(__METHOD_NAME__, "Unrecognised PTC term index - maptable file is perhaps malformed.");
-	    break;
-	  }
-	}
+      // nVector is 1 to 5 for x, px, y, py, deltaP
+      if (nVector < 1 || nVector > 5)
+	{throw BDSException(__METHOD_NAME__, "Unrecognised PTC term index - maptable file is perhaps malformed.");}
+      if (nx < 0 || npx < 0 || ny < 0 || npy < 0 || ndeltaP < 0)
+	{throw BDSException(__METHOD_NAME__, "Negative PTC term power - maptable file is perhaps malformed.");}
+      AddTerm(term, nVector - 1);
     }
+
+  CompileMap();
 #ifdef BDSDEBUG
       G4cout << __METHOD_NAME__ << "> Loaded Map:" << maptableFile << G4endl;
 #endif
 }
 
+void BDSPTCOneTurnMap::AddTerm(const PTCMapTerm& term,
+			       G4int             outputIndex)
+{
+  monomialPowers.push_back({term.nx, term.npx, term.ny, term.npy, term.ndeltaP});
+  std::array<G4double, 5> coefficients = {0, 0, 0, 0, 0};
+  coefficients[outputIndex] = term.coefficient;
+  monomialCoefficients.insert(monomialCoefficients.end(), coefficients.begin(), coefficients.end());
+}
+
+void BDSPTCOneTurnMap::CompileMap()
+{
+  // sort the monomials by their powers so that neighbours share leading powers
+  std::vector<std::size_t> order(monomialPowers.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+		   [&](std::size_t a, std::size_t b){return monomialPowers[a] < monomialPowers[b];});
+
+  // merge the terms for all outputs with the same powers into one monomial
+  std::vector<std::array<G4int, 5> > powers;
+  std::vector<G4double> coefficients;
+  for (auto i : order)
+    {
+      if (powers.empty() || powers.back() != monomialPowers[i])
+	{
+	  powers.push_back(monomialPowers[i]);
+	  coefficients.insert(coefficients.end(), 5, 0.0);
+	}
+      G4double* row = coefficients.data() + coefficients.size() - 5;
+      for (G4int j = 0; j < 5; j++)
+	{row[j] += monomialCoefficients[5*i + j];}
+    }
+  monomialPowers       = std::move(powers);
+  monomialCoefficients = std::move(coefficients);
+
+  // the products of the powers of variables before the first one that differs
+  // from the previous monomial are still valid and are not recalculated
+  firstNewVariable.resize(monomialPowers.size());
+  for (std::size_t i = 0; i < monomialPowers.size(); i++)
+    {
+      G4int first = 0;
+      if (i > 0)
+	{
+	  while (first < 5 && monomialPowers[i][first] == monomialPowers[i-1][first])
+	    {first++;}
+	}
+      firstNewVariable[i] = first;
+    }
+
+  // power tables up to the highest power of each variable
+  G4int offset = 0;
+  for (G4int v = 0; v < 5; v++)
+    {
+      G4int maxPower = 0;
+      for (const auto& p : monomialPowers)
+	{maxPower = std::max(maxPower, p[v]);}
+      powerTableOffset[v] = offset;
+      offset += maxPower + 1;
+    }
+  powerTable.resize(offset);
+}
+
 void BDSPTCOneTurnMap::SetInitialPrimaryCoordinates(const BDSParticleCoordsFullGlobal& coords,
 						    G4bool beamOffsetS0In)
 {
@@ -160,26 +216,13 @@ void BDSPTCOneTurnMap::GetThisTurn(G4double& x,
 #endif
 
       lastTurnNumber = turnsTaken;
-      xOut = Evaluate(xTerms,
-		      xLastTurn, pxLastTurn,
-		      yLastTurn, pyLastTurn,
-		      deltaPLastTurn);
-      pxOut = Evaluate(pxTerms,
-		       xLastTurn, pxLastTurn,
-		       yLastTurn, pyLastTurn,
-		       deltaPLastTurn);
-      yOut = Evaluate(yTerms,
-		      xLastTurn, pxLastTurn,
-		      yLastTurn, pyLastTurn,
-		      deltaPLastTurn);
-      pyOut = Evaluate(pyTerms,
-		       xLastTurn, pxLastTurn,
-		       yLastTurn, pyLastTurn,
-		       deltaPLastTurn);
-      deltaPOut = Evaluate(deltaPTerms,
-			   xLastTurn, pxLastTurn,
-			   yLastTurn, pyLastTurn,
-			   deltaPLastTurn);
+      PTCCoordinates coords = {xLastTurn, pxLastTurn, yLastTurn, pyLastTurn, deltaPLastTurn};
+      Evaluate(coords, coords);
+      xOut      = coords[0];
+      pxOut     = coords[1];
+      yOut      = coords[2];
+      pyOut     = coords[3];
+      deltaPOut = coords[4];
       // Cache results for next turn.  Do it here, before we convert to BDSIM coordinates.
       xLastTurn      = xOut;
       pxLastTurn     = pxOut;
@@ -244,24 +287,34 @@ void BDSPTCOneTurnMap::GetThisTurn(G4double& x,
 #endif
 }
 
-G4double BDSPTCOneTurnMap::Evaluate(std::vector<PTCMapTerm>& terms,
-				    G4double x,
-                                    G4double px,
-				    G4double y,
-				    G4double py,
-                                    G4double deltaP) const
+void BDSPTCOneTurnMap::Evaluate(const PTCCoordinates& in,
+				PTCCoordinates&       out)
 {
-  G4double result = 0;
-  for (const auto& term : terms)
+  // power tables by repeated multiplication
+  for (G4int v = 0; v < 5; v++)
+    {
+      G4double* table = powerTable.data() + powerTableOffset[v];
+      G4int nPowers = (v < 4 ? powerTableOffset[v+1] : (G4int)powerTable.size()) - powerTableOffset[v];
+      table[0] = 1.0;
+      for (G4int n = 1; n < nPowers; n++)
+	{table[n] = table[n-1] * in[v];}
+    }
+
+  // partial[k] is the product of the powers of the first k variables
+  G4double partial[6] = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+  G4double result[5]  = {0, 0, 0, 0, 0};
+  const G4double* coefficients = monomialCoefficients.data();
+  for (std::size_t i = 0; i < monomialPowers.size(); i++, coefficients += 5)
     {
-      result += (term.coefficient
-		 * std::pow(x, term.nx)
-		 * std::pow(px, term.npx)
-		 * std::pow(y, term.ny)
-		 * std::pow(py, term.npy)
-		 * std::pow(deltaP, term.ndeltaP));
+      const std::array<G4int, 5>& powers = monomialPowers[i];
+      for (G4int v = firstNewVariable[i]; v < 5; v++)
+	{partial[v+1] = partial[v] * powerTable[powerTableOffset[v] + powers[v]];}
+      const G4double monomial = partial[5];
+      for (G4int j = 0; j < 5; j++)
+	{result[j] += coefficients[j] * monomial;}
     }
-  return result;
+  for (G4int j = 0; j < 5; j++)
+    {out[j] = result[j];}
 }
 
 G4bool BDSPTCOneTurnMap::ShouldApplyToPrimary(G4double momentum,
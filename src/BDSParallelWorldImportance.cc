@@ -32,15 +32,19 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4PVPlacement.hh"
 #include "G4VisAttributes.hh"
 #include "G4VPhysicalVolume.hh"
+#include "G4WeightWindowStore.hh"
 
 #ifdef USE_GZSTREAM
 #include "src-external/gzstream/gzstream.h"
 #endif
 
+#include <cfloat>
 #include <iomanip>
 #include <map>
+#include <set>
 #include <string>
 #include <fstream>
+#include <vector>
 
 BDSParallelWorldImportance::BDSParallelWorldImportance(G4String name,
                                                        G4String importanceWorldGeometryFile,
@@ -57,6 +61,21 @@ BDSParallelWorldImportance::BDSParallelWorldImportance(G4String name,
 #ifdef BDSDEBUG
   verbosity  = 10;
 #endif
+
+  // energy boundaries between weight windows in GeV - the last window is always open ended
+  G4String energyBounds = BDSGlobalConstants::Instance()->WeightWindowEnergyBounds();
+  for (const auto& bound : BDS::SplitOnWhiteSpace(energyBounds))
+    {
+      G4double value = 0;
+      try
+        {value = std::stod(bound);}
+      catch (...)
+        {throw BDSException(__METHOD_NAME__, "weightWindowEnergyBounds value \"" + bound + "\" is not numeric.");}
+      if (value <= 0)
+        {throw BDSException(__METHOD_NAME__, "weightWindowEnergyBounds values must be greater than 0.");}
+      weightWindowUpperEnergyBounds.insert(value*CLHEP::GeV);
+    }
+  weightWindowUpperEnergyBounds.insert(DBL_MAX);
 }
 
 void BDSParallelWorldImportance::Construct()
@@ -157,11 +176,17 @@ void BDSParallelWorldImportance::AddIStore()
   // set importance values
   for (const auto& cell : imVolumeStore)
     {
-      G4String cellName        = cell.GetPhysicalVolume().GetName();
-      G4double importanceValue = GetCellImportanceValue(cellName);
+      G4String cellName = cell.GetPhysicalVolume().GetName();
+      std::vector<G4double> importanceValues = GetCellImportanceValues(cellName);
+      if (importanceValues.size() > 1)
+        {
+          G4String message = "More than one importance value for cell \"" + cellName + "\" - multiple values\n";
+          message += "(one per energy window) are only permitted with the option useWeightWindows.";
+          throw BDSException(__METHOD_NAME__, message);
+        }
 
       if (!aIstore->IsKnown(cell))
-        {aIstore->AddImportanceGeometryCell(importanceValue, cell.GetPhysicalVolume(), 0);}
+        {aIstore->AddImportanceGeometryCell(importanceValues[0], cell.GetPhysicalVolume(), 0);}
       else
         {
           G4String message = "Geometry cell \"" + cellName + "\" already exists and has been previously\n";
@@ -170,18 +195,69 @@ void BDSParallelWorldImportance::AddIStore()
         }
     }
 
+  PrintCells();
+}
+
+void BDSParallelWorldImportance::AddWeightWindowStore()
+{
+  G4WeightWindowStore* wwStore = G4WeightWindowStore::GetInstance(imWorldPV->GetName());
+  wwStore->SetGeneralUpperEnergyBounds(weightWindowUpperEnergyBounds);
+  std::size_t nWindows = weightWindowUpperEnergyBounds.size();
+
+  // world volume has importance 1 and therefore a lower weight bound of 1 in all windows
+  G4GeometryCell gWorldVolumeCell(*imWorldPV, 0);
+  wwStore->AddLowerWeights(gWorldVolumeCell, std::vector<G4double>(nWindows, 1.0));
+
+  for (const auto& cell : imVolumeStore)
+    {
+      G4String cellName = cell.GetPhysicalVolume().GetName();
+      std::vector<G4double> importanceValues = GetCellImportanceValues(cellName);
+      if (importanceValues.size() == 1)
+        {importanceValues.resize(nWindows, importanceValues[0]);}
+      else if (importanceValues.size() != nWindows)
+        {
+          G4String message = "Cell \"" + cellName + "\" has " + std::to_string(importanceValues.size());
+          message += " importance values but there are " + std::to_string(nWindows) + " energy windows.";
+          throw BDSException(__METHOD_NAME__, message);
+        }
+
+      if (wwStore->IsKnown(cell))
+        {
+          G4String message = "Geometry cell \"" + cellName + "\" already exists and has been previously\n";
+          message += "added to the weight window store.";
+          throw BDSException(__METHOD_NAME__, message);
+        }
+
+      // a particle's weight is inversely proportional to the importance of the region it is in
+      std::vector<G4double> lowerWeights;
+      lowerWeights.reserve(nWindows);
+      for (auto importanceValue : importanceValues)
+        {lowerWeights.push_back(1.0 / importanceValue);}
+      wwStore->AddLowerWeights(cell, lowerWeights);
+    }
+
+  PrintCells();
+}
+
+void BDSParallelWorldImportance::PrintCells() const
+{
   // feedback - user controllable
   if (verbosity > 0)
     {
       auto flagsCache(G4cout.flags());
       G4cout << imVolumeStore;
       for (const auto& cellAndImportance : imVolumesAndValues)
-	{G4cout << std::left << std::setw(25) << cellAndImportance.first << " " << cellAndImportance.second << G4endl;}
+        {
+          G4cout << std::left << std::setw(25) << cellAndImportance.first;
+          for (auto importanceValue : cellAndImportance.second)
+            {G4cout << " " << importanceValue;}
+          G4cout << G4endl;
+        }
       G4cout.flags(flagsCache);
     }
 }
 
-G4double BDSParallelWorldImportance::GetCellImportanceValue(const G4String& cellName)
+std::vector<G4double> BDSParallelWorldImportance::GetCellImportanceValues(const G4String& cellName)
 {
   // strip off the prepended componentName that we introduce in the geometry factory
   // this is controlled by the member variable of this class above
@@ -210,19 +286,21 @@ G4double BDSParallelWorldImportance::GetCellImportanceValue(const G4String& cell
   auto result = imVolumesAndValues.find(pureCellName);
   if (result != imVolumesAndValues.end())
     {
-      G4double importanceValue = (*result).second;
-      // importance value must be finite and positive.
-      if (importanceValue < 0)
+      // importance values must be finite and positive.
+      for (auto importanceValue : (*result).second)
         {
-          G4String message = "Importance value is negative for cell \"" + pureCellName + "\".";
-          throw BDSException(__METHOD_NAME__, message);
-        }
-      else if (!BDS::IsFinite(importanceValue))
-        {
-          G4String message = "Importance value is zero for cell \"" + pureCellName + "\".";
-          throw BDSException(__METHOD_NAME__, message);
+          if (importanceValue < 0)
+            {
+              G4String message = "Importance value is negative for cell \"" + pureCellName + "\".";
+              throw BDSException(__METHOD_NAME__, message);
+            }
+          else if (!BDS::IsFinite(importanceValue))
+            {
+              G4String message = "Importance value is zero for cell \"" + pureCellName + "\".";
+              throw BDSException(__METHOD_NAME__, message);
+            }
         }
-      return importanceValue;
+      return (*result).second;
     }
   else
     {
@@ -40,9 +40,12 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ImportanceBiasing.hh"
 #include "G4IStore.hh"
 #include "G4ParallelWorldPhysics.hh"
+#include "G4PlaceOfAction.hh"
 #include "G4VModularPhysicsList.hh"
 #include "G4VUserDetectorConstruction.hh"
 #include "G4VUserParallelWorld.hh"
+#include "G4WeightWindowAlgorithm.hh"
+#include "G4WeightWindowBiasing.hh"
 
 #include "globals.hh"
 
@@ -175,21 +178,50 @@ void BDS::AddIStore(const std::vector<G4VUserParallelWorld*>& worlds)
   {
     BDSParallelWorldImportance* importanceWorld = BDS::GetImportanceSamplingWorld(worlds);
     //only add importance store if the world exists
-    if (importanceWorld)
-      {importanceWorld->AddIStore();}
-    else
+    if (!importanceWorld)
       {throw BDSException(__METHOD_NAME__, "Importance sampling world not found.");}
+    if (BDSGlobalConstants::Instance()->UseWeightWindows())
+      {importanceWorld->AddWeightWindowStore();}
+    else
+      {importanceWorld->AddIStore();}
   }
 
 void BDS::RegisterImportanceBiasing(const std::vector<G4VUserParallelWorld*>& worlds,
                     G4VModularPhysicsList* physList)
 {
   BDSParallelWorldImportance* importanceWorld = BDS::GetImportanceSamplingWorld(worlds);
+  const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+
+  std::vector<G4String> particleNames = BDS::SplitOnWhiteSpace(globals->ImportanceParticles());
+  if (particleNames.empty())
+    {throw BDSException(__METHOD_NAME__, "no particles specified in option importanceParticles.");}
 
-  // create world geometry sampler
-  G4GeometrySampler* pgs = new G4GeometrySampler(importanceWorld->GetWorldVolume(), "neutron");
-  pgs->SetParallel(true);
-  physList->RegisterPhysics(new G4ImportanceBiasing(pgs,importanceWorld->GetName()));
+  // one weight window algorithm shared by all particles
+  G4WeightWindowAlgorithm* wwAlgorithm = nullptr;
+  if (globals->UseWeightWindows())
+    {
+      G4double upperLimitFactor = globals->WeightWindowUpperLimitFactor();
+      G4double survivalFactor   = globals->WeightWindowSurvivalFactor();
+      G4int    maximumSplits    = globals->WeightWindowMaximumSplits();
+      if (survivalFactor < 1)
+        {throw BDSException(__METHOD_NAME__, "weightWindowSurvivalFactor must be >= 1.");}
+      if (upperLimitFactor <= survivalFactor)
+        {throw BDSException(__METHOD_NAME__, "weightWindowUpperLimitFactor must be greater than weightWindowSurvivalFactor.");}
+      if (maximumSplits < 1)
+        {throw BDSException(__METHOD_NAME__, "weightWindowMaximumSplits must be >= 1.");}
+      wwAlgorithm = new G4WeightWindowAlgorithm(upperLimitFactor, survivalFactor, maximumSplits);
+    }
+
+  // create a world geometry sampler for each particle species to be biased
+  for (const auto& particleName : particleNames)
+    {
+      G4GeometrySampler* pgs = new G4GeometrySampler(importanceWorld->GetWorldVolume(), particleName);
+      pgs->SetParallel(true);
+      if (wwAlgorithm)
+        {physList->RegisterPhysics(new G4WeightWindowBiasing(pgs, wwAlgorithm, onBoundary, importanceWorld->GetName()));}
+      else
+        {physList->RegisterPhysics(new G4ImportanceBiasing(pgs, importanceWorld->GetName()));}
+    }
 }
 
 BDSParallelWorldImportance* BDS::GetImportanceSamplingWorld(const std::vector<G4VUserParallelWorld*>& worlds)
@@ -16,14 +16,20 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSAcceleratorModel.hh"
+#include "BDSBeamline.hh"
+#include "BDSBeamlineElement.hh"
 #include "BDSBunch.hh"
 #include "BDSDebug.hh"
 #include "BDSEventInfo.hh"
 #include "BDSException.hh"
 #include "BDSExtent.hh"
+#include "BDSFastTracker.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSIonDefinition.hh"
 #include "BDSOutputLoader.hh"
+#include "BDSParticleCoords.hh"
+#include "BDSParticleCoordsFullGlobal.hh"
 #include "BDSParticleDefinition.hh"
 #include "BDSPhysicsUtilities.hh"
 #include "BDSPrimaryGeneratorAction.hh"
@@ -38,6 +44,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "parser/beam.h"
 
 #include "CLHEP/Random/Random.h"
+#include "CLHEP/Units/PhysicalConstants.h"
 
 #include "globals.hh" // geant4 types / globals
 #include "G4Event.hh"
@@ -48,6 +55,11 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "G4ParticleDefinition.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
+#include "G4ThreeVector.hh"
+#include "G4Transform3D.hh"
+
+#include <algorithm>
+#include <cmath>
 
 BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
                                                      const GMAD::Beam& beam,
@@ -55,11 +67,14 @@ BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
   bunch(bunchIn),
   recreateFile(nullptr),
   eventOffset(0),
+  seedPerEvent(false),
   ionPrimary(false),
   distrFileMatchLength(beam.distrFileMatchLength),
   ionCached(false),
   oneTurnMap(nullptr),
-  generatorFromFile(nullptr)
+  generatorFromFile(nullptr),
+  fastTrackPrimaries(false),
+  fastTracker(nullptr)
 {
   if (!bunchIn)
     {throw BDSException(__METHOD_NAME__, "valid BDSBunch required");}
@@ -70,6 +85,7 @@ BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
   writeASCIISeedState = BDSGlobalConstants::Instance()->WriteSeedState();
   recreate            = BDSGlobalConstants::Instance()->Recreate();
   useASCIISeedState   = BDSGlobalConstants::Instance()->UseASCIISeedState();
+  seedPerEvent        = BDSGlobalConstants::Instance()->SeedPerEvent();
 
   if (recreate)
     {
@@ -83,6 +99,14 @@ BDSPrimaryGeneratorAction::BDSPrimaryGeneratorAction(BDSBunch*         bunchIn,
   particleGun->SetParticleTime(0);
   
   generatorFromFile = BDSPrimaryGeneratorFile::ConstructGenerator(beam, bunch, recreate, eventOffset, batchMode);
+
+  fastTrackPrimaries = BDSGlobalConstants::Instance()->FastTrackPrimaries();
+  if (fastTrackPrimaries && BDSGlobalConstants::Instance()->Circular())
+    {
+      BDS::Warning(__METHOD_NAME__, "fastTrackPrimaries is not possible in a circular machine - turning off");
+      fastTrackPrimaries = false;
+    }
+  fastTrackBatch.Resize(1);
 }
 
 BDSPrimaryGeneratorAction::~BDSPrimaryGeneratorAction()
@@ -90,6 +114,7 @@ BDSPrimaryGeneratorAction::~BDSPrimaryGeneratorAction()
   delete particleGun;
   delete recreateFile;
   delete generatorFromFile;
+  delete fastTracker;
 }
 
 void BDSPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
@@ -105,6 +130,8 @@ void BDSPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
       BDSRandom::SetSeedState(recreateFile->SeedState(thisEventID + eventOffset));
       bunch->CalculateBunchIndex(thisEventID + eventOffset); // correct bunch index
     }
+  else if (seedPerEvent)
+    {BDSRandom::SetSeedForEvent(G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID(), thisEventID);}
 
   // save the seed state in a file to recover potentially unrecoverable events
   if (writeASCIISeedState)
@@ -121,7 +148,10 @@ void BDSPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
   BDSEventInfo* eventInfo = new BDSEventInfo();
   eventInfo->SetBunchIndex(bunch->CurrentBunchIndex());
   anEvent->SetUserInformation(eventInfo);
-  eventInfo->SetSeedStateAtStart(BDSRandom::GetSeedState());
+  if (seedPerEvent && !recreate && !useASCIISeedState)
+    {eventInfo->SetSeedStateAtStart(BDSRandom::EventSeedState(G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID(), thisEventID));}
+  else
+    {eventInfo->SetSeedStateAtStart(BDSRandom::GetSeedState());}
 
   // events from external file
   if (generatorFromFile)
@@ -192,13 +222,16 @@ void BDSPrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
     G4cout << __METHOD_NAME__ << coords << G4endl;
 #endif
 
-  G4ThreeVector PartMomDir(coords.global.xp,coords.global.yp,coords.global.zp);
-  G4ThreeVector PartPosition(coords.global.x,coords.global.y,coords.global.z);
+  // the coordinates Geant4 starts from - the primary coordinates stored in the output are unchanged
+  BDSParticleCoords start = fastTrackPrimaries ? FastTrack(coords) : coords.global;
+
+  G4ThreeVector PartMomDir(start.xp,start.yp,start.zp);
+  G4ThreeVector PartPosition(start.x,start.y,start.z);
 
   particleGun->SetParticlePosition(PartPosition);
   particleGun->SetParticleEnergy(EK);
   particleGun->SetParticleMomentumDirection(PartMomDir);
-  particleGun->SetParticleTime(coords.global.T);
+  particleGun->SetParticleTime(start.T);
 
   particleGun->GeneratePrimaryVertex(anEvent);
 
@@ -260,3 +293,61 @@ void BDSPrimaryGeneratorAction::GeneratePrimariesFromFile(G4Event* anEvent)
       G4EventManager::GetEventManager()->AbortCurrentEvent();
     }
 }
+
+BDSParticleCoords BDSPrimaryGeneratorAction::FastTrack(const BDSParticleCoordsFullGlobal& coords)
+{
+  // only for particles starting at the beginning of the beam line travelling forwards
+  const BDSParticleCoordsFull& local = coords.local;
+  const BDSParticleDefinition* particle = bunch->ParticleDefinition();
+  G4double momentum2 = local.totalEnergy*local.totalEnergy - particle->Mass()*particle->Mass();
+  if (bunch->UseCurvilinearTransform() || BDS::IsFinite(local.z) || local.zp <= 0 || momentum2 <= 0)
+    {return coords.global;}
+
+  if (!fastTracker)
+    {
+      const BDSBeamline* beamline = BDSAcceleratorModel::Instance()->BeamlineMain();
+      if (!beamline)
+        {return coords.global;}
+      fastTracker = new BDSFastTracker(beamline);
+    }
+  if (fastTracker->NElements() == 0)
+    {return coords.global;}
+
+  G4double momentum = std::sqrt(momentum2);
+  fastTrackBatch.x[0]  = local.x;
+  fastTrackBatch.xp[0] = local.xp;
+  fastTrackBatch.y[0]  = local.y;
+  fastTrackBatch.yp[0] = local.yp;
+  fastTrackBatch.T[0]  = coords.global.T;
+  // as eqOfM->FCof() / momentum in BDSIntegratorQuadrupole
+  fastTrackBatch.kappaFactor[0]  = CLHEP::eplus * particle->Charge() * CLHEP::c_light / momentum;
+  fastTrackBatch.velocity[0]     = momentum / local.totalEnergy * CLHEP::c_light;
+  fastTrackBatch.elementIndex[0] = 0;
+
+  fastTracker->Track(fastTrackBatch);
+
+  G4int index = fastTrackBatch.elementIndex[0];
+  if (index == 0)
+    {return coords.global;}
+
+  // hand over at the start of the first element not traversed
+  const BDSBeamline* beamline = fastTracker->Beamline();
+  G4double x = fastTrackBatch.x[0];
+  G4double y = fastTrackBatch.y[0];
+  G4Transform3D transform;
+  if (index < (G4int)beamline->size())
+    {// element is known so no need to look it up by s
+      const BDSBeamlineElement* element = beamline->at(index);
+      transform = beamline->GetGlobalEuclideanTransformInElement(element, element->GetSPositionStart(), x, y);
+    }
+  else
+    {transform = beamline->GetGlobalEuclideanTransform(beamline->GetSMaximum(), x, y);}
+
+  // unit momentum components as in the integrators
+  G4double xp = fastTrackBatch.xp[0];
+  G4double yp = fastTrackBatch.yp[0];
+  G4ThreeVector localMom(xp, yp, std::sqrt(std::max(0.0, 1.0 - xp*xp - yp*yp)));
+  G4ThreeVector globalMom = localMom.transform(transform.getRotation());
+  G4ThreeVector globalPos = transform.getTranslation();
+  return BDSParticleCoords(globalPos, globalMom, fastTrackBatch.T[0]);
+}
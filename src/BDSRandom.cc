@@ -34,6 +34,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "CLHEP/ClhepVersion.h"
 #endif
 
+#include <cstdint>
 #include <ctime>
 #include <map>
 #include <string>
@@ -46,6 +47,40 @@ std::map<BDSRandomEngineType, std::string>* BDSRandomEngineType::dictionary =
 						   {BDSRandomEngineType::mixmax,    "mixmax"}
     });
 
+namespace
+{
+  /// Seed chosen at the start of the run - from the options or the time.
+  long runSeed = 0;
+
+  /// Prefix of the compact per-event seed state.
+  const std::string eventSeedPrefix = "BDSIMEventSeed";
+
+  /// SplitMix64 finaliser - a fast well mixing hash of a 64 bit integer.
+  uint64_t Mix(uint64_t z)
+  {
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  void SeedEngineForEvent(long seed, G4int runID, G4int eventID)
+  {
+    CLHEP::HepRandomEngine* engine = CLHEP::HepRandom::getTheEngine();
+#ifdef CLHEPHASMIXMAX
+    if (auto mixmax = dynamic_cast<CLHEP::MixMaxRng*>(engine))
+      {// independent streams by construction
+	mixmax->seed_uniquestream(0, (uint32_t)seed, (uint32_t)runID, (uint32_t)eventID);
+	return;
+      }
+#endif
+    uint64_t counter = ((uint64_t)(uint32_t)runID << 32) | (uint64_t)(uint32_t)eventID;
+    uint64_t hash = Mix((uint64_t)seed ^ Mix(counter));
+    // HepJamesRandom requires a seed in [0, 900000000)
+    engine->setSeed((long)(hash % 900000000ULL), 0);
+  }
+}
+
 BDSRandomEngineType BDSRandom::DetermineRandomEngineType(G4String engineType)
 {
   std::map<G4String, BDSRandomEngineType> types;
@@ -111,6 +146,7 @@ void BDSRandom::SetSeed()
 #endif
 
   CLHEP::HepRandom::setTheSeed(seed);
+  runSeed = seed;
 
   // feedback - get the seed from the generator itself (ensures set correctly)
   G4cout << __METHOD_NAME__ << "Random number generator's seed = "
@@ -161,10 +197,31 @@ void BDSRandom::LoadSeedState(const G4String& inSeedFilename)
 #endif
 }
 
+void BDSRandom::SetSeedForEvent(G4int runID, G4int eventID)
+{
+  SeedEngineForEvent(runSeed, runID, eventID);
+}
+
+G4String BDSRandom::EventSeedState(G4int runID, G4int eventID)
+{
+  return eventSeedPrefix + " " + std::to_string(runSeed) + " " + std::to_string(runID) + " " + std::to_string(eventID);
+}
+
 void BDSRandom::SetSeedState(const G4String& seedState)
 {
   if (seedState.empty())
     {G4cout << __METHOD_NAME__ << "empty seed state supplied - no seed state set" << G4endl; return;}
+  if (seedState.compare(0, eventSeedPrefix.size(), eventSeedPrefix) == 0)
+    {// compact per-event state
+      std::istringstream ss(seedState.substr(eventSeedPrefix.size()));
+      long  seed    = 0;
+      G4int runID   = 0;
+      G4int eventID = 0;
+      if (!(ss >> seed >> runID >> eventID))
+	{throw BDSException(__METHOD_NAME__, "invalid event seed state \"" + seedState + "\"");}
+      SeedEngineForEvent(seed, runID, eventID);
+      return;
+    }
   std::stringstream ss;
   ss.str(seedState); // set contents of string stream as input string
   SetSeedState(ss);
@@ -30,6 +30,9 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 BDSRegion::BDSRegion(G4String nameIn):
   name(nameIn),
+  minimumKineticEnergy(0),
+  rouletteKineticEnergy(0),
+  rouletteProbability(0),
   g4cuts(nullptr),
   g4region(nullptr)
 {
@@ -61,8 +64,14 @@ BDSRegion::BDSRegion(G4String nameIn,
 		     G4double rangeCutElectronsIn,
 		     G4double rangeCutPositronsIn,
 		     G4double rangeCutProtonsIn,
-		     G4double rangeCutPhotonsIn):
+		     G4double rangeCutPhotonsIn,
+		     G4double minimumKineticEnergyIn,
+		     G4double rouletteKineticEnergyIn,
+		     G4double rouletteProbabilityIn):
   name(nameIn),
+  minimumKineticEnergy(minimumKineticEnergyIn),
+  rouletteKineticEnergy(rouletteKineticEnergyIn),
+  rouletteProbability(rouletteProbabilityIn),
   g4cuts(nullptr),
   g4region(nullptr)
 {
@@ -85,7 +94,10 @@ BDSRegion::BDSRegion(const GMAD::Region& parserRegion,
 	    parserRegion.prodCutElectrons * CLHEP::m,
 	    parserRegion.prodCutPositrons * CLHEP::m,
 	    parserRegion.prodCutProtons   * CLHEP::m,
-	    parserRegion.prodCutPhotons   * CLHEP::m)
+	    parserRegion.prodCutPhotons   * CLHEP::m,
+	    parserRegion.minimumKineticEnergy  * CLHEP::GeV,
+	    parserRegion.rouletteKineticEnergy * CLHEP::GeV,
+	    parserRegion.rouletteProbability)
 {;}
 
 BDSRegion::~BDSRegion()
@@ -102,6 +114,13 @@ std::ostream& operator<< (std::ostream& out, BDSRegion const &r)
   out << "e+ range cut      " << r.rangeCutPositrons << " mm" << G4endl;
   out << "proton range cut  " << r.rangeCutProtons   << " mm" << G4endl;
   out << "photon range cut  " << r.rangeCutPhotons   << " mm" << G4endl;
+  if (BDS::IsFinite(r.minimumKineticEnergy))
+    {out << "minimum Ek        " << r.minimumKineticEnergy/CLHEP::GeV << " GeV" << G4endl;}
+  if (BDS::IsFinite(r.rouletteKineticEnergy))
+    {
+      out << "roulette Ek       " << r.rouletteKineticEnergy/CLHEP::GeV << " GeV" << G4endl;
+      out << "roulette prob.    " << r.rouletteProbability << G4endl;
+    }
   return out;
 }
 
@@ -25,6 +25,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSEventAction.hh"
 #include "BDSEventInfo.hh"
 #include "BDSException.hh"
+#include "BDSFieldLoader.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSOutput.hh"
 #include "BDSParser.hh"
@@ -151,6 +152,7 @@ void BDSRunAction::EndOfRunAction(const G4Run* aRun)
   
   // Output feedback
   G4cout << G4endl << __METHOD_NAME__ << "Run " << aRun->GetRunID() << " end. Time is " << asctime(localtime(&stoptime));
+  BDSFieldLoader::Instance()->PrintDeferredFieldSummary();
   
   // Write output
   // In the case of a file-based bunch generator, it will have cached these numbers - get them.
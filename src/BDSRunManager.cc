@@ -19,16 +19,25 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSRunManager.hh"
 #include "BDSDebug.hh"
 #include "BDSDetectorConstruction.hh"
+#include "BDSEventArena.hh"
 #include "BDSExceptionHandler.hh"
 #include "BDSExtent.hh"
 #include "BDSFieldQuery.hh"
+#include "BDSGlobalConstants.hh"
 #include "BDSPrimaryGeneratorAction.hh"
+#include "BDSScorerBuffer.hh"
+#include "BDSWarning.hh"
 
+#include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4ScoringManager.hh"
 #include "G4UImanager.hh"
+#include "G4VHitsCollection.hh"
 
 #include "CLHEP/Random/Random.h"
 
-BDSRunManager::BDSRunManager()
+BDSRunManager::BDSRunManager():
+  eventsKept(false)
 {
   // Construct an exception handler to catch Geant4 aborts.
   // This has to be done after G4RunManager::G4RunManager() which constructs
@@ -60,6 +69,17 @@ void BDSRunManager::Initialize()
     }
   if (const auto primaryGeneratorAction = dynamic_cast<BDSPrimaryGeneratorAction*>(userPrimaryGeneratorAction))
     {primaryGeneratorAction->SetWorldExtent(worldExtent);}
+
+  // Events may be kept by the visualisation in interactive mode, so only allow
+  // the event arena in batch mode where we know when the event is deleted.
+  const BDSGlobalConstants* globals = BDSGlobalConstants::Instance();
+  if (globals->UseEventArena())
+    {
+      if (globals->Batch())
+        {BDSEventArena::Instance()->SetActive(true);}
+      else
+        {BDS::Warning(__METHOD_NAME__, "option useEventArena is only used in batch mode - ignoring");}
+    }
 }
 
 void BDSRunManager::BeamOn(G4int n_event,const char* macroFile,G4int n_select)
@@ -105,11 +125,44 @@ void BDSRunManager::ProcessOneEvent(G4int i_event)
     {return;}
   eventManager->ProcessOneEvent(currentEvent);
   AnalyzeEvent(currentEvent);
-  UpdateScoring();
+  UpdateScoringMeshes();
   if (i_event < n_select_msg)
     {G4UImanager::GetUIpointer()->ApplyCommand(msgText);}
 }
 
+void BDSRunManager::UpdateScoringMeshes()
+{
+  G4ScoringManager* scoringManager = G4ScoringManager::GetScoringManagerIfExist();
+  if (!scoringManager)
+    {return;}
+  if (scoringManager->GetNumberOfMesh() < 1)
+    {return;}
+  G4HCofThisEvent* HCE = currentEvent->GetHCofThisEvent();
+  if (!HCE)
+    {return;}
+  G4int nCollections = (G4int)HCE->GetCapacity();
+  for (G4int i = 0; i < nCollections; i++)
+    {
+      G4VHitsCollection* hc = HCE->GetHC(i);
+      if (!hc)
+        {continue;}
+      if (dynamic_cast<BDSScorerBufferCollection*>(hc))
+        {continue;} // not a G4THitsMap - can't be accumulated by Geant4
+      scoringManager->Accumulate(hc);
+    }
+}
+
+void BDSRunManager::TerminateOneEvent()
+{
+  eventsKept = eventsKept || n_perviousEventsToBeKept > 0 || (currentEvent && currentEvent->ToBeKept());
+  G4RunManager::TerminateOneEvent();
+  
+  // All hits and trajectories of the event have now been deleted by Geant4 so the
+  // memory can be reclaimed in one go for the next event.
+  if (BDSEventArena::Active() && !eventsKept)
+    {BDSEventArena::Instance()->Reset();}
+}
+
 void BDSRunManager::AbortRun(G4bool)
 {
   G4cout << "Terminate run - trying to write and close output file" << G4endl;
@@ -38,6 +38,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSSDType.hh"
 #include "BDSSDTerminator.hh"
 #include "BDSSDVolumeExit.hh"
+#include "BDSScoringMeshAnalytic.hh"
 
 #include "G4SDKineticEnergyFilter.hh"
 #include "G4SDManager.hh"
@@ -404,6 +405,12 @@ void BDSSDManager::RegisterPrimitiveScorerNames(const std::vector<G4String>& nam
     }
 }
 
+void BDSSDManager::RegisterAnalyticScoringMesh(BDSScoringMeshAnalytic* mesh)
+{
+  G4SDManager::GetSDMpointer()->AddNewDetector(mesh);
+  analyticScoringMeshes.push_back(mesh);
+}
+
 void BDSSDManager::SetLinkRegistry(BDSLinkRegistry* registry)
 {
   if (samplerLink)
@@ -0,0 +1,54 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSScorerBuffer.hh"
+
+#include "globals.hh"
+
+#include <algorithm>
+#include <vector>
+
+BDSScorerBuffer::Page::Page()
+{
+  std::fill(values, values + pageSize, 0.0);
+  std::fill(used,   used   + pageSize, false);
+}
+
+BDSScorerBuffer::BDSScorerBuffer(G4int nCellsIn):
+  nCells(std::max(0, nCellsIn))
+{
+  pages.resize((nCells + pageSize - 1) / pageSize, nullptr);
+}
+
+BDSScorerBuffer::~BDSScorerBuffer()
+{
+  for (auto page : pages)
+    {delete page;}
+}
+
+void BDSScorerBuffer::Clear()
+{
+  for (auto index : touched)
+    {
+      Page* page = pages[index >> pageShift];
+      G4int i = index & pageMask;
+      page->values[i] = 0;
+      page->used[i]   = false;
+    }
+  touched.clear();
+}
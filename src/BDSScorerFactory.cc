@@ -120,7 +120,7 @@ G4VPrimitiveScorer* BDSScorerFactory::GetAppropriateScorer(const BDSScorerInfo&
     case BDSScorerType::cellflux4d:
       {
     BDSPSCellFlux4D* scorer = new BDSPSCellFlux4D(info.name, mapper, "percm2");
-	scorer->Weighted(true);
+	scorer->SetWeighted(true);
 	result = scorer;
 	break;
       }
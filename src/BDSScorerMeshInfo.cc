@@ -46,6 +46,7 @@ BDSScorerMeshInfo::BDSScorerMeshInfo(const GMAD::ScorerMesh& mesh)
   nBinsR = mesh.nr;
   nBinsPhi = mesh.nphi;
   nBinsE = mesh.ne;
+  analytic = mesh.analytic;
 
   if (geometryType == "box")
     {
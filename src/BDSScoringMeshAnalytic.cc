@@ -0,0 +1,515 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSDebug.hh"
+#include "BDSException.hh"
+#include "BDSHistBinMapper.hh"
+#include "BDSPSCellFluxScaled3D.hh"
+#include "BDSScorerBuffer.hh"
+#include "BDSScorerMeshInfo.hh"
+#include "BDSScoringMeshAnalytic.hh"
+#include "BDSUtilities.hh"
+
+#ifdef USE_BOOST
+#include <boost/variant.hpp>
+#endif
+
+#include "globals.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4Material.hh"
+#include "G4Step.hh"
+#include "G4StepPoint.hh"
+#include "G4Track.hh"
+#include "G4VPrimitiveScorer.hh"
+#include "G4VSDFilter.hh"
+
+#include "CLHEP/Geometry/Point3D.h"
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+BDSScoringMeshAnalytic::BDSScoringMeshAnalytic(const G4String&          name,
+                                               const BDSScorerMeshInfo& recipe,
+                                               const G4Transform3D&     placementTransform):
+  G4VSensitiveDetector(name),
+  cylindrical(false),
+  globalToLocal(placementTransform.inverse()),
+  boxCellVolume(0),
+  mapper(nullptr)
+{
+  if (recipe.geometryType == "box")
+    {
+      // same sizes and order of indices as BDSScoringMeshBox
+      halfSize[0] = recipe.ScoringMeshX();
+      halfSize[1] = recipe.ScoringMeshY();
+      halfSize[2] = recipe.ScoringMeshZ();
+      nSegment[0] = recipe.nBinsX;
+      nSegment[1] = recipe.nBinsY;
+      nSegment[2] = recipe.nBinsZ;
+      boxCellVolume = 1;
+      for (G4int i = 0; i < 3; i++)
+        {
+          cellWidth[i] = 2*halfSize[i] / (G4double)nSegment[i];
+          boxCellVolume *= cellWidth[i];
+        }
+    }
+  else if (recipe.geometryType == "cylindrical")
+    {
+      // same sizes and order of indices (z, phi, r) as BDSScoringMeshCylinder
+      cylindrical = true;
+      halfSize[0] = recipe.ScoringMeshR();
+      halfSize[1] = 0;
+      halfSize[2] = recipe.ScoringMeshZ();
+      nSegment[0] = recipe.nBinsZ;
+      nSegment[1] = recipe.nBinsPhi;
+      nSegment[2] = recipe.nBinsR;
+      cellWidth[0] = 2*halfSize[2] / (G4double)nSegment[0];
+      cellWidth[1] = CLHEP::twopi   / (G4double)nSegment[1];
+      cellWidth[2] = halfSize[0]    / (G4double)nSegment[2];
+      cylinderCellVolume.resize(nSegment[2]);
+      for (G4int k = 0; k < nSegment[2]; k++)
+        {// (r2^2 - r1^2) * dphi / 2 * dz as G4Tubs
+          G4double r1 = k*cellWidth[2];
+          G4double r2 = (k+1)*cellWidth[2];
+          cylinderCellVolume[k] = 0.5*(r2*r2 - r1*r1) * cellWidth[1] * cellWidth[0];
+        }
+    }
+  else
+    {
+      G4String msg = "mesh geometry type \"" + recipe.geometryType + "\" is not correct. The possible options are \"box\" and \"cylindrical\"";
+      throw BDSException(__METHOD_NAME__, msg);
+    }
+
+#ifdef USE_BOOST
+  mapper = new BDSHistBinMapper(nSegment[0], nSegment[1], nSegment[2], recipe.nBinsE, recipe.energyAxis);
+#else
+  mapper = new BDSHistBinMapper(nSegment[0], nSegment[1], nSegment[2], recipe.nBinsE);
+#endif
+}
+
+BDSScoringMeshAnalytic::~BDSScoringMeshAnalytic()
+{
+  for (auto& quantity : quantities)
+    {
+      delete quantity.scorer;
+      delete quantity.hits;
+    }
+  delete mapper;
+}
+
+void BDSScoringMeshAnalytic::RegisterScorer(BDSScorerType       scorerType,
+                                            G4VPrimitiveScorer* scorer)
+{
+  Quantity quantity;
+  quantity.scorerType = scorerType;
+  quantity.scorer     = scorer;
+  quantity.scaled     = nullptr;
+  quantity.HCID       = -1;
+  quantity.hits       = nullptr;
+  switch (scorerType.underlying())
+    {
+    case BDSScorerType::cellflux3d:
+    case BDSScorerType::cellflux4d:
+    case BDSScorerType::depositedenergy3d:
+    case BDSScorerType::depositeddose3d:
+    case BDSScorerType::population3d:
+      {break;}
+    case BDSScorerType::cellfluxscaled3d:
+    case BDSScorerType::cellfluxscaledperparticle3d:
+      {quantity.scaled = dynamic_cast<BDSPSCellFluxScaled3D*>(scorer); break;}
+    default:
+      {
+        G4String msg = "scorer \"" + scorer->GetName() + "\" of type \"" + scorerType.ToString();
+        msg += "\" cannot be used in analytic mesh \"" + SensitiveDetectorName + "\" - only quantities along each step are supported";
+        throw BDSException(__METHOD_NAME__, msg);
+        break;
+      }
+    }
+  collectionName.insert(scorer->GetName());
+  quantities.push_back(quantity);
+}
+
+void BDSScoringMeshAnalytic::Initialize(G4HCofThisEvent* HCE)
+{
+  for (G4int i = 0; i < (G4int)quantities.size(); i++)
+    {
+      Quantity& quantity = quantities[i];
+      if (!quantity.hits)
+        {
+          G4int nCells = (G4int)(mapper->NBinsI() * mapper->NBinsJ() * mapper->NBinsK() * mapper->NBinsL());
+          quantity.hits = new BDSScorerBuffer(nCells);
+        }
+      quantity.hits->Clear();
+      if (quantity.HCID < 0)
+        {quantity.HCID = GetCollectionID(i);}
+      HCE->AddHitsCollection(quantity.HCID, new BDSScorerBufferCollection(SensitiveDetectorName, collectionName[i], quantity.hits));
+      quantity.cellTracks.clear();
+    }
+}
+
+G4int BDSScoringMeshAnalytic::Bin(G4double value, G4double low, G4double width, G4int n)
+{
+  G4int result = (G4int)std::floor((value - low) / width);
+  return std::max(0, std::min(n - 1, result));
+}
+
+G4bool BDSScoringMeshAnalytic::PointCell(const G4ThreeVector& p, Segment& cell) const
+{
+  if (cylindrical)
+    {
+      if (std::abs(p.z()) > halfSize[2] || p.perp() > halfSize[0])
+        {return false;}
+      G4double phi = p.phi() < 0 ? p.phi() + CLHEP::twopi : p.phi();
+      G4int k = Bin(p.perp(), 0, cellWidth[2], nSegment[2]);
+      cell = {Bin(p.z(), -halfSize[2], cellWidth[0], nSegment[0]),
+              Bin(phi, 0, cellWidth[1], nSegment[1]),
+              k, 1.0, cylinderCellVolume[k]};
+      return true;
+    }
+  for (G4int i = 0; i < 3; i++)
+    {
+      if (std::abs(p[i]) > halfSize[i])
+        {return false;}
+    }
+  cell = {Bin(p[0], -halfSize[0], cellWidth[0], nSegment[0]),
+          Bin(p[1], -halfSize[1], cellWidth[1], nSegment[1]),
+          Bin(p[2], -halfSize[2], cellWidth[2], nSegment[2]),
+          1.0, boxCellVolume};
+  return true;
+}
+
+void BDSScoringMeshAnalytic::ScoreStep(const G4Step* step)
+{
+  const G4StepPoint* preStepPoint  = step->GetPreStepPoint();
+  const G4StepPoint* postStepPoint = step->GetPostStepPoint();
+  G4ThreeVector a = globalToLocal * (HepGeom::Point3D<G4double>)preStepPoint->GetPosition();
+  G4ThreeVector b = globalToLocal * (HepGeom::Point3D<G4double>)postStepPoint->GetPosition();
+
+  segments.clear();
+  if (cylindrical)
+    {WalkCylinder(a, b);}
+  else
+    {WalkBox(a, b);}
+  if (segments.empty())
+    {return;}
+
+  // energy is deposited in the cell of the pre-step point as for G4PSEnergyDeposit3D, where
+  // the step can't leave the cell, or the post-step point for a step that enters the mesh
+  Segment depositCell;
+  G4bool depositInMesh = PointCell(a, depositCell) || PointCell(b, depositCell);
+
+  G4double stepLength = step->GetStepLength();
+  G4double edep       = step->GetTotalEnergyDeposit();
+  G4double weight     = preStepPoint->GetWeight();
+  const G4Track* track = step->GetTrack();
+  for (auto& quantity : quantities)
+    {
+      const G4VSDFilter* filter = quantity.scorer->GetFilter();
+      if (filter && !filter->Accept(step))
+        {continue;}
+
+      switch (quantity.scorerType.underlying())
+        {
+        case BDSScorerType::cellflux3d:
+        case BDSScorerType::cellflux4d:
+        case BDSScorerType::cellfluxscaled3d:
+        case BDSScorerType::cellfluxscaledperparticle3d:
+          {// track length in the cell / cell volume as G4PSCellFlux3D
+            if (!BDS::IsFinite(stepLength))
+              {break;}
+            G4double factor = weight * stepLength;
+            if (quantity.scaled)
+              {factor *= quantity.scaled->GetConversionFactor(track->GetDefinition()->GetPDGEncoding(), preStepPoint->GetKineticEnergy());}
+            G4int l = 0;
+#ifdef USE_BOOST
+            if (quantity.scorerType == BDSScorerType::cellflux4d)
+              {// as BDSPSCellFlux4D
+                G4double energy = postStepPoint->GetKineticEnergy();
+                l = boost::apply_visitor([&energy](auto&& one){return (decltype(one)(one))->index(energy);}, mapper->GetEnergyAxis()) + 1;
+              }
+#endif
+            for (const auto& segment : segments)
+              {
+                G4double value = factor * segment.fraction / segment.volume;
+                quantity.hits->Add(mapper->GlobalFromIJKLIndex(segment.i, segment.j, segment.k, l), value);
+              }
+            break;
+          }
+        case BDSScorerType::depositedenergy3d:
+          {
+            if (!BDS::IsFinite(edep) || !depositInMesh)
+              {break;}
+            G4double value = edep * weight;
+            quantity.hits->Add(mapper->GlobalFromIJKLIndex(depositCell.i, depositCell.j, depositCell.k), value);
+            break;
+          }
+        case BDSScorerType::depositeddose3d:
+          {// energy / mass of the cell as G4PSDoseDeposit3D
+            G4double density = preStepPoint->GetMaterial()->GetDensity();
+            if (!BDS::IsFinite(edep) || !BDS::IsFinite(density) || !depositInMesh)
+              {break;}
+            G4double value = edep * weight / (density * depositCell.volume);
+            quantity.hits->Add(mapper->GlobalFromIJKLIndex(depositCell.i, depositCell.j, depositCell.k), value);
+            break;
+          }
+        case BDSScorerType::population3d:
+          {// each track once per cell per event as G4PSPopulation3D
+            G4int trackID = track->GetTrackID();
+            for (const auto& segment : segments)
+              {
+                G4int index = mapper->GlobalFromIJKLIndex(segment.i, segment.j, segment.k);
+                if (quantity.cellTracks.insert(std::make_pair(index, trackID)).second)
+                  {
+                    G4double value = weight;
+                    quantity.hits->Add(index, value);
+                  }
+              }
+            break;
+          }
+        default:
+          {break;}
+        }
+    }
+}
+
+void BDSScoringMeshAnalytic::WalkBox(const G4ThreeVector& a, const G4ThreeVector& b)
+{
+  G4ThreeVector d = b - a;
+  G4double chordLength = d.mag();
+
+  // a step without length (e.g. at rest) goes entirely in the cell it's in
+  if (chordLength < 1e-9*CLHEP::mm)
+    {
+      Segment cell;
+      if (PointCell(a, cell))
+        {segments.push_back(cell);}
+      return;
+    }
+
+  // clip the chord (parameterised by t from 0 to 1) to the box
+  G4double t0 = 0;
+  G4double t1 = 1;
+  for (G4int i = 0; i < 3; i++)
+    {
+      if (d[i] == 0)
+        {
+          if (std::abs(a[i]) > halfSize[i])
+            {return;}
+          continue;
+        }
+      G4double tLow  = (-halfSize[i] - a[i]) / d[i];
+      G4double tHigh = ( halfSize[i] - a[i]) / d[i];
+      if (tLow > tHigh)
+        {std::swap(tLow, tHigh);}
+      t0 = std::max(t0, tLow);
+      t1 = std::min(t1, tHigh);
+      if (t0 >= t1)
+        {return;}
+    }
+
+  // cell at the start - if this is on a cell face and the chord goes the other way, the
+  // first part has no length and the walk moves straight on to the next cell
+  G4int    index[3];
+  G4int    direction[3];
+  G4double tNext[3];
+  G4double tDelta[3];
+  for (G4int i = 0; i < 3; i++)
+    {
+      index[i] = Bin(a[i] + d[i]*t0, -halfSize[i], cellWidth[i], nSegment[i]);
+      if (d[i] > 0)
+        {
+          direction[i] = 1;
+          tNext[i]  = (-halfSize[i] + (index[i] + 1)*cellWidth[i] - a[i]) / d[i];
+          tDelta[i] = cellWidth[i] / d[i];
+        }
+      else if (d[i] < 0)
+        {
+          direction[i] = -1;
+          tNext[i]  = (-halfSize[i] + index[i]*cellWidth[i] - a[i]) / d[i];
+          tDelta[i] = -cellWidth[i] / d[i];
+        }
+      else
+        {
+          direction[i] = 0;
+          tNext[i]  = std::numeric_limits<G4double>::max();
+          tDelta[i] = std::numeric_limits<G4double>::max();
+        }
+    }
+
+  // advance to the nearest cell face each time
+  G4double t = t0;
+  while (t < t1)
+    {
+      G4int axis = 0;
+      if (tNext[1] < tNext[axis])
+        {axis = 1;}
+      if (tNext[2] < tNext[axis])
+        {axis = 2;}
+      G4double tEnd = std::min(tNext[axis], t1);
+      if (tEnd > t)
+        {segments.push_back({index[0], index[1], index[2], tEnd - t, boxCellVolume});}
+      t = tEnd;
+      index[axis] += direction[axis];
+      if (index[axis] < 0 || index[axis] >= nSegment[axis])
+        {break;}
+      tNext[axis] += tDelta[axis];
+    }
+}
+
+void BDSScoringMeshAnalytic::WalkCylinder(const G4ThreeVector& a, const G4ThreeVector& b)
+{
+  const G4double rMax  = halfSize[0];
+  const G4double zHalf = halfSize[2];
+  G4ThreeVector d = b - a;
+  G4double chordLength = d.mag();
+
+  if (chordLength < 1e-9*CLHEP::mm)
+    {
+      Segment cell;
+      if (PointCell(a, cell))
+        {segments.push_back(cell);}
+      return;
+    }
+
+  // clip the chord (parameterised by t from 0 to 1) to the z extent
+  G4double t0 = 0;
+  G4double t1 = 1;
+  if (d.z() == 0)
+    {
+      if (std::abs(a.z()) > zHalf)
+        {return;}
+    }
+  else
+    {
+      G4double tLow  = (-zHalf - a.z()) / d.z();
+      G4double tHigh = ( zHalf - a.z()) / d.z();
+      if (tLow > tHigh)
+        {std::swap(tLow, tHigh);}
+      t0 = std::max(t0, tLow);
+      t1 = std::min(t1, tHigh);
+      if (t0 >= t1)
+        {return;}
+    }
+
+  // radius squared along the chord is A t^2 + 2 B t + C
+  G4double A = d.x()*d.x() + d.y()*d.y();
+  G4double B = a.x()*d.x() + a.y()*d.y();
+  G4double C = a.x()*a.x() + a.y()*a.y();
+  if (A == 0)
+    {
+      if (C > rMax*rMax)
+        {return;}
+    }
+  else
+    {
+      G4double discriminant = B*B - A*(C - rMax*rMax);
+      if (discriminant <= 0)
+        {return;}
+      G4double root = std::sqrt(discriminant);
+      t0 = std::max(t0, (-B - root) / A);
+      t1 = std::min(t1, (-B + root) / A);
+      if (t0 >= t1)
+        {return;}
+    }
+
+  crossings.clear();
+  crossings.push_back(t0);
+  crossings.push_back(t1);
+
+  // z planes between the ends
+  if (d.z() != 0 && nSegment[0] > 1)
+    {
+      G4int first = Bin(a.z() + d.z()*t0, -zHalf, cellWidth[0], nSegment[0]);
+      G4int last  = Bin(a.z() + d.z()*t1, -zHalf, cellWidth[0], nSegment[0]);
+      if (first > last)
+        {std::swap(first, last);}
+      for (G4int m = first + 1; m <= last; m++)
+        {crossings.push_back((-zHalf + m*cellWidth[0] - a.z()) / d.z());}
+    }
+
+  // radial cylinders between the minimum and maximum radius on the clipped chord
+  if (A > 0 && nSegment[2] > 1)
+    {
+      G4double tClosest = std::max(t0, std::min(t1, -B / A));
+      auto r2 = [&](G4double tt){return (A*tt + 2*B)*tt + C;};
+      G4double rMinimum = std::sqrt(std::max(0.0, r2(tClosest)));
+      G4double rMaximum = std::sqrt(std::max(r2(t0), r2(t1)));
+      G4int first = (G4int)std::ceil(rMinimum / cellWidth[2]);
+      G4int last  = std::min(nSegment[2] - 1, (G4int)std::floor(rMaximum / cellWidth[2]));
+      for (G4int m = std::max(1, first); m <= last; m++)
+        {
+          G4double rm = m*cellWidth[2];
+          G4double discriminant = B*B - A*(C - rm*rm);
+          if (discriminant < 0)
+            {continue;}
+          G4double root = std::sqrt(discriminant);
+          crossings.push_back((-B - root) / A);
+          crossings.push_back((-B + root) / A);
+        }
+    }
+
+  // phi half planes - phi changes monotonically along a line that misses the axis
+  if (A > 0 && nSegment[1] > 1)
+    {
+      G4double angularMomentum = a.x()*d.y() - a.y()*d.x();
+      if (std::abs(angularMomentum) <= 1e-12 * std::sqrt(A*C))
+        {crossings.push_back(-B / A);} // through the axis - phi jumps by pi there
+      else
+        {
+          G4int    direction = angularMomentum > 0 ? 1 : -1;
+          G4ThreeVector start = a + d*t0;
+          G4ThreeVector end   = a + d*t1;
+          G4double phiStart = start.phi() < 0 ? start.phi() + CLHEP::twopi : start.phi();
+          G4double phiEnd   = end.phi()   < 0 ? end.phi()   + CLHEP::twopi : end.phi();
+          G4int m    = Bin(phiStart, 0, cellWidth[1], nSegment[1]);
+          G4int last = Bin(phiEnd,   0, cellWidth[1], nSegment[1]);
+          for (G4int n = 0; m != last && n < nSegment[1]; n++)
+            {
+              G4int boundary = direction > 0 ? m + 1 : m;
+              G4double phiBoundary = boundary*cellWidth[1];
+              G4double nx = -std::sin(phiBoundary);
+              G4double ny =  std::cos(phiBoundary);
+              G4double denominator = d.x()*nx + d.y()*ny;
+              if (denominator != 0)
+                {crossings.push_back(-(a.x()*nx + a.y()*ny) / denominator);}
+              m = (m + direction + nSegment[1]) % nSegment[1];
+            }
+        }
+    }
+
+  // each interval between crossings is in one cell
+  std::sort(crossings.begin(), crossings.end());
+  for (G4int n = 0; n < (G4int)crossings.size() - 1; n++)
+    {
+      G4double tStart = std::max(t0, crossings[n]);
+      G4double tEnd   = std::min(t1, crossings[n+1]);
+      if (tEnd <= tStart)
+        {continue;}
+      G4ThreeVector midPoint = a + d*(0.5*(tStart + tEnd));
+      G4double phi = midPoint.phi() < 0 ? midPoint.phi() + CLHEP::twopi : midPoint.phi();
+      G4int k = Bin(midPoint.perp(), 0, cellWidth[2], nSegment[2]);
+      segments.push_back({Bin(midPoint.z(), -zHalf, cellWidth[0], nSegment[0]),
+                          Bin(phi, 0, cellWidth[1], nSegment[1]),
+                          k, tEnd - tStart, cylinderCellVolume[k]});
+    }
+}
@@ -16,24 +16,37 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSAcceleratorModel.hh"
 #include "BDSDebug.hh"
+#include "BDSException.hh"
 #include "BDSGlobalConstants.hh"
 #include "BDSMultiSensitiveDetectorOrdered.hh"
+#include "BDSRegion.hh"
 #include "BDSRunManager.hh"
 #include "BDSSDEnergyDeposition.hh"
 #include "BDSSDEnergyDepositionGlobal.hh"
 #include "BDSStackingAction.hh"
+#include "BDSUtilities.hh"
 
 #include "globals.hh" // geant4 globals / types
 #include "G4Run.hh"
 #include "G4Event.hh"
+#include "G4LogicalVolume.hh"
 #include "G4ThreeVector.hh"
 #include "G4Track.hh"
 #include "G4TrackStatus.hh"
 #include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
 #include "G4ParticleTypes.hh"
+#include "G4Region.hh"
+#include "G4VPhysicalVolume.hh"
 #include "G4VSensitiveDetector.hh"
 #include "G4Version.hh"
+#include "Randomize.hh"
+
+#include <cfloat>
+#include <cmath>
+#include <vector>
 
 #if G4VERSION_NUMBER > 1029
 #include "G4MultiSensitiveDetector.hh"
@@ -41,7 +54,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 G4double BDSStackingAction::energyKilled = 0;
 
-BDSStackingAction::BDSStackingAction(const BDSGlobalConstants* globals)
+BDSStackingAction::BDSStackingAction(const BDSGlobalConstants* globals):
+  tablesBuilt(false)
 {
   killNeutrinos     = globals->KillNeutrinos();
   stopSecondaries   = globals->StopSecondaries();
@@ -49,11 +63,94 @@ BDSStackingAction::BDSStackingAction(const BDSGlobalConstants* globals)
   if (maxTracksPerEvent == 0) // 0 is default -> no action - set maximum possible number
     {maxTracksPerEvent = LONG_MAX;}
   minimumEK = globals->MinimumKineticEnergy();
+  rouletteEK = globals->RouletteKineticEnergy();
+  rouletteProbability = globals->RouletteProbability();
   particlesToExcludeFromCuts = globals->ParticlesToExcludeFromCutsAsSet();
+
+  if (rouletteProbability <= 0 || rouletteProbability > 1)
+    {throw BDSException(__METHOD_NAME__, "option rouletteProbability must be in the range (0,1]");}
+  defaultTable.minimumEK           = minimumEK;
+  defaultTable.rouletteEK          = rouletteEK;
+  defaultTable.rouletteProbability = rouletteProbability;
 }
 
 BDSStackingAction::~BDSStackingAction()
-{;}
+{
+  for (auto t : tableStorage)
+    {delete t;}
+}
+
+void BDSStackingAction::BuildTables()
+{
+  // region specific settings - any not set in the region take the global value
+  const auto& regions = BDSAcceleratorModel::Instance()->Regions();
+  for (const auto& nameRegion : regions)
+    {
+      const BDSRegion* r = nameRegion.second;
+      if (!r->g4region)
+        {continue;}
+      auto table = new ClassificationTable();
+      table->minimumEK           = BDS::IsFinite(r->minimumKineticEnergy)  ? r->minimumKineticEnergy  : minimumEK;
+      table->rouletteEK          = BDS::IsFinite(r->rouletteKineticEnergy) ? r->rouletteKineticEnergy : rouletteEK;
+      table->rouletteProbability = BDS::IsFinite(r->rouletteProbability)   ? r->rouletteProbability   : rouletteProbability;
+      if (table->rouletteProbability <= 0 || table->rouletteProbability > 1)
+        {throw BDSException(__METHOD_NAME__, "rouletteProbability in region \"" + r->name + "\" must be in the range (0,1]");}
+      tableStorage.push_back(table);
+      
+      G4int regionID = r->g4region->GetInstanceID();
+      if (regionID >= (G4int)regionTables.size())
+        {regionTables.resize(regionID + 1, nullptr);}
+      regionTables[regionID] = table;
+    }
+
+  // fill each table for all particles known so far
+  std::vector<ClassificationTable*> allTables = tableStorage;
+  allTables.push_back(&defaultTable);
+  G4ParticleTable::G4PTblDicIterator* it = G4ParticleTable::GetParticleTable()->GetIterator();
+  for (auto table : allTables)
+    {
+      it->reset();
+      while ((*it)())
+        {FillEntry(*table, it->value());}
+    }
+  tablesBuilt = true;
+}
+
+void BDSStackingAction::FillEntry(ClassificationTable& table,
+                                  const G4ParticleDefinition* particle) const
+{
+  G4int id = particle->GetParticleDefinitionID();
+  if (id >= (G4int)table.killEKs.size())
+    {
+      table.killEKs.resize(id + 1, -1);
+      table.rouletteEKs.resize(id + 1, 0);
+    }
+
+  G4int pdgCode = particle->GetPDGEncoding();
+  G4bool excluded = particlesToExcludeFromCuts.count(pdgCode) > 0;
+  G4int pdgNr = std::abs(pdgCode);
+  G4bool isNeutrino = pdgNr == 12 || pdgNr == 14 || pdgNr == 16;
+  
+  G4double killEK = excluded ? 0 : table.minimumEK;
+  if (killNeutrinos && isNeutrino)
+    {killEK = DBL_MAX;}
+  table.killEKs[id] = killEK;
+  table.rouletteEKs[id] = excluded ? 0 : table.rouletteEK;
+}
+
+inline BDSStackingAction::ClassificationTable& BDSStackingAction::TableForTrack(const G4Track* aTrack)
+{
+  const G4VPhysicalVolume* pv = aTrack->GetVolume();
+  if (!pv || regionTables.empty())
+    {return defaultTable;}
+  const G4Region* region = pv->GetLogicalVolume()->GetRegion();
+  if (!region)
+    {return defaultTable;}
+  G4int regionID = region->GetInstanceID();
+  if (regionID < (G4int)regionTables.size() && regionTables[regionID])
+    {return *regionTables[regionID];}
+  return defaultTable;
+}
 
 G4ClassificationOfNewTrack BDSStackingAction::ClassifyNewTrack(const G4Track * aTrack)
 {
@@ -70,26 +167,35 @@ G4ClassificationOfNewTrack BDSStackingAction::ClassifyNewTrack(const G4Track * a
 	<< std::setw(6) << SM->GetNPostponedTrack()
 	<< G4endl;
 #endif
-  G4int pdgCode = aTrack->GetParticleDefinition()->GetPDGEncoding();
-  if ( (aTrack->GetKineticEnergy() < minimumEK) && (particlesToExcludeFromCuts.count(pdgCode) == 0) )
+  ClassificationTable& table = TableForTrack(aTrack);
+  const G4ParticleDefinition* particle = aTrack->GetParticleDefinition();
+  G4int id = particle->GetParticleDefinitionID();
+  if (id >= (G4int)table.killEKs.size() || table.killEKs[id] < 0)
+    {FillEntry(table, particle);} // e.g. an ion created on the fly
+  
+  G4double ek = aTrack->GetKineticEnergy();
+  if (ek < table.killEKs[id])
     {classification = fKill;}
   
   // If beyond max number of tracks, kill it
   if (aTrack->GetTrackID() > maxTracksPerEvent)
     {classification = fKill;}
 
-  // Optionally kill all neutrinos
-  if (killNeutrinos)
-    {
-      G4int pdgNr = std::abs(pdgCode);
-      if( pdgNr == 12 || pdgNr == 14 || pdgNr == 16)
-	{classification = fKill;}
-    }
-
   // Optionally kill secondaries
-  if (stopSecondaries && (aTrack->GetParentID() > 0))
+  G4bool secondary = aTrack->GetParentID() > 0;
+  if (stopSecondaries && secondary)
     {classification = fKill;}
 
+  // Russian roulette for low energy secondaries. Killed ones are not counted as
+  // energy deposition as the survivors carry their weight.
+  if (classification != fKill && secondary && ek < table.rouletteEKs[id])
+    {
+      if (G4UniformRand() > table.rouletteProbability)
+        {return fKill;}
+      G4Track* track = const_cast<G4Track*>(aTrack); // only the weight is changed
+      track->SetWeight(aTrack->GetWeight() / table.rouletteProbability);
+    }
+  
   // Here we must take care of energy conservation. If we artificially kill the track
   // we should record its loss as energy deposition. Find if the volume is sensitive
   // and if so record the track there. Note a track is not a step and is a snap shot at
@@ -158,6 +264,11 @@ void BDSStackingAction::NewStage()
 }
     
 void BDSStackingAction::PrepareNewEvent()
-{;}
+{
+  // build at the first event when all regions are defined and the physics list
+  // has constructed all the particles
+  if (!tablesBuilt)
+    {BuildTables();}
+}
 
 
@@ -16,6 +16,8 @@ GNU General Public License for more details.
 You should have received a copy of the GNU General Public License
 along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 */
+#include "BDSScoringMeshAnalytic.hh"
+#include "BDSSDManager.hh"
 #include "BDSSteppingAction.hh"
 #include "BDSUtilities.hh"
 
@@ -32,7 +34,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 BDSSteppingAction::BDSSteppingAction():
   verboseStep(false),
   verboseEventStart(false),
-  verboseEventStop(false)
+  verboseEventStop(false),
+  analyticScoringMeshes(BDSSDManager::Instance()->AnalyticScoringMeshes())
 {;}
 
 BDSSteppingAction::BDSSteppingAction(G4bool verboseStepIn,
@@ -40,7 +43,8 @@ BDSSteppingAction::BDSSteppingAction(G4bool verboseStepIn,
 				     G4int  verboseEventStopIn):
   verboseStep(verboseStepIn),
   verboseEventStart(verboseEventStartIn),
-  verboseEventStop(verboseEventStopIn)
+  verboseEventStop(verboseEventStopIn),
+  analyticScoringMeshes(BDSSDManager::Instance()->AnalyticScoringMeshes())
 {;}
 
 BDSSteppingAction::~BDSSteppingAction()
@@ -48,6 +52,9 @@ BDSSteppingAction::~BDSSteppingAction()
 
 void BDSSteppingAction::UserSteppingAction(const G4Step* step)
 {
+  for (auto mesh : analyticScoringMeshes)
+    {mesh->ScoreStep(step);}
+  
   if (!verboseStep)
     {return;}
   G4int eventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
@@ -0,0 +1,190 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSArray3DCoords.hh"
+#include "BDSException.hh"
+#include "BDSFieldValue.hh"
+#include "BDSInterpolator3D.hh"
+#include "BDSInterpolator3DCubic.hh"
+#include "BDSInterpolator3DLinear.hh"
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Benchmark of interpolated lookups in a 3D field map stored with the linear
+ * (x fastest) and tiled memory layouts of BDSArray4D. The same positions are
+ * queried for both and the results must be identical.
+ *
+ * Usage: BDSArrayLayoutTester [points per dimension] [number of lookups]
+ * The default map is 160^3 points (~50 MB as float), much larger than L2.
+ */
+
+namespace
+{
+  /// Positions along a random walk with steps of about a grid spacing - as along a
+  /// track - reflected at the edges of the map.
+  std::vector<G4ThreeVector> RandomWalk(G4int nSteps, G4double halfWidth, G4double step)
+  {
+    std::mt19937 rng(12345);
+    std::normal_distribution<G4double> gaus(0, step);
+    std::vector<G4ThreeVector> result;
+    result.reserve(nSteps);
+    G4ThreeVector p(0,0,0);
+    for (G4int i = 0; i < nSteps; i++)
+      {
+	p += G4ThreeVector(gaus(rng), gaus(rng), gaus(rng));
+	for (G4int c = 0; c < 3; c++)
+	  {
+	    if (p[c] > halfWidth)
+	      {p[c] = 2*halfWidth - p[c];}
+	    else if (p[c] < -halfWidth)
+	      {p[c] = -2*halfWidth - p[c];}
+	  }
+	result.push_back(p);
+      }
+    return result;
+  }
+
+  /// Positions uniformly distributed in the map - the worst case for any cache.
+  std::vector<G4ThreeVector> Uniform(G4int nSteps, G4double halfWidth)
+  {
+    std::mt19937 rng(54321);
+    std::uniform_real_distribution<G4double> flat(-halfWidth, halfWidth);
+    std::vector<G4ThreeVector> result;
+    result.reserve(nSteps);
+    for (G4int i = 0; i < nSteps; i++)
+      {result.emplace_back(flat(rng), flat(rng), flat(rng));}
+    return result;
+  }
+
+  /// Query all the positions and return the time taken in seconds. The sum of the
+  /// values is returned in sum so the results can be compared.
+  G4double Time(const BDSInterpolator3D* interpolator,
+		const std::vector<G4ThreeVector>& positions,
+		G4ThreeVector& sum)
+  {
+    sum = G4ThreeVector();
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& p : positions)
+      {sum += interpolator->GetInterpolatedValue(p.x(), p.y(), p.z());}
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<G4double>(stop - start).count();
+  }
+}
+
+int main(int argc, char** argv)
+{
+  G4int nPoints  = argc > 1 ? std::atoi(argv[1]) : 160;
+  G4int nLookups = argc > 2 ? std::atoi(argv[2]) : 2000000;
+  if (nPoints < 4 || nLookups < 1)
+    {std::cerr << "usage: BDSArrayLayoutTester [points per dimension >= 4] [number of lookups]" << std::endl; return 1;}
+
+  const G4double halfWidth = 1.0;
+  const G4double spacing   = 2*halfWidth / (nPoints - 1);
+  BDSArray3DCoords* linear = nullptr;
+  BDSArray3DCoords* tiled  = nullptr;
+  try
+    {
+      linear = new BDSArray3DCoords(nPoints, nPoints, nPoints,
+				    -halfWidth, halfWidth,
+				    -halfWidth, halfWidth,
+				    -halfWidth, halfWidth);
+      for (G4int z = 0; z < nPoints; z++)
+	{
+	  for (G4int y = 0; y < nPoints; y++)
+	    {
+	      for (G4int x = 0; x < nPoints; x++)
+		{
+		  G4double xc = -halfWidth + x*spacing;
+		  G4double yc = -halfWidth + y*spacing;
+		  G4double zc = -halfWidth + z*spacing;
+		  (*linear)(x,y,z) = BDSFieldValue((FIELDTYPET)(std::sin(3*xc)*std::cos(2*yc)),
+						   (FIELDTYPET)(xc*yc + zc),
+						   (FIELDTYPET)std::cos(4*zc));
+		}
+	    }
+	}
+      tiled = new BDSArray3DCoords(*linear);
+      tiled->Tile();
+    }
+  catch (const BDSException& e)
+    {std::cerr << e.what() << std::endl; return 1;}
+
+  std::cout << "Map of " << nPoints << "^3 points: "
+	    << linear->NStored()*sizeof(BDSFieldValue) / (1024*1024) << " MB linear, "
+	    << tiled->NStored()*sizeof(BDSFieldValue) / (1024*1024) << " MB tiled" << std::endl;
+  std::cout << nLookups << " lookups per test" << std::endl;
+
+  struct Pattern
+  {
+    std::string name;
+    std::vector<G4ThreeVector> positions;
+  };
+  std::vector<Pattern> patterns = {{"random walk", RandomWalk(nLookups, halfWidth, spacing)},
+				   {"uniform",     Uniform(nLookups, halfWidth)}};
+
+  G4bool identical = true;
+  for (const std::string interpolatorName : {"linear", "cubic"})
+    {
+      BDSInterpolator3D* iLinear = nullptr;
+      BDSInterpolator3D* iTiled  = nullptr;
+      if (interpolatorName == "cubic")
+	{
+	  iLinear = new BDSInterpolator3DCubic(linear);
+	  iTiled  = new BDSInterpolator3DCubic(tiled);
+	}
+      else
+	{
+	  iLinear = new BDSInterpolator3DLinear(linear);
+	  iTiled  = new BDSInterpolator3DLinear(tiled);
+	}
+      
+      for (const auto& pattern : patterns)
+	{
+	  G4ThreeVector sumLinear, sumTiled;
+	  G4double tLinear = Time(iLinear, pattern.positions, sumLinear);
+	  G4double tTiled  = Time(iTiled,  pattern.positions, sumTiled);
+	  std::cout << std::setw(7)  << interpolatorName << " " << std::setw(12) << pattern.name
+		    << " linear: " << std::setw(8) << tLinear << " s"
+		    << "  tiled: " << std::setw(8) << tTiled  << " s"
+		    << "  speed up: " << std::setw(6) << tLinear / tTiled << std::endl;
+	  if (sumLinear != sumTiled)
+	    {
+	      std::cerr << "different results for the tiled layout: " << sumLinear << " " << sumTiled << std::endl;
+	      identical = false;
+	    }
+	}
+      delete iLinear;
+      delete iTiled;
+    }
+
+  delete linear;
+  delete tiled;
+  return identical ? 0 : 1;
+}
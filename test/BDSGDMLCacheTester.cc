@@ -0,0 +1,103 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSGDMLPreprocessor.hh"
+
+#include "G4String.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Write (or overwrite) a small text file.
+void WriteFile(const std::string& fileName, const std::string& contents)
+{
+  std::ofstream out(fileName.c_str());
+  out << contents;
+}
+
+/// Print the outcome of one check and return 1 if it failed.
+int Check(const std::string& name, bool ok)
+{
+  std::cout << name << (ok ? ": ok" : ": FAIL") << std::endl;
+  return ok ? 0 : 1;
+}
+
+/// Write the test geometry. The main file includes its materials as an external
+/// entity and a modular file from a physical volume as in Geant4.
+void WriteGeometry(const std::string& material, const std::string& subMaterial)
+{
+  WriteFile("gdmlcachetest_main.gdml",
+	    "<?xml version=\"1.0\" ?>\n"
+	    "<!DOCTYPE gdml [\n"
+	    "<!ENTITY materials SYSTEM \"gdmlcachetest_materials.xml\">\n"
+	    "]>\n"
+	    "<gdml xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xsi:noNamespaceSchemaLocation=\"gdml.xsd\">\n"
+	    "  &materials;\n"
+	    "  <solids><box lunit=\"mm\" name=\"world\" x=\"200\" y=\"200\" z=\"200\"/></solids>\n"
+	    "  <structure>\n"
+	    "    <volume name=\"worldlv\">\n"
+	    "      <materialref ref=\"G4_Galactic\"/>\n"
+	    "      <solidref ref=\"world\"/>\n"
+	    "      <physvol name=\"subpv\"><file name=\"gdmlcachetest_sub.gdml\"/></physvol>\n"
+	    "    </volume>\n"
+	    "  </structure>\n"
+	    "  <setup name=\"Default\" version=\"1.0\"><world ref=\"worldlv\"/></setup>\n"
+	    "</gdml>\n");
+  WriteFile("gdmlcachetest_materials.xml",
+	    "<materials><material name=\"boxmat\"><D value=\"1\"/><fraction n=\"1\" ref=\"" + material + "\"/></material></materials>\n");
+  WriteFile("gdmlcachetest_sub.gdml",
+	    "<?xml version=\"1.0\" ?>\n"
+	    "<gdml>\n"
+	    "  <solids><box lunit=\"mm\" name=\"subbox\" x=\"20\" y=\"30\" z=\"40\"/></solids>\n"
+	    "  <structure><volume name=\"subboxlv\"><materialref ref=\"" + subMaterial + "\"/><solidref ref=\"subbox\"/></volume></structure>\n"
+	    "  <setup name=\"Default\" version=\"1.0\"><world ref=\"subboxlv\"/></setup>\n"
+	    "</gdml>\n");
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+  const G4String mainFile = "gdmlcachetest_main.gdml";
+  const G4String variant  = "prefix_PREPROCESSED";
+  int result = 0;
+
+  WriteGeometry("G4_Cu", "G4_Fe");
+  std::vector<G4String> dependencies = BDS::GDMLDependencies(mainFile);
+  auto has = [&dependencies](const G4String& name)
+	     {return std::find(dependencies.begin(), dependencies.end(), name) != dependencies.end();};
+  result += Check("entity dependency found", has("gdmlcachetest_materials.xml"));
+  result += Check("modular file dependency found", has("gdmlcachetest_sub.gdml"));
+
+  std::uint64_t original = BDS::GDMLCacheKey(mainFile, variant);
+  result += Check("hit for the same input", BDS::GDMLCacheKey(mainFile, variant) == original);
+  result += Check("miss for another prefix", BDS::GDMLCacheKey(mainFile, "prefix_OTHER") != original);
+
+  WriteGeometry("G4_W", "G4_Fe");
+  result += Check("miss for a changed entity", BDS::GDMLCacheKey(mainFile, variant) != original);
+
+  WriteGeometry("G4_Cu", "G4_W");
+  result += Check("miss for a changed modular file", BDS::GDMLCacheKey(mainFile, variant) != original);
+
+  WriteGeometry("G4_Cu", "G4_Fe");
+  result += Check("hit once restored", BDS::GDMLCacheKey(mainFile, variant) == original);
+
+  return result;
+}
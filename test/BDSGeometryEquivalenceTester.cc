@@ -0,0 +1,323 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSBeamPipe.hh"
+#include "BDSBeamPipeFactoryBase.hh"
+#include "BDSBeamPipeFactoryCircular.hh"
+#include "BDSBeamPipeFactoryLHC.hh"
+#include "BDSBeamPipeFactoryRectEllipse.hh"
+#include "BDSBeamPipeFactoryRectEllipsePoints.hh"
+#include "BDSException.hh"
+#include "BDSExtent.hh"
+#include "BDSGeometryInspector.hh"
+#include "BDSMagnetGeometryType.hh"
+#include "BDSMagnetOuter.hh"
+#include "BDSMagnetOuterFactoryPolesCircular.hh"
+#include "BDSMagnetOuterInfo.hh"
+#include "BDSMaterials.hh"
+
+#include "globals.hh"
+#include "G4Box.hh"
+#include "G4GeometryManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Navigator.hh"
+#include "G4PVPlacement.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+
+#include "CLHEP/Random/MixMaxRng.h"
+#include "CLHEP/Random/RandFlat.h"
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Solids of an assembly with the name they're reported by.
+using LabelledSolids = std::vector<std::pair<std::string, G4VSolid*> >;
+
+/// The container solid and the solid of each distinct logical volume placed in it,
+/// labelled by the logical volume name without the prefix of the assembly name.
+LabelledSolids Solids(G4LogicalVolume* container, const std::string& prefix)
+{
+  LabelledSolids result = {{"container", container->GetSolid()}};
+  std::set<G4LogicalVolume*> seen;
+  for (G4int i = 0; i < (G4int)container->GetNoDaughters(); i++)
+    {
+      G4LogicalVolume* lv = container->GetDaughter(i)->GetLogicalVolume();
+      if (!seen.insert(lv).second)
+	{continue;} // e.g. each pole of a magnet
+      std::string name = lv->GetName();
+      if (name.size() > prefix.size() + 1 && name.compare(0, prefix.size(), prefix) == 0)
+	{name = name.substr(prefix.size() + 1);}
+      result.emplace_back(name, lv->GetSolid());
+    }
+  return result;
+}
+
+/// Volume where one solid reports inside and the other outside as a fraction of the
+/// volume of the first solid, both estimated from random points in the box. The
+/// fraction is therefore independent of how much of the box the solid fills, which
+/// matters for thin pipe walls. Points on the surface of either solid are not counted
+/// as they're ambiguous by construction. Returns 1 if no points are inside the first
+/// solid so the comparison can't pass vacuously.
+G4double MismatchFraction(const G4VSolid* a,
+			  const G4VSolid* b,
+			  const BDSExtent& box,
+			  G4double zHalf,
+			  CLHEP::HepRandomEngine* engine,
+			  G4int nPoints)
+{
+  G4int nInsideA  = 0;
+  G4int nMismatch = 0;
+  for (G4int i = 0; i < nPoints; i++)
+    {
+      G4ThreeVector p(CLHEP::RandFlat::shoot(engine, box.XNeg(), box.XPos()),
+		      CLHEP::RandFlat::shoot(engine, box.YNeg(), box.YPos()),
+		      CLHEP::RandFlat::shoot(engine, -zHalf, zHalf));
+      EInside ia = a->Inside(p);
+      EInside ib = b->Inside(p);
+      if (ia == kInside)
+	{nInsideA++;}
+      if (ia != kSurface && ib != kSurface && ia != ib)
+	{nMismatch++;}
+    }
+  return nInsideA > 0 ? (G4double)nMismatch / (G4double)nInsideA : 1;
+}
+
+/// Number of tracking steps per second taken by a navigator through an assembly placed
+/// in a world just larger than it, as for neutral particles without a field. Each ray
+/// starts at a random point in the box with a random direction and is stepped from
+/// boundary to boundary until it leaves the world. The geometry is closed (voxelised)
+/// for the timing as it would be for a run.
+G4double StepsPerSecond(G4LogicalVolume* assembly,
+			const BDSExtent& box,
+			G4double zHalfAssembly,
+			G4double zHalfStart,
+			CLHEP::HepRandomEngine* engine,
+			G4int nRays)
+{
+  const G4double margin = 1*CLHEP::mm;
+  G4Material* worldMaterial = BDSMaterials::Instance()->GetMaterial("vacuum");
+  G4Box* worldSolid = new G4Box("world_solid",
+				box.MaximumX() + margin,
+				box.MaximumY() + margin,
+				zHalfAssembly + margin);
+  G4LogicalVolume* worldLV = new G4LogicalVolume(worldSolid, worldMaterial, "world_lv");
+  G4VPhysicalVolume* worldPV = new G4PVPlacement(nullptr, G4ThreeVector(), worldLV, "world_pv", nullptr, false, 0);
+  G4VPhysicalVolume* assemblyPV = new G4PVPlacement(nullptr, G4ThreeVector(), assembly, "assembly_pv", worldLV, false, 0);
+  G4GeometryManager::GetInstance()->CloseGeometry(true, false, worldPV);
+
+  std::vector<G4ThreeVector> points;
+  std::vector<G4ThreeVector> directions;
+  points.reserve(nRays);
+  directions.reserve(nRays);
+  for (G4int i = 0; i < nRays; i++)
+    {
+      points.emplace_back(CLHEP::RandFlat::shoot(engine, box.XNeg(), box.XPos()),
+			  CLHEP::RandFlat::shoot(engine, box.YNeg(), box.YPos()),
+			  CLHEP::RandFlat::shoot(engine, -zHalfStart, zHalfStart));
+      G4double cosTheta = CLHEP::RandFlat::shoot(engine, -1, 1);
+      G4double phi = CLHEP::RandFlat::shoot(engine, 0, CLHEP::twopi);
+      G4double sinTheta = std::sqrt(1 - cosTheta*cosTheta);
+      directions.emplace_back(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+    }
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(worldPV);
+  const G4int maxStepsPerRay = 1000; // guard against a ray stuck on a boundary
+  G4long nSteps = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (G4int i = 0; i < nRays; i++)
+    {
+      G4ThreeVector p = points[i];
+      const G4ThreeVector& v = directions[i];
+      navigator.LocateGlobalPointAndSetup(p, &v, false, false);
+      for (G4int j = 0; j < maxStepsPerRay; j++)
+	{
+	  G4double safety = 0;
+	  G4double step = navigator.ComputeStep(p, v, kInfinity, safety);
+	  nSteps++;
+	  if (step >= kInfinity)
+	    {break;}
+	  p += step*v;
+	  navigator.SetGeometricallyLimitedStep();
+	  if (!navigator.LocateGlobalPointAndSetup(p, &v, true, false))
+	    {break;} // left the world
+	}
+    }
+  auto stop = std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed = stop - start;
+
+  G4GeometryManager::GetInstance()->OpenGeometry(worldPV);
+  delete assemblyPV;
+  delete worldPV;
+  delete worldLV;
+  delete worldSolid;
+  return (G4double)nSteps / elapsed.count();
+}
+
+/// Compare each solid of two assemblies built with and without Boolean solids, in
+/// the order they're placed, and print the tracking step rate through each.
+G4int CompareAssemblies(const std::string& name,
+			G4LogicalVolume* containerBoolean,
+			const std::string& prefixBoolean,
+			G4LogicalVolume* containerFree,
+			const std::string& prefixFree,
+			const BDSExtent& box,
+			G4double zHalfAssembly,
+			G4double zHalfSample,
+			CLHEP::HepRandomEngine* engine)
+{
+  const G4double maxMismatch = 5e-3; // polygonal approximation of curved edges
+  const G4int    nPoints     = 200000;
+  const G4int    nRays       = 100000;
+
+  LabelledSolids sb = Solids(containerBoolean, prefixBoolean);
+  LabelledSolids sf = Solids(containerFree,    prefixFree);
+  if (sb.size() != sf.size())
+    {
+      std::cout << name << ": " << sb.size() << " solids with booleans but " << sf.size()
+		<< " without <- FAIL" << std::endl;
+      return 1;
+    }
+
+  G4int result = 0;
+  for (G4int i = 0; i < (G4int)sb.size(); i++)
+    {
+      G4double mismatch = MismatchFraction(sb[i].second, sf[i].second, box, zHalfSample, engine, nPoints);
+      G4bool ok = mismatch < maxMismatch;
+      std::cout << name << " " << sb[i].first << ": mismatch fraction of own volume " << mismatch
+		<< (ok ? "" : " <- FAIL") << std::endl;
+      if (!ok)
+	{result = 1;}
+    }
+
+  G4double rateBoolean = StepsPerSecond(containerBoolean, box, zHalfAssembly, zHalfSample, engine, nRays);
+  G4double rateFree    = StepsPerSecond(containerFree,    box, zHalfAssembly, zHalfSample, engine, nRays);
+  std::cout << name << ": tracking steps/s boolean " << rateBoolean << " boolean free " << rateFree
+	    << " (x" << rateFree / rateBoolean << ")" << std::endl;
+  return result;
+}
+
+int main(int /*argc*/, char** /*argv*/)
+{
+  G4int result = 0;
+  try
+    {
+      G4Material* vacuum = BDSMaterials::Instance()->GetMaterial("vacuum");
+      G4Material* steel  = BDSMaterials::Instance()->GetMaterial("stainlesssteel");
+      G4Material* iron   = BDSMaterials::Instance()->GetMaterial("iron");
+
+      BDSBeamPipeFactoryRectEllipse       rectEllipseBoolean;
+      BDSBeamPipeFactoryLHC               lhcBoolean;
+      BDSBeamPipeFactoryRectEllipsePoints rectEllipsePoints;
+      BDSBeamPipeFactoryRectEllipsePoints lhcPoints(true);
+
+      struct TestCase
+      {
+	std::string             name;
+	BDSBeamPipeFactoryBase* booleanFactory;
+	BDSBeamPipeFactoryBase* pointsFactory;
+	G4double aper1;
+	G4double aper2;
+	G4double aper3;
+	G4double aper4;
+      };
+      const G4double mm = CLHEP::mm;
+      std::vector<TestCase> cases = {
+	{"rectellipse",      &rectEllipseBoolean, &rectEllipsePoints, 30*mm, 20*mm, 35*mm, 25*mm},
+	{"rectellipse-flat", &rectEllipseBoolean, &rectEllipsePoints, 40*mm, 15*mm, 45*mm, 45*mm},
+	{"lhc",              &lhcBoolean,         &lhcPoints,         22*mm, 18*mm, 24*mm, 0}
+      };
+
+      const G4double length        = 1*CLHEP::m;
+      const G4double thickness     = 1.5*mm;
+      const G4double zHalfSample   = 0.4*length; // away from the end faces
+      const G4double extentMargin  = 1e-3*mm;
+      CLHEP::MixMaxRng engine(1234);
+
+      for (const auto& tc : cases)
+	{
+	  std::string nameBoolean = tc.name + "_boolean";
+	  std::string namePoints  = tc.name + "_points";
+	  BDSBeamPipe* bpBoolean = tc.booleanFactory->CreateBeamPipe(nameBoolean, length,
+								     tc.aper1, tc.aper2, tc.aper3, tc.aper4,
+								     vacuum, thickness, steel);
+	  BDSBeamPipe* bpPoints  = tc.pointsFactory->CreateBeamPipe(namePoints, length,
+								    tc.aper1, tc.aper2, tc.aper3, tc.aper4,
+								    vacuum, thickness, steel);
+
+	  // the inspector gives a conservative extent for the boolean solids so the
+	  // extruded ones must lie within it
+	  BDSExtent extBoolean = BDS::DetermineExtents(bpBoolean->GetContainerSolid()).first;
+	  BDSExtent extPoints  = BDS::DetermineExtents(bpPoints->GetContainerSolid()).first;
+	  G4bool extentOK = extPoints.XPos() <= extBoolean.XPos() + extentMargin
+	    && extPoints.YPos() <= extBoolean.YPos() + extentMargin
+	    && extPoints.XNeg() >= extBoolean.XNeg() - extentMargin
+	    && extPoints.YNeg() >= extBoolean.YNeg() - extentMargin;
+	  std::cout << tc.name << " container extent boolean: " << extBoolean
+		    << " extruded: " << extPoints << (extentOK ? "" : " <- FAIL") << std::endl;
+	  if (!extentOK)
+	    {result = 1;}
+
+	  result += CompareAssemblies(tc.name,
+				      bpBoolean->GetContainerLogicalVolume(), nameBoolean,
+				      bpPoints->GetContainerLogicalVolume(),  namePoints,
+				      extBoolean, 0.5*length, zHalfSample, &engine);
+	  delete bpBoolean;
+	  delete bpPoints;
+	}
+
+      // poles of a quadrupole with a circular yoke, intersected with the yoke or built
+      // with an arc at their outer edge
+      BDSBeamPipeFactoryCircular circular;
+      BDSMagnetOuterFactoryPolesCircular polesBoolean;
+      BDSMagnetOuterFactoryPolesCircular polesArc;
+      polesBoolean.SetBooleanFreeGeometry(false);
+      polesArc.SetBooleanFreeGeometry(true);
+      BDSMagnetOuterInfo recipe("quadrupole", BDSMagnetGeometryType::polescircular,
+				450*mm, iron, 50*mm);
+      recipe.buildEndPieces = false;
+      BDSBeamPipe* bpQuad = circular.CreateBeamPipe("quadrupole_bp", length, 40*mm, 40*mm, 0, 0,
+						    vacuum, thickness, steel);
+      BDSMagnetOuter* quadBoolean = polesBoolean.CreateQuadrupole("quadrupole_boolean", length, bpQuad,
+								  length, &recipe);
+      BDSMagnetOuter* quadArc     = polesArc.CreateQuadrupole("quadrupole_arc", length, bpQuad,
+							      length, &recipe);
+      result += CompareAssemblies("quadrupole-poles",
+				  quadBoolean->GetContainerLogicalVolume(), "quadrupole_boolean",
+				  quadArc->GetContainerLogicalVolume(),     "quadrupole_arc",
+				  quadBoolean->GetExtent(), 0.5*length, zHalfSample, &engine);
+      delete quadBoolean;
+      delete quadArc;
+      delete bpQuad;
+    }
+  catch (const BDSException& exception)
+    {
+      std::cerr << exception.what() << std::endl;
+      return 1;
+    }
+  return result > 0 ? 1 : 0;
+}
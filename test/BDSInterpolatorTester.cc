@@ -24,6 +24,7 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 #include "BDSFieldInfo.hh"
 #include "BDSFieldLoader.hh"
 #include "BDSFieldMag.hh"
+#include "BDSFieldMapPrecision.hh"
 #include "BDSFieldMagInterpolated2D.hh"
 #include "BDSFieldType.hh"
 #include "BDSFieldValue.hh"
@@ -36,6 +37,8 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "CLHEP/Units/SystemOfUnits.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <ostream>
@@ -95,6 +98,31 @@ void Query(BDSFieldMag* field,
   ofile2.close();
 }
 
+/// Return the largest difference in field magnitude between two fields relative to
+/// the largest field magnitude, sampling nX x nY points in the given range.
+double MaximumRelativeDifference(BDSFieldMag* a,
+				 BDSFieldMag* b,
+				 G4double ymin, G4double ymax, G4double xmin, G4double xmax,
+				 G4int nX, G4int nY)
+{
+  double xStep = (xmax - xmin) / (double)nX;
+  double yStep = (ymax - ymin) / (double)nY;
+  double maxDifference = 0;
+  double maxMagnitude  = 0;
+  for (int iy = 0; iy < nY; iy++)
+    {
+      for (int ix = 0; ix < nX; ix++)
+	{
+	  G4ThreeVector position(xmin + ix*xStep, ymin + iy*yStep, 0);
+	  G4ThreeVector fa = a->GetField(position);
+	  G4ThreeVector fb = b->GetField(position);
+	  maxDifference = std::max(maxDifference, (fa - fb).mag());
+	  maxMagnitude  = std::max(maxMagnitude, fa.mag());
+	}
+    }
+  return maxMagnitude > 0 ? maxDifference / maxMagnitude : maxDifference;
+}
+
 int main(int /*argc*/, char** /*argv*/)
 {
   const std::string exampleFile2D = "../examples/features/fields/maps_bdsim/2dexample.dat";
@@ -173,6 +201,18 @@ int main(int /*argc*/, char** /*argv*/)
   catch (const std::exception& e)
     {std::cout << e.what() << std::endl; return 1;}
 
+  // 2D Cubic with the map quantised to int16
+  BDSFieldInfo* infoBiCubicInt16 = new BDSFieldInfo(*infoBiCubic);
+  infoBiCubicInt16->SetMapPrecision(BDSFieldMapPrecision::int16);
+
+  BDSFieldMag* biCubicInt16 = nullptr;
+  try
+    {biCubicInt16 = BDSFieldLoader::Instance()->LoadMagField(*infoBiCubicInt16);}
+  catch (const BDSException& e)
+    {std::cout << e.what() << std::endl; return 1;}
+  catch (const std::exception& e)
+    {std::cout << e.what() << std::endl; return 1;}
+
   // Get the raw data
   if (biNearest)
     {
@@ -210,6 +250,23 @@ int main(int /*argc*/, char** /*argv*/)
       G4cout << biCubic->GetField(G4ThreeVector(10, 11, 0)) << G4endl;
     }
   
+  // The quantised map should agree with the standard precision one to well within
+  // the precision of the map itself. One int16 step is ~3e-5 of the peak field.
+  if (biCubic && biCubicInt16)
+    {
+      Query(biCubicInt16, ymin, ymax, xmin, xmax, nX, nY, "cubic_int16");
+      double relativeDifference = MaximumRelativeDifference(biCubic, biCubicInt16,
+							    ymin, ymax, xmin, xmax, nX, nY);
+      G4cout << "Maximum relative difference of int16 map: " << relativeDifference << G4endl;
+      const double tolerance = 1e-4;
+      if (relativeDifference > tolerance)
+	{
+	  std::cerr << "int16 map differs from standard precision map by more than "
+		    << tolerance << " of the peak field" << std::endl;
+	  return 1;
+	}
+    }
+  
   //const G4String exampleFile2DQuadrant = "../examples/features/fields/maps_bdsim/2d_dipole_quadrant.dat";
   //BDSFieldLoaderBDSIM<std::ifstream> loader;
   //BDSArray2DCoords* result = loader.Load2D(exampleFile2DQuadrant);
@@ -24,31 +24,46 @@ along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
  *
  * version @BDSIM_VERSION@
  */
+#include "BDSBunch.hh"
 #include "BDSBunchSixTrackLink.hh"
 #include "BDSIMLink.hh"
 #include "BDSException.hh"
+#include "BDSHitSamplerLink.hh"
+#include "BDSLinkParticleBatch.hh"
+#include "BDSParticleCoordsFull.hh"
+#include "BDSParticleDefinition.hh"
 
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4Types.hh"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <iostream>
+#include <map>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+/// Coordinates returned for one particle: x (m), xp, y (m), yp, total energy (GeV).
+using Returned = std::map<int, std::array<double, 5> >;
+
+int TrackBatchMatchesSingle(BDSIMLink* bds, BDSBunchSixTrackLink* stp);
+int ElementUpdateTracksNewElements(BDSIMLink* bds, BDSBunchSixTrackLink* stp);
+
 int main(int argc, char** argv)
 {
   BDSIMLink* bds = nullptr;
   BDSBunchSixTrackLink* stp = nullptr;
+  int result = 0;
   try
     {
       stp = new BDSBunchSixTrackLink();
       bds = new BDSIMLink(stp);
 
-      //std::vector<std::string> arguments = {"--file=../examples/features/link/link_collimators.gmad",
-      //				    "--vis_debug"/*, "--batch"*/};
-      /*std::vector<char*> argvv;
-	for (const auto& arg : arguments)
-	{argvv.push_back((char*)arg.data());}
-	argv.push_back(std::string(*(argv->[0])));
-      */
       bds->Initialise(argc, argv, true, 100);
       if (!bds->Initialised())
 	{
@@ -57,11 +72,10 @@ int main(int argc, char** argv)
 	}
       else
 	{
-	  bds->BeamOn();
+	  result += TrackBatchMatchesSingle(bds, stp);
+	  result += ElementUpdateTracksNewElements(bds, stp);
+	  result = result > 0 ? 1 : 0;
 	}
-      auto hits = bds->SamplerHits();
-      if (hits)
-	{G4cout << hits->entries() << G4endl;}
       delete bds;
       delete stp;
     }
@@ -80,5 +94,175 @@ int main(int argc, char** argv)
       exit(1);
     }
 
-  return 0;
+  return result;
+}
+
+/// Compare the particles returned by two ways of tracking. Every particle must be
+/// returned by both with the same coordinates to within rounding.
+int Compare(const std::string& name, const Returned& expected, const Returned& returned)
+{
+  int result = 0;
+  if (returned.size() != expected.size())
+    {
+      std::cout << name << ": " << returned.size() << " particles returned but "
+		<< expected.size() << " expected <- FAIL" << std::endl;
+      return 1;
+    }
+  for (const auto& kv : expected)
+    {
+      auto search = returned.find(kv.first);
+      if (search == returned.end())
+	{
+	  std::cout << name << ": particle " << kv.first << " not returned <- FAIL" << std::endl;
+	  result = 1;
+	  continue;
+	}
+      for (int i = 0; i < 5; i++)
+	{
+	  double a = kv.second[i];
+	  double b = search->second[i];
+	  if (std::abs(a - b) > 1e-9 * std::max(1.0, std::abs(a)))
+	    {
+	      std::cout << name << ": particle " << kv.first << " coordinate " << i << " is " << b
+			<< " but " << a << " expected <- FAIL" << std::endl;
+	      result = 1;
+	    }
+	}
+    }
+  if (result == 0)
+    {std::cout << name << ": " << returned.size() << " particles match" << std::endl;}
+  return result;
+}
+
+/// 450 GeV protons within 2 mm of the axis and nearly parallel to it.
+BDSLinkParticleBatch TestProtons()
+{
+  BDSLinkParticleBatch batch;
+  for (int i = 0; i < 8; i++)
+    {
+      double x  = (-1.75 + 0.5*i) * 1e-3;
+      double xp = (i % 2 == 0 ? 1 : -1) * 1e-6 * i;
+      double y  = (0.2*i - 0.7) * 1e-3;
+      double yp = -2e-6 + 5e-7*i;
+      batch.Append(x, xp, y, yp, 0, 450, 1, 2212, 0, i + 1, 0);
+    }
+  return batch;
+}
+
+/// Track each particle in its own run with BeamOn(1) through the selected link element
+/// and return the particles that reach the link sampler by external ID.
+Returned TrackOneAtATime(BDSIMLink* bds, BDSBunchSixTrackLink* stp, const BDSLinkParticleBatch& particles)
+{
+  Returned result;
+  for (int i = 0; i < (int)particles.Size(); i++)
+    {
+      stp->ClearParticles();
+      bds->ClearSamplerHits();
+      G4ParticleDefinition* particleDef = G4ParticleTable::GetParticleTable()->FindParticle(particles.pdgID[i]);
+      G4double totalEnergy = particles.totalEnergy[i] * CLHEP::GeV;
+      BDSParticleCoordsFull coords(particles.x[i]*CLHEP::m, particles.y[i]*CLHEP::m, 0,
+				   particles.xp[i], particles.yp[i],
+				   BDSBunch::CalculateZp(particles.xp[i], particles.yp[i], 1),
+				   particles.T[i]*CLHEP::s, 0, totalEnergy, particles.weight[i]);
+      auto particleDefinition = new BDSParticleDefinition(particleDef, totalEnergy, 0, 0, 1, nullptr);
+      stp->AddParticle(particleDefinition, coords, particles.externalParticleID[i], particles.externalParentID[i]);
+      bds->BeamOn(1);
+      const BDSHitsCollectionSamplerLink* hits = bds->SamplerHits();
+      for (int j = 0; hits && j < (int)hits->entries(); j++)
+	{
+	  const BDSHitSamplerLink* hit = (*hits)[j];
+	  result[hit->externalParticleID] = {hit->coords.x / CLHEP::m, hit->coords.xp,
+					     hit->coords.y / CLHEP::m, hit->coords.yp,
+					     hit->coords.totalEnergy / CLHEP::GeV};
+	}
+    }
+  stp->ClearParticles();
+  bds->ClearSamplerHits();
+  return result;
+}
+
+/// Track protons through the gap of a collimator one at a time with BeamOn and
+/// as a batch with TrackBatch, with one and several primaries per event, and check
+/// the same particles are returned with the same coordinates. The protons don't
+/// touch the jaws so their tracking doesn't depend on the random numbers used.
+int TrackBatchMatchesSingle(BDSIMLink* bds, BDSBunchSixTrackLink* stp)
+{
+  bds->AddLinkCollimatorJaw("batchgap", "Cu", 1*CLHEP::m, 5*CLHEP::mm, 5*CLHEP::mm, 0, 0, 0);
+  bds->SelectLinkElement("batchgap");
+
+  BDSLinkParticleBatch batch = TestProtons();
+  Returned single = TrackOneAtATime(bds, stp, batch);
+  if (single.size() != batch.Size())
+    {
+      std::cout << "tracked one at a time: " << single.size() << " of " << batch.Size()
+		<< " particles returned <- FAIL" << std::endl;
+      return 1;
+    }
+
+  int result = 0;
+  BDSLinkParticleBatch returned;
+  for (int primariesPerEvent : {1, 3})
+    {
+      bds->TrackBatch(batch, returned, primariesPerEvent);
+      Returned fromBatch;
+      for (int i = 0; i < (int)returned.Size(); i++)
+	{
+	  fromBatch[returned.externalParticleID[i]] = {returned.x[i], returned.xp[i],
+						       returned.y[i], returned.yp[i],
+						       returned.totalEnergy[i]};
+	}
+      result += Compare("TrackBatch with " + std::to_string(primariesPerEvent) + " primaries per event",
+			single, fromBatch);
+    }
+  return result > 0 ? 1 : 0;
+}
+
+/// Add two collimators inside one BeginLinkElementUpdate / EndLinkElementUpdate bracket
+/// with the incremental geometry update: one with the same 5 mm half gap as "batchgap"
+/// and one with a 1 mm half gap that the outer protons hit. After the update the
+/// protons must be tracked through the existing and the new wide collimator as
+/// before, and those outside 1 mm must not be returned unchanged by the narrow one.
+int ElementUpdateTracksNewElements(BDSIMLink* bds, BDSBunchSixTrackLink* stp)
+{
+  BDSLinkParticleBatch batch = TestProtons();
+  bds->SelectLinkElement("batchgap");
+  Returned before = TrackOneAtATime(bds, stp, batch);
+
+  bds->SetIncrementalGeometryUpdate(true);
+  bds->BeginLinkElementUpdate();
+  bds->AddLinkCollimatorJaw("updategap",    "Cu", 1*CLHEP::m, 5*CLHEP::mm, 5*CLHEP::mm, 0, 0, 0);
+  bds->AddLinkCollimatorJaw("updatenarrow", "Cu", 1*CLHEP::m, 1*CLHEP::mm, 1*CLHEP::mm, 0, 0, 0);
+  bds->EndLinkElementUpdate();
+  bds->SetIncrementalGeometryUpdate(false);
+
+  int result = 0;
+  bds->SelectLinkElement("batchgap");
+  result += Compare("existing collimator after update", before, TrackOneAtATime(bds, stp, batch));
+  bds->SelectLinkElement("updategap");
+  result += Compare("collimator added in update", before, TrackOneAtATime(bds, stp, batch));
+
+  bds->SelectLinkElement("updatenarrow");
+  Returned narrow = TrackOneAtATime(bds, stp, batch);
+  int nHit = 0;
+  for (int i = 0; i < (int)batch.Size(); i++)
+    {
+      // the jaws are parallel to the axis so only the entry position matters
+      if (std::abs(batch.x[i]) < 0.9e-3)
+	{continue;}
+      nHit++;
+      int id = batch.externalParticleID[i];
+      auto search = narrow.find(id);
+      if (search != narrow.end() && std::abs(search->second[4] - before[id][4]) < 1e-9 * before[id][4]
+	  && std::abs(search->second[0] - before[id][0]) < 1e-12)
+	{
+	  std::cout << "narrow collimator added in update: particle " << id
+		    << " passed through the jaw unchanged <- FAIL" << std::endl;
+	  result++;
+	}
+    }
+  if (nHit == 0)
+    {std::cout << "narrow collimator added in update: no protons hit the jaws <- FAIL" << std::endl; result++;}
+  else if (result == 0)
+    {std::cout << "narrow collimator added in update: " << nHit << " protons hit the jaws" << std::endl;}
+  return result > 0 ? 1 : 0;
 }
@@ -0,0 +1,148 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "TBranch.h"
+#include "TFile.h"
+#include "TObjArray.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Compare the Optics tree in an optics file (from rebdsimOptics or rebdsimCombine)
+ * with that in a reference file made from the same events. Every branch of the
+ * reference must be in the test file with the same number of entries. Each value
+ * must agree to the tolerance times the larger of its magnitude and its statistical
+ * error (the "Sigma_" branch of the same name where there is one), so a change in
+ * only the order or method of summation passes, but any change in the result that
+ * matters compared to the error does not. The test file must also have the
+ * OpticsMoments tree, with one entry per sampler, from which the optics are merged.
+ */
+int main(int argc, char** argv)
+{
+  if (argc != 4)
+    {
+      std::cout << "usage: BDSOpticsComparisonTester <referenceOpticsFile> <opticsFile> <tolerance>" << std::endl;
+      return 1;
+    }
+  const double tolerance = std::stod(argv[3]);
+
+  TFile* f1 = TFile::Open(argv[1]);
+  TFile* f2 = TFile::Open(argv[2]);
+  if (!f1 || f1->IsZombie() || !f2 || f2->IsZombie())
+    {std::cerr << "unable to open input files" << std::endl; return 1;}
+  TTree* t1 = dynamic_cast<TTree*>(f1->Get("Optics"));
+  TTree* t2 = dynamic_cast<TTree*>(f2->Get("Optics"));
+  if (!t1 || !t2)
+    {std::cerr << "no Optics tree in input files" << std::endl; return 1;}
+  const long nEntries = (long)t1->GetEntries();
+  if ((long)t2->GetEntries() != nEntries)
+    {
+      std::cout << "Optics has " << t2->GetEntries() << " entries but " << nEntries
+		<< " in the reference <- FAIL" << std::endl;
+      return 1;
+    }
+
+  int result = 0;
+  TTree* moments = dynamic_cast<TTree*>(f2->Get("OpticsMoments"));
+  if (!moments)
+    {std::cout << "no OpticsMoments tree in " << argv[2] << " <- FAIL" << std::endl; result = 1;}
+  else if ((long)moments->GetEntries() != nEntries)
+    {
+      std::cout << "OpticsMoments has " << moments->GetEntries() << " entries but Optics has "
+		<< nEntries << " <- FAIL" << std::endl;
+      result = 1;
+    }
+
+  // read every branch of both files into memory
+  std::vector<std::string> names;
+  TObjArray* branches = t1->GetListOfBranches();
+  for (int i = 0; i < branches->GetEntries(); i++)
+    {names.push_back(std::string(branches->At(i)->GetName()));}
+  auto readBranch = [nEntries](TTree* tree, const std::string& name, std::vector<double>& values)
+  {
+    TBranch* branch = tree->GetBranch(name.c_str());
+    if (!branch)
+      {return false;}
+    double value = 0;
+    tree->SetBranchStatus("*", 0);
+    tree->SetBranchStatus(name.c_str(), 1);
+    tree->SetBranchAddress(name.c_str(), &value);
+    values.resize(nEntries);
+    for (long i = 0; i < nEntries; i++)
+      {
+	tree->GetEntry(i);
+	values[i] = value;
+      }
+    tree->ResetBranchAddresses();
+    return true;
+  };
+
+  double largestRatio = 0;
+  std::string largestRatioName;
+  for (const auto& name : names)
+    {
+      std::vector<double> v1, v2, errors;
+      readBranch(t1, name, v1);
+      if (!readBranch(t2, name, v2))
+	{
+	  std::cout << "branch " << name << " missing <- FAIL" << std::endl;
+	  result = 1;
+	  continue;
+	}
+      bool hasError = name.rfind("Sigma_", 0) != 0 && readBranch(t1, "Sigma_" + name, errors);
+      for (long i = 0; i < nEntries; i++)
+	{
+	  if (std::isnan(v1[i]) && std::isnan(v2[i]))
+	    {continue;}
+	  double scale = std::abs(v1[i]);
+	  if (hasError && std::isfinite(errors[i]))
+	    {scale = std::max(scale, errors[i]);}
+	  double difference = std::abs(v1[i] - v2[i]);
+	  if (difference == 0)
+	    {continue;}
+	  double ratio = scale > 0 ? difference / scale : difference;
+	  if (!(ratio <= tolerance)) // also catches a nan in only one file
+	    {
+	      std::cout << name << " entry " << i << ": " << v2[i] << " but " << v1[i]
+			<< " in the reference <- FAIL" << std::endl;
+	      result = 1;
+	    }
+	  if (ratio > largestRatio)
+	    {
+	      largestRatio = ratio;
+	      largestRatioName = name;
+	    }
+	}
+    }
+  std::cout << names.size() << " branches of " << nEntries << " samplers compared, largest difference "
+	    << largestRatio << " of the value or its error";
+  if (!largestRatioName.empty())
+    {std::cout << " (" << largestRatioName << ")";}
+  std::cout << std::endl;
+
+  f1->Close();
+  f2->Close();
+  delete f1;
+  delete f2;
+  return result;
+}
@@ -0,0 +1,152 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "BDSException.hh"
+#include "BDSParticleDefinition.hh"
+#include "BDSPTCOneTurnMap.hh"
+
+#include "globals.hh"
+
+#include "CLHEP/Units/PhysicalConstants.h"
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/// Reference evaluation of the map with one std::pow per variable per term as
+/// the map was originally evaluated.
+struct ReferenceTerm
+{
+  G4int    output;
+  G4double coefficient;
+  G4int    n[5];
+};
+
+std::vector<ReferenceTerm> LoadReference(const std::string& fileName)
+{
+  std::vector<ReferenceTerm> terms;
+  std::ifstream infile(fileName);
+  std::string line;
+  while (std::getline(infile, line))
+    {
+      if (line.empty() || line.at(0) == '@' || line.at(0) == '*' || line.at(0) == '$')
+	{continue;}
+      std::istringstream stream(line);
+      std::string name;
+      ReferenceTerm t;
+      G4int dimensionality, totalOrder, nt;
+      stream >> name >> t.coefficient >> t.output >> dimensionality >> totalOrder
+	     >> t.n[0] >> t.n[1] >> t.n[2] >> t.n[3] >> t.n[4] >> nt;
+      t.output -= 1;
+      terms.push_back(t);
+    }
+  return terms;
+}
+
+void EvaluateReference(const std::vector<ReferenceTerm>& terms,
+		       BDSPTCOneTurnMap::PTCCoordinates& coords)
+{
+  BDSPTCOneTurnMap::PTCCoordinates result = {0, 0, 0, 0, 0};
+  for (const auto& t : terms)
+    {
+      result[t.output] += t.coefficient
+	* std::pow(coords[0], t.n[0])
+	* std::pow(coords[1], t.n[1])
+	* std::pow(coords[2], t.n[2])
+	* std::pow(coords[3], t.n[3])
+	* std::pow(coords[4], t.n[4]);
+    }
+  coords = result;
+}
+
+int main(int argc, char** argv)
+{
+  std::string mapFile = argc > 1 ? argv[1] : "otm.dat"; // examples/features/options/otm.dat
+  G4int nParticles    = argc > 2 ? std::stoi(argv[2]) : 1000;
+  G4int nTurns        = argc > 3 ? std::stoi(argv[3]) : 100;
+
+  try
+    {
+      BDSParticleDefinition proton("proton", CLHEP::proton_mass_c2, 1, 0, 0, 450*CLHEP::GeV, 1);
+      BDSPTCOneTurnMap otm(mapFile, &proton);
+      std::vector<ReferenceTerm> reference = LoadReference(mapFile);
+      std::cout << reference.size() << " terms compiled to " << otm.NMonomials() << " monomials" << std::endl;
+
+      // small deterministic spread of initial coordinates
+      std::vector<BDSPTCOneTurnMap::PTCCoordinates> initial;
+      for (G4int i = 0; i < nParticles; i++)
+	{
+	  G4double f = (G4double)(i % 97) / 97.0 - 0.5;
+	  G4double g = (G4double)(i % 89) / 89.0 - 0.5;
+	  initial.push_back({1e-4*f, 1e-6*g, 1e-4*g, 1e-6*f, 1e-4*f*g});
+	}
+
+      auto compiled = initial;
+      auto start = std::chrono::steady_clock::now();
+      for (G4int turn = 0; turn < nTurns; turn++)
+	{
+	  for (auto& coords : compiled)
+	    {otm.Evaluate(coords, coords);}
+	}
+      auto stop = std::chrono::steady_clock::now();
+      G4double tCompiled = std::chrono::duration<G4double>(stop - start).count();
+
+      auto naive = initial;
+      start = std::chrono::steady_clock::now();
+      for (G4int turn = 0; turn < nTurns; turn++)
+	{
+	  for (auto& coords : naive)
+	    {EvaluateReference(reference, coords);}
+	}
+      stop = std::chrono::steady_clock::now();
+      G4double tNaive = std::chrono::duration<G4double>(stop - start).count();
+
+      G4double maxDifference = 0;
+      for (G4int i = 0; i < nParticles; i++)
+	{
+	  for (G4int j = 0; j < 5; j++)
+	    {
+	      G4double scale = std::max(std::abs(naive[i][j]), 1e-12);
+	      maxDifference = std::max(maxDifference, std::abs(naive[i][j] - compiled[i][j]) / scale);
+	    }
+	}
+
+      std::cout << nParticles << " particles x " << nTurns << " turns" << std::endl;
+      std::cout << "std::pow evaluation: " << tNaive    << " s" << std::endl;
+      std::cout << "compiled evaluation: " << tCompiled << " s" << std::endl;
+      std::cout << "maximum relative difference: " << maxDifference << std::endl;
+      if (maxDifference > 1e-9)
+	{
+	  std::cerr << "Compiled map does not agree with reference evaluation" << std::endl;
+	  return 1;
+	}
+    }
+  catch (const BDSException& exception)
+    {
+      std::cerr << exception.what() << std::endl;
+      return 1;
+    }
+  return 0;
+}
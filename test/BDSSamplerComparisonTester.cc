@@ -0,0 +1,105 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "DataLoader.hh"
+#include "Event.hh"
+
+#include "TChain.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Compare the hits of one sampler in two runs of the same events, e.g. with a
+ * field map stored at two precisions or with and without fast tracking. For each of x, xp, y and yp the largest
+ * difference for any hit is divided by the RMS of that coordinate in the first
+ * file. The comparison passes if every event has the same number of hits in both
+ * files and each of these ratios is below the tolerance.
+ */
+int main(int argc, char** argv)
+{
+  if (argc != 5)
+    {
+      std::cout << "usage: BDSSamplerComparisonTester <datafile1> <datafile2> <samplerName> <tolerance>" << std::endl;
+      return 1;
+    }
+  const std::string samplerName = std::string(argv[3]);
+  const double tolerance        = std::stod(argv[4]);
+
+  DataLoader* dl1 = new DataLoader(std::string(argv[1]));
+  DataLoader* dl2 = new DataLoader(std::string(argv[2]));
+  TChain* eventTree1 = dl1->GetEventTree();
+  TChain* eventTree2 = dl2->GetEventTree();
+  // branch names of samplers end in '.'
+  auto s1 = dl1->GetEvent()->GetSampler(samplerName + ".");
+  auto s2 = dl2->GetEvent()->GetSampler(samplerName + ".");
+  if (!s1 || !s2)
+    {std::cerr << "no sampler \"" << samplerName << "\" in both files" << std::endl; return 1;}
+  if (eventTree1->GetEntries() != eventTree2->GetEntries())
+    {std::cerr << "different numbers of events" << std::endl; return 1;}
+
+  const std::vector<std::string> names = {"x", "xp", "y", "yp"};
+  std::vector<double> maxDifference(4, 0);
+  std::vector<double> sum(4, 0);
+  std::vector<double> sum2(4, 0);
+  long nHits = 0;
+  int result = 0;
+  for (long i = 0; i < (long)eventTree1->GetEntries(); i++)
+    {
+      eventTree1->GetEntry(i);
+      eventTree2->GetEntry(i);
+      if (s1->n != s2->n)
+	{
+	  std::cout << "event " << i << ": " << s1->n << " hits vs " << s2->n << " <- FAIL" << std::endl;
+	  result = 1;
+	  continue;
+	}
+      for (int j = 0; j < s1->n; j++)
+	{
+	  const double v1[4] = {s1->x[j], s1->xp[j], s1->y[j], s1->yp[j]};
+	  const double v2[4] = {s2->x[j], s2->xp[j], s2->y[j], s2->yp[j]};
+	  for (int k = 0; k < 4; k++)
+	    {
+	      maxDifference[k] = std::max(maxDifference[k], std::abs(v1[k] - v2[k]));
+	      sum[k]  += v1[k];
+	      sum2[k] += v1[k]*v1[k];
+	    }
+	  nHits++;
+	}
+    }
+  if (nHits == 0)
+    {std::cerr << "no hits in sampler \"" << samplerName << "\"" << std::endl; return 1;}
+
+  for (int k = 0; k < 4; k++)
+    {
+      double mean = sum[k] / (double)nHits;
+      double rms  = std::sqrt(std::max(0.0, sum2[k] / (double)nHits - mean*mean));
+      double ratio = rms > 0 ? maxDifference[k] / rms : maxDifference[k];
+      bool ok = ratio < tolerance;
+      std::cout << names[k] << ": largest difference " << maxDifference[k] << ", rms " << rms
+		<< ", ratio " << ratio << (ok ? "" : " <- FAIL") << std::endl;
+      if (!ok)
+	{result = 1;}
+    }
+  delete dl1;
+  delete dl2;
+  return result;
+}
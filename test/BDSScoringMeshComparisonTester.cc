@@ -0,0 +1,123 @@
+/* 
+Beam Delivery Simulation (BDSIM) Copyright (C) Royal Holloway, 
+University of London 2001 - 2024.
+
+This file is part of BDSIM.
+
+BDSIM is free software: you can redistribute it and/or modify 
+it under the terms of the GNU General Public License as published 
+by the Free Software Foundation version 3 of the License.
+
+BDSIM is distributed in the hope that it will be useful, but 
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with BDSIM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "TDirectory.h"
+#include "TFile.h"
+#include "TH3D.h"
+#include "TKey.h"
+#include "TList.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+/**
+ * Compare the merged scoring mesh histograms (from rebdsimHistoMerge) of two
+ * statistically independent runs voxel by voxel. For each voxel with an error
+ * in either file the pull (a - b) / sqrt(ea^2 + eb^2) is formed. Each test is made
+ * at the 3 sigma (0.27%) level for Gaussian errors: the chi2 of each histogram must
+ * be below n + 3 sqrt(2n) for n voxels, the largest pull in each histogram must be
+ * below the value exceeded by any of its n voxels with a probability of 0.27%, and
+ * the number of voxels with |pull| > 3 over all histograms must be below the
+ * expected number plus 3 times its binomial standard deviation.
+ */
+int main(int argc, char** argv)
+{
+  if (argc != 3)
+    {
+      std::cout << "usage: BDSScoringMeshComparisonTester <histosFile1> <histosFile2>" << std::endl;
+      return 1;
+    }
+  const double p3Sigma = std::erfc(3 / std::sqrt(2.0)); // two sided probability of |pull| > 3
+  const std::string dirName      = "Event/MergedHistograms";
+
+  TFile* f1 = TFile::Open(argv[1]);
+  TFile* f2 = TFile::Open(argv[2]);
+  if (!f1 || f1->IsZombie() || !f2 || f2->IsZombie())
+    {std::cerr << "unable to open input files" << std::endl; return 1;}
+  TDirectory* d1 = f1->GetDirectory(dirName.c_str());
+  TDirectory* d2 = f2->GetDirectory(dirName.c_str());
+  if (!d1 || !d2)
+    {std::cerr << "no " << dirName << " in input files" << std::endl; return 1;}
+
+  int result = 0;
+  int nHistograms = 0;
+  long nVoxelsTotal = 0;
+  long nOver3Total  = 0;
+  TIter next(d1->GetListOfKeys());
+  while (TKey* key = (TKey*)next())
+    {
+      if (std::string(key->GetClassName()) != "TH3D")
+	{continue;} // only scoring mesh histograms
+      TH3D* h1 = dynamic_cast<TH3D*>(key->ReadObj());
+      TH3D* h2 = dynamic_cast<TH3D*>(d2->Get(key->GetName()));
+      if (!h1 || !h2 || h1->GetNcells() != h2->GetNcells())
+	{
+	  std::cout << key->GetName() << ": missing or different binning <- FAIL" << std::endl;
+	  result = 1;
+	  continue;
+	}
+      nHistograms++;
+      long nVoxels = 0;
+      long nOver3  = 0;
+      double chi2  = 0;
+      double worst = 0;
+      for (int i = 0; i < h1->GetNcells(); i++)
+	{
+	  double a  = h1->GetBinContent(i);
+	  double b  = h2->GetBinContent(i);
+	  double e2 = std::pow(h1->GetBinError(i), 2) + std::pow(h2->GetBinError(i), 2);
+	  if (e2 <= 0)
+	    {
+	      if (a != b)
+		{nOver3++; worst = std::numeric_limits<double>::infinity();} // differ with no statistical error
+	      continue;
+	    }
+	  double pull = (a - b) / std::sqrt(e2);
+	  chi2 += pull*pull;
+	  nVoxels++;
+	  if (std::abs(pull) > 3)
+	    {nOver3++;}
+	  worst = std::max(worst, std::abs(pull));
+	}
+      double maxChi2 = nVoxels + 3*std::sqrt(2.0*nVoxels);
+      double maxPull = 3;
+      while (nVoxels * std::erfc(maxPull / std::sqrt(2.0)) > p3Sigma)
+	{maxPull += 0.01;}
+      bool ok = chi2 < maxChi2 && worst < maxPull;
+      std::cout << key->GetName() << ": " << nVoxels << " voxels, chi2 " << chi2 << " (< " << maxChi2
+		<< "), >3 sigma " << nOver3 << ", largest pull " << worst << " (< " << maxPull << ")"
+		<< (ok ? "" : " <- FAIL") << std::endl;
+      if (!ok)
+	{result = 1;}
+      nVoxelsTotal += nVoxels;
+      nOver3Total  += nOver3;
+    }
+  double expected = nVoxelsTotal * p3Sigma;
+  double maxOver3 = expected + 3*std::sqrt(expected*(1 - p3Sigma));
+  std::cout << "voxels > 3 sigma: " << nOver3Total << " of " << nVoxelsTotal
+	    << " (expected " << expected << ", < " << maxOver3 << ")" << std::endl;
+  if (nHistograms == 0 || nVoxelsTotal == 0 || (double)nOver3Total > maxOver3)
+    {result = 1;}
+
+  f1->Close();
+  f2->Close();
+  return result;
+}